@@ -0,0 +1,1578 @@
+/*
+ * Bench handle
+ *
+ * Copyright (C) 2011-2018, Omar Choudary <choudary.omar@gmail.com>
+ *                          Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <system_string.h>
+#include <types.h>
+#include <wide_string.h>
+
+#include <time.h>
+
+#include "bench_handle.h"
+#include "fvdetools_libcaes.h"
+#include "fvdetools_libcerror.h"
+#include "fvdetools_libfvde.h"
+#include "fvdetools_libhmac.h"
+
+/* The key derivation and checksum functions are not part of the public API of libfvde
+ * but are exported by the library when it is not build as a DLL
+ */
+#if !defined( LIBFVDE_DLL_IMPORT )
+#include "../libfvde/libfvde_checksum.h"
+#include "../libfvde/libfvde_password.h"
+#include "../libfvde/libfvde_sha256_multi_buffer.h"
+#endif
+
+#define BENCH_HANDLE_NOTIFY_STREAM			stdout
+
+/* The default number of PBKDF2 iterations
+ */
+#define BENCH_HANDLE_DEFAULT_NUMBER_OF_ITERATIONS	41000
+
+/* The default minimum duration of a benchmark in seconds
+ */
+#define BENCH_HANDLE_DEFAULT_DURATION			1
+
+/* The size of the buffer used by the benchmarks
+ */
+#define BENCH_HANDLE_BUFFER_SIZE			65536
+
+/* The size of the checksummed part of a metadata block
+ */
+#define BENCH_HANDLE_METADATA_BLOCK_SIZE		8184
+
+/* The benchmarks that depend on a crypto backend
+ */
+#define BENCH_HANDLE_BENCHMARK_AES			0x01
+#define BENCH_HANDLE_BENCHMARK_SHA256			0x02
+#define BENCH_HANDLE_BENCHMARK_CRC32			0x04
+#define BENCH_HANDLE_BENCHMARK_PBKDF2_BATCH		0x08
+#define BENCH_HANDLE_BENCHMARK_ALL			0x0f
+
+/* Copies a string of a decimal value to a 64-bit value
+ * Returns 1 if successful or -1 on error
+ */
+int fvdetools_system_string_copy_from_64_bit_in_decimal(
+     const system_character_t *string,
+     size_t string_size,
+     uint64_t *value_64bit,
+     libcerror_error_t **error )
+{
+	static char *function              = "fvdetools_system_string_copy_from_64_bit_in_decimal";
+	size_t string_index                = 0;
+	system_character_t character_value = 0;
+	uint8_t maximum_string_index       = 20;
+	int8_t sign                        = 1;
+
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( string_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid string size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_64bit == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value 64-bit.",
+		 function );
+
+		return( -1 );
+	}
+	*value_64bit = 0;
+
+	if( string[ string_index ] == (system_character_t) '-' )
+	{
+		string_index++;
+		maximum_string_index++;
+
+		sign = -1;
+	}
+	else if( string[ string_index ] == (system_character_t) '+' )
+	{
+		string_index++;
+		maximum_string_index++;
+	}
+	while( string_index < string_size )
+	{
+		if( string[ string_index ] == 0 )
+		{
+			break;
+		}
+		if( string_index > (size_t) maximum_string_index )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_LARGE,
+			 "%s: string too large.",
+			 function );
+
+			return( -1 );
+		}
+		*value_64bit *= 10;
+
+		if( ( string[ string_index ] >= (system_character_t) '0' )
+		 && ( string[ string_index ] <= (system_character_t) '9' ) )
+		{
+			character_value = (system_character_t) ( string[ string_index ] - (system_character_t) '0' );
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported character value: %" PRIc_SYSTEM " at index: %d.",
+			 function,
+			 string[ string_index ],
+			 string_index );
+
+			return( -1 );
+		}
+		*value_64bit += character_value;
+
+		string_index++;
+	}
+	if( sign == -1 )
+	{
+		*value_64bit *= (uint64_t) -1;
+	}
+	return( 1 );
+}
+
+/* Retrieves the name of the backend used by libcaes
+ * Returns a string containing the name
+ */
+const char *bench_handle_get_aes_backend(
+             void )
+{
+#if defined( HAVE_LOCAL_LIBCAES )
+	return( libcaes_get_implementation_name() );
+#else
+	return( "libcaes" );
+#endif
+}
+
+/* Retrieves the name of the backend used by libhmac for SHA-256
+ * Returns a string containing the name
+ */
+const char *bench_handle_get_sha256_backend(
+             void )
+{
+#if defined( HAVE_LOCAL_LIBHMAC )
+	return( libhmac_sha256_get_implementation_name() );
+#else
+	return( "libhmac" );
+#endif
+}
+
+/* Enables or disables the hardware accelerated backends of the libraries
+ * The table or generic backends are used when disabled
+ */
+void bench_handle_set_hardware_enabled(
+      int enabled )
+{
+#if defined( HAVE_LOCAL_LIBCAES )
+	libcaes_set_hardware_enabled(
+	 enabled );
+#endif
+#if defined( HAVE_LOCAL_LIBHMAC )
+	libhmac_sha256_set_hardware_enabled(
+	 enabled );
+#endif
+#if !defined( LIBFVDE_DLL_IMPORT )
+	libfvde_checksum_set_hardware_enabled(
+	 enabled );
+#endif
+}
+
+/* Creates a bench handle
+ * Make sure the value bench_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_initialize(
+     bench_handle_t **bench_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_initialize";
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *bench_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid bench handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*bench_handle = memory_allocate_structure(
+	                 bench_handle_t );
+
+	if( *bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create bench handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *bench_handle,
+	     0,
+	     sizeof( bench_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear bench handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfvde_volume_initialize(
+	     &( ( *bench_handle )->input_volume ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input volume.",
+		 function );
+
+		goto on_error;
+	}
+	( *bench_handle )->number_of_iterations = BENCH_HANDLE_DEFAULT_NUMBER_OF_ITERATIONS;
+	( *bench_handle )->duration             = BENCH_HANDLE_DEFAULT_DURATION;
+	( *bench_handle )->notify_stream        = BENCH_HANDLE_NOTIFY_STREAM;
+
+	return( 1 );
+
+on_error:
+	if( *bench_handle != NULL )
+	{
+		memory_free(
+		 *bench_handle );
+
+		*bench_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a bench handle
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_free(
+     bench_handle_t **bench_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_free";
+	int result            = 1;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *bench_handle != NULL )
+	{
+		if( ( *bench_handle )->input_volume != NULL )
+		{
+			if( libfvde_volume_free(
+			     &( ( *bench_handle )->input_volume ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free input volume.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *bench_handle );
+
+		*bench_handle = NULL;
+	}
+	return( result );
+}
+
+/* Signals the bench handle to abort
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_signal_abort(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_signal_abort";
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+	bench_handle->abort = 1;
+
+	if( bench_handle->input_volume != NULL )
+	{
+		if( libfvde_volume_signal_abort(
+		     bench_handle->input_volume,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal input volume to abort.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Sets the number of PBKDF2 iterations
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_set_number_of_iterations(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_set_number_of_iterations";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( fvdetools_system_string_copy_from_64_bit_in_decimal(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit decimal.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( value_64bit == 0 )
+	 || ( value_64bit > (uint64_t) UINT32_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of iterations value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	bench_handle->number_of_iterations = (uint32_t) value_64bit;
+
+	return( 1 );
+}
+
+/* Sets the minimum duration of a benchmark in seconds
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_set_duration(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_set_duration";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( fvdetools_system_string_copy_from_64_bit_in_decimal(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit decimal.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( value_64bit == 0 )
+	 || ( value_64bit > 3600 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid duration value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	bench_handle->duration = (uint32_t) value_64bit;
+
+	return( 1 );
+}
+
+/* Reads the encrypted root plist file
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_read_encrypted_root_plist(
+     bench_handle_t *bench_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_read_encrypted_root_plist";
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libfvde_volume_read_encrypted_root_plist_wide(
+	     bench_handle->input_volume,
+	     filename,
+	     error ) != 1 )
+#else
+	if( libfvde_volume_read_encrypted_root_plist(
+	     bench_handle->input_volume,
+	     filename,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read encrypted root plist file.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Opens the input volume and retrieves the number of PBKDF2 iterations
+ * of its first passphrase wrapped KEK
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_open_input(
+     bench_handle_t *bench_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	uint8_t salt[ 16 ];
+	uint8_t wrapped_kek[ 24 ];
+
+	static char *function                 = "bench_handle_open_input";
+	uint32_t number_of_iterations         = 0;
+	int number_of_passphrase_wrapped_keks = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+	/* The volume does not need to be unlocked to retrieve the passphrase wrapped KEKs
+	 */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libfvde_volume_open_wide(
+	     bench_handle->input_volume,
+	     filename,
+	     LIBFVDE_OPEN_READ,
+	     error ) == -1 )
+#else
+	if( libfvde_volume_open(
+	     bench_handle->input_volume,
+	     filename,
+	     LIBFVDE_OPEN_READ,
+	     error ) == -1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open input volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfvde_volume_get_number_of_passphrase_wrapped_keks(
+	     bench_handle->input_volume,
+	     &number_of_passphrase_wrapped_keks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of passphrase wrapped KEKs.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_passphrase_wrapped_keks > 0 )
+	{
+		if( libfvde_volume_get_passphrase_wrapped_kek_by_index(
+		     bench_handle->input_volume,
+		     0,
+		     salt,
+		     16,
+		     &number_of_iterations,
+		     wrapped_kek,
+		     24,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve passphrase wrapped KEK: 0.",
+			 function );
+
+			return( -1 );
+		}
+		if( number_of_iterations != 0 )
+		{
+			bench_handle->number_of_iterations = number_of_iterations;
+		}
+	}
+	return( 1 );
+}
+
+/* Closes the bench handle
+ * Returns the 0 if succesful or -1 on error
+ */
+int bench_handle_close_input(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_close_input";
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfvde_volume_close(
+	     bench_handle->input_volume,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close input volume.",
+		 function );
+
+		return( -1 );
+	}
+	return( 0 );
+}
+
+/* Prints a benchmark result
+ * The result is printed as tab separated values
+ */
+void bench_handle_result_fprint(
+      bench_handle_t *bench_handle,
+      const char *benchmark,
+      const char *backend,
+      const char *parameter,
+      uint64_t parameter_value,
+      uint64_t number_of_units,
+      uint64_t units_per_value,
+      clock_t elapsed_time,
+      const char *unit )
+{
+	double value = 0.0;
+
+	if( elapsed_time > 0 )
+	{
+		value = ( (double) number_of_units * CLOCKS_PER_SEC ) / ( (double) elapsed_time * units_per_value );
+	}
+	fprintf(
+	 bench_handle->notify_stream,
+	 "%s\t%s\t%s=%" PRIu64 "\t%.2f\t%s\n",
+	 benchmark,
+	 backend,
+	 parameter,
+	 parameter_value,
+	 value,
+	 unit );
+}
+
+/* Determines if a benchmark has run for the minimum duration
+ * Returns 1 if it has, 0 if not
+ */
+int bench_handle_has_finished(
+     bench_handle_t *bench_handle,
+     clock_t start_time,
+     clock_t *elapsed_time )
+{
+	*elapsed_time = clock() - start_time;
+
+	if( bench_handle->abort != 0 )
+	{
+		return( 1 );
+	}
+	if( *elapsed_time >= (clock_t) ( bench_handle->duration * CLOCKS_PER_SEC ) )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Benchmarks AES-XTS decryption of data units
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_aes_xts_fprint(
+     bench_handle_t *bench_handle,
+     uint8_t *buffer,
+     size_t key_bit_size,
+     size_t data_unit_size,
+     libcerror_error_t **error )
+{
+	uint8_t key[ 32 ];
+	uint8_t tweak_key[ 32 ];
+	uint8_t tweak_value[ 16 ];
+
+	libcaes_tweaked_context_t *xts_context = NULL;
+	static char *function                  = "bench_handle_aes_xts_fprint";
+	clock_t elapsed_time                   = 0;
+	clock_t start_time                     = 0;
+	uint64_t data_unit_number              = 0;
+	uint64_t number_of_bytes               = 0;
+	size_t data_offset                     = 0;
+	uint8_t byte_index                     = 0;
+
+	for( byte_index = 0;
+	     byte_index < 32;
+	     byte_index++ )
+	{
+		key[ byte_index ]       = byte_index;
+		tweak_key[ byte_index ] = (uint8_t) ( 0xff - byte_index );
+	}
+	if( memory_set(
+	     tweak_value,
+	     0,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear tweak value.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcaes_tweaked_context_initialize(
+	     &xts_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize XTS context.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcaes_tweaked_context_set_keys(
+	     xts_context,
+	     LIBCAES_CRYPT_MODE_DECRYPT,
+	     key,
+	     key_bit_size,
+	     tweak_key,
+	     key_bit_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set keys in XTS context.",
+		 function );
+
+		goto on_error;
+	}
+	start_time = clock();
+
+	do
+	{
+		/* Decrypt the buffer as consecutive data units
+		 */
+		for( data_offset = 0;
+		     ( data_offset + data_unit_size ) <= BENCH_HANDLE_BUFFER_SIZE;
+		     data_offset += data_unit_size )
+		{
+			tweak_value[ 0 ] = (uint8_t) data_unit_number;
+			tweak_value[ 1 ] = (uint8_t) ( data_unit_number >> 8 );
+			tweak_value[ 2 ] = (uint8_t) ( data_unit_number >> 16 );
+			tweak_value[ 3 ] = (uint8_t) ( data_unit_number >> 24 );
+
+			if( libcaes_crypt_xts(
+			     xts_context,
+			     LIBCAES_CRYPT_MODE_DECRYPT,
+			     tweak_value,
+			     16,
+			     &( buffer[ data_offset ] ),
+			     data_unit_size,
+			     &( buffer[ data_offset ] ),
+			     data_unit_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+				 LIBCERROR_ENCRYPTION_ERROR_DECRYPT_FAILED,
+				 "%s: unable to decrypt data unit.",
+				 function );
+
+				goto on_error;
+			}
+			data_unit_number++;
+
+			number_of_bytes += data_unit_size;
+		}
+	}
+	while( bench_handle_has_finished(
+	        bench_handle,
+	        start_time,
+	        &elapsed_time ) == 0 );
+
+	if( libcaes_tweaked_context_free(
+	     &xts_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free XTS context.",
+		 function );
+
+		goto on_error;
+	}
+	bench_handle_result_fprint(
+	 bench_handle,
+	 ( key_bit_size == 128 ) ? "aes_xts_128_decrypt" : "aes_xts_256_decrypt",
+	 bench_handle_get_aes_backend(),
+	 "data_unit_size",
+	 (uint64_t) data_unit_size,
+	 number_of_bytes,
+	 1000000,
+	 elapsed_time,
+	 "MB/s" );
+
+	return( 1 );
+
+on_error:
+	if( xts_context != NULL )
+	{
+		libcaes_tweaked_context_free(
+		 &xts_context,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Benchmarks the SHA-256 block transform
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_sha256_fprint(
+     bench_handle_t *bench_handle,
+     uint8_t *buffer,
+     libcerror_error_t **error )
+{
+	uint8_t hash[ 32 ];
+
+	libhmac_sha256_context_t *sha256_context = NULL;
+	static char *function                    = "bench_handle_sha256_fprint";
+	clock_t elapsed_time                     = 0;
+	clock_t start_time                       = 0;
+	uint64_t number_of_blocks                = 0;
+
+	if( libhmac_sha256_initialize(
+	     &sha256_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize SHA-256 context.",
+		 function );
+
+		goto on_error;
+	}
+	start_time = clock();
+
+	do
+	{
+		if( libhmac_sha256_update(
+		     sha256_context,
+		     buffer,
+		     BENCH_HANDLE_BUFFER_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update SHA-256 hash.",
+			 function );
+
+			goto on_error;
+		}
+		number_of_blocks += BENCH_HANDLE_BUFFER_SIZE / 64;
+	}
+	while( bench_handle_has_finished(
+	        bench_handle,
+	        start_time,
+	        &elapsed_time ) == 0 );
+
+	if( libhmac_sha256_finalize(
+	     sha256_context,
+	     hash,
+	     32,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to finalize SHA-256 hash.",
+		 function );
+
+		goto on_error;
+	}
+	if( libhmac_sha256_free(
+	     &sha256_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free SHA-256 context.",
+		 function );
+
+		goto on_error;
+	}
+	bench_handle_result_fprint(
+	 bench_handle,
+	 "sha256_compress",
+	 bench_handle_get_sha256_backend(),
+	 "block_size",
+	 64,
+	 number_of_blocks,
+	 1,
+	 elapsed_time,
+	 "compressions/s" );
+
+	return( 1 );
+
+on_error:
+	if( sha256_context != NULL )
+	{
+		libhmac_sha256_free(
+		 &sha256_context,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#if !defined( LIBFVDE_DLL_IMPORT )
+
+/* Benchmarks PBKDF2-HMAC-SHA256 key derivations
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_pbkdf2_fprint(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error )
+{
+	uint8_t key[ 16 ];
+	uint8_t salt[ 16 ];
+
+	static char *function          = "bench_handle_pbkdf2_fprint";
+	clock_t elapsed_time           = 0;
+	clock_t start_time             = 0;
+	uint64_t number_of_derivations = 0;
+
+	if( memory_set(
+	     salt,
+	     0x5a,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to set salt.",
+		 function );
+
+		return( -1 );
+	}
+	start_time = clock();
+
+	do
+	{
+		if( libfvde_password_pbkdf2(
+		     (uint8_t *) "password",
+		     8,
+		     salt,
+		     16,
+		     bench_handle->number_of_iterations,
+		     key,
+		     16,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to derive key.",
+			 function );
+
+			return( -1 );
+		}
+		number_of_derivations++;
+	}
+	while( bench_handle_has_finished(
+	        bench_handle,
+	        start_time,
+	        &elapsed_time ) == 0 );
+
+	bench_handle_result_fprint(
+	 bench_handle,
+	 "pbkdf2_sha256",
+	 bench_handle_get_sha256_backend(),
+	 "iterations",
+	 (uint64_t) bench_handle->number_of_iterations,
+	 number_of_derivations,
+	 1,
+	 elapsed_time,
+	 "derivations/s" );
+
+	return( 1 );
+}
+
+/* Benchmarks batched PBKDF2-HMAC-SHA256 key derivations
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_pbkdf2_batch_fprint(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error )
+{
+	uint8_t password_data[ 64 * 8 ];
+	uint8_t keys[ 64 * 16 ];
+	uint8_t salt[ 16 ];
+
+	const uint8_t *passwords[ 64 ];
+	size_t password_sizes[ 64 ];
+
+	char backend_string[ 32 ];
+
+	const char *backend            = NULL;
+	static char *function          = "bench_handle_pbkdf2_batch_fprint";
+	clock_t elapsed_time           = 0;
+	clock_t start_time             = 0;
+	uint64_t number_of_derivations = 0;
+	int number_of_lanes            = 0;
+	int number_of_passwords        = 0;
+	int password_index             = 0;
+
+	if( memory_set(
+	     salt,
+	     0x5a,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to set salt.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_lanes = libfvde_sha256_multi_buffer_get_number_of_lanes();
+
+	if( number_of_lanes == 0 )
+	{
+		number_of_passwords = 16;
+
+		backend = bench_handle_get_sha256_backend();
+	}
+	else
+	{
+		number_of_passwords = number_of_lanes * 4;
+
+		if( number_of_passwords > 64 )
+		{
+			number_of_passwords = 64;
+		}
+		if( narrow_string_snprintf(
+		     backend_string,
+		     32,
+		     "multi-buffer-x%d",
+		     number_of_lanes ) < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set backend.",
+			 function );
+
+			return( -1 );
+		}
+		backend = backend_string;
+	}
+	for( password_index = 0;
+	     password_index < number_of_passwords;
+	     password_index++ )
+	{
+		if( narrow_string_snprintf(
+		     (char *) &( password_data[ password_index * 8 ] ),
+		     8,
+		     "pass%03d",
+		     password_index ) < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set password: %d.",
+			 function,
+			 password_index );
+
+			return( -1 );
+		}
+		passwords[ password_index ]      = &( password_data[ password_index * 8 ] );
+		password_sizes[ password_index ] = 7;
+	}
+	start_time = clock();
+
+	do
+	{
+		if( libfvde_password_pbkdf2_batch(
+		     passwords,
+		     password_sizes,
+		     number_of_passwords,
+		     salt,
+		     16,
+		     bench_handle->number_of_iterations,
+		     keys,
+		     64 * 16,
+		     16,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to derive keys.",
+			 function );
+
+			return( -1 );
+		}
+		number_of_derivations += number_of_passwords;
+	}
+	while( bench_handle_has_finished(
+	        bench_handle,
+	        start_time,
+	        &elapsed_time ) == 0 );
+
+	bench_handle_result_fprint(
+	 bench_handle,
+	 "pbkdf2_sha256_batch",
+	 backend,
+	 "iterations",
+	 (uint64_t) bench_handle->number_of_iterations,
+	 number_of_derivations,
+	 1,
+	 elapsed_time,
+	 "derivations/s" );
+
+	return( 1 );
+}
+
+/* Benchmarks the CRC-32C of metadata blocks
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_crc32_fprint(
+     bench_handle_t *bench_handle,
+     uint8_t *buffer,
+     libcerror_error_t **error )
+{
+	static char *function    = "bench_handle_crc32_fprint";
+	clock_t elapsed_time     = 0;
+	clock_t start_time       = 0;
+	uint64_t number_of_bytes = 0;
+	uint32_t checksum        = 0;
+	size_t buffer_offset     = 0;
+
+	start_time = clock();
+
+	do
+	{
+		for( buffer_offset = 0;
+		     ( buffer_offset + BENCH_HANDLE_METADATA_BLOCK_SIZE ) <= BENCH_HANDLE_BUFFER_SIZE;
+		     buffer_offset += BENCH_HANDLE_METADATA_BLOCK_SIZE )
+		{
+			if( libfvde_checksum_calculate_weak_crc32(
+			     &checksum,
+			     &( buffer[ buffer_offset ] ),
+			     BENCH_HANDLE_METADATA_BLOCK_SIZE,
+			     0xffffffffUL,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to calculate CRC-32 checksum.",
+				 function );
+
+				return( -1 );
+			}
+			number_of_bytes += BENCH_HANDLE_METADATA_BLOCK_SIZE;
+		}
+	}
+	while( bench_handle_has_finished(
+	        bench_handle,
+	        start_time,
+	        &elapsed_time ) == 0 );
+
+	bench_handle_result_fprint(
+	 bench_handle,
+	 "crc32c",
+	 libfvde_checksum_get_implementation_name(),
+	 "block_size",
+	 BENCH_HANDLE_METADATA_BLOCK_SIZE,
+	 number_of_bytes,
+	 1000000,
+	 elapsed_time,
+	 "MB/s" );
+
+	return( 1 );
+}
+
+#endif /* !defined( LIBFVDE_DLL_IMPORT ) */
+
+/* Runs the benchmarks that use the currently enabled backends
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_run_benchmarks(
+     bench_handle_t *bench_handle,
+     uint8_t *buffer,
+     uint8_t benchmarks,
+     libcerror_error_t **error )
+{
+	size_t data_unit_sizes[ 2 ] = { 512, 4096 };
+	size_t key_bit_sizes[ 2 ]   = { 128, 256 };
+
+	static char *function       = "bench_handle_run_benchmarks";
+	int data_unit_size_index    = 0;
+	int key_bit_size_index      = 0;
+
+	if( ( benchmarks & BENCH_HANDLE_BENCHMARK_AES ) != 0 )
+	{
+		for( key_bit_size_index = 0;
+		     key_bit_size_index < 2;
+		     key_bit_size_index++ )
+		{
+			for( data_unit_size_index = 0;
+			     data_unit_size_index < 2;
+			     data_unit_size_index++ )
+			{
+				if( bench_handle->abort != 0 )
+				{
+					break;
+				}
+				if( bench_handle_aes_xts_fprint(
+				     bench_handle,
+				     buffer,
+				     key_bit_sizes[ key_bit_size_index ],
+				     data_unit_sizes[ data_unit_size_index ],
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GENERIC,
+					 "%s: unable to run AES-XTS benchmark.",
+					 function );
+
+					return( -1 );
+				}
+			}
+		}
+	}
+	if( ( benchmarks & BENCH_HANDLE_BENCHMARK_SHA256 ) != 0 )
+	{
+		if( bench_handle->abort == 0 )
+		{
+			if( bench_handle_sha256_fprint(
+			     bench_handle,
+			     buffer,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to run SHA-256 benchmark.",
+				 function );
+
+				return( -1 );
+			}
+		}
+#if !defined( LIBFVDE_DLL_IMPORT )
+		if( bench_handle->abort == 0 )
+		{
+			if( bench_handle_pbkdf2_fprint(
+			     bench_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to run PBKDF2 benchmark.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		if( ( ( benchmarks & BENCH_HANDLE_BENCHMARK_PBKDF2_BATCH ) != 0 )
+		 && ( bench_handle->abort == 0 ) )
+		{
+			if( bench_handle_pbkdf2_batch_fprint(
+			     bench_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to run batched PBKDF2 benchmark.",
+				 function );
+
+				return( -1 );
+			}
+		}
+#endif /* !defined( LIBFVDE_DLL_IMPORT ) */
+	}
+#if !defined( LIBFVDE_DLL_IMPORT )
+	if( ( benchmarks & BENCH_HANDLE_BENCHMARK_CRC32 ) != 0 )
+	{
+		if( bench_handle->abort == 0 )
+		{
+			if( bench_handle_crc32_fprint(
+			     bench_handle,
+			     buffer,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to run CRC-32 benchmark.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+#endif /* !defined( LIBFVDE_DLL_IMPORT ) */
+
+	return( 1 );
+}
+
+/* Runs the benchmarks
+ * The benchmarks are run once per backend, first with the hardware accelerated
+ * backends enabled and then with the table or generic backends
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_run(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error )
+{
+	const char *aes_backend    = NULL;
+	const char *sha256_backend = NULL;
+	uint8_t *buffer            = NULL;
+	static char *function      = "bench_handle_run";
+	size_t buffer_index        = 0;
+	uint8_t benchmarks         = 0;
+
+#if !defined( LIBFVDE_DLL_IMPORT )
+	const char *crc32_backend  = NULL;
+#endif
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * BENCH_HANDLE_BUFFER_SIZE );
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		goto on_error;
+	}
+	for( buffer_index = 0;
+	     buffer_index < BENCH_HANDLE_BUFFER_SIZE;
+	     buffer_index++ )
+	{
+		buffer[ buffer_index ] = (uint8_t) ( buffer_index * 7 );
+	}
+	fprintf(
+	 bench_handle->notify_stream,
+	 "benchmark\tbackend\tparameter\tvalue\tunit\n" );
+
+	bench_handle_set_hardware_enabled(
+	 1 );
+
+	aes_backend    = bench_handle_get_aes_backend();
+	sha256_backend = bench_handle_get_sha256_backend();
+
+#if !defined( LIBFVDE_DLL_IMPORT )
+	crc32_backend = libfvde_checksum_get_implementation_name();
+#endif
+	if( bench_handle_run_benchmarks(
+	     bench_handle,
+	     buffer,
+	     BENCH_HANDLE_BENCHMARK_ALL,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to run benchmarks.",
+		 function );
+
+		goto on_error;
+	}
+	/* Only the benchmarks of which the backend changes when the hardware
+	 * accelerated backends are disabled are run again
+	 */
+	bench_handle_set_hardware_enabled(
+	 0 );
+
+	if( narrow_string_compare(
+	     aes_backend,
+	     bench_handle_get_aes_backend(),
+	     narrow_string_length( aes_backend ) + 1 ) != 0 )
+	{
+		benchmarks |= BENCH_HANDLE_BENCHMARK_AES;
+	}
+	if( narrow_string_compare(
+	     sha256_backend,
+	     bench_handle_get_sha256_backend(),
+	     narrow_string_length( sha256_backend ) + 1 ) != 0 )
+	{
+		benchmarks |= BENCH_HANDLE_BENCHMARK_SHA256;
+
+#if !defined( LIBFVDE_DLL_IMPORT )
+		/* The batched PBKDF2 only uses libhmac if there is no multi-buffer SHA-256
+		 */
+		if( libfvde_sha256_multi_buffer_get_number_of_lanes() == 0 )
+		{
+			benchmarks |= BENCH_HANDLE_BENCHMARK_PBKDF2_BATCH;
+		}
+#endif
+	}
+#if !defined( LIBFVDE_DLL_IMPORT )
+	if( narrow_string_compare(
+	     crc32_backend,
+	     libfvde_checksum_get_implementation_name(),
+	     narrow_string_length( crc32_backend ) + 1 ) != 0 )
+	{
+		benchmarks |= BENCH_HANDLE_BENCHMARK_CRC32;
+	}
+#endif
+	if( ( benchmarks != 0 )
+	 && ( bench_handle->abort == 0 ) )
+	{
+		if( bench_handle_run_benchmarks(
+		     bench_handle,
+		     buffer,
+		     benchmarks,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to run benchmarks without hardware acceleration.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	bench_handle_set_hardware_enabled(
+	 1 );
+
+	memory_free(
+	 buffer );
+
+	return( 1 );
+
+on_error:
+	bench_handle_set_hardware_enabled(
+	 1 );
+
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	return( -1 );
+}
+
@@ -0,0 +1,175 @@
+/*
+ * Bench handle
+ *
+ * Copyright (C) 2011-2018, Omar Choudary <choudary.omar@gmail.com>
+ *                          Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _BENCH_HANDLE_H )
+#define _BENCH_HANDLE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include <time.h>
+
+#include "fvdetools_libcerror.h"
+#include "fvdetools_libfvde.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct bench_handle bench_handle_t;
+
+struct bench_handle
+{
+	/* The libfvde input volume
+	 */
+	libfvde_volume_t *input_volume;
+
+	/* The number of PBKDF2 iterations
+	 */
+	uint32_t number_of_iterations;
+
+	/* The minimum duration of a benchmark in seconds
+	 */
+	uint32_t duration;
+
+	/* The notification output stream
+	 */
+	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+int fvdetools_system_string_copy_from_64_bit_in_decimal(
+     const system_character_t *string,
+     size_t string_size,
+     uint64_t *value_64bit,
+     libcerror_error_t **error );
+
+const char *bench_handle_get_aes_backend(
+             void );
+
+const char *bench_handle_get_sha256_backend(
+             void );
+
+void bench_handle_set_hardware_enabled(
+      int enabled );
+
+int bench_handle_initialize(
+     bench_handle_t **bench_handle,
+     libcerror_error_t **error );
+
+int bench_handle_free(
+     bench_handle_t **bench_handle,
+     libcerror_error_t **error );
+
+int bench_handle_signal_abort(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error );
+
+int bench_handle_set_number_of_iterations(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int bench_handle_set_duration(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int bench_handle_read_encrypted_root_plist(
+     bench_handle_t *bench_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int bench_handle_open_input(
+     bench_handle_t *bench_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int bench_handle_close_input(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error );
+
+void bench_handle_result_fprint(
+      bench_handle_t *bench_handle,
+      const char *benchmark,
+      const char *backend,
+      const char *parameter,
+      uint64_t parameter_value,
+      uint64_t number_of_units,
+      uint64_t units_per_value,
+      clock_t elapsed_time,
+      const char *unit );
+
+int bench_handle_has_finished(
+     bench_handle_t *bench_handle,
+     clock_t start_time,
+     clock_t *elapsed_time );
+
+int bench_handle_aes_xts_fprint(
+     bench_handle_t *bench_handle,
+     uint8_t *buffer,
+     size_t key_bit_size,
+     size_t data_unit_size,
+     libcerror_error_t **error );
+
+int bench_handle_sha256_fprint(
+     bench_handle_t *bench_handle,
+     uint8_t *buffer,
+     libcerror_error_t **error );
+
+#if !defined( LIBFVDE_DLL_IMPORT )
+
+int bench_handle_pbkdf2_fprint(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error );
+
+int bench_handle_pbkdf2_batch_fprint(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error );
+
+int bench_handle_crc32_fprint(
+     bench_handle_t *bench_handle,
+     uint8_t *buffer,
+     libcerror_error_t **error );
+
+#endif /* !defined( LIBFVDE_DLL_IMPORT ) */
+
+int bench_handle_run_benchmarks(
+     bench_handle_t *bench_handle,
+     uint8_t *buffer,
+     uint8_t benchmarks,
+     libcerror_error_t **error );
+
+int bench_handle_run(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _BENCH_HANDLE_H ) */
+
@@ -0,0 +1,386 @@
+/*
+ * Benchmarks the crypto backends used for FileVault Drive Encryption (FVDE)
+ *
+ * Copyright (C) 2011-2018, Omar Choudary <choudary.omar@gmail.com>
+ *                          Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "bench_handle.h"
+#include "fvdetools_getopt.h"
+#include "fvdetools_libcerror.h"
+#include "fvdetools_libclocale.h"
+#include "fvdetools_libcnotify.h"
+#include "fvdetools_libfvde.h"
+#include "fvdetools_output.h"
+#include "fvdetools_signal.h"
+#include "fvdetools_unused.h"
+
+bench_handle_t *fvdebench_bench_handle = NULL;
+int fvdebench_abort                    = 0;
+
+/* Prints the executable usage information
+ */
+void usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Use fvdebench to measure the throughput of the crypto backends\n"
+	                 " used for MacOS-X FileVault Drive Encrypted (FVDE) volumes\n\n" );
+
+	fprintf( stream, "Usage: fvdebench [ -e filename ] [ -i iterations ] [ -t seconds ]\n"
+	                 "                 [ -hvV ] [ source ]\n\n" );
+
+	fprintf( stream, "\tsource: the source file or device, if provided the number\n"
+	                 "\t        of PBKDF2 iterations of its first passphrase wrapped\n"
+	                 "\t        KEK is used\n\n" );
+
+	fprintf( stream, "\t-e:     specify the name of the EncryptedRoot.plist.wipekey file\n" );
+	fprintf( stream, "\t-h:     shows this help\n" );
+	fprintf( stream, "\t-i:     specify the number of PBKDF2 iterations, overrides the\n"
+	                 "\t        number of iterations of the source (default is 41000)\n" );
+	fprintf( stream, "\t-t:     specify the minimum duration of every benchmark in\n"
+	                 "\t        seconds (default is 1)\n" );
+	fprintf( stream, "\t-v:     verbose output to stderr\n" );
+	fprintf( stream, "\t-V:     print version\n" );
+	fprintf( stream, "\nThe results are written to stdout as tab separated values.\n"
+	                 "Benchmarks that have a hardware accelerated backend are\n"
+	                 "repeated with the table or generic backend.\n" );
+}
+
+/* Signal handler for fvdebench
+ */
+void fvdebench_signal_handler(
+      fvdetools_signal_t signal FVDETOOLS_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "fvdebench_signal_handler";
+
+	FVDETOOLS_UNREFERENCED_PARAMETER( signal )
+
+	fvdebench_abort = 1;
+
+	if( fvdebench_bench_handle != NULL )
+	{
+		if( bench_handle_signal_abort(
+		     fvdebench_bench_handle,
+		     &error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to signal bench handle to abort.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	/* Force stdin to close otherwise any function reading it will remain blocked
+	 */
+#if defined( WINAPI ) && !defined( __CYGWIN__ )
+	if( _close(
+	     0 ) != 0 )
+#else
+	if( close(
+	     0 ) != 0 )
+#endif
+	{
+		libcnotify_printf(
+		 "%s: unable to close stdin.\n",
+		 function );
+	}
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	libfvde_error_t *error                                   = NULL;
+	system_character_t *option_duration                      = NULL;
+	system_character_t *option_encrypted_root_plist_filename = NULL;
+	system_character_t *option_number_of_iterations          = NULL;
+	system_character_t *source                               = NULL;
+	system_integer_t option                                  = 0;
+	int verbose                                              = 0;
+
+	libcnotify_stream_set(
+	 stderr,
+	 NULL );
+	libcnotify_verbose_set(
+	 1 );
+
+	if( libclocale_initialize(
+             "fvdetools",
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize locale values.\n" );
+
+		goto on_error;
+	}
+        if( fvdetools_output_initialize(
+             _IONBF,
+             &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize output settings.\n" );
+
+		goto on_error;
+	}
+	/* The version is not printed so that stdout only contains the results
+	 */
+	while( ( option = fvdetools_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "e:hi:t:vV" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM "\n",
+				 argv[ optind - 1 ] );
+
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'e':
+				option_encrypted_root_plist_filename = optarg;
+
+				break;
+
+			case (system_integer_t) 'h':
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'i':
+				option_number_of_iterations = optarg;
+
+				break;
+
+			case (system_integer_t) 't':
+				option_duration = optarg;
+
+				break;
+
+			case (system_integer_t) 'v':
+				verbose = 1;
+
+				break;
+
+			case (system_integer_t) 'V':
+				fvdeoutput_version_fprint(
+				 stdout,
+				 "fvdebench" );
+
+				fvdeoutput_copyright_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+		}
+	}
+	if( optind < argc )
+	{
+		source = argv[ optind ];
+	}
+	libcnotify_verbose_set(
+	 verbose );
+	libfvde_notify_set_stream(
+	 stderr,
+	 NULL );
+	libfvde_notify_set_verbose(
+	 verbose );
+
+	if( bench_handle_initialize(
+	     &fvdebench_bench_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize bench handle.\n" );
+
+		goto on_error;
+	}
+	if( option_duration != NULL )
+	{
+		if( bench_handle_set_duration(
+		     fvdebench_bench_handle,
+		     option_duration,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set duration.\n" );
+
+			goto on_error;
+		}
+	}
+	if( source != NULL )
+	{
+		if( option_encrypted_root_plist_filename != NULL )
+		{
+			if( bench_handle_read_encrypted_root_plist(
+			     fvdebench_bench_handle,
+			     option_encrypted_root_plist_filename,
+			     &error ) != 1 )
+			{
+				fprintf(
+				 stderr,
+				 "Unable to read encrypted root plist file.\n" );
+
+				goto on_error;
+			}
+		}
+		if( bench_handle_open_input(
+		     fvdebench_bench_handle,
+		     source,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to open: %" PRIs_SYSTEM ".\n",
+			 source );
+
+			goto on_error;
+		}
+		if( bench_handle_close_input(
+		     fvdebench_bench_handle,
+		     &error ) != 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to close bench handle.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_number_of_iterations != NULL )
+	{
+		if( bench_handle_set_number_of_iterations(
+		     fvdebench_bench_handle,
+		     option_number_of_iterations,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set number of iterations.\n" );
+
+			goto on_error;
+		}
+	}
+	if( fvdetools_signal_attach(
+	     fvdebench_signal_handler,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to attach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( bench_handle_run(
+	     fvdebench_bench_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to run benchmarks.\n" );
+
+		goto on_error;
+	}
+	if( fvdetools_signal_detach(
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to detach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( fvdebench_abort != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Aborted.\n" );
+
+		goto on_error;
+	}
+	if( bench_handle_free(
+	     &fvdebench_bench_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free bench handle.\n" );
+
+		goto on_error;
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( fvdebench_bench_handle != NULL )
+	{
+		bench_handle_free(
+		 &fvdebench_bench_handle,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
+
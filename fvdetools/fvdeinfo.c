@@ -60,13 +60,15 @@ void usage_fprint(
 	                 " Drive Encrypted (FVDE) volume\n\n" );
 
 	fprintf( stream, "Usage: fvdeinfo [ -e filename ] [ -k keys ] [ -o offset ]\n"
-	                 "                [ -p password ] [ -r password ] [ -hvV ]\n"
+	                 "                [ -p password ] [ -r password ] [ -hjvV ]\n"
 	                 "                source\n\n" );
 
 	fprintf( stream, "\tsource: the source file or device\n\n" );
 
 	fprintf( stream, "\t-e:     specify the name of the EncryptedRoot.plist.wipekey file\n" );
 	fprintf( stream, "\t-h:     shows this help\n" );
+	fprintf( stream, "\t-j:     only print the passphrase wrapped KEKs in the John the\n"
+	                 "\t        Ripper $fvde$ format, no password is needed\n" );
 	fprintf( stream, "\t-k:     the volume master key formatted in base16\n" );
 	fprintf( stream, "\t-o:     specify the volume offset\n" );
 	fprintf( stream, "\t-p:     specify the password\n" );
@@ -136,6 +138,7 @@ int main( int argc, char * const argv[] )
 	system_character_t *source                               = NULL;
 	char *program                                            = "fvdeinfo";
 	system_integer_t option                                  = 0;
+	int option_passphrase_wrapped_keks                       = 0;
 	int result                                               = 0;
 	int verbose                                              = 0;
 
@@ -172,7 +175,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = fvdetools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "e:hk:o:p:r:vV" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "e:hjk:o:p:r:vV" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -199,6 +202,11 @@ int main( int argc, char * const argv[] )
 
 				return( EXIT_SUCCESS );
 
+			case (system_integer_t) 'j':
+				option_passphrase_wrapped_keks = 1;
+
+				break;
+
 			case (system_integer_t) 'k':
 				option_keys = optarg;
 
@@ -332,6 +340,22 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
+	/* Printing the passphrase wrapped KEKs only requires the encryption context
+	 */
+	if( option_passphrase_wrapped_keks != 0 )
+	{
+		if( info_handle_set_parse_profile(
+		     fvdeinfo_info_handle,
+		     LIBFVDE_PARSE_PROFILE_KEYS_ONLY,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set parse profile.\n" );
+
+			goto on_error;
+		}
+	}
 	result = info_handle_open_input(
 	          fvdeinfo_info_handle,
 	          source,
@@ -346,6 +370,19 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	if( option_passphrase_wrapped_keks != 0 )
+	{
+		if( info_handle_passphrase_wrapped_keks_fprint(
+		     fvdeinfo_info_handle,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to print passphrase wrapped KEKs.\n" );
+
+			goto on_error;
+		}
+	}
 	else if( result == 0 )
 	{
 		fprintf(
@@ -354,9 +391,9 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
-	if( info_handle_volume_fprint(
-	     fvdeinfo_info_handle,
-	     &error ) != 1 )
+	else if( info_handle_volume_fprint(
+	          fvdeinfo_info_handle,
+	          &error ) != 1 )
 	{
 		fprintf(
 		 stderr,
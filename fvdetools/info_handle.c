@@ -686,6 +686,44 @@ int info_handle_set_volume_offset(
 	return( 1 );
 }
 
+/* Sets the metadata parse profile
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_set_parse_profile(
+     info_handle_t *info_handle,
+     uint8_t parse_profile,
+     libcerror_error_t **error )
+{
+	static char *function = "info_handle_set_parse_profile";
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfvde_volume_set_parse_profile(
+	     info_handle->input_volume,
+	     parse_profile,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set parse profile.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
 /* Opens the info handle
  * Returns 1 if successful, 0 if the keys could not be read or -1 on error
  */
@@ -1019,3 +1057,104 @@ on_error:
 	return( -1 );
 }
 
+
+/* Prints the passphrase wrapped KEKs in the John the Ripper $fvde$ format
+ * No key is derived hence no password is needed
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_passphrase_wrapped_keks_fprint(
+     info_handle_t *info_handle,
+     libcerror_error_t **error )
+{
+	uint8_t salt[ 16 ];
+	uint8_t wrapped_kek[ 24 ];
+
+	static char *function                 = "info_handle_passphrase_wrapped_keks_fprint";
+	size_t data_index                     = 0;
+	uint32_t number_of_iterations         = 0;
+	int number_of_passphrase_wrapped_keks = 0;
+	int passphrase_wrapped_kek_index      = 0;
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfvde_volume_get_number_of_passphrase_wrapped_keks(
+	     info_handle->input_volume,
+	     &number_of_passphrase_wrapped_keks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of passphrase wrapped KEKs.",
+		 function );
+
+		return( -1 );
+	}
+	for( passphrase_wrapped_kek_index = 0;
+	     passphrase_wrapped_kek_index < number_of_passphrase_wrapped_keks;
+	     passphrase_wrapped_kek_index++ )
+	{
+		if( libfvde_volume_get_passphrase_wrapped_kek_by_index(
+		     info_handle->input_volume,
+		     passphrase_wrapped_kek_index,
+		     salt,
+		     16,
+		     &number_of_iterations,
+		     wrapped_kek,
+		     24,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve passphrase wrapped KEK: %d.",
+			 function,
+			 passphrase_wrapped_kek_index );
+
+			return( -1 );
+		}
+		fprintf(
+		 info_handle->notify_stream,
+		 "$fvde$1$16$" );
+
+		for( data_index = 0;
+		     data_index < 16;
+		     data_index++ )
+		{
+			fprintf(
+			 info_handle->notify_stream,
+			 "%02" PRIx8 "",
+			 salt[ data_index ] );
+		}
+		fprintf(
+		 info_handle->notify_stream,
+		 "$%" PRIu32 "$",
+		 number_of_iterations );
+
+		for( data_index = 0;
+		     data_index < 24;
+		     data_index++ )
+		{
+			fprintf(
+			 info_handle->notify_stream,
+			 "%02" PRIx8 "",
+			 wrapped_kek[ data_index ] );
+		}
+		fprintf(
+		 info_handle->notify_stream,
+		 "\n" );
+	}
+	return( 1 );
+}
+
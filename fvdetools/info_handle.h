@@ -103,6 +103,11 @@ int info_handle_set_volume_offset(
      const system_character_t *string,
      libcerror_error_t **error );
 
+int info_handle_set_parse_profile(
+     info_handle_t *info_handle,
+     uint8_t parse_profile,
+     libcerror_error_t **error );
+
 int info_handle_open_input(
      info_handle_t *info_handle,
      const system_character_t *filename,
@@ -116,6 +121,10 @@ int info_handle_volume_fprint(
      info_handle_t *info_handle,
      libcerror_error_t **error );
 
+int info_handle_passphrase_wrapped_keks_fprint(
+     info_handle_t *info_handle,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
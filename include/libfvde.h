@@ -290,6 +290,34 @@ ssize_t libfvde_volume_read_buffer_at_offset(
          off64_t offset,
          libfvde_error_t **error );
 
+/* Reads (media) data at a specific offset without using the current offset
+ * This function does not change the current offset, when multi-threading support
+ * is enabled multiple threads can read from the volume concurrently
+ * Returns the number of bytes read or -1 on error
+ */
+LIBFVDE_EXTERN \
+ssize_t libfvde_volume_read_buffer_at_offset_positional(
+         libfvde_volume_t *volume,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libfvde_error_t **error );
+
+/* Reads (media) data at specific offsets into buffers
+ * The requests are coalesced and read in the order of their location in the volume
+ * The number of bytes read into each buffer is returned in read counts
+ * Returns 1 if successful or -1 on error
+ */
+LIBFVDE_EXTERN \
+int libfvde_volume_read_buffers_at_offsets(
+     libfvde_volume_t *volume,
+     void **buffers,
+     const size_t *buffer_sizes,
+     const off64_t *offsets,
+     ssize_t *read_counts,
+     int number_of_buffers,
+     libfvde_error_t **error );
+
 #ifdef TODO_WRITE_SUPPORT
 
 /* Writes (media) data at the current offset
@@ -343,6 +371,18 @@ int libfvde_volume_get_logical_volume_size(
      size64_t *size,
      libfvde_error_t **error );
 
+/* Retrieves the next range of the logical volume that is mapped onto the physical volume
+ * The range starts at or after the offset, data outside the mapped ranges is read as 0-byte values
+ * Returns 1 if successful, 0 if no mapped data at or after the offset or -1 on error
+ */
+LIBFVDE_EXTERN \
+int libfvde_volume_get_next_mapped_range(
+     libfvde_volume_t *volume,
+     off64_t offset,
+     off64_t *range_offset,
+     size64_t *range_size,
+     libfvde_error_t **error );
+
 /* Retrieves the encryption method of the logical volume
  * Returns 1 if successful or -1 on error
  */
@@ -370,6 +410,49 @@ int libfvde_volume_get_physical_volume_encryption_method(
      uint32_t *encryption_method,
      libfvde_error_t **error );
 
+/* Retrieves the number of passphrase wrapped KEKs
+ * The volume needs to be opened but does not need to be unlocked
+ * Returns 1 if successful or -1 on error
+ */
+LIBFVDE_EXTERN \
+int libfvde_volume_get_number_of_passphrase_wrapped_keks(
+     libfvde_volume_t *volume,
+     int *number_of_passphrase_wrapped_keks,
+     libfvde_error_t **error );
+
+/* Retrieves a specific passphrase wrapped KEK
+ * This provides the values needed to verify a password without deriving any key
+ * The salt is 16 bytes and the wrapped KEK 24 bytes in size
+ * The volume needs to be opened but does not need to be unlocked
+ * Returns 1 if successful or -1 on error
+ */
+LIBFVDE_EXTERN \
+int libfvde_volume_get_passphrase_wrapped_kek_by_index(
+     libfvde_volume_t *volume,
+     int passphrase_wrapped_kek_index,
+     uint8_t *salt,
+     size_t salt_size,
+     uint32_t *number_of_iterations,
+     uint8_t *wrapped_kek,
+     size_t wrapped_kek_size,
+     libfvde_error_t **error );
+
+/* Determines which of multiple UTF-8 encoded passwords unwraps a specific passphrase wrapped KEK
+ * The password keys are derived in a batch, using the multi-buffer PBKDF2 if supported by the CPU
+ * The string lengths should not include the end-of-string character
+ * The volume needs to be opened but does not need to be unlocked
+ * Returns 1 if one of the passwords unwraps the KEK, 0 if none or -1 on error
+ */
+LIBFVDE_EXTERN \
+int libfvde_volume_check_utf8_passwords(
+     libfvde_volume_t *volume,
+     int passphrase_wrapped_kek_index,
+     const uint8_t **utf8_strings,
+     const size_t *utf8_string_lengths,
+     int number_of_passwords,
+     int *password_index,
+     libfvde_error_t **error );
+
 /* Sets the keys
  * This function needs to be used before one of the open functions
  * Returns 1 if successful or -1 on error
@@ -425,6 +508,81 @@ int libfvde_volume_set_utf16_recovery_password(
      size_t utf16_string_length,
      libfvde_error_t **error );
 
+/* Sets the size of the data read and decrypted at once
+ * The size must be a multiple of 512, 0 represents the block size of the volume
+ * This function needs to be used before one of the open functions
+ * Returns 1 if successful or -1 on error
+ */
+LIBFVDE_EXTERN \
+int libfvde_volume_set_sector_data_size(
+     libfvde_volume_t *volume,
+     size_t sector_data_size,
+     libfvde_error_t **error );
+
+/* Sets the size of the sectors cache in bytes
+ * 0 represents the default number of cache entries
+ * This function needs to be used before one of the open functions
+ * Returns 1 if successful or -1 on error
+ */
+LIBFVDE_EXTERN \
+int libfvde_volume_set_cache_size(
+     libfvde_volume_t *volume,
+     size_t cache_size,
+     libfvde_error_t **error );
+
+/* Sets the maximum size of the data read ahead at once in bytes
+ * The size must be a multiple of 512, 0 disables read-ahead
+ * Sequential reads are read ahead and decrypted on a separate thread
+ * Read-ahead is only used if the library was built with multi-threading support
+ * and the file IO handle can be cloned
+ * This function needs to be used before one of the open functions
+ * Returns 1 if successful or -1 on error
+ */
+LIBFVDE_EXTERN \
+int libfvde_volume_set_read_ahead_size(
+     libfvde_volume_t *volume,
+     size_t read_ahead_size,
+     libfvde_error_t **error );
+
+/* Sets the number of threads used to decrypt large reads
+ * 0 disables decrypting large reads using multiple threads
+ * Sector aligned reads of 256 KiB or more are divided over the threads
+ * Multiple threads are only used if the library was built with multi-threading support
+ * This function needs to be used before one of the open functions
+ * Returns 1 if successful or -1 on error
+ */
+LIBFVDE_EXTERN \
+int libfvde_volume_set_number_of_decryption_threads(
+     libfvde_volume_t *volume,
+     int number_of_threads,
+     libfvde_error_t **error );
+
+/* Sets if the volume is opened lazily
+ * When opened lazily only the newest valid copy of the metadata is parsed
+ * and the secondary encrypted metadata is only read when the primary cannot be used
+ * This function needs to be used before one of the open functions
+ * Returns 1 if successful or -1 on error
+ */
+LIBFVDE_EXTERN \
+int libfvde_volume_set_lazy_open(
+     libfvde_volume_t *volume,
+     uint8_t lazy_open,
+     libfvde_error_t **error );
+
+/* Sets the metadata parse profile
+ * The parse profile contains the LIBFVDE_PARSE_PROFILE_FLAGS of the encrypted metadata
+ * that is read, the default is LIBFVDE_PARSE_PROFILE_FULL
+ * If the layout is not read the volume data cannot be read and the keys are not unlocked,
+ * LIBFVDE_PARSE_PROFILE_KEYS_ONLY is intended to retrieve the passphrase wrapped KEKs
+ * This function needs to be used before one of the open functions
+ * Returns 1 if successful or -1 on error
+ */
+LIBFVDE_EXTERN \
+int libfvde_volume_set_parse_profile(
+     libfvde_volume_t *volume,
+     uint8_t parse_profile,
+     libfvde_error_t **error );
+
 /* Reads the EncryptedRoot.plist file
  * This function needs to be used before one of the open functions
  * Returns 1 if successful or -1 on error
@@ -463,6 +621,86 @@ int libfvde_volume_read_encrypted_root_plist_file_io_handle(
 
 #endif /* defined( LIBFVDE_HAVE_BFIO ) */
 
+/* Exports the layout of the volume to a (sidecar) layout file
+ * The layout file contains the values needed to map the logical volume
+ * without having to parse the metadata, it does not contain key material
+ * This function needs to be used after one of the open functions
+ * Returns 1 if successful or -1 on error
+ */
+LIBFVDE_EXTERN \
+int libfvde_volume_export_layout(
+     libfvde_volume_t *volume,
+     const char *filename,
+     libfvde_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Exports the layout of the volume to a (sidecar) layout file
+ * This function needs to be used after one of the open functions
+ * Returns 1 if successful or -1 on error
+ */
+LIBFVDE_EXTERN \
+int libfvde_volume_export_layout_wide(
+     libfvde_volume_t *volume,
+     const wchar_t *filename,
+     libfvde_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+#if defined( LIBFVDE_HAVE_BFIO )
+
+/* Exports the layout of the volume to a (sidecar) layout file using a Basic File IO (bfio) handle
+ * This function needs to be used after one of the open functions
+ * Returns 1 if successful or -1 on error
+ */
+LIBFVDE_EXTERN \
+int libfvde_volume_export_layout_file_io_handle(
+     libfvde_volume_t *volume,
+     libbfio_handle_t *file_io_handle,
+     libfvde_error_t **error );
+
+#endif /* defined( LIBFVDE_HAVE_BFIO ) */
+
+/* Imports the layout of the volume from a (sidecar) layout file
+ * If the layout is still valid for the volume the open functions
+ * do not parse the metadata, otherwise the layout is ignored
+ * This function needs to be used before one of the open functions
+ * Returns 1 if successful or -1 on error
+ */
+LIBFVDE_EXTERN \
+int libfvde_volume_import_layout(
+     libfvde_volume_t *volume,
+     const char *filename,
+     libfvde_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Imports the layout of the volume from a (sidecar) layout file
+ * This function needs to be used before one of the open functions
+ * Returns 1 if successful or -1 on error
+ */
+LIBFVDE_EXTERN \
+int libfvde_volume_import_layout_wide(
+     libfvde_volume_t *volume,
+     const wchar_t *filename,
+     libfvde_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+#if defined( LIBFVDE_HAVE_BFIO )
+
+/* Imports the layout of the volume from a (sidecar) layout file using a Basic File IO (bfio) handle
+ * This function needs to be used before one of the open functions
+ * Returns 1 if successful or -1 on error
+ */
+LIBFVDE_EXTERN \
+int libfvde_volume_import_layout_file_io_handle(
+     libfvde_volume_t *volume,
+     libbfio_handle_t *file_io_handle,
+     libfvde_error_t **error );
+
+#endif /* defined( LIBFVDE_HAVE_BFIO ) */
+
 /* -------------------------------------------------------------------------
  * Volume functions - deprecated
  * ------------------------------------------------------------------------- */
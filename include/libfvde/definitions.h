@@ -58,5 +58,24 @@ enum LIBFVDE_ENCRYPTION_METHODS
 	LIBFVDE_ENCRYPTION_METHOD_AES_XTS	= 2
 };
 
+/* The metadata parse profile flags
+ * bit 1        set to 1 to read the encrypted metadata blocks that contain the keys
+ * bit 2        set to 1 to read the encrypted metadata blocks that contain the layout
+ * bit 3        set to 1 to read the other encrypted metadata blocks
+ * bit 4-8      not used
+ */
+enum LIBFVDE_PARSE_PROFILE_FLAGS
+{
+	LIBFVDE_PARSE_PROFILE_FLAG_KEYS		= 0x01,
+	LIBFVDE_PARSE_PROFILE_FLAG_LAYOUT	= 0x02,
+	LIBFVDE_PARSE_PROFILE_FLAG_OTHER	= 0x04
+};
+
+/* The metadata parse profiles
+ */
+#define LIBFVDE_PARSE_PROFILE_KEYS_ONLY		( LIBFVDE_PARSE_PROFILE_FLAG_KEYS )
+#define LIBFVDE_PARSE_PROFILE_LAYOUT_ONLY	( LIBFVDE_PARSE_PROFILE_FLAG_LAYOUT )
+#define LIBFVDE_PARSE_PROFILE_FULL		( LIBFVDE_PARSE_PROFILE_FLAG_KEYS | LIBFVDE_PARSE_PROFILE_FLAG_LAYOUT | LIBFVDE_PARSE_PROFILE_FLAG_OTHER )
+
 #endif /* !defined( _LIBFVDE_DEFINITIONS_H ) */
 
@@ -38,6 +38,7 @@
 
 #include "libcaes_context.h"
 #include "libcaes_definitions.h"
+#include "libcaes_hardware.h"
 #include "libcaes_key.h"
 #include "libcaes_libcerror.h"
 #include "libcaes_types.h"
@@ -1246,9 +1247,7 @@ int libcaes_crypt_cbc(
 	uint8_t internal_initialization_vector[ 16 ];
 #endif
 
-#if defined( LIBCAES_HAVE_AES_SUPPORT )
 	libcaes_internal_context_t *internal_context = NULL;
-#endif
 	static char *function                        = "libcaes_crypt_cbc";
 
 #if defined( WINAPI ) && ( WINVER >= 0x0600 )
@@ -1290,9 +1289,7 @@ int libcaes_crypt_cbc(
 
 		return( -1 );
 	}
-#if defined( LIBCAES_HAVE_AES_SUPPORT )
 	internal_context = (libcaes_internal_context_t *) context;
-#endif
 
 	if( ( mode != LIBCAES_CRYPT_MODE_DECRYPT )
 	 && ( mode != LIBCAES_CRYPT_MODE_ENCRYPT ) )
@@ -1736,7 +1733,20 @@ int libcaes_crypt_cbc(
 
 		goto on_error;
 	}
-	if( mode == LIBCAES_CRYPT_MODE_ENCRYPT )
+	if( libcaes_hardware_is_supported() != 0 )
+	{
+		libcaes_hardware_crypt_cbc(
+		 internal_context->round_keys,
+		 internal_context->number_of_round_keys,
+		 mode,
+		 internal_initialization_vector,
+		 input_data,
+		 output_data,
+		 input_data_size / 16 );
+
+		data_offset = input_data_size;
+	}
+	else if( mode == LIBCAES_CRYPT_MODE_ENCRYPT )
 	{
 		if( memory_copy(
 		     output_data,
@@ -2789,6 +2799,18 @@ int libcaes_crypt_ecb(
 	 &safe_output_data_size );
 
 #else
+	if( libcaes_hardware_is_supported() != 0 )
+	{
+		libcaes_hardware_crypt_ecb(
+		 internal_context->round_keys,
+		 internal_context->number_of_round_keys,
+		 mode,
+		 input_data,
+		 output_data,
+		 input_data_size / 16 );
+
+		data_offset = input_data_size & ~( (size_t) 0x0f );
+	}
 	while( data_offset < input_data_size )
 	{
 		byte_stream_copy_to_uint32_little_endian(
@@ -0,0 +1,1526 @@
+/*
+ * AES hardware acceleration functions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libcaes_definitions.h"
+#include "libcaes_hardware.h"
+
+#if !defined( LIBCAES_HAVE_AES_SUPPORT )
+
+/* The hardware functions use the round keys as calculated by
+ * libcaes_internal_context_set_encryption_key and libcaes_internal_context_set_decryption_key
+ * On a little-endian CPU the 32-bit round key values are stored in the same byte order
+ * as the AES instructions expect and the decryption round keys are those of the equivalent
+ * inverse cipher
+ */
+#if defined( __GNUC__ ) && ( defined( __x86_64__ ) || defined( __i386__ ) ) && ( ( __GNUC__ >= 5 ) || defined( __clang__ ) )
+#include <cpuid.h>
+#include <wmmintrin.h>
+#include <emmintrin.h>
+
+#define LIBCAES_HAVE_X86_AES_INSTRUCTIONS	1
+#define LIBCAES_X86_AES_TARGET			__attribute__((target("aes,sse2")))
+
+#if ( defined( __clang__ ) && ( __clang_major__ >= 6 ) ) || ( !defined( __clang__ ) && ( __GNUC__ >= 8 ) )
+#include <immintrin.h>
+
+#define LIBCAES_HAVE_X86_VAES_INSTRUCTIONS	1
+#define LIBCAES_X86_VAES_TARGET			__attribute__((target("aes,avx512f,vaes")))
+#endif
+
+#elif defined( _MSC_VER ) && ( _MSC_VER >= 1900 ) && ( defined( _M_X64 ) || defined( _M_IX86 ) )
+#include <intrin.h>
+#include <wmmintrin.h>
+#include <emmintrin.h>
+
+#define LIBCAES_HAVE_X86_AES_INSTRUCTIONS	1
+#define LIBCAES_X86_AES_TARGET
+
+#if ( _MSC_VER >= 1920 ) && defined( _M_X64 )
+#include <immintrin.h>
+
+#define LIBCAES_HAVE_X86_VAES_INSTRUCTIONS	1
+#define LIBCAES_X86_VAES_TARGET
+#endif
+
+#elif defined( __aarch64__ ) && ( defined( __ARM_FEATURE_AES ) || defined( __ARM_FEATURE_CRYPTO ) ) && !defined( __ARM_BIG_ENDIAN )
+#include <arm_neon.h>
+
+#define LIBCAES_HAVE_ARM_AES_INSTRUCTIONS	1
+
+#endif
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
+#include <pthread.h>
+#endif
+
+/* The state of libcaes_hardware_initialize
+ */
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && defined( WINAPI )
+static LONG volatile libcaes_hardware_initialize_state = 0;
+
+#elif defined( HAVE_MULTI_THREAD_SUPPORT ) && defined( HAVE_PTHREAD_H )
+static pthread_once_t libcaes_hardware_initialize_once = PTHREAD_ONCE_INIT;
+
+#else
+static int libcaes_hardware_is_initialized = 0;
+
+#endif
+
+/* Value to indicate the CPU supports the AES instructions
+ */
+static int libcaes_hardware_support = 0;
+
+/* Value to indicate the CPU and operating system support the 512-bit vector AES instructions
+ */
+static int libcaes_hardware_vaes_support = 0;
+
+/* Value to indicate the AES instructions are disabled and the table based implementation is used
+ */
+static int libcaes_hardware_disabled = 0;
+
+#if defined( LIBCAES_HAVE_X86_VAES_INSTRUCTIONS )
+
+/* Retrieves the extended control register (XCR0) that contains the state components enabled by the operating system
+ */
+static uint64_t libcaes_hardware_get_extended_control_register(
+                 void )
+{
+#if defined( _MSC_VER )
+	return( (uint64_t) _xgetbv( 0 ) );
+#else
+	uint32_t eax = 0;
+	uint32_t edx = 0;
+
+	__asm__ __volatile__ (
+	 "xgetbv"
+	 : "=a" ( eax ), "=d" ( edx )
+	 : "c" ( 0 ) );
+
+	return( ( (uint64_t) edx << 32 ) | eax );
+#endif
+}
+
+#endif /* defined( LIBCAES_HAVE_X86_VAES_INSTRUCTIONS ) */
+
+/* Determines the AES instructions supported by the CPU and operating system
+ */
+static void libcaes_hardware_select(
+             void )
+{
+#if defined( LIBCAES_HAVE_X86_AES_INSTRUCTIONS )
+	int cpu_information[ 4 ];
+
+#if !defined( _MSC_VER )
+	unsigned int eax = 0;
+	unsigned int ebx = 0;
+	unsigned int ecx = 0;
+	unsigned int edx = 0;
+#endif
+#endif /* defined( LIBCAES_HAVE_X86_AES_INSTRUCTIONS ) */
+
+#if defined( LIBCAES_HAVE_X86_AES_INSTRUCTIONS )
+#if defined( _MSC_VER )
+	__cpuid(
+	 cpu_information,
+	 1 );
+#else
+	if( __get_cpuid(
+	     1,
+	     &eax,
+	     &ebx,
+	     &ecx,
+	     &edx ) == 0 )
+	{
+		ecx = 0;
+	}
+	cpu_information[ 2 ] = (int) ecx;
+#endif
+	/* AES (ECX bit 25)
+	 */
+	if( ( cpu_information[ 2 ] & 0x02000000UL ) != 0 )
+	{
+		libcaes_hardware_support = 1;
+	}
+#if defined( LIBCAES_HAVE_X86_VAES_INSTRUCTIONS )
+	/* OSXSAVE (ECX bit 27) is required to read XCR0
+	 */
+	if( ( libcaes_hardware_support != 0 )
+	 && ( ( cpu_information[ 2 ] & 0x08000000UL ) != 0 ) )
+	{
+#if defined( _MSC_VER )
+		__cpuidex(
+		 cpu_information,
+		 7,
+		 0 );
+#else
+		if( __get_cpuid_count(
+		     7,
+		     0,
+		     &eax,
+		     &ebx,
+		     &ecx,
+		     &edx ) == 0 )
+		{
+			ebx = 0;
+			ecx = 0;
+		}
+		cpu_information[ 1 ] = (int) ebx;
+		cpu_information[ 2 ] = (int) ecx;
+#endif
+		/* AVX512F (EBX bit 16) and VAES (ECX bit 9) with the SSE, AVX, opmask and ZMM states enabled
+		 */
+		if( ( ( cpu_information[ 1 ] & 0x00010000UL ) != 0 )
+		 && ( ( cpu_information[ 2 ] & 0x00000200UL ) != 0 )
+		 && ( ( libcaes_hardware_get_extended_control_register() & 0xe6 ) == 0xe6 ) )
+		{
+			libcaes_hardware_vaes_support = 1;
+		}
+	}
+#endif /* defined( LIBCAES_HAVE_X86_VAES_INSTRUCTIONS ) */
+#elif defined( LIBCAES_HAVE_ARM_AES_INSTRUCTIONS )
+	/* The compiler only defines the AES feature macros if the target CPU supports it
+	 */
+	libcaes_hardware_support = 1;
+#endif
+}
+
+/* Determines the hardware support once
+ */
+void libcaes_hardware_initialize(
+      void )
+{
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && defined( WINAPI )
+	/* State 0 represents not determined, 1 determining and 2 determined
+	 */
+	if( InterlockedCompareExchange(
+	     &libcaes_hardware_initialize_state,
+	     1,
+	     0 ) == 0 )
+	{
+		libcaes_hardware_select();
+
+		InterlockedExchange(
+		 &libcaes_hardware_initialize_state,
+		 2 );
+	}
+	while( InterlockedCompareExchange(
+	        &libcaes_hardware_initialize_state,
+	        2,
+	        2 ) != 2 )
+	{
+		Sleep(
+		 0 );
+	}
+#elif defined( HAVE_MULTI_THREAD_SUPPORT ) && defined( HAVE_PTHREAD_H )
+	pthread_once(
+	 &libcaes_hardware_initialize_once,
+	 &libcaes_hardware_select );
+#else
+	if( libcaes_hardware_is_initialized == 0 )
+	{
+		libcaes_hardware_select();
+
+		libcaes_hardware_is_initialized = 1;
+	}
+#endif
+}
+
+/* Determines if the CPU supports AES instructions
+ * Returns 1 if supported or 0 if not
+ */
+int libcaes_hardware_is_supported(
+     void )
+{
+	libcaes_hardware_initialize();
+
+	if( libcaes_hardware_disabled != 0 )
+	{
+		return( 0 );
+	}
+	return( libcaes_hardware_support );
+}
+
+/* Enables or disables the use of the AES instructions
+ * This function is intended for testing and should not be called while data is being de/encrypted
+ */
+void libcaes_hardware_set_enabled(
+      int enabled )
+{
+	if( enabled == 0 )
+	{
+		libcaes_hardware_disabled = 1;
+	}
+	else
+	{
+		libcaes_hardware_disabled = 0;
+	}
+}
+
+/* Retrieves the name of the AES implementation that is used
+ * Returns a string containing the name
+ */
+const char *libcaes_hardware_get_implementation_name(
+             void )
+{
+	if( libcaes_hardware_is_supported() == 0 )
+	{
+		return( "table" );
+	}
+#if defined( LIBCAES_HAVE_X86_AES_INSTRUCTIONS )
+	/* XTS uses the 512-bit vector AES instructions for runs of 16 or more blocks
+	 */
+	if( libcaes_hardware_vaes_support != 0 )
+	{
+		return( "aes-ni+vaes-avx512" );
+	}
+	return( "aes-ni" );
+
+#elif defined( LIBCAES_HAVE_ARM_AES_INSTRUCTIONS )
+	return( "armv8-aes" );
+
+#else
+	return( "table" );
+#endif
+}
+
+#if defined( LIBCAES_HAVE_X86_AES_INSTRUCTIONS )
+
+/* Encrypts a block using the x86 AES instructions
+ */
+#define libcaes_hardware_x86_encrypt_block( round_keys, number_of_rounds, block, round_index ) \
+	block = _mm_xor_si128( block, round_keys[ 0 ] ); \
+	for( round_index = 1; round_index < number_of_rounds; round_index++ ) \
+	{ \
+		block = _mm_aesenc_si128( block, round_keys[ round_index ] ); \
+	} \
+	block = _mm_aesenclast_si128( block, round_keys[ number_of_rounds ] );
+
+/* Decrypts a block using the x86 AES instructions
+ */
+#define libcaes_hardware_x86_decrypt_block( round_keys, number_of_rounds, block, round_index ) \
+	block = _mm_xor_si128( block, round_keys[ 0 ] ); \
+	for( round_index = 1; round_index < number_of_rounds; round_index++ ) \
+	{ \
+		block = _mm_aesdec_si128( block, round_keys[ round_index ] ); \
+	} \
+	block = _mm_aesdeclast_si128( block, round_keys[ number_of_rounds ] );
+
+/* Decrypts 4 independent blocks using the x86 AES instructions
+ * The blocks are interleaved to hide the latency of the AES instructions
+ */
+#define libcaes_hardware_x86_decrypt_4_blocks( round_keys, number_of_rounds, block0, block1, block2, block3, round_index ) \
+	block0 = _mm_xor_si128( block0, round_keys[ 0 ] ); \
+	block1 = _mm_xor_si128( block1, round_keys[ 0 ] ); \
+	block2 = _mm_xor_si128( block2, round_keys[ 0 ] ); \
+	block3 = _mm_xor_si128( block3, round_keys[ 0 ] ); \
+	for( round_index = 1; round_index < number_of_rounds; round_index++ ) \
+	{ \
+		block0 = _mm_aesdec_si128( block0, round_keys[ round_index ] ); \
+		block1 = _mm_aesdec_si128( block1, round_keys[ round_index ] ); \
+		block2 = _mm_aesdec_si128( block2, round_keys[ round_index ] ); \
+		block3 = _mm_aesdec_si128( block3, round_keys[ round_index ] ); \
+	} \
+	block0 = _mm_aesdeclast_si128( block0, round_keys[ number_of_rounds ] ); \
+	block1 = _mm_aesdeclast_si128( block1, round_keys[ number_of_rounds ] ); \
+	block2 = _mm_aesdeclast_si128( block2, round_keys[ number_of_rounds ] ); \
+	block3 = _mm_aesdeclast_si128( block3, round_keys[ number_of_rounds ] );
+
+/* Encrypts 4 independent blocks using the x86 AES instructions
+ */
+#define libcaes_hardware_x86_encrypt_4_blocks( round_keys, number_of_rounds, block0, block1, block2, block3, round_index ) \
+	block0 = _mm_xor_si128( block0, round_keys[ 0 ] ); \
+	block1 = _mm_xor_si128( block1, round_keys[ 0 ] ); \
+	block2 = _mm_xor_si128( block2, round_keys[ 0 ] ); \
+	block3 = _mm_xor_si128( block3, round_keys[ 0 ] ); \
+	for( round_index = 1; round_index < number_of_rounds; round_index++ ) \
+	{ \
+		block0 = _mm_aesenc_si128( block0, round_keys[ round_index ] ); \
+		block1 = _mm_aesenc_si128( block1, round_keys[ round_index ] ); \
+		block2 = _mm_aesenc_si128( block2, round_keys[ round_index ] ); \
+		block3 = _mm_aesenc_si128( block3, round_keys[ round_index ] ); \
+	} \
+	block0 = _mm_aesenclast_si128( block0, round_keys[ number_of_rounds ] ); \
+	block1 = _mm_aesenclast_si128( block1, round_keys[ number_of_rounds ] ); \
+	block2 = _mm_aesenclast_si128( block2, round_keys[ number_of_rounds ] ); \
+	block3 = _mm_aesenclast_si128( block3, round_keys[ number_of_rounds ] );
+
+/* Applies the AES instruction to 8 independent blocks
+ */
+#define libcaes_hardware_x86_8_blocks( instruction, blocks, round_key ) \
+	blocks[ 0 ] = instruction( blocks[ 0 ], round_key ); \
+	blocks[ 1 ] = instruction( blocks[ 1 ], round_key ); \
+	blocks[ 2 ] = instruction( blocks[ 2 ], round_key ); \
+	blocks[ 3 ] = instruction( blocks[ 3 ], round_key ); \
+	blocks[ 4 ] = instruction( blocks[ 4 ], round_key ); \
+	blocks[ 5 ] = instruction( blocks[ 5 ], round_key ); \
+	blocks[ 6 ] = instruction( blocks[ 6 ], round_key ); \
+	blocks[ 7 ] = instruction( blocks[ 7 ], round_key );
+
+/* Multiplies a XTS tweak value by the primitive element alpha in GF(2^128)
+ */
+#define libcaes_hardware_x86_xts_multiply_tweak( tweak, carry_values ) \
+	carry_values = _mm_and_si128( _mm_srai_epi32( tweak, 31 ), _mm_set_epi32( 0x87, 1, 1, 1 ) ); \
+	tweak        = _mm_xor_si128( _mm_slli_epi32( tweak, 1 ), _mm_shuffle_epi32( carry_values, 0x93 ) );
+
+/* Loads the round keys into registers
+ */
+LIBCAES_X86_AES_TARGET \
+static void libcaes_hardware_x86_load_round_keys(
+             __m128i *round_key_values,
+             const uint32_t *round_keys,
+             uint8_t number_of_rounds )
+{
+	uint8_t round_index = 0;
+
+	for( round_index = 0;
+	     round_index <= number_of_rounds;
+	     round_index++ )
+	{
+		round_key_values[ round_index ] = _mm_loadu_si128(
+		                                   (const __m128i *) &( round_keys[ round_index * 4 ] ) );
+	}
+}
+
+/* De- or encrypts blocks using AES-ECB and the x86 AES instructions
+ */
+LIBCAES_X86_AES_TARGET \
+static void libcaes_hardware_x86_crypt_ecb(
+             const uint32_t *round_keys,
+             uint8_t number_of_rounds,
+             int mode,
+             const uint8_t *input_data,
+             uint8_t *output_data,
+             size_t number_of_blocks )
+{
+	__m128i round_key_values[ 15 ];
+
+	__m128i block0      = _mm_setzero_si128();
+	__m128i block1      = _mm_setzero_si128();
+	__m128i block2      = _mm_setzero_si128();
+	__m128i block3      = _mm_setzero_si128();
+	uint8_t round_index = 0;
+
+	libcaes_hardware_x86_load_round_keys(
+	 round_key_values,
+	 round_keys,
+	 number_of_rounds );
+
+	while( number_of_blocks >= 4 )
+	{
+		block0 = _mm_loadu_si128( (const __m128i *) &( input_data[ 0 ] ) );
+		block1 = _mm_loadu_si128( (const __m128i *) &( input_data[ 16 ] ) );
+		block2 = _mm_loadu_si128( (const __m128i *) &( input_data[ 32 ] ) );
+		block3 = _mm_loadu_si128( (const __m128i *) &( input_data[ 48 ] ) );
+
+		if( mode == LIBCAES_CRYPT_MODE_ENCRYPT )
+		{
+			libcaes_hardware_x86_encrypt_4_blocks(
+			 round_key_values,
+			 number_of_rounds,
+			 block0,
+			 block1,
+			 block2,
+			 block3,
+			 round_index )
+		}
+		else
+		{
+			libcaes_hardware_x86_decrypt_4_blocks(
+			 round_key_values,
+			 number_of_rounds,
+			 block0,
+			 block1,
+			 block2,
+			 block3,
+			 round_index )
+		}
+		_mm_storeu_si128( (__m128i *) &( output_data[ 0 ] ), block0 );
+		_mm_storeu_si128( (__m128i *) &( output_data[ 16 ] ), block1 );
+		_mm_storeu_si128( (__m128i *) &( output_data[ 32 ] ), block2 );
+		_mm_storeu_si128( (__m128i *) &( output_data[ 48 ] ), block3 );
+
+		input_data       += 64;
+		output_data      += 64;
+		number_of_blocks -= 4;
+	}
+	while( number_of_blocks > 0 )
+	{
+		block0 = _mm_loadu_si128( (const __m128i *) input_data );
+
+		if( mode == LIBCAES_CRYPT_MODE_ENCRYPT )
+		{
+			libcaes_hardware_x86_encrypt_block(
+			 round_key_values,
+			 number_of_rounds,
+			 block0,
+			 round_index )
+		}
+		else
+		{
+			libcaes_hardware_x86_decrypt_block(
+			 round_key_values,
+			 number_of_rounds,
+			 block0,
+			 round_index )
+		}
+		_mm_storeu_si128( (__m128i *) output_data, block0 );
+
+		input_data       += 16;
+		output_data      += 16;
+		number_of_blocks -= 1;
+	}
+}
+
+/* De- or encrypts blocks using AES-CBC and the x86 AES instructions
+ * The initialization vector is updated to the last cipher text block
+ */
+LIBCAES_X86_AES_TARGET \
+static void libcaes_hardware_x86_crypt_cbc(
+             const uint32_t *round_keys,
+             uint8_t number_of_rounds,
+             int mode,
+             uint8_t *initialization_vector,
+             const uint8_t *input_data,
+             uint8_t *output_data,
+             size_t number_of_blocks )
+{
+	__m128i round_key_values[ 15 ];
+
+	__m128i block0              = _mm_setzero_si128();
+	__m128i block1              = _mm_setzero_si128();
+	__m128i block2              = _mm_setzero_si128();
+	__m128i block3              = _mm_setzero_si128();
+	__m128i cipher_block0       = _mm_setzero_si128();
+	__m128i cipher_block1       = _mm_setzero_si128();
+	__m128i cipher_block2       = _mm_setzero_si128();
+	__m128i cipher_block3       = _mm_setzero_si128();
+	__m128i vector_value        = _mm_setzero_si128();
+	uint8_t round_index         = 0;
+
+	libcaes_hardware_x86_load_round_keys(
+	 round_key_values,
+	 round_keys,
+	 number_of_rounds );
+
+	vector_value = _mm_loadu_si128(
+	                (const __m128i *) initialization_vector );
+
+	if( mode == LIBCAES_CRYPT_MODE_ENCRYPT )
+	{
+		/* CBC encryption depends on the previous cipher text block
+		 */
+		while( number_of_blocks > 0 )
+		{
+			block0 = _mm_xor_si128(
+			          _mm_loadu_si128( (const __m128i *) input_data ),
+			          vector_value );
+
+			libcaes_hardware_x86_encrypt_block(
+			 round_key_values,
+			 number_of_rounds,
+			 block0,
+			 round_index )
+
+			_mm_storeu_si128( (__m128i *) output_data, block0 );
+
+			vector_value = block0;
+
+			input_data       += 16;
+			output_data      += 16;
+			number_of_blocks -= 1;
+		}
+	}
+	else
+	{
+		while( number_of_blocks >= 4 )
+		{
+			cipher_block0 = _mm_loadu_si128( (const __m128i *) &( input_data[ 0 ] ) );
+			cipher_block1 = _mm_loadu_si128( (const __m128i *) &( input_data[ 16 ] ) );
+			cipher_block2 = _mm_loadu_si128( (const __m128i *) &( input_data[ 32 ] ) );
+			cipher_block3 = _mm_loadu_si128( (const __m128i *) &( input_data[ 48 ] ) );
+
+			block0 = cipher_block0;
+			block1 = cipher_block1;
+			block2 = cipher_block2;
+			block3 = cipher_block3;
+
+			libcaes_hardware_x86_decrypt_4_blocks(
+			 round_key_values,
+			 number_of_rounds,
+			 block0,
+			 block1,
+			 block2,
+			 block3,
+			 round_index )
+
+			/* The input and output data can overlap, the cipher text blocks
+			 * were read before the output data is written
+			 */
+			_mm_storeu_si128( (__m128i *) &( output_data[ 0 ] ), _mm_xor_si128( block0, vector_value ) );
+			_mm_storeu_si128( (__m128i *) &( output_data[ 16 ] ), _mm_xor_si128( block1, cipher_block0 ) );
+			_mm_storeu_si128( (__m128i *) &( output_data[ 32 ] ), _mm_xor_si128( block2, cipher_block1 ) );
+			_mm_storeu_si128( (__m128i *) &( output_data[ 48 ] ), _mm_xor_si128( block3, cipher_block2 ) );
+
+			vector_value = cipher_block3;
+
+			input_data       += 64;
+			output_data      += 64;
+			number_of_blocks -= 4;
+		}
+		while( number_of_blocks > 0 )
+		{
+			cipher_block0 = _mm_loadu_si128( (const __m128i *) input_data );
+
+			block0 = cipher_block0;
+
+			libcaes_hardware_x86_decrypt_block(
+			 round_key_values,
+			 number_of_rounds,
+			 block0,
+			 round_index )
+
+			_mm_storeu_si128( (__m128i *) output_data, _mm_xor_si128( block0, vector_value ) );
+
+			vector_value = cipher_block0;
+
+			input_data       += 16;
+			output_data      += 16;
+			number_of_blocks -= 1;
+		}
+	}
+	_mm_storeu_si128(
+	 (__m128i *) initialization_vector,
+	 vector_value );
+}
+
+#if defined( LIBCAES_HAVE_X86_VAES_INSTRUCTIONS )
+
+/* Multiplies the 4 XTS tweak values in a 512-bit vector by x^4 in GF(2^128)
+ * The 4 bits shifted out of the lower 64-bit half move into the upper half,
+ * the 4 bits shifted out of the upper half are reduced by the polynomial 0x87
+ */
+#define libcaes_hardware_x86_vaes_xts_multiply_tweaks( tweaks, carry_values, reduced_values ) \
+	carry_values   = _mm512_shuffle_epi32( _mm512_srli_epi64( tweaks, 60 ), (_MM_PERM_ENUM) 0x4e ); \
+	reduced_values = _mm512_xor_si512( \
+	                  _mm512_xor_si512( carry_values, _mm512_slli_epi64( carry_values, 1 ) ), \
+	                  _mm512_xor_si512( _mm512_slli_epi64( carry_values, 2 ), _mm512_slli_epi64( carry_values, 7 ) ) ); \
+	tweaks         = _mm512_xor_si512( \
+	                  _mm512_slli_epi64( tweaks, 4 ), \
+	                  _mm512_mask_blend_epi64( 0xaa, reduced_values, carry_values ) );
+
+/* Applies the vector AES instruction to 4 independent 512-bit vectors of 4 blocks each
+ */
+#define libcaes_hardware_x86_vaes_16_blocks( instruction, blocks, round_key ) \
+	blocks[ 0 ] = instruction( blocks[ 0 ], round_key ); \
+	blocks[ 1 ] = instruction( blocks[ 1 ], round_key ); \
+	blocks[ 2 ] = instruction( blocks[ 2 ], round_key ); \
+	blocks[ 3 ] = instruction( blocks[ 3 ], round_key );
+
+/* De- or encrypts blocks using AES-XTS and the 512-bit vector AES instructions
+ * The blocks are processed in multitudes of 16 blocks
+ * The tweak value is updated for the block following the last processed block
+ * Returns the number of blocks processed
+ */
+LIBCAES_X86_VAES_TARGET \
+static size_t libcaes_hardware_x86_vaes_crypt_xts(
+               const uint32_t *round_keys,
+               uint8_t number_of_rounds,
+               int mode,
+               uint8_t *tweak_data,
+               const uint8_t *input_data,
+               uint8_t *output_data,
+               size_t number_of_blocks )
+{
+	__m512i round_key_values[ 15 ];
+	__m512i blocks[ 4 ];
+	__m512i tweaks[ 4 ];
+
+	__m512i carry_values     = _mm512_setzero_si512();
+	__m512i reduced_values   = _mm512_setzero_si512();
+	__m128i carry_value      = _mm_setzero_si128();
+	__m128i tweak_value      = _mm_setzero_si128();
+	size_t number_of_processed_blocks = 0;
+	uint8_t round_index      = 0;
+	uint8_t vector_index     = 0;
+
+	for( round_index = 0;
+	     round_index <= number_of_rounds;
+	     round_index++ )
+	{
+		round_key_values[ round_index ] = _mm512_broadcast_i32x4(
+		                                   _mm_loadu_si128(
+		                                    (const __m128i *) &( round_keys[ round_index * 4 ] ) ) );
+	}
+	/* The first vector contains the tweak values of 4 consecutive blocks
+	 */
+	tweak_value = _mm_loadu_si128(
+	               (const __m128i *) tweak_data );
+
+	tweaks[ 0 ] = _mm512_castsi128_si512(
+	               tweak_value );
+
+	libcaes_hardware_x86_xts_multiply_tweak(
+	 tweak_value,
+	 carry_value )
+
+	tweaks[ 0 ] = _mm512_inserti32x4(
+	               tweaks[ 0 ],
+	               tweak_value,
+	               1 );
+
+	libcaes_hardware_x86_xts_multiply_tweak(
+	 tweak_value,
+	 carry_value )
+
+	tweaks[ 0 ] = _mm512_inserti32x4(
+	               tweaks[ 0 ],
+	               tweak_value,
+	               2 );
+
+	libcaes_hardware_x86_xts_multiply_tweak(
+	 tweak_value,
+	 carry_value )
+
+	tweaks[ 0 ] = _mm512_inserti32x4(
+	               tweaks[ 0 ],
+	               tweak_value,
+	               3 );
+
+	while( number_of_blocks >= 16 )
+	{
+		for( vector_index = 0;
+		     vector_index < 4;
+		     vector_index++ )
+		{
+			if( vector_index > 0 )
+			{
+				tweaks[ vector_index ] = tweaks[ vector_index - 1 ];
+
+				libcaes_hardware_x86_vaes_xts_multiply_tweaks(
+				 tweaks[ vector_index ],
+				 carry_values,
+				 reduced_values )
+			}
+			blocks[ vector_index ] = _mm512_xor_si512(
+			                          _mm512_loadu_si512( (const void *) &( input_data[ vector_index * 64 ] ) ),
+			                          tweaks[ vector_index ] );
+
+			blocks[ vector_index ] = _mm512_xor_si512(
+			                          blocks[ vector_index ],
+			                          round_key_values[ 0 ] );
+		}
+		if( mode == LIBCAES_CRYPT_MODE_ENCRYPT )
+		{
+			for( round_index = 1;
+			     round_index < number_of_rounds;
+			     round_index++ )
+			{
+				libcaes_hardware_x86_vaes_16_blocks(
+				 _mm512_aesenc_epi128,
+				 blocks,
+				 round_key_values[ round_index ] )
+			}
+			libcaes_hardware_x86_vaes_16_blocks(
+			 _mm512_aesenclast_epi128,
+			 blocks,
+			 round_key_values[ number_of_rounds ] )
+		}
+		else
+		{
+			for( round_index = 1;
+			     round_index < number_of_rounds;
+			     round_index++ )
+			{
+				libcaes_hardware_x86_vaes_16_blocks(
+				 _mm512_aesdec_epi128,
+				 blocks,
+				 round_key_values[ round_index ] )
+			}
+			libcaes_hardware_x86_vaes_16_blocks(
+			 _mm512_aesdeclast_epi128,
+			 blocks,
+			 round_key_values[ number_of_rounds ] )
+		}
+		for( vector_index = 0;
+		     vector_index < 4;
+		     vector_index++ )
+		{
+			_mm512_storeu_si512(
+			 (void *) &( output_data[ vector_index * 64 ] ),
+			 _mm512_xor_si512(
+			  blocks[ vector_index ],
+			  tweaks[ vector_index ] ) );
+		}
+		tweaks[ 0 ] = tweaks[ 3 ];
+
+		libcaes_hardware_x86_vaes_xts_multiply_tweaks(
+		 tweaks[ 0 ],
+		 carry_values,
+		 reduced_values )
+
+		input_data                 += 256;
+		output_data                += 256;
+		number_of_blocks           -= 16;
+		number_of_processed_blocks += 16;
+	}
+	_mm_storeu_si128(
+	 (__m128i *) tweak_data,
+	 _mm512_castsi512_si128( tweaks[ 0 ] ) );
+
+	return( number_of_processed_blocks );
+}
+
+#endif /* defined( LIBCAES_HAVE_X86_VAES_INSTRUCTIONS ) */
+
+/* De- or encrypts blocks using AES-XTS and the x86 AES instructions
+ * Up to 8 blocks are processed in parallel to hide the latency of the AES instructions
+ * The tweak value is updated for the block following the last block
+ */
+LIBCAES_X86_AES_TARGET \
+static void libcaes_hardware_x86_crypt_xts(
+             const uint32_t *round_keys,
+             uint8_t number_of_rounds,
+             int mode,
+             uint8_t *tweak_data,
+             const uint8_t *input_data,
+             uint8_t *output_data,
+             size_t number_of_blocks )
+{
+	__m128i round_key_values[ 15 ];
+	__m128i blocks[ 8 ];
+	__m128i tweaks[ 8 ];
+
+	__m128i carry_values = _mm_setzero_si128();
+	__m128i tweak_value  = _mm_setzero_si128();
+	uint8_t block_index  = 0;
+	uint8_t round_index  = 0;
+
+#if defined( LIBCAES_HAVE_X86_VAES_INSTRUCTIONS )
+	size_t number_of_processed_blocks = 0;
+
+	if( ( libcaes_hardware_vaes_support != 0 )
+	 && ( number_of_blocks >= 16 ) )
+	{
+		number_of_processed_blocks = libcaes_hardware_x86_vaes_crypt_xts(
+		                              round_keys,
+		                              number_of_rounds,
+		                              mode,
+		                              tweak_data,
+		                              input_data,
+		                              output_data,
+		                              number_of_blocks );
+
+		input_data       += number_of_processed_blocks * 16;
+		output_data      += number_of_processed_blocks * 16;
+		number_of_blocks -= number_of_processed_blocks;
+	}
+#endif
+	libcaes_hardware_x86_load_round_keys(
+	 round_key_values,
+	 round_keys,
+	 number_of_rounds );
+
+	tweak_value = _mm_loadu_si128(
+	               (const __m128i *) tweak_data );
+
+	while( number_of_blocks >= 8 )
+	{
+		for( block_index = 0;
+		     block_index < 8;
+		     block_index++ )
+		{
+			tweaks[ block_index ] = tweak_value;
+
+			blocks[ block_index ] = _mm_xor_si128(
+			                         _mm_loadu_si128( (const __m128i *) &( input_data[ block_index * 16 ] ) ),
+			                         tweak_value );
+
+			blocks[ block_index ] = _mm_xor_si128(
+			                         blocks[ block_index ],
+			                         round_key_values[ 0 ] );
+
+			libcaes_hardware_x86_xts_multiply_tweak(
+			 tweak_value,
+			 carry_values )
+		}
+		if( mode == LIBCAES_CRYPT_MODE_ENCRYPT )
+		{
+			for( round_index = 1;
+			     round_index < number_of_rounds;
+			     round_index++ )
+			{
+				libcaes_hardware_x86_8_blocks(
+				 _mm_aesenc_si128,
+				 blocks,
+				 round_key_values[ round_index ] )
+			}
+			libcaes_hardware_x86_8_blocks(
+			 _mm_aesenclast_si128,
+			 blocks,
+			 round_key_values[ number_of_rounds ] )
+		}
+		else
+		{
+			for( round_index = 1;
+			     round_index < number_of_rounds;
+			     round_index++ )
+			{
+				libcaes_hardware_x86_8_blocks(
+				 _mm_aesdec_si128,
+				 blocks,
+				 round_key_values[ round_index ] )
+			}
+			libcaes_hardware_x86_8_blocks(
+			 _mm_aesdeclast_si128,
+			 blocks,
+			 round_key_values[ number_of_rounds ] )
+		}
+		for( block_index = 0;
+		     block_index < 8;
+		     block_index++ )
+		{
+			_mm_storeu_si128(
+			 (__m128i *) &( output_data[ block_index * 16 ] ),
+			 _mm_xor_si128(
+			  blocks[ block_index ],
+			  tweaks[ block_index ] ) );
+		}
+		input_data       += 128;
+		output_data      += 128;
+		number_of_blocks -= 8;
+	}
+	while( number_of_blocks > 0 )
+	{
+		blocks[ 0 ] = _mm_xor_si128(
+		               _mm_loadu_si128( (const __m128i *) input_data ),
+		               tweak_value );
+
+		if( mode == LIBCAES_CRYPT_MODE_ENCRYPT )
+		{
+			libcaes_hardware_x86_encrypt_block(
+			 round_key_values,
+			 number_of_rounds,
+			 blocks[ 0 ],
+			 round_index )
+		}
+		else
+		{
+			libcaes_hardware_x86_decrypt_block(
+			 round_key_values,
+			 number_of_rounds,
+			 blocks[ 0 ],
+			 round_index )
+		}
+		_mm_storeu_si128(
+		 (__m128i *) output_data,
+		 _mm_xor_si128( blocks[ 0 ], tweak_value ) );
+
+		libcaes_hardware_x86_xts_multiply_tweak(
+		 tweak_value,
+		 carry_values )
+
+		input_data       += 16;
+		output_data      += 16;
+		number_of_blocks -= 1;
+	}
+	_mm_storeu_si128(
+	 (__m128i *) tweak_data,
+	 tweak_value );
+}
+
+#endif /* defined( LIBCAES_HAVE_X86_AES_INSTRUCTIONS ) */
+
+#if defined( LIBCAES_HAVE_ARM_AES_INSTRUCTIONS )
+
+/* Encrypts a block using the ARMv8 AES instructions
+ * AESE includes the round key addition that precedes SubBytes and ShiftRows
+ */
+static uint8x16_t libcaes_hardware_arm_encrypt_block(
+                   const uint8x16_t *round_key_values,
+                   uint8_t number_of_rounds,
+                   uint8x16_t block )
+{
+	uint8_t round_index = 0;
+
+	for( round_index = 0;
+	     round_index < number_of_rounds - 1;
+	     round_index++ )
+	{
+		block = vaesmcq_u8(
+		         vaeseq_u8(
+		          block,
+		          round_key_values[ round_index ] ) );
+	}
+	block = vaeseq_u8(
+	         block,
+	         round_key_values[ number_of_rounds - 1 ] );
+
+	return( veorq_u8(
+	         block,
+	         round_key_values[ number_of_rounds ] ) );
+}
+
+/* Decrypts a block using the ARMv8 AES instructions
+ */
+static uint8x16_t libcaes_hardware_arm_decrypt_block(
+                   const uint8x16_t *round_key_values,
+                   uint8_t number_of_rounds,
+                   uint8x16_t block )
+{
+	uint8_t round_index = 0;
+
+	for( round_index = 0;
+	     round_index < number_of_rounds - 1;
+	     round_index++ )
+	{
+		block = vaesimcq_u8(
+		         vaesdq_u8(
+		          block,
+		          round_key_values[ round_index ] ) );
+	}
+	block = vaesdq_u8(
+	         block,
+	         round_key_values[ number_of_rounds - 1 ] );
+
+	return( veorq_u8(
+	         block,
+	         round_key_values[ number_of_rounds ] ) );
+}
+
+/* Loads the round keys into registers
+ */
+static void libcaes_hardware_arm_load_round_keys(
+             uint8x16_t *round_key_values,
+             const uint32_t *round_keys,
+             uint8_t number_of_rounds )
+{
+	uint8_t round_index = 0;
+
+	for( round_index = 0;
+	     round_index <= number_of_rounds;
+	     round_index++ )
+	{
+		round_key_values[ round_index ] = vld1q_u8(
+		                                   (const uint8_t *) &( round_keys[ round_index * 4 ] ) );
+	}
+}
+
+/* Multiplies a XTS tweak value by the primitive element alpha in GF(2^128)
+ */
+static uint8x16_t libcaes_hardware_arm_xts_multiply_tweak(
+                   uint8x16_t tweak )
+{
+	static const int32_t carry_mask_values[ 4 ] = { 1, 1, 1, 0x87 };
+
+	int32x4_t carry_values = vshrq_n_s32(
+	                          vreinterpretq_s32_u8( tweak ),
+	                          31 );
+
+	carry_values = vandq_s32(
+	                carry_values,
+	                vld1q_s32( carry_mask_values ) );
+
+	/* Move the carry of each 32-bit value to the next 32-bit value
+	 */
+	carry_values = vextq_s32(
+	                carry_values,
+	                carry_values,
+	                3 );
+
+	return( veorq_u8(
+	         vreinterpretq_u8_s32(
+	          vshlq_n_s32(
+	           vreinterpretq_s32_u8( tweak ),
+	           1 ) ),
+	         vreinterpretq_u8_s32( carry_values ) ) );
+}
+
+/* De- or encrypts blocks using AES-XTS and the ARMv8 AES instructions
+ * The tweak value is updated for the block following the last block
+ */
+static void libcaes_hardware_arm_crypt_xts(
+             const uint32_t *round_keys,
+             uint8_t number_of_rounds,
+             int mode,
+             uint8_t *tweak_data,
+             const uint8_t *input_data,
+             uint8_t *output_data,
+             size_t number_of_blocks )
+{
+	uint8x16_t round_key_values[ 15 ];
+
+	uint8x16_t block       = vdupq_n_u8( 0 );
+	uint8x16_t tweak_value = vld1q_u8( tweak_data );
+
+	libcaes_hardware_arm_load_round_keys(
+	 round_key_values,
+	 round_keys,
+	 number_of_rounds );
+
+	while( number_of_blocks > 0 )
+	{
+		block = veorq_u8(
+		         vld1q_u8( input_data ),
+		         tweak_value );
+
+		if( mode == LIBCAES_CRYPT_MODE_ENCRYPT )
+		{
+			block = libcaes_hardware_arm_encrypt_block(
+			         round_key_values,
+			         number_of_rounds,
+			         block );
+		}
+		else
+		{
+			block = libcaes_hardware_arm_decrypt_block(
+			         round_key_values,
+			         number_of_rounds,
+			         block );
+		}
+		vst1q_u8(
+		 output_data,
+		 veorq_u8(
+		  block,
+		  tweak_value ) );
+
+		tweak_value = libcaes_hardware_arm_xts_multiply_tweak(
+		               tweak_value );
+
+		input_data       += 16;
+		output_data      += 16;
+		number_of_blocks -= 1;
+	}
+	vst1q_u8(
+	 tweak_data,
+	 tweak_value );
+}
+
+#endif /* defined( LIBCAES_HAVE_ARM_AES_INSTRUCTIONS ) */
+
+/* De- or encrypts blocks using AES-ECB and the AES instructions of the CPU
+ * libcaes_hardware_is_supported must return 1 before this function is used
+ */
+void libcaes_hardware_crypt_ecb(
+      const uint32_t *round_keys,
+      uint8_t number_of_rounds,
+      int mode,
+      const uint8_t *input_data,
+      uint8_t *output_data,
+      size_t number_of_blocks )
+{
+#if defined( LIBCAES_HAVE_X86_AES_INSTRUCTIONS )
+	libcaes_hardware_x86_crypt_ecb(
+	 round_keys,
+	 number_of_rounds,
+	 mode,
+	 input_data,
+	 output_data,
+	 number_of_blocks );
+
+#elif defined( LIBCAES_HAVE_ARM_AES_INSTRUCTIONS )
+	uint8x16_t round_key_values[ 15 ];
+
+	uint8x16_t block = vdupq_n_u8( 0 );
+
+	libcaes_hardware_arm_load_round_keys(
+	 round_key_values,
+	 round_keys,
+	 number_of_rounds );
+
+	while( number_of_blocks > 0 )
+	{
+		block = vld1q_u8( input_data );
+
+		if( mode == LIBCAES_CRYPT_MODE_ENCRYPT )
+		{
+			block = libcaes_hardware_arm_encrypt_block(
+			         round_key_values,
+			         number_of_rounds,
+			         block );
+		}
+		else
+		{
+			block = libcaes_hardware_arm_decrypt_block(
+			         round_key_values,
+			         number_of_rounds,
+			         block );
+		}
+		vst1q_u8(
+		 output_data,
+		 block );
+
+		input_data       += 16;
+		output_data      += 16;
+		number_of_blocks -= 1;
+	}
+#endif
+}
+
+/* De- or encrypts blocks using AES-CBC and the AES instructions of the CPU
+ * The initialization vector is updated to the last cipher text block
+ * libcaes_hardware_is_supported must return 1 before this function is used
+ */
+void libcaes_hardware_crypt_cbc(
+      const uint32_t *round_keys,
+      uint8_t number_of_rounds,
+      int mode,
+      uint8_t *initialization_vector,
+      const uint8_t *input_data,
+      uint8_t *output_data,
+      size_t number_of_blocks )
+{
+#if defined( LIBCAES_HAVE_X86_AES_INSTRUCTIONS )
+	libcaes_hardware_x86_crypt_cbc(
+	 round_keys,
+	 number_of_rounds,
+	 mode,
+	 initialization_vector,
+	 input_data,
+	 output_data,
+	 number_of_blocks );
+
+#elif defined( LIBCAES_HAVE_ARM_AES_INSTRUCTIONS )
+	uint8x16_t round_key_values[ 15 ];
+
+	uint8x16_t block        = vdupq_n_u8( 0 );
+	uint8x16_t cipher_block = vdupq_n_u8( 0 );
+	uint8x16_t vector_value = vld1q_u8( initialization_vector );
+
+	libcaes_hardware_arm_load_round_keys(
+	 round_key_values,
+	 round_keys,
+	 number_of_rounds );
+
+	while( number_of_blocks > 0 )
+	{
+		if( mode == LIBCAES_CRYPT_MODE_ENCRYPT )
+		{
+			block = libcaes_hardware_arm_encrypt_block(
+			         round_key_values,
+			         number_of_rounds,
+			         veorq_u8(
+			          vld1q_u8( input_data ),
+			          vector_value ) );
+
+			vector_value = block;
+		}
+		else
+		{
+			cipher_block = vld1q_u8( input_data );
+
+			block = veorq_u8(
+			         libcaes_hardware_arm_decrypt_block(
+			          round_key_values,
+			          number_of_rounds,
+			          cipher_block ),
+			         vector_value );
+
+			vector_value = cipher_block;
+		}
+		vst1q_u8(
+		 output_data,
+		 block );
+
+		input_data       += 16;
+		output_data      += 16;
+		number_of_blocks -= 1;
+	}
+	vst1q_u8(
+	 initialization_vector,
+	 vector_value );
+#endif
+}
+
+/* De- or encrypts blocks using AES-XTS and the AES instructions of the CPU
+ * The tweak value is updated for the block following the last block
+ */
+static void libcaes_hardware_crypt_xts_blocks(
+             const uint32_t *round_keys,
+             uint8_t number_of_rounds,
+             int mode,
+             uint8_t *tweak_data,
+             const uint8_t *input_data,
+             uint8_t *output_data,
+             size_t number_of_blocks )
+{
+#if defined( LIBCAES_HAVE_X86_AES_INSTRUCTIONS )
+	libcaes_hardware_x86_crypt_xts(
+	 round_keys,
+	 number_of_rounds,
+	 mode,
+	 tweak_data,
+	 input_data,
+	 output_data,
+	 number_of_blocks );
+
+#elif defined( LIBCAES_HAVE_ARM_AES_INSTRUCTIONS )
+	libcaes_hardware_arm_crypt_xts(
+	 round_keys,
+	 number_of_rounds,
+	 mode,
+	 tweak_data,
+	 input_data,
+	 output_data,
+	 number_of_blocks );
+#endif
+}
+
+/* Multiplies a XTS tweak value by the primitive element alpha in GF(2^128)
+ */
+static void libcaes_hardware_xts_multiply_tweak_data(
+             uint8_t *tweak_data )
+{
+	uint8_t block_index = 0;
+	uint8_t byte_value  = 0;
+	uint8_t carry_bit   = 0;
+
+	for( block_index = 0;
+	     block_index < 16;
+	     block_index++ )
+	{
+		byte_value = ( tweak_data[ block_index ] << 1 ) | carry_bit;
+		carry_bit  = tweak_data[ block_index ] >> 7;
+
+		tweak_data[ block_index ] = byte_value;
+	}
+	if( carry_bit > 0 )
+	{
+		tweak_data[ 0 ] ^= 0x87;
+	}
+}
+
+/* De- or encrypts data using AES-XTS and the AES instructions of the CPU
+ * The data size must be 16 or more, if the data size is not a multitude of 16
+ * the last 2 blocks are handled using ciphertext stealing
+ * The input and output data can refer to the same buffer
+ * libcaes_hardware_is_supported must return 1 before this function is used
+ */
+void libcaes_hardware_crypt_xts(
+      const uint32_t *round_keys,
+      uint8_t number_of_rounds,
+      int mode,
+      const uint8_t *encrypted_tweak_value,
+      const uint8_t *input_data,
+      uint8_t *output_data,
+      size_t data_size )
+{
+	uint8_t block_data[ 16 ];
+	uint8_t stolen_block_data[ 16 ];
+	uint8_t stolen_tweak_data[ 16 ];
+	uint8_t tweak_data[ 16 ];
+
+	size_t data_offset         = 0;
+	size_t number_of_blocks    = data_size / 16;
+	size_t remaining_data_size = data_size % 16;
+
+	memory_copy(
+	 tweak_data,
+	 encrypted_tweak_value,
+	 16 );
+
+	/* The last full block is handled together with the remaining data
+	 */
+	if( remaining_data_size > 0 )
+	{
+		number_of_blocks -= 1;
+	}
+	libcaes_hardware_crypt_xts_blocks(
+	 round_keys,
+	 number_of_rounds,
+	 mode,
+	 tweak_data,
+	 input_data,
+	 output_data,
+	 number_of_blocks );
+
+	if( remaining_data_size > 0 )
+	{
+		data_offset = number_of_blocks * 16;
+
+		/* Read the remaining input data before the output data is written
+		 * since the buffers can overlap
+		 */
+		memory_copy(
+		 stolen_block_data,
+		 &( input_data[ data_offset + 16 ] ),
+		 remaining_data_size );
+
+		memory_copy(
+		 stolen_tweak_data,
+		 tweak_data,
+		 16 );
+
+		/* On decryption the last full block was encrypted with the tweak value
+		 * of the remaining data
+		 */
+		if( mode == LIBCAES_CRYPT_MODE_DECRYPT )
+		{
+			libcaes_hardware_xts_multiply_tweak_data(
+			 stolen_tweak_data );
+		}
+		libcaes_hardware_crypt_xts_blocks(
+		 round_keys,
+		 number_of_rounds,
+		 mode,
+		 stolen_tweak_data,
+		 &( input_data[ data_offset ] ),
+		 block_data,
+		 1 );
+
+		memory_copy(
+		 &( stolen_block_data[ remaining_data_size ] ),
+		 &( block_data[ remaining_data_size ] ),
+		 16 - remaining_data_size );
+
+		memory_copy(
+		 &( output_data[ data_offset + 16 ] ),
+		 block_data,
+		 remaining_data_size );
+
+		/* On encryption the tweak value of the remaining data follows that of the last full block
+		 */
+		if( mode == LIBCAES_CRYPT_MODE_ENCRYPT )
+		{
+			memory_copy(
+			 tweak_data,
+			 stolen_tweak_data,
+			 16 );
+		}
+		libcaes_hardware_crypt_xts_blocks(
+		 round_keys,
+		 number_of_rounds,
+		 mode,
+		 tweak_data,
+		 stolen_block_data,
+		 &( output_data[ data_offset ] ),
+		 1 );
+
+		memory_set(
+		 block_data,
+		 0,
+		 16 );
+
+		memory_set(
+		 stolen_block_data,
+		 0,
+		 16 );
+
+		memory_set(
+		 stolen_tweak_data,
+		 0,
+		 16 );
+	}
+	memory_set(
+	 tweak_data,
+	 0,
+	 16 );
+}
+
+/* De- or encrypts consecutive data units using AES-XTS and the AES instructions of the CPU
+ * The tweak value of a data unit is its data unit number as a 128-bit little-endian value
+ * The tweak values of up to 8 data units are encrypted together before the data units
+ * are de- or encrypted
+ * The data unit size must be 16 or more
+ * libcaes_hardware_is_supported must return 1 before this function is used
+ */
+void libcaes_hardware_crypt_xts_data_units(
+      const uint32_t *round_keys,
+      uint8_t number_of_rounds,
+      const uint32_t *tweak_round_keys,
+      uint8_t number_of_tweak_rounds,
+      int mode,
+      uint64_t data_unit_number,
+      size_t data_unit_size,
+      const uint8_t *input_data,
+      uint8_t *output_data,
+      size_t number_of_data_units )
+{
+	uint8_t tweak_values[ 8 * 16 ];
+
+	size_t data_unit_index        = 0;
+	size_t number_of_tweak_values = 0;
+	size_t tweak_value_index      = 0;
+
+	memory_set(
+	 tweak_values,
+	 0,
+	 8 * 16 );
+
+	while( number_of_data_units > 0 )
+	{
+		number_of_tweak_values = number_of_data_units;
+
+		if( number_of_tweak_values > 8 )
+		{
+			number_of_tweak_values = 8;
+		}
+		for( tweak_value_index = 0;
+		     tweak_value_index < number_of_tweak_values;
+		     tweak_value_index++ )
+		{
+			byte_stream_copy_from_uint64_little_endian(
+			 &( tweak_values[ tweak_value_index * 16 ] ),
+			 data_unit_number + tweak_value_index );
+
+			byte_stream_copy_from_uint64_little_endian(
+			 &( tweak_values[ ( tweak_value_index * 16 ) + 8 ] ),
+			 (uint64_t) 0 );
+		}
+		libcaes_hardware_crypt_ecb(
+		 tweak_round_keys,
+		 number_of_tweak_rounds,
+		 LIBCAES_CRYPT_MODE_ENCRYPT,
+		 tweak_values,
+		 tweak_values,
+		 number_of_tweak_values );
+
+		for( tweak_value_index = 0;
+		     tweak_value_index < number_of_tweak_values;
+		     tweak_value_index++ )
+		{
+			libcaes_hardware_crypt_xts(
+			 round_keys,
+			 number_of_rounds,
+			 mode,
+			 &( tweak_values[ tweak_value_index * 16 ] ),
+			 &( input_data[ data_unit_index * data_unit_size ] ),
+			 &( output_data[ data_unit_index * data_unit_size ] ),
+			 data_unit_size );
+
+			data_unit_index++;
+		}
+		data_unit_number     += number_of_tweak_values;
+		number_of_data_units -= number_of_tweak_values;
+	}
+	memory_set(
+	 tweak_values,
+	 0,
+	 8 * 16 );
+}
+
+#endif /* !defined( LIBCAES_HAVE_AES_SUPPORT ) */
+
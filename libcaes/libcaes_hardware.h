@@ -0,0 +1,94 @@
+/*
+ * AES hardware acceleration functions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#if !defined( _LIBCAES_HARDWARE_H )
+#define _LIBCAES_HARDWARE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libcaes_definitions.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if !defined( LIBCAES_HAVE_AES_SUPPORT )
+
+void libcaes_hardware_initialize(
+      void );
+
+int libcaes_hardware_is_supported(
+     void );
+
+void libcaes_hardware_set_enabled(
+      int enabled );
+
+const char *libcaes_hardware_get_implementation_name(
+             void );
+
+void libcaes_hardware_crypt_ecb(
+      const uint32_t *round_keys,
+      uint8_t number_of_rounds,
+      int mode,
+      const uint8_t *input_data,
+      uint8_t *output_data,
+      size_t number_of_blocks );
+
+void libcaes_hardware_crypt_cbc(
+      const uint32_t *round_keys,
+      uint8_t number_of_rounds,
+      int mode,
+      uint8_t *initialization_vector,
+      const uint8_t *input_data,
+      uint8_t *output_data,
+      size_t number_of_blocks );
+
+void libcaes_hardware_crypt_xts(
+      const uint32_t *round_keys,
+      uint8_t number_of_rounds,
+      int mode,
+      const uint8_t *encrypted_tweak_value,
+      const uint8_t *input_data,
+      uint8_t *output_data,
+      size_t data_size );
+
+void libcaes_hardware_crypt_xts_data_units(
+      const uint32_t *round_keys,
+      uint8_t number_of_rounds,
+      const uint32_t *tweak_round_keys,
+      uint8_t number_of_tweak_rounds,
+      int mode,
+      uint64_t data_unit_number,
+      size_t data_unit_size,
+      const uint8_t *input_data,
+      uint8_t *output_data,
+      size_t number_of_data_units );
+
+#endif /* !defined( LIBCAES_HAVE_AES_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBCAES_HARDWARE_H ) */
+
@@ -23,7 +23,9 @@
 #include <types.h>
 
 #include "libcaes_definitions.h"
+#include "libcaes_hardware.h"
 #include "libcaes_support.h"
+#include "libcaes_unused.h"
 
 #if !defined( HAVE_LOCAL_LIBCAES )
 
@@ -37,3 +39,34 @@ const char *libcaes_get_version(
 
 #endif
 
+/* Retrieves the name of the AES implementation that is used
+ * Returns a string containing the name
+ */
+const char *libcaes_get_implementation_name(
+             void )
+{
+#if defined( LIBCAES_HAVE_AES_SUPPORT ) && defined( WINAPI )
+	return( "wincrypt" );
+
+#elif defined( LIBCAES_HAVE_AES_SUPPORT )
+	return( "openssl" );
+
+#else
+	return( libcaes_hardware_get_implementation_name() );
+#endif
+}
+
+/* Enables or disables the use of the AES instructions
+ * This function is intended for testing and benchmarking and should not be called while data is being de/encrypted
+ */
+void libcaes_set_hardware_enabled(
+      int enabled LIBCAES_ATTRIBUTE_UNUSED )
+{
+#if !defined( LIBCAES_HAVE_AES_SUPPORT )
+	libcaes_hardware_set_enabled(
+	 enabled );
+#else
+	LIBCAES_UNREFERENCED_PARAMETER( enabled )
+#endif
+}
+
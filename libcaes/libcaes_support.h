@@ -39,6 +39,14 @@ const char *libcaes_get_version(
 
 #endif
 
+LIBCAES_EXTERN \
+const char *libcaes_get_implementation_name(
+             void );
+
+LIBCAES_EXTERN \
+void libcaes_set_hardware_enabled(
+      int enabled );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -26,6 +26,7 @@
 
 #include "libcaes_context.h"
 #include "libcaes_definitions.h"
+#include "libcaes_hardware.h"
 #include "libcaes_libcerror.h"
 #include "libcaes_tweaked_context.h"
 #include "libcaes_types.h"
@@ -442,10 +443,28 @@ int libcaes_crypt_xts(
 
 		goto on_error;
 	}
-	if( memory_copy(
-	     output_data,
-	     input_data,
-	     input_data_size ) == NULL )
+#if !defined( LIBCAES_HAVE_AES_SUPPORT )
+	if( libcaes_hardware_is_supported() != 0 )
+	{
+		libcaes_hardware_crypt_xts(
+		 ( (libcaes_internal_context_t *) internal_tweaked_context->main_context )->round_keys,
+		 ( (libcaes_internal_context_t *) internal_tweaked_context->main_context )->number_of_round_keys,
+		 mode,
+		 encrypted_tweak_value,
+		 input_data,
+		 output_data,
+		 input_data_size );
+
+		data_offset = input_data_size;
+	}
+#endif
+	/* The data is de/encrypted in place in the output data
+	 */
+	if( ( output_data != input_data )
+	 && ( memory_copy(
+	       &( output_data[ data_offset ] ),
+	       &( input_data[ data_offset ] ),
+	       input_data_size - data_offset ) == NULL ) )
 	{
 		libcerror_error_set(
 		 error,
@@ -456,7 +475,7 @@ int libcaes_crypt_xts(
 
 		return( -1 );
 	}
-	remaining_data_size = input_data_size;
+	remaining_data_size = input_data_size - data_offset;
 
 	while( ( data_offset + 16 ) <= input_data_size )
 	{
@@ -758,3 +777,209 @@ on_error:
 	return( -1 );
 }
 
+/* De- or encrypts consecutive data units using AES-XTS (XEX-based tweaked-codebook mode with ciphertext stealing)
+ * The tweak value of a data unit is its data unit number as a 128-bit little-endian value,
+ * where the first data unit has the data unit number provided
+ * The input data size must be a multitude of the data unit size
+ * Returns 1 if successful or -1 on error
+ */
+int libcaes_crypt_xts_data_units(
+     libcaes_tweaked_context_t *tweaked_context,
+     int mode,
+     uint64_t data_unit_number,
+     size_t data_unit_size,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error )
+{
+	uint8_t tweak_value[ 16 ];
+
+	static char *function                                        = "libcaes_crypt_xts_data_units";
+	size_t data_offset                                           = 0;
+
+#if !defined( LIBCAES_HAVE_AES_SUPPORT )
+	libcaes_internal_tweaked_context_t *internal_tweaked_context = NULL;
+#endif
+
+	if( tweaked_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tweaked context.",
+		 function );
+
+		return( -1 );
+	}
+#if !defined( LIBCAES_HAVE_AES_SUPPORT )
+	internal_tweaked_context = (libcaes_internal_tweaked_context_t *) tweaked_context;
+#endif
+
+	if( ( mode != LIBCAES_CRYPT_MODE_DECRYPT )
+	 && ( mode != LIBCAES_CRYPT_MODE_ENCRYPT ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_unit_size < 16 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid data unit size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_unit_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data unit size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input data.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid input data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( input_data_size % data_unit_size ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid input data size value not a multitude of data unit size.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output data.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid output data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data_size < input_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid ouput data size smaller than input data size.",
+		 function );
+
+		return( -1 );
+	}
+#if !defined( LIBCAES_HAVE_AES_SUPPORT )
+	if( libcaes_hardware_is_supported() != 0 )
+	{
+		libcaes_hardware_crypt_xts_data_units(
+		 ( (libcaes_internal_context_t *) internal_tweaked_context->main_context )->round_keys,
+		 ( (libcaes_internal_context_t *) internal_tweaked_context->main_context )->number_of_round_keys,
+		 ( (libcaes_internal_context_t *) internal_tweaked_context->tweak_context )->round_keys,
+		 ( (libcaes_internal_context_t *) internal_tweaked_context->tweak_context )->number_of_round_keys,
+		 mode,
+		 data_unit_number,
+		 data_unit_size,
+		 input_data,
+		 output_data,
+		 input_data_size / data_unit_size );
+
+		return( 1 );
+	}
+#endif
+	while( data_offset < input_data_size )
+	{
+		if( memory_set(
+		     tweak_value,
+		     0,
+		     16 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear tweak value.",
+			 function );
+
+			return( -1 );
+		}
+		byte_stream_copy_from_uint64_little_endian(
+		 tweak_value,
+		 data_unit_number );
+
+		if( libcaes_crypt_xts(
+		     tweaked_context,
+		     mode,
+		     tweak_value,
+		     16,
+		     &( input_data[ data_offset ] ),
+		     data_unit_size,
+		     &( output_data[ data_offset ] ),
+		     data_unit_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+			 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+			 "%s: unable to de/encrypt data unit: %" PRIu64 ".",
+			 function,
+			 data_unit_number );
+
+			return( -1 );
+		}
+		data_offset      += data_unit_size;
+		data_unit_number += 1;
+	}
+	return( 1 );
+}
+
@@ -78,6 +78,18 @@ int libcaes_crypt_xts(
      size_t output_data_size,
      libcerror_error_t **error );
 
+LIBCAES_EXTERN \
+int libcaes_crypt_xts_data_units(
+     libcaes_tweaked_context_t *tweaked_context,
+     int mode,
+     uint64_t data_unit_number,
+     size_t data_unit_size,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error );
+
 #ifdef __cplusplus
 }
 #endif
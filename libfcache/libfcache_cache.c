@@ -172,6 +172,9 @@ int libfcache_cache_free(
 
 			result = -1;
 		}
+		libfcache_internal_cache_free_identifier_index(
+		 internal_cache );
+
 		memory_free(
 		 internal_cache );
 	}
@@ -217,6 +220,11 @@ int libfcache_cache_empty(
 	}
 	internal_cache->number_of_cache_values = 0;
 
+	/* The identifier index is recreated when it is needed
+	 */
+	libfcache_internal_cache_free_identifier_index(
+	 internal_cache );
+
 	return( 1 );
 }
 
@@ -317,6 +325,25 @@ int libfcache_cache_resize(
 	}
 	internal_cache = (libfcache_internal_cache_t *) cache;
 
+	/* The identifier index refers to all cache entries,
+	 * hence a cache used by identifier is emptied before resizing
+	 */
+	if( internal_cache->hash_table != NULL )
+	{
+		if( libfcache_cache_empty(
+		     cache,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to empty cache.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	if( libcdata_array_resize(
 	     internal_cache->entries,
 	     maximum_cache_entries,
@@ -581,3 +608,573 @@ int libfcache_cache_set_value_by_index(
 	return( 1 );
 }
 
+
+/* Creates the identifier index of the cache
+ * Returns 1 if successful or -1 on error
+ */
+int libfcache_internal_cache_initialize_identifier_index(
+     libfcache_internal_cache_t *internal_cache,
+     libcerror_error_t **error )
+{
+	static char *function       = "libfcache_internal_cache_initialize_identifier_index";
+	int cache_entry_index       = 0;
+	int hash_table_index        = 0;
+	int number_of_cache_entries = 0;
+
+	if( internal_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_cache->hash_table != NULL )
+	 || ( internal_cache->entry_links != NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid cache - identifier index value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     internal_cache->entries,
+	     &number_of_cache_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries from entries array.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_cache_entries <= 0 )
+	 || ( number_of_cache_entries > ( INT_MAX / 2 ) )
+	 || ( (size_t) number_of_cache_entries > (size_t) ( SSIZE_MAX / sizeof( libfcache_cache_entry_links_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of cache entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* Use at least twice as many buckets as cache entries to keep the chains short
+	 */
+	internal_cache->hash_table_size = 2;
+
+	while( internal_cache->hash_table_size < ( 2 * number_of_cache_entries ) )
+	{
+		internal_cache->hash_table_size *= 2;
+	}
+	internal_cache->hash_table = (int *) memory_allocate(
+	                                      sizeof( int ) * internal_cache->hash_table_size );
+
+	if( internal_cache->hash_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create hash table.",
+		 function );
+
+		goto on_error;
+	}
+	internal_cache->entry_links = (libfcache_cache_entry_links_t *) memory_allocate(
+	                                                                 sizeof( libfcache_cache_entry_links_t ) * number_of_cache_entries );
+
+	if( internal_cache->entry_links == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create entry links.",
+		 function );
+
+		goto on_error;
+	}
+	for( hash_table_index = 0;
+	     hash_table_index < internal_cache->hash_table_size;
+	     hash_table_index++ )
+	{
+		internal_cache->hash_table[ hash_table_index ] = -1;
+	}
+	for( cache_entry_index = 0;
+	     cache_entry_index < number_of_cache_entries;
+	     cache_entry_index++ )
+	{
+		internal_cache->entry_links[ cache_entry_index ].file_index         = -1;
+		internal_cache->entry_links[ cache_entry_index ].offset             = (off64_t) -1;
+		internal_cache->entry_links[ cache_entry_index ].next_in_bucket     = -1;
+		internal_cache->entry_links[ cache_entry_index ].more_recently_used = -1;
+		internal_cache->entry_links[ cache_entry_index ].less_recently_used = -1;
+	}
+	internal_cache->most_recently_used_entry_index  = -1;
+	internal_cache->least_recently_used_entry_index = -1;
+
+	return( 1 );
+
+on_error:
+	libfcache_internal_cache_free_identifier_index(
+	 internal_cache );
+
+	return( -1 );
+}
+
+/* Frees the identifier index of the cache
+ */
+void libfcache_internal_cache_free_identifier_index(
+      libfcache_internal_cache_t *internal_cache )
+{
+	if( internal_cache == NULL )
+	{
+		return;
+	}
+	if( internal_cache->entry_links != NULL )
+	{
+		memory_free(
+		 internal_cache->entry_links );
+
+		internal_cache->entry_links = NULL;
+	}
+	if( internal_cache->hash_table != NULL )
+	{
+		memory_free(
+		 internal_cache->hash_table );
+
+		internal_cache->hash_table = NULL;
+	}
+	internal_cache->hash_table_size                 = 0;
+	internal_cache->most_recently_used_entry_index  = -1;
+	internal_cache->least_recently_used_entry_index = -1;
+}
+
+/* Retrieves the hash table index of an identifier
+ * Returns the hash table index
+ */
+int libfcache_internal_cache_get_hash_table_index(
+     libfcache_internal_cache_t *internal_cache,
+     int file_index,
+     off64_t offset )
+{
+	uint64_t hash_value = 0;
+
+	/* The offsets are typically multiples of a block size
+	 * hence the lower bits are mixed with the upper bits
+	 */
+	hash_value  = (uint64_t) offset;
+	hash_value ^= (uint64_t) (uint32_t) file_index << 48;
+	hash_value ^= hash_value >> 33;
+	hash_value *= 0xff51afd7ed558ccdULL;
+	hash_value ^= hash_value >> 33;
+
+	return( (int) ( hash_value & (uint64_t) ( internal_cache->hash_table_size - 1 ) ) );
+}
+
+/* Retrieves the index of the cache entry with a specific identifier
+ * Returns the cache entry index or -1 if not available
+ */
+int libfcache_internal_cache_get_entry_index_by_identifier(
+     libfcache_internal_cache_t *internal_cache,
+     int file_index,
+     off64_t offset )
+{
+	int cache_entry_index = 0;
+
+	cache_entry_index = internal_cache->hash_table[ libfcache_internal_cache_get_hash_table_index(
+	                                                 internal_cache,
+	                                                 file_index,
+	                                                 offset ) ];
+
+	while( cache_entry_index != -1 )
+	{
+		if( ( internal_cache->entry_links[ cache_entry_index ].file_index == file_index )
+		 && ( internal_cache->entry_links[ cache_entry_index ].offset == offset ) )
+		{
+			break;
+		}
+		cache_entry_index = internal_cache->entry_links[ cache_entry_index ].next_in_bucket;
+	}
+	return( cache_entry_index );
+}
+
+/* Removes a cache entry from the hash table
+ */
+void libfcache_internal_cache_remove_from_hash_table(
+      libfcache_internal_cache_t *internal_cache,
+      int cache_entry_index,
+      int file_index,
+      off64_t offset )
+{
+	int *bucket_entry_index = NULL;
+
+	bucket_entry_index = &( internal_cache->hash_table[ libfcache_internal_cache_get_hash_table_index(
+	                                                     internal_cache,
+	                                                     file_index,
+	                                                     offset ) ] );
+
+	while( *bucket_entry_index != -1 )
+	{
+		if( *bucket_entry_index == cache_entry_index )
+		{
+			*bucket_entry_index = internal_cache->entry_links[ cache_entry_index ].next_in_bucket;
+
+			break;
+		}
+		bucket_entry_index = &( internal_cache->entry_links[ *bucket_entry_index ].next_in_bucket );
+	}
+	internal_cache->entry_links[ cache_entry_index ].file_index     = -1;
+	internal_cache->entry_links[ cache_entry_index ].offset         = (off64_t) -1;
+	internal_cache->entry_links[ cache_entry_index ].next_in_bucket = -1;
+}
+
+/* Moves a cache entry to the front of the least recently used list
+ */
+void libfcache_internal_cache_set_most_recently_used(
+      libfcache_internal_cache_t *internal_cache,
+      int cache_entry_index )
+{
+	libfcache_cache_entry_links_t *entry_links = NULL;
+
+	if( internal_cache->most_recently_used_entry_index == cache_entry_index )
+	{
+		return;
+	}
+	entry_links = &( internal_cache->entry_links[ cache_entry_index ] );
+
+	/* A cache entry that is not the most recently used one
+	 * is in the list if it has a more recently used cache entry
+	 */
+	if( entry_links->more_recently_used != -1 )
+	{
+		internal_cache->entry_links[ entry_links->more_recently_used ].less_recently_used = entry_links->less_recently_used;
+
+		if( entry_links->less_recently_used != -1 )
+		{
+			internal_cache->entry_links[ entry_links->less_recently_used ].more_recently_used = entry_links->more_recently_used;
+		}
+		else
+		{
+			internal_cache->least_recently_used_entry_index = entry_links->more_recently_used;
+		}
+	}
+	entry_links->more_recently_used = -1;
+	entry_links->less_recently_used = internal_cache->most_recently_used_entry_index;
+
+	if( internal_cache->most_recently_used_entry_index != -1 )
+	{
+		internal_cache->entry_links[ internal_cache->most_recently_used_entry_index ].more_recently_used = cache_entry_index;
+	}
+	internal_cache->most_recently_used_entry_index = cache_entry_index;
+
+	if( internal_cache->least_recently_used_entry_index == -1 )
+	{
+		internal_cache->least_recently_used_entry_index = cache_entry_index;
+	}
+}
+
+/* Retrieves the cache value for a specific identifier
+ * The cache value becomes the most recently used one
+ * Returns 1 if successful, 0 if no such value or -1 on error
+ */
+int libfcache_cache_get_value_by_identifier(
+     libfcache_cache_t *cache,
+     int file_index,
+     off64_t offset,
+     time_t timestamp,
+     libfcache_cache_value_t **cache_value,
+     libcerror_error_t **error )
+{
+	libfcache_cache_value_t *safe_cache_value  = NULL;
+	libfcache_internal_cache_t *internal_cache = NULL;
+	static char *function                      = "libfcache_cache_get_value_by_identifier";
+	int cache_entry_index                      = 0;
+
+	if( cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache.",
+		 function );
+
+		return( -1 );
+	}
+	internal_cache = (libfcache_internal_cache_t *) cache;
+
+	if( cache_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache value.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_cache->hash_table == NULL )
+	{
+		return( 0 );
+	}
+	cache_entry_index = libfcache_internal_cache_get_entry_index_by_identifier(
+	                     internal_cache,
+	                     file_index,
+	                     offset );
+
+	if( cache_entry_index == -1 )
+	{
+		return( 0 );
+	}
+	if( libcdata_array_get_entry_by_index(
+	     internal_cache->entries,
+	     cache_entry_index,
+	     (intptr_t **) &safe_cache_value,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cache value: %d from entries array.",
+		 function,
+		 cache_entry_index );
+
+		return( -1 );
+	}
+	if( safe_cache_value == NULL )
+	{
+		return( 0 );
+	}
+	if( ( (libfcache_internal_cache_value_t *) safe_cache_value )->timestamp != timestamp )
+	{
+		return( 0 );
+	}
+	libfcache_internal_cache_set_most_recently_used(
+	 internal_cache,
+	 cache_entry_index );
+
+	*cache_value = safe_cache_value;
+
+	return( 1 );
+}
+
+/* Sets the cache value for a specific identifier
+ * If the cache is full the least recently used cache value is replaced
+ * Note that a cache should either be used by index or by identifier
+ * Returns 1 if successful or -1 on error
+ */
+int libfcache_cache_set_value_by_identifier(
+     libfcache_cache_t *cache,
+     int file_index,
+     off64_t offset,
+     time_t timestamp,
+     intptr_t *value,
+     int (*free_value)(
+            intptr_t **value,
+            libcerror_error_t **error ),
+     uint8_t flags,
+     libcerror_error_t **error )
+{
+	libfcache_cache_entry_links_t *entry_links = NULL;
+	libfcache_cache_value_t *cache_value       = NULL;
+	libfcache_internal_cache_t *internal_cache = NULL;
+	static char *function                      = "libfcache_cache_set_value_by_identifier";
+	int cache_entry_index                      = 0;
+	int hash_table_index                       = 0;
+	int number_of_cache_entries                = 0;
+
+	if( cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache.",
+		 function );
+
+		return( -1 );
+	}
+	internal_cache = (libfcache_internal_cache_t *) cache;
+
+	if( internal_cache->hash_table == NULL )
+	{
+		if( libfcache_internal_cache_initialize_identifier_index(
+		     internal_cache,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create identifier index.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	cache_entry_index = libfcache_internal_cache_get_entry_index_by_identifier(
+	                     internal_cache,
+	                     file_index,
+	                     offset );
+
+	if( cache_entry_index == -1 )
+	{
+		if( libcdata_array_get_number_of_entries(
+		     internal_cache->entries,
+		     &number_of_cache_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of entries from entries array.",
+			 function );
+
+			return( -1 );
+		}
+		if( internal_cache->number_of_cache_values < number_of_cache_entries )
+		{
+			cache_entry_index = internal_cache->number_of_cache_values;
+		}
+		else
+		{
+			cache_entry_index = internal_cache->least_recently_used_entry_index;
+
+			if( cache_entry_index == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: invalid cache - missing least recently used cache entry.",
+				 function );
+
+				return( -1 );
+			}
+			libfcache_internal_cache_remove_from_hash_table(
+			 internal_cache,
+			 cache_entry_index,
+			 internal_cache->entry_links[ cache_entry_index ].file_index,
+			 internal_cache->entry_links[ cache_entry_index ].offset );
+		}
+		hash_table_index = libfcache_internal_cache_get_hash_table_index(
+		                    internal_cache,
+		                    file_index,
+		                    offset );
+
+		entry_links = &( internal_cache->entry_links[ cache_entry_index ] );
+
+		entry_links->file_index     = file_index;
+		entry_links->offset         = offset;
+		entry_links->next_in_bucket = internal_cache->hash_table[ hash_table_index ];
+
+		internal_cache->hash_table[ hash_table_index ] = cache_entry_index;
+	}
+	libfcache_internal_cache_set_most_recently_used(
+	 internal_cache,
+	 cache_entry_index );
+
+	if( libcdata_array_get_entry_by_index(
+	     internal_cache->entries,
+	     cache_entry_index,
+	     (intptr_t **) &cache_value,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cache value: %d from entries array.",
+		 function,
+		 cache_entry_index );
+
+		return( -1 );
+	}
+	if( cache_value == NULL )
+	{
+		if( libfcache_cache_value_initialize(
+		     &cache_value,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create cache value.",
+			 function );
+
+			return( -1 );
+		}
+		if( libcdata_array_set_entry_by_index(
+		     internal_cache->entries,
+		     cache_entry_index,
+		     (intptr_t *) cache_value,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set cache value: %d in entries array.",
+			 function,
+			 cache_entry_index );
+
+			libfcache_cache_value_free(
+			 &cache_value,
+			 NULL );
+
+			return( -1 );
+		}
+		internal_cache->number_of_cache_values++;
+	}
+	if( libfcache_cache_value_set_value(
+	     cache_value,
+	     value,
+	     free_value,
+	     flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set value in cache value.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfcache_cache_value_set_identifier(
+	     cache_value,
+	     file_index,
+	     offset,
+	     timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set identifier in cache value.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
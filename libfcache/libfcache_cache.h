@@ -36,6 +36,31 @@
 extern "C" {
 #endif
 
+typedef struct libfcache_cache_entry_links libfcache_cache_entry_links_t;
+
+struct libfcache_cache_entry_links
+{
+	/* The file index of the identifier
+	 */
+	int file_index;
+
+	/* The offset of the identifier
+	 */
+	off64_t offset;
+
+	/* The index of the next cache entry in the same hash table bucket
+	 */
+	int next_in_bucket;
+
+	/* The index of the more recently used cache entry
+	 */
+	int more_recently_used;
+
+	/* The index of the less recently used cache entry
+	 */
+	int less_recently_used;
+};
+
 typedef struct libfcache_internal_cache libfcache_internal_cache_t;
 
 struct libfcache_internal_cache
@@ -47,6 +72,27 @@ struct libfcache_internal_cache
 	/* The number of cache values
 	 */
 	int number_of_cache_values;
+
+	/* The identifier hash table, contains the index of the first cache entry
+	 * of every bucket or -1 if empty, only used by the by identifier functions
+	 */
+	int *hash_table;
+
+	/* The number of hash table buckets, which is a power of 2
+	 */
+	int hash_table_size;
+
+	/* The hash table and least recently used list links of every cache entry
+	 */
+	libfcache_cache_entry_links_t *entry_links;
+
+	/* The index of the most recently used cache entry
+	 */
+	int most_recently_used_entry_index;
+
+	/* The index of the least recently used cache entry
+	 */
+	int least_recently_used_entry_index;
 };
 
 LIBFCACHE_EXTERN \
@@ -112,6 +158,55 @@ int libfcache_cache_set_value_by_index(
      uint8_t flags,
      libcerror_error_t **error );
 
+int libfcache_internal_cache_initialize_identifier_index(
+     libfcache_internal_cache_t *internal_cache,
+     libcerror_error_t **error );
+
+void libfcache_internal_cache_free_identifier_index(
+      libfcache_internal_cache_t *internal_cache );
+
+int libfcache_internal_cache_get_hash_table_index(
+     libfcache_internal_cache_t *internal_cache,
+     int file_index,
+     off64_t offset );
+
+int libfcache_internal_cache_get_entry_index_by_identifier(
+     libfcache_internal_cache_t *internal_cache,
+     int file_index,
+     off64_t offset );
+
+void libfcache_internal_cache_remove_from_hash_table(
+      libfcache_internal_cache_t *internal_cache,
+      int cache_entry_index,
+      int file_index,
+      off64_t offset );
+
+void libfcache_internal_cache_set_most_recently_used(
+      libfcache_internal_cache_t *internal_cache,
+      int cache_entry_index );
+
+LIBFCACHE_EXTERN \
+int libfcache_cache_get_value_by_identifier(
+     libfcache_cache_t *cache,
+     int file_index,
+     off64_t offset,
+     time_t timestamp,
+     libfcache_cache_value_t **cache_value,
+     libcerror_error_t **error );
+
+LIBFCACHE_EXTERN \
+int libfcache_cache_set_value_by_identifier(
+     libfcache_cache_t *cache,
+     int file_index,
+     off64_t offset,
+     time_t timestamp,
+     intptr_t *value,
+     int (*free_value)(
+            intptr_t **value,
+            libcerror_error_t **error ),
+     uint8_t flags,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
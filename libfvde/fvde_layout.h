@@ -0,0 +1,193 @@
+/*
+ * The layout (sidecar) file definition
+ *
+ * Copyright (C) 2011-2018, Omar Choudary <choudary.omar@gmail.com>
+ *                          Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _FVDE_LAYOUT_H )
+#define _FVDE_LAYOUT_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct fvde_layout_file_header fvde_layout_file_header_t;
+
+struct fvde_layout_file_header
+{
+	/* The signature
+	 * Consists of 8 bytes
+	 * Contains: "fvdelayt"
+	 */
+	uint8_t signature[ 8 ];
+
+	/* The format version
+	 * Consists of 4 bytes
+	 * Contains 1
+	 */
+	uint8_t format_version[ 4 ];
+
+	/* The data size
+	 * Consists of 4 bytes
+	 * Contains the size of the data that follows the file header
+	 */
+	uint8_t data_size[ 4 ];
+
+	/* The checksum
+	 * Consists of 4 bytes
+	 * Contains a weak CRC-32 of the data that follows the file header
+	 */
+	uint8_t checksum[ 4 ];
+
+	/* The number of segment descriptors
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_segment_descriptors[ 4 ];
+
+	/* The number of data area descriptors
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_data_area_descriptors[ 4 ];
+
+	/* Reserved
+	 * Consists of 4 bytes
+	 */
+	uint8_t reserved[ 4 ];
+};
+
+typedef struct fvde_layout_volume fvde_layout_volume_t;
+
+struct fvde_layout_volume
+{
+	/* The (stored) checksum of the volume header
+	 * Consists of 4 bytes
+	 */
+	uint8_t volume_header_checksum[ 4 ];
+
+	/* The serial number
+	 * Consists of 4 bytes
+	 */
+	uint8_t serial_number[ 4 ];
+
+	/* The physical volume identifier
+	 * Consists of 16 bytes
+	 * Contains an UUID
+	 */
+	uint8_t physical_volume_identifier[ 16 ];
+
+	/* The block size
+	 * Consists of 4 bytes
+	 */
+	uint8_t block_size[ 4 ];
+
+	/* The metadata copy index
+	 * Consists of 4 bytes
+	 */
+	uint8_t metadata_copy_index[ 4 ];
+
+	/* The (stored) checksums of the metadata block headers of the 4 metadata copies
+	 * Consists of 4 x 4 bytes
+	 */
+	uint8_t metadata_checksums[ 16 ];
+
+	/* The transaction numbers of the metadata block headers of the 4 metadata copies
+	 * Consists of 4 x 8 bytes
+	 */
+	uint8_t metadata_transaction_numbers[ 32 ];
+
+	/* The encrypted metadata size
+	 * Consists of 8 bytes
+	 */
+	uint8_t encrypted_metadata_size[ 8 ];
+
+	/* The primary encrypted metadata offset
+	 * Consists of 8 bytes
+	 */
+	uint8_t primary_encrypted_metadata_offset[ 8 ];
+
+	/* The secondary encrypted metadata offset
+	 * Consists of 8 bytes
+	 */
+	uint8_t secondary_encrypted_metadata_offset[ 8 ];
+
+	/* The logical volume offset
+	 * Consists of 8 bytes
+	 */
+	uint8_t logical_volume_offset[ 8 ];
+
+	/* The logical volume size
+	 * Consists of 8 bytes
+	 */
+	uint8_t logical_volume_size[ 8 ];
+};
+
+typedef struct fvde_layout_segment_descriptor fvde_layout_segment_descriptor_t;
+
+struct fvde_layout_segment_descriptor
+{
+	/* The logical block number
+	 * Consists of 8 bytes
+	 */
+	uint8_t logical_block_number[ 8 ];
+
+	/* The number of blocks
+	 * Consists of 8 bytes
+	 */
+	uint8_t number_of_blocks[ 8 ];
+
+	/* The physical block number
+	 * Consists of 8 bytes
+	 */
+	uint8_t physical_block_number[ 8 ];
+};
+
+typedef struct fvde_layout_data_area_descriptor fvde_layout_data_area_descriptor_t;
+
+struct fvde_layout_data_area_descriptor
+{
+	/* The offset
+	 * Consists of 8 bytes
+	 */
+	uint8_t offset[ 8 ];
+
+	/* The size
+	 * Consists of 8 bytes
+	 */
+	uint8_t size[ 8 ];
+
+	/* The data type
+	 * Consists of 8 bytes
+	 */
+	uint8_t data_type[ 8 ];
+
+	/* The mapped offset
+	 * Consists of 8 bytes
+	 */
+	uint8_t mapped_offset[ 8 ];
+};
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _FVDE_LAYOUT_H ) */
+
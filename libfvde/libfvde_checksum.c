@@ -20,20 +20,322 @@
  */
 
 #include <common.h>
+#include <byte_stream.h>
 #include <types.h>
 
+#include "libfvde_checksum.h"
 #include "libfvde_libcerror.h"
+#include "libfvde_once.h"
 
-/* Table of CRC-32 values of 8-bit values
+#if defined( __GNUC__ ) && ( defined( __x86_64__ ) || defined( __i386__ ) ) && ( ( __GNUC__ >= 5 ) || defined( __clang__ ) )
+#include <cpuid.h>
+#include <nmmintrin.h>
+
+#define LIBFVDE_HAVE_CRC32C_INSTRUCTIONS	1
+#define LIBFVDE_CRC32C_TARGET			__attribute__((target("sse4.2")))
+
+#elif defined( _MSC_VER ) && ( _MSC_VER >= 1900 ) && ( defined( _M_X64 ) || defined( _M_IX86 ) )
+#include <intrin.h>
+#include <nmmintrin.h>
+
+#define LIBFVDE_HAVE_CRC32C_INSTRUCTIONS	1
+#define LIBFVDE_CRC32C_TARGET
+
+#elif defined( __aarch64__ ) && defined( __ARM_FEATURE_CRC32 )
+#include <arm_acle.h>
+
+#define LIBFVDE_HAVE_CRC32C_INSTRUCTIONS	1
+#define LIBFVDE_CRC32C_TARGET
+
+#endif
+
+#if defined( LIBFVDE_HAVE_CRC32C_INSTRUCTIONS )
+
+#if defined( __aarch64__ )
+#define libfvde_checksum_crc32c_update_8bit( checksum, value ) \
+	checksum = __crc32cb( checksum, value )
+
+#define libfvde_checksum_crc32c_update_64bit( checksum, value ) \
+	checksum = __crc32cd( checksum, value )
+
+#elif defined( __x86_64__ ) || defined( _M_X64 )
+#define libfvde_checksum_crc32c_update_8bit( checksum, value ) \
+	checksum = _mm_crc32_u8( checksum, value )
+
+#define libfvde_checksum_crc32c_update_64bit( checksum, value ) \
+	checksum = (uint32_t) _mm_crc32_u64( checksum, value )
+
+#else
+#define libfvde_checksum_crc32c_update_8bit( checksum, value ) \
+	checksum = _mm_crc32_u8( checksum, value )
+
+#define libfvde_checksum_crc32c_update_64bit( checksum, value ) \
+	checksum = _mm_crc32_u32( checksum, (uint32_t) ( value ) ); \
+	checksum = _mm_crc32_u32( checksum, (uint32_t) ( ( value ) >> 32 ) )
+
+#endif
+
+/* The sizes of the parts that are calculated in parallel
+ */
+#define LIBFVDE_CHECKSUM_CRC32C_LONG_PART_SIZE	1024
+#define LIBFVDE_CHECKSUM_CRC32C_SHORT_PART_SIZE	128
+
+#endif /* defined( LIBFVDE_HAVE_CRC32C_INSTRUCTIONS ) */
+
+/* Tables of CRC-32 values of 8-bit values
+ * The first table contains the CRC-32 of a byte, the others are used to
+ * calculate the CRC-32 of 8 bytes at a time (slicing-by-8)
  */
-uint32_t libfvde_checksum_crc32_table[ 256 ];
+uint32_t libfvde_checksum_crc32_table[ 8 ][ 256 ];
 
 /* Value to indicate the CRC-32 table been computed
  */
 int libfvde_checksum_crc32_table_computed = 0;
 
-/* Initializes the internal CRC-32 table
- * The table speeds up the CRC-32 calculation
+/* The polynomial of the CRC-32 table
+ */
+static uint32_t libfvde_checksum_crc32_table_polynomial = 0;
+
+/* Value to indicate the CPU supports the CRC-32C (Castagnoli) instructions
+ * This value is determined once by libfvde_checksum_initialize
+ */
+static int libfvde_checksum_crc32c_hardware_support = 0;
+
+/* Value to indicate the use of the CRC-32C instructions is disabled
+ */
+static int libfvde_checksum_crc32c_hardware_disabled = 0;
+
+/* The once value of libfvde_checksum_initialize
+ */
+static libfvde_once_t libfvde_checksum_initialize_once = LIBFVDE_ONCE_INITIALIZER;
+
+#if defined( LIBFVDE_HAVE_CRC32C_INSTRUCTIONS )
+
+/* Tables to shift a CRC-32C value over a part of zero bytes
+ * These are used to combine the CRC-32C values of parts that are calculated in parallel
+ */
+static uint32_t libfvde_checksum_crc32c_long_shift_table[ 4 ][ 256 ];
+static uint32_t libfvde_checksum_crc32c_short_shift_table[ 4 ][ 256 ];
+
+/* Initializes a table to shift a CRC-32 value over a number of zero bytes
+ */
+static void libfvde_checksum_initialize_crc32_shift_table(
+             uint32_t shift_table[ 4 ][ 256 ],
+             size_t size )
+{
+	uint32_t bit_values[ 32 ];
+
+	size_t byte_index     = 0;
+	uint32_t checksum     = 0;
+	uint32_t table_index  = 0;
+	uint8_t bit_iterator  = 0;
+	uint8_t table_number  = 0;
+
+	/* Calculate the shifted value of every individual bit
+	 */
+	for( bit_iterator = 0;
+	     bit_iterator < 32;
+	     bit_iterator++ )
+	{
+		checksum = (uint32_t) 1UL << bit_iterator;
+
+		for( byte_index = 0;
+		     byte_index < size;
+		     byte_index++ )
+		{
+			checksum = libfvde_checksum_crc32_table[ 0 ][ checksum & 0x000000ffUL ] ^ ( checksum >> 8 );
+		}
+		bit_values[ bit_iterator ] = checksum;
+	}
+	/* The shift is linear, so the shifted value of a byte is the combination
+	 * of the shifted values of its bits
+	 */
+	for( table_number = 0;
+	     table_number < 4;
+	     table_number++ )
+	{
+		for( table_index = 0;
+		     table_index < 256;
+		     table_index++ )
+		{
+			checksum = 0;
+
+			for( bit_iterator = 0;
+			     bit_iterator < 8;
+			     bit_iterator++ )
+			{
+				if( ( table_index & ( 1 << bit_iterator ) ) != 0 )
+				{
+					checksum ^= bit_values[ ( table_number * 8 ) + bit_iterator ];
+				}
+			}
+			shift_table[ table_number ][ table_index ] = checksum;
+		}
+	}
+}
+
+/* Shifts a CRC-32 value over the number of zero bytes of the shift table
+ */
+#define libfvde_checksum_crc32_shift( shift_table, checksum ) \
+	( shift_table[ 0 ][ checksum & 0x000000ffUL ] \
+	^ shift_table[ 1 ][ ( checksum >> 8 ) & 0x000000ffUL ] \
+	^ shift_table[ 2 ][ ( checksum >> 16 ) & 0x000000ffUL ] \
+	^ shift_table[ 3 ][ checksum >> 24 ] )
+
+/* Determines if the CPU supports the CRC-32C (Castagnoli) instructions
+ * Returns 1 if supported or 0 if not
+ */
+static int libfvde_checksum_crc32c_hardware_is_supported(
+            void )
+{
+#if defined( __aarch64__ )
+	/* The compiler only defines the CRC32 feature macro if the target CPU supports it
+	 */
+	return( 1 );
+#else
+	int cpu_information[ 4 ];
+
+#if defined( _MSC_VER )
+	__cpuid(
+	 cpu_information,
+	 1 );
+#else
+	unsigned int eax = 0;
+	unsigned int ebx = 0;
+	unsigned int ecx = 0;
+	unsigned int edx = 0;
+
+	if( __get_cpuid(
+	     1,
+	     &eax,
+	     &ebx,
+	     &ecx,
+	     &edx ) == 0 )
+	{
+		ecx = 0;
+	}
+	cpu_information[ 2 ] = (int) ecx;
+#endif
+	/* SSE4.2 (ECX bit 20)
+	 */
+	if( ( cpu_information[ 2 ] & 0x00100000UL ) != 0 )
+	{
+		return( 1 );
+	}
+	return( 0 );
+#endif
+}
+
+/* Calculates the CRC-32C of parts of a buffer in parallel
+ * Returns the CRC-32C of the parts and updates the buffer and size
+ */
+#define libfvde_checksum_calculate_crc32c_parts( checksum, buffer, size, part_size, shift_table, checksum1, checksum2, value_64bit, buffer_end ) \
+	while( size >= ( 3 * part_size ) ) \
+	{ \
+		checksum1  = 0; \
+		checksum2  = 0; \
+		buffer_end = &( buffer[ part_size ] ); \
+\
+		do \
+		{ \
+			byte_stream_copy_to_uint64_little_endian( buffer, value_64bit ); \
+			libfvde_checksum_crc32c_update_64bit( checksum, value_64bit ); \
+\
+			byte_stream_copy_to_uint64_little_endian( &( buffer[ part_size ] ), value_64bit ); \
+			libfvde_checksum_crc32c_update_64bit( checksum1, value_64bit ); \
+\
+			byte_stream_copy_to_uint64_little_endian( &( buffer[ 2 * part_size ] ), value_64bit ); \
+			libfvde_checksum_crc32c_update_64bit( checksum2, value_64bit ); \
+\
+			buffer += 8; \
+		} \
+		while( buffer < buffer_end ); \
+\
+		checksum = libfvde_checksum_crc32_shift( shift_table, checksum ) ^ checksum1; \
+		checksum = libfvde_checksum_crc32_shift( shift_table, checksum ) ^ checksum2; \
+\
+		buffer += 2 * part_size; \
+		size   -= 3 * part_size; \
+	}
+
+/* Calculates the CRC-32C (Castagnoli) of a buffer using the CRC-32C instructions of the CPU
+ * The buffer is divided in 3 parts that are calculated in parallel to hide the latency of the instruction
+ * Returns the CRC-32C
+ */
+LIBFVDE_CRC32C_TARGET
+static uint32_t libfvde_checksum_calculate_crc32c_hardware(
+                 uint32_t checksum,
+                 const uint8_t *buffer,
+                 size_t size )
+{
+	const uint8_t *buffer_end = NULL;
+	uint64_t value_64bit      = 0;
+	uint32_t checksum1        = 0;
+	uint32_t checksum2        = 0;
+
+	/* Align the buffer to 8 bytes
+	 */
+	while( ( size > 0 )
+	    && ( ( (intptr_t) buffer & 7 ) != 0 ) )
+	{
+		libfvde_checksum_crc32c_update_8bit(
+		 checksum,
+		 *buffer );
+
+		buffer++;
+		size--;
+	}
+	libfvde_checksum_calculate_crc32c_parts(
+	 checksum,
+	 buffer,
+	 size,
+	 LIBFVDE_CHECKSUM_CRC32C_LONG_PART_SIZE,
+	 libfvde_checksum_crc32c_long_shift_table,
+	 checksum1,
+	 checksum2,
+	 value_64bit,
+	 buffer_end )
+
+	libfvde_checksum_calculate_crc32c_parts(
+	 checksum,
+	 buffer,
+	 size,
+	 LIBFVDE_CHECKSUM_CRC32C_SHORT_PART_SIZE,
+	 libfvde_checksum_crc32c_short_shift_table,
+	 checksum1,
+	 checksum2,
+	 value_64bit,
+	 buffer_end )
+
+	while( size >= 8 )
+	{
+		byte_stream_copy_to_uint64_little_endian(
+		 buffer,
+		 value_64bit );
+
+		libfvde_checksum_crc32c_update_64bit(
+		 checksum,
+		 value_64bit );
+
+		buffer += 8;
+		size   -= 8;
+	}
+	while( size > 0 )
+	{
+		libfvde_checksum_crc32c_update_8bit(
+		 checksum,
+		 *buffer );
+
+		buffer++;
+		size--;
+	}
+	return( checksum );
+}
+
+#endif /* defined( LIBFVDE_HAVE_CRC32C_INSTRUCTIONS ) */
+
+/* Initializes the internal CRC-32 tables
+ * The tables speed up the CRC-32 calculation
  */
 void libfvde_checksum_initialize_crc32_table(
       uint32_t polynomial )
@@ -41,6 +343,7 @@ void libfvde_checksum_initialize_crc32_table(
 	uint32_t checksum    = 0;
 	uint32_t table_index = 0;
 	uint8_t bit_iterator = 0;
+	uint8_t table_number = 0;
 
 	for( table_index = 0;
 	     table_index < 256;
@@ -61,9 +364,98 @@ void libfvde_checksum_initialize_crc32_table(
 				checksum = checksum >> 1;
 			}
 		}
-		libfvde_checksum_crc32_table[ table_index ] = checksum;
+		libfvde_checksum_crc32_table[ 0 ][ table_index ] = checksum;
+	}
+	for( table_number = 1;
+	     table_number < 8;
+	     table_number++ )
+	{
+		for( table_index = 0;
+		     table_index < 256;
+		     table_index++ )
+		{
+			checksum = libfvde_checksum_crc32_table[ table_number - 1 ][ table_index ];
+
+			libfvde_checksum_crc32_table[ table_number ][ table_index ] = libfvde_checksum_crc32_table[ 0 ][ checksum & 0x000000ffUL ] ^ ( checksum >> 8 );
+		}
+	}
+	libfvde_checksum_crc32_table_polynomial = polynomial;
+	libfvde_checksum_crc32_table_computed   = 1;
+}
+
+/* Computes the CRC-32 table and determines if the CPU supports the CRC-32C instructions
+ */
+static void libfvde_checksum_select(
+             void )
+{
+	if( libfvde_checksum_crc32_table_computed == 0 )
+	{
+		libfvde_checksum_initialize_crc32_table(
+		 0x82f63b78UL );
+	}
+#if defined( LIBFVDE_HAVE_CRC32C_INSTRUCTIONS )
+	if( libfvde_checksum_crc32c_hardware_is_supported() != 0 )
+	{
+		libfvde_checksum_initialize_crc32_shift_table(
+		 libfvde_checksum_crc32c_long_shift_table,
+		 LIBFVDE_CHECKSUM_CRC32C_LONG_PART_SIZE );
+
+		libfvde_checksum_initialize_crc32_shift_table(
+		 libfvde_checksum_crc32c_short_shift_table,
+		 LIBFVDE_CHECKSUM_CRC32C_SHORT_PART_SIZE );
+
+		libfvde_checksum_crc32c_hardware_support = 1;
+	}
+#endif
+}
+
+/* Selects the checksum implementation once
+ */
+void libfvde_checksum_initialize(
+      void )
+{
+	libfvde_once_call(
+	 &libfvde_checksum_initialize_once,
+	 &libfvde_checksum_select );
+}
+
+/* Retrieves the name of the CRC-32 implementation that is used
+ * Returns a string containing the name
+ */
+const char *libfvde_checksum_get_implementation_name(
+             void )
+{
+	libfvde_checksum_initialize();
+
+#if defined( LIBFVDE_HAVE_CRC32C_INSTRUCTIONS )
+	if( ( libfvde_checksum_crc32c_hardware_support != 0 )
+	 && ( libfvde_checksum_crc32c_hardware_disabled == 0 )
+	 && ( libfvde_checksum_crc32_table_polynomial == 0x82f63b78UL ) )
+	{
+#if defined( __aarch64__ )
+		return( "armv8-crc32" );
+#else
+		return( "sse4.2" );
+#endif
+	}
+#endif
+	return( "slicing-by-8" );
+}
+
+/* Enables or disables the use of the CRC-32C instructions
+ * This function is intended for testing and benchmarking and should not be called while checksums are being calculated
+ */
+void libfvde_checksum_set_hardware_enabled(
+      int enabled )
+{
+	if( enabled == 0 )
+	{
+		libfvde_checksum_crc32c_hardware_disabled = 1;
+	}
+	else
+	{
+		libfvde_checksum_crc32c_hardware_disabled = 0;
 	}
-	libfvde_checksum_crc32_table_computed = 1;
 }
 
 /* Calculates the weak CRC-32 checksum of a buffer
@@ -78,6 +470,7 @@ int libfvde_checksum_calculate_weak_crc32(
 {
 	static char *function = "libfvde_checkcum_calculate_weak_crc32";
 	size_t buffer_offset  = 0;
+	uint32_t safe_checksum = 0;
 	uint32_t table_index  = 0;
 
 	if( checksum == NULL )
@@ -113,21 +506,55 @@ int libfvde_checksum_calculate_weak_crc32(
 
 		return( -1 );
 	}
-        if( libfvde_checksum_crc32_table_computed == 0 )
+	libfvde_checksum_initialize();
+
+	safe_checksum = initial_value;
+
+#if defined( LIBFVDE_HAVE_CRC32C_INSTRUCTIONS )
+	/* The CRC-32C instructions only support the Castagnoli polynomial
+	 */
+	if( ( libfvde_checksum_crc32c_hardware_support != 0 )
+	 && ( libfvde_checksum_crc32c_hardware_disabled == 0 )
+	 && ( libfvde_checksum_crc32_table_polynomial == 0x82f63b78UL ) )
 	{
-		libfvde_checksum_initialize_crc32_table(
-		 0x82f63b78UL );
+		*checksum = libfvde_checksum_calculate_crc32c_hardware(
+		             safe_checksum,
+		             buffer,
+		             size );
+
+		return( 1 );
 	}
-	*checksum = initial_value;
+#endif
+	/* Calculate the checksum 8 bytes at a time
+	 */
+	while( ( buffer_offset + 8 ) <= size )
+	{
+		safe_checksum ^= (uint32_t) buffer[ buffer_offset ]
+		               | ( (uint32_t) buffer[ buffer_offset + 1 ] << 8 )
+		               | ( (uint32_t) buffer[ buffer_offset + 2 ] << 16 )
+		               | ( (uint32_t) buffer[ buffer_offset + 3 ] << 24 );
 
-        for( buffer_offset = 0;
+		safe_checksum = libfvde_checksum_crc32_table[ 7 ][ safe_checksum & 0x000000ffUL ]
+		              ^ libfvde_checksum_crc32_table[ 6 ][ ( safe_checksum >> 8 ) & 0x000000ffUL ]
+		              ^ libfvde_checksum_crc32_table[ 5 ][ ( safe_checksum >> 16 ) & 0x000000ffUL ]
+		              ^ libfvde_checksum_crc32_table[ 4 ][ safe_checksum >> 24 ]
+		              ^ libfvde_checksum_crc32_table[ 3 ][ buffer[ buffer_offset + 4 ] ]
+		              ^ libfvde_checksum_crc32_table[ 2 ][ buffer[ buffer_offset + 5 ] ]
+		              ^ libfvde_checksum_crc32_table[ 1 ][ buffer[ buffer_offset + 6 ] ]
+		              ^ libfvde_checksum_crc32_table[ 0 ][ buffer[ buffer_offset + 7 ] ];
+
+		buffer_offset += 8;
+	}
+        for( ;
 	     buffer_offset < size;
 	     buffer_offset++ )
 	{
-		table_index = ( *checksum ^ buffer[ buffer_offset ] ) & 0x000000ffUL;
+		table_index = ( safe_checksum ^ buffer[ buffer_offset ] ) & 0x000000ffUL;
 
-		*checksum = libfvde_checksum_crc32_table[ table_index ] ^ ( *checksum >> 8 );
+		safe_checksum = libfvde_checksum_crc32_table[ 0 ][ table_index ] ^ ( safe_checksum >> 8 );
         }
+	*checksum = safe_checksum;
+
 	return( 1 );
 }
 
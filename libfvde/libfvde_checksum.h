@@ -34,6 +34,15 @@ extern "C" {
 void libfvde_checksum_initialize_crc32_table(
       uint32_t polynomial );
 
+void libfvde_checksum_initialize(
+      void );
+
+const char *libfvde_checksum_get_implementation_name(
+             void );
+
+void libfvde_checksum_set_hardware_enabled(
+      int enabled );
+
 int libfvde_checksum_calculate_weak_crc32(
      uint32_t *checksum,
      const uint8_t *buffer,
@@ -0,0 +1,784 @@
+/*
+ * Decryption pool functions
+ *
+ * Copyright (C) 2011-2018, Omar Choudary <choudary.omar@gmail.com>
+ *                          Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfvde_decryption_pool.h"
+#include "libfvde_definitions.h"
+#include "libfvde_libcaes.h"
+#include "libfvde_libcerror.h"
+#include "libfvde_libcnotify.h"
+#include "libfvde_libcthreads.h"
+#include "libfvde_unused.h"
+
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+
+/* Creates a decryption pool
+ * Make sure the value decryption_pool is referencing, is set to NULL
+ * Every thread of the pool decrypts with the XTS context of the job it runs
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_decryption_pool_initialize(
+     libfvde_decryption_pool_t **decryption_pool,
+     int number_of_threads,
+     const uint8_t *key,
+     const uint8_t *tweak_key,
+     libcerror_error_t **error )
+{
+	static char *function = "libfvde_decryption_pool_initialize";
+	int job_index         = 0;
+
+	if( decryption_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid decryption pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *decryption_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid decryption pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads <= 0 )
+	 || ( number_of_threads > LIBFVDE_MAXIMUM_NUMBER_OF_DECRYPTION_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key.",
+		 function );
+
+		return( -1 );
+	}
+	if( tweak_key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tweak key.",
+		 function );
+
+		return( -1 );
+	}
+	*decryption_pool = memory_allocate_structure(
+	                    libfvde_decryption_pool_t );
+
+	if( *decryption_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create decryption pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *decryption_pool,
+	     0,
+	     sizeof( libfvde_decryption_pool_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear decryption pool.",
+		 function );
+
+		memory_free(
+		 *decryption_pool );
+
+		*decryption_pool = NULL;
+
+		return( -1 );
+	}
+	( *decryption_pool )->number_of_threads = number_of_threads;
+
+	for( job_index = 0;
+	     job_index < number_of_threads;
+	     job_index++ )
+	{
+		( *decryption_pool )->jobs[ job_index ].decryption_pool = *decryption_pool;
+
+		if( libcaes_tweaked_context_initialize(
+		     &( ( *decryption_pool )->jobs[ job_index ].xts_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create job: %d XTS context.",
+			 function,
+			 job_index );
+
+			goto on_error;
+		}
+		if( libcaes_tweaked_context_set_keys(
+		     ( *decryption_pool )->jobs[ job_index ].xts_context,
+		     LIBCAES_CRYPT_MODE_DECRYPT,
+		     key,
+		     128,
+		     tweak_key,
+		     128,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set keys in job: %d XTS context.",
+			 function,
+			 job_index );
+
+			goto on_error;
+		}
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *decryption_pool )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *decryption_pool )->condition_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *decryption_pool )->condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_thread_pool_create(
+	     &( ( *decryption_pool )->thread_pool ),
+	     NULL,
+	     number_of_threads,
+	     number_of_threads,
+	     (int (*)(intptr_t *, void *)) &libfvde_decryption_pool_job_callback,
+	     NULL,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *decryption_pool != NULL )
+	{
+		libfvde_decryption_pool_free(
+		 decryption_pool,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a decryption pool
+ * Joins the threads of the pool if they were started
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_decryption_pool_free(
+     libfvde_decryption_pool_t **decryption_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "libfvde_decryption_pool_free";
+	int job_index         = 0;
+	int result            = 1;
+
+	if( decryption_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid decryption pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *decryption_pool != NULL )
+	{
+		if( ( *decryption_pool )->thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *decryption_pool )->thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *decryption_pool )->condition != NULL )
+		{
+			if( libcthreads_condition_free(
+			     &( ( *decryption_pool )->condition ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free condition.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *decryption_pool )->condition_mutex != NULL )
+		{
+			if( libcthreads_mutex_free(
+			     &( ( *decryption_pool )->condition_mutex ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free condition mutex.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *decryption_pool )->mutex != NULL )
+		{
+			if( libcthreads_mutex_free(
+			     &( ( *decryption_pool )->mutex ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free mutex.",
+				 function );
+
+				result = -1;
+			}
+		}
+		for( job_index = 0;
+		     job_index < LIBFVDE_MAXIMUM_NUMBER_OF_DECRYPTION_THREADS;
+		     job_index++ )
+		{
+			if( ( *decryption_pool )->jobs[ job_index ].xts_context != NULL )
+			{
+				if( libcaes_tweaked_context_free(
+				     &( ( *decryption_pool )->jobs[ job_index ].xts_context ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free job: %d XTS context.",
+					 function,
+					 job_index );
+
+					result = -1;
+				}
+			}
+		}
+		memory_free(
+		 *decryption_pool );
+
+		*decryption_pool = NULL;
+	}
+	return( result );
+}
+
+/* Decrypts the data of a job, this function is called by a thread of the thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_decryption_pool_job_callback(
+     libfvde_decryption_job_t *decryption_job,
+     void *arguments LIBFVDE_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error                   = NULL;
+	libfvde_decryption_pool_t *decryption_pool = NULL;
+	static char *function                      = "libfvde_decryption_pool_job_callback";
+	int result                                 = 1;
+
+	LIBFVDE_UNREFERENCED_PARAMETER( arguments )
+
+	if( decryption_job == NULL )
+	{
+		return( -1 );
+	}
+	decryption_pool = decryption_job->decryption_pool;
+
+	if( decryption_pool == NULL )
+	{
+		return( -1 );
+	}
+	if( libcaes_crypt_xts_data_units(
+	     decryption_job->xts_context,
+	     LIBCAES_CRYPT_MODE_DECRYPT,
+	     decryption_job->data_unit_number,
+	     decryption_job->data_unit_size,
+	     decryption_job->data,
+	     decryption_job->data_size,
+	     decryption_job->data,
+	     decryption_job->data_size,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+		 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+		 "%s: unable to decrypt data.",
+		 function );
+
+		result = -1;
+	}
+	/* The reading thread waits for the number of pending jobs to reach 0
+	 */
+	if( libcthreads_mutex_grab(
+	     decryption_pool->condition_mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab condition mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( result != 1 )
+	{
+		decryption_pool->number_of_failed_jobs += 1;
+	}
+	decryption_pool->number_of_pending_jobs -= 1;
+
+	if( libcthreads_condition_broadcast(
+	     decryption_pool->condition,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to broadcast condition.",
+		 function );
+
+		result = -1;
+	}
+	if( libcthreads_mutex_release(
+	     decryption_pool->condition_mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release condition mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( error != NULL )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( result );
+
+on_error:
+	if( error != NULL )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+/* Decrypts data in place using the threads of the decryption pool
+ * The data is divided into chunks of consecutive data units, the last chunk
+ * is decrypted by the calling thread using the XTS context provided
+ * Returns 1 if successful, 0 if the decryption pool is in use or -1 on error
+ */
+int libfvde_decryption_pool_decrypt(
+     libfvde_decryption_pool_t *decryption_pool,
+     libcaes_tweaked_context_t *xts_context,
+     uint64_t data_unit_number,
+     size_t data_unit_size,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	libfvde_decryption_job_t *decryption_job = NULL;
+	static char *function                    = "libfvde_decryption_pool_decrypt";
+	size_t chunk_size                        = 0;
+	size_t data_offset                       = 0;
+	uint64_t number_of_data_units            = 0;
+	uint64_t number_of_chunk_data_units      = 0;
+	uint64_t remaining_number_of_data_units  = 0;
+	int job_index                            = 0;
+	int number_of_chunks                     = 0;
+	int number_of_jobs                       = 0;
+	int result                               = 1;
+
+	if( decryption_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid decryption pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( xts_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid XTS context.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_unit_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid data unit size value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size == 0 )
+	 || ( data_size > (size_t) SSIZE_MAX )
+	 || ( ( data_size % data_unit_size ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* Only a single read at a time uses the jobs, another read
+	 * that wants to use the pool in the meantime decrypts by itself
+	 */
+	result = libcthreads_mutex_try_grab(
+	          decryption_pool->mutex,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	number_of_data_units = (uint64_t) ( data_size / data_unit_size );
+	number_of_chunks     = decryption_pool->number_of_threads + 1;
+
+	if( number_of_data_units < (uint64_t) number_of_chunks )
+	{
+		number_of_chunks = (int) number_of_data_units;
+	}
+	number_of_jobs                 = number_of_chunks - 1;
+	remaining_number_of_data_units = number_of_data_units;
+
+	if( libcthreads_mutex_grab(
+	     decryption_pool->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab condition mutex.",
+		 function );
+
+		goto on_error;
+	}
+	decryption_pool->number_of_pending_jobs = number_of_jobs;
+	decryption_pool->number_of_failed_jobs  = 0;
+
+	if( libcthreads_mutex_release(
+	     decryption_pool->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release condition mutex.",
+		 function );
+
+		goto on_error;
+	}
+	result = 1;
+
+	for( job_index = 0;
+	     job_index < number_of_jobs;
+	     job_index++ )
+	{
+		number_of_chunk_data_units = remaining_number_of_data_units / (uint64_t) ( number_of_chunks - job_index );
+		chunk_size                 = (size_t) number_of_chunk_data_units * data_unit_size;
+
+		decryption_job = &( decryption_pool->jobs[ job_index ] );
+
+		decryption_job->data_unit_number = data_unit_number;
+		decryption_job->data_unit_size   = data_unit_size;
+		decryption_job->data             = &( data[ data_offset ] );
+		decryption_job->data_size        = chunk_size;
+
+		if( libcthreads_thread_pool_push(
+		     decryption_pool->thread_pool,
+		     (intptr_t *) decryption_job,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push job: %d onto thread pool.",
+			 function,
+			 job_index );
+
+			result = -1;
+
+			break;
+		}
+		data_unit_number               += number_of_chunk_data_units;
+		data_offset                    += chunk_size;
+		remaining_number_of_data_units -= number_of_chunk_data_units;
+	}
+	if( result == 1 )
+	{
+		if( libcaes_crypt_xts_data_units(
+		     xts_context,
+		     LIBCAES_CRYPT_MODE_DECRYPT,
+		     data_unit_number,
+		     data_unit_size,
+		     &( data[ data_offset ] ),
+		     data_size - data_offset,
+		     &( data[ data_offset ] ),
+		     data_size - data_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+			 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+			 "%s: unable to decrypt data.",
+			 function );
+
+			result = -1;
+		}
+	}
+	/* The jobs that were pushed reference the data hence they
+	 * need to complete before returning, also on error
+	 */
+	if( libcthreads_mutex_grab(
+	     decryption_pool->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab condition mutex.",
+		 function );
+
+		goto on_error;
+	}
+	decryption_pool->number_of_pending_jobs -= number_of_jobs - job_index;
+
+	while( decryption_pool->number_of_pending_jobs > 0 )
+	{
+		if( libcthreads_condition_wait(
+		     decryption_pool->condition,
+		     decryption_pool->condition_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to wait for condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 decryption_pool->condition_mutex,
+			 NULL );
+
+			goto on_error;
+		}
+	}
+	if( decryption_pool->number_of_failed_jobs != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+		 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+		 "%s: unable to decrypt data of: %d jobs.",
+		 function,
+		 decryption_pool->number_of_failed_jobs );
+
+		result = -1;
+	}
+	if( libcthreads_mutex_release(
+	     decryption_pool->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release condition mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_release(
+	     decryption_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+
+on_error:
+	libcthreads_mutex_release(
+	 decryption_pool->mutex,
+	 NULL );
+
+	return( -1 );
+}
+
+#endif /* defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,137 @@
+/*
+ * Decryption pool functions
+ *
+ * Copyright (C) 2011-2018, Omar Choudary <choudary.omar@gmail.com>
+ *                          Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFVDE_DECRYPTION_POOL_H )
+#define _LIBFVDE_DECRYPTION_POOL_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfvde_definitions.h"
+#include "libfvde_libcaes.h"
+#include "libfvde_libcerror.h"
+#include "libfvde_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfvde_decryption_pool libfvde_decryption_pool_t;
+
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+
+typedef struct libfvde_decryption_job libfvde_decryption_job_t;
+
+struct libfvde_decryption_job
+{
+	/* The decryption pool
+	 */
+	libfvde_decryption_pool_t *decryption_pool;
+
+	/* The XTS context
+	 */
+	libcaes_tweaked_context_t *xts_context;
+
+	/* The data unit number of the first data unit
+	 */
+	uint64_t data_unit_number;
+
+	/* The data unit size
+	 */
+	size_t data_unit_size;
+
+	/* The data
+	 */
+	uint8_t *data;
+
+	/* The data size
+	 */
+	size_t data_size;
+};
+
+struct libfvde_decryption_pool
+{
+	/* The number of threads
+	 */
+	int number_of_threads;
+
+	/* The jobs, every job has its own XTS context
+	 */
+	libfvde_decryption_job_t jobs[ LIBFVDE_MAXIMUM_NUMBER_OF_DECRYPTION_THREADS ];
+
+	/* The number of jobs that have not completed
+	 */
+	int number_of_pending_jobs;
+
+	/* The number of jobs that failed
+	 */
+	int number_of_failed_jobs;
+
+	/* The mutex that allows a single read to use the jobs at a time
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The mutex that protects the number of pending and failed jobs
+	 */
+	libcthreads_mutex_t *condition_mutex;
+
+	/* The condition that signals the completion of a job
+	 */
+	libcthreads_condition_t *condition;
+
+	/* The thread pool
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+};
+
+int libfvde_decryption_pool_initialize(
+     libfvde_decryption_pool_t **decryption_pool,
+     int number_of_threads,
+     const uint8_t *key,
+     const uint8_t *tweak_key,
+     libcerror_error_t **error );
+
+int libfvde_decryption_pool_free(
+     libfvde_decryption_pool_t **decryption_pool,
+     libcerror_error_t **error );
+
+int libfvde_decryption_pool_job_callback(
+     libfvde_decryption_job_t *decryption_job,
+     void *arguments );
+
+int libfvde_decryption_pool_decrypt(
+     libfvde_decryption_pool_t *decryption_pool,
+     libcaes_tweaked_context_t *xts_context,
+     uint64_t data_unit_number,
+     size_t data_unit_size,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFVDE_DECRYPTION_POOL_H ) */
+
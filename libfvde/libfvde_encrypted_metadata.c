@@ -29,6 +29,7 @@
 
 #include "libfvde_checksum.h"
 #include "libfvde_data_area_descriptor.h"
+#include "libfvde_decryption_pool.h"
 #include "libfvde_definitions.h"
 #include "libfvde_encrypted_metadata.h"
 #include "libfvde_encryption_context_plist.h"
@@ -42,8 +43,10 @@
 #include "libfvde_libfplist.h"
 #include "libfvde_libfvalue.h"
 #include "libfvde_metadata_block.h"
+#include "libfvde_passphrase_wrapped_kek.h"
 #include "libfvde_password.h"
 #include "libfvde_segment_descriptor.h"
+#include "libfvde_unused.h"
 
 #include "fvde_metadata.h"
 
@@ -2032,6 +2035,8 @@ int libfvde_encrypted_metadata_read_type_0x001a(
 
 			goto on_error;
 		}
+		encrypted_metadata->logical_volume_family_identifier_is_set = 1;
+
 		if( libfplist_property_free(
 		     &sub_property,
 		     error ) != 1 )
@@ -3219,7 +3224,8 @@ int libfvde_encrypted_metadata_read_type_0x0305(
 #endif
 	block_data_offset = 8;
 
-	/* Use the most recent 0x0305 metadata block
+	/* Use the most recent 0x0305 metadata blocks, the segment descriptors
+	 * can be stored in multiple metadata blocks of the same group
 	 */
 	if( encrypted_metadata->block_group_0x0305 < block_group )
 	{
@@ -3237,6 +3243,9 @@ int libfvde_encrypted_metadata_read_type_0x0305(
 
 			goto on_error;
 		}
+		encrypted_metadata->block_group_0x0305                     = block_group;
+		encrypted_metadata->logical_volume_block_number_0x0305     = 0;
+		encrypted_metadata->logical_volume_number_of_blocks_0x0305 = 0;
 	}
 	if( number_of_entries > 0 )
 	{
@@ -3352,7 +3361,7 @@ int libfvde_encrypted_metadata_read_type_0x0305(
 #endif
 			block_data_offset += 40;
 
-			if( encrypted_metadata->block_group_0x0305 < block_group )
+			if( encrypted_metadata->block_group_0x0305 == block_group )
 			{
 				if( libcdata_array_append_entry(
 				     encrypted_metadata->segment_descriptors,
@@ -3393,15 +3402,16 @@ int libfvde_encrypted_metadata_read_type_0x0305(
 				}
 			}
 		}
-		if( encrypted_metadata->block_group_0x0305 < block_group )
+		/* The logical volume is described by all the segments of the group
+		 */
+		if( encrypted_metadata->block_group_0x0305 == block_group )
 		{
-			if( number_of_entries == 1 )
+			if( ( encrypted_metadata->logical_volume_number_of_blocks_0x0305 == 0 )
+			 || ( encrypted_metadata->logical_volume_block_number_0x0305 > block_number ) )
 			{
-				encrypted_metadata->logical_volume_block_number_0x0305     = block_number;
-				encrypted_metadata->logical_volume_number_of_blocks_0x0305 = number_of_blocks;
-
-				encrypted_metadata->block_group_0x0305 = block_group;
+				encrypted_metadata->logical_volume_block_number_0x0305 = block_number;
 			}
+			encrypted_metadata->logical_volume_number_of_blocks_0x0305 += number_of_blocks;
 		}
 	}
 	return( 1 );
@@ -4088,30 +4098,75 @@ int libfvde_encrypted_metadata_read_type_0x0505(
 	return( 1 );
 }
 
+/* Retrieves the parse profile flag of a metadata block type
+ * Returns the parse profile flag
+ */
+uint8_t libfvde_encrypted_metadata_get_parse_profile_flag(
+     uint16_t block_type )
+{
+	switch( block_type )
+	{
+		case 0x0019:
+		case 0x001a:
+			return( LIBFVDE_PARSE_PROFILE_FLAG_KEYS );
+
+		case 0x0304:
+		case 0x0305:
+		case 0x0404:
+		case 0x0405:
+		case 0x0505:
+			return( LIBFVDE_PARSE_PROFILE_FLAG_LAYOUT );
+
+		default:
+			break;
+	}
+	return( LIBFVDE_PARSE_PROFILE_FLAG_OTHER );
+}
+
 /* Reads the encrypted metadata
+ * The blocks of a window are decrypted in parallel if a decryption pool is provided,
+ * the decrypted blocks are read in order by the calling thread
+ * Only the block types of the parse profile are read, if only the keys are read
+ * the reading stops once the encryption context and logical volume family identifier are set
  * Returns 1 if successful or -1 on error
  */
 int libfvde_encrypted_metadata_read(
      libfvde_encrypted_metadata_t *encrypted_metadata,
      libfvde_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
+     libfvde_decryption_pool_t *decryption_pool LIBFVDE_ATTRIBUTE_UNUSED,
      off64_t file_offset,
      uint64_t encrypted_metadata_size,
+     uint8_t parse_profile,
      libcerror_error_t **error )
 {
+	uint8_t block_is_empty[ LIBFVDE_ENCRYPTED_METADATA_WINDOW_SIZE / 8192 ];
 	uint8_t tweak_value[ 16 ];
 
 	libcaes_tweaked_context_t *xts_context   = NULL;
 	libfvde_metadata_block_t *metadata_block = NULL;
+	uint8_t *block_data                      = NULL;
 	uint8_t *encrypted_metadata_data         = NULL;
 	uint8_t *encrypted_data                  = NULL;
 	uint8_t *metadata_block_data             = NULL;
 	static char *function                    = "libfvde_encrypted_metadata_read";
+	size_t block_index                       = 0;
+	size_t data_offset                       = 0;
+	size_t read_size                         = 0;
+	size_t window_size                       = 0;
 	ssize_t read_count                       = 0;
 	uint64_t calculated_block_number         = 0;
-	uint8_t empty_block_found                = 0;
+	uint8_t window_is_decrypted              = 0;
 	int result                               = 0;
 
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	size_t number_of_decrypt_blocks          = 0;
+#endif
+
+#if !defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	LIBFVDE_UNREFERENCED_PARAMETER( decryption_pool )
+#endif
+
 	if( encrypted_metadata == NULL )
 	{
 		libcerror_error_set(
@@ -4182,8 +4237,17 @@ int libfvde_encrypted_metadata_read(
 
 		goto on_error;
 	}
+	/* The encrypted metadata is read and decrypted in windows
+	 * so that the data after the last metadata block is not read
+	 */
+	window_size = LIBFVDE_ENCRYPTED_METADATA_WINDOW_SIZE;
+
+	if( (uint64_t) window_size > encrypted_metadata_size )
+	{
+		window_size = (size_t) encrypted_metadata_size;
+	}
 	encrypted_data = (uint8_t *) memory_allocate(
-	                              sizeof( uint8_t ) * (size_t) encrypted_metadata_size );
+	                              sizeof( uint8_t ) * window_size );
 
 	if( encrypted_data == NULL )
 	{
@@ -4196,23 +4260,6 @@ int libfvde_encrypted_metadata_read(
 
 		goto on_error;
 	}
-	read_count = libbfio_handle_read_buffer(
-	              file_io_handle,
-	              encrypted_data,
-	              (size_t) encrypted_metadata_size,
-	              error );
-
-	if( read_count != (ssize_t) encrypted_metadata_size )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read encrypted metadata.",
-		 function );
-
-		goto on_error;
-	}
 	if( libcaes_tweaked_context_initialize(
 	     &xts_context,
 	     error ) == -1 )
@@ -4258,8 +4305,6 @@ int libfvde_encrypted_metadata_read(
 
 		goto on_error;
 	}
-	encrypted_metadata_data = encrypted_data;
-
 /* TODO move data allocation into metadata_block? */
 	if( libfvde_metadata_block_initialize(
 	     &metadata_block,
@@ -4274,76 +4319,161 @@ int libfvde_encrypted_metadata_read(
 
 		goto on_error;
 	}
-	while( encrypted_metadata_size > 0 )
+	while( encrypted_metadata_size >= 8192 )
 	{
-		result = libfvde_metadata_block_check_for_empty_block(
-			  encrypted_metadata_data,
-			  8192,
-			  error );
-
-		if( result == -1 )
+		if( data_offset >= read_size )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine if encrypted medadata block data is empty.",
-			 function );
+			read_size = window_size;
 
-			return( -1 );
-		}
-		else if( result != 0 )
-		{
-			empty_block_found = 1;
+			if( (uint64_t) read_size > encrypted_metadata_size )
+			{
+				read_size = (size_t) encrypted_metadata_size;
+			}
+			read_size -= read_size % 8192;
+
+			read_count = libbfio_handle_read_buffer(
+			              file_io_handle,
+			              encrypted_data,
+			              read_size,
+			              error );
+
+			if( read_count != (ssize_t) read_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read encrypted metadata.",
+				 function );
+
+				goto on_error;
+			}
+			data_offset = 0;
+
+			/* Determine which blocks of the window are empty before the blocks
+			 * are decrypted in place, up to the first empty block
+			 */
+			for( block_index = 0;
+			     block_index < ( read_size / 8192 );
+			     block_index++ )
+			{
+				result = libfvde_metadata_block_check_for_empty_block(
+					  &( encrypted_data[ block_index * 8192 ] ),
+					  8192,
+					  error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to determine if encrypted medadata block data is empty.",
+					 function );
+
+					goto on_error;
+				}
+				block_is_empty[ block_index ] = (uint8_t) result;
+
+				if( result != 0 )
+				{
+					break;
+				}
+			}
+			window_is_decrypted = 0;
+
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+			/* The blocks before the first empty block are decrypted
+			 */
+			number_of_decrypt_blocks = block_index;
+
+			if( ( decryption_pool != NULL )
+			 && ( number_of_decrypt_blocks > 1 ) )
+			{
+				result = libfvde_decryption_pool_decrypt(
+				          decryption_pool,
+				          xts_context,
+				          calculated_block_number,
+				          8192,
+				          encrypted_data,
+				          number_of_decrypt_blocks * 8192,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+					 LIBCERROR_ENCRYPTION_ERROR_DECRYPT_FAILED,
+					 "%s: unable to decrypt metadata data blocks using decryption pool.",
+					 function );
+
+					goto on_error;
+				}
+				window_is_decrypted = (uint8_t) result;
+			}
+#endif
 		}
-		else if( empty_block_found != 0 )
+		encrypted_metadata_data = &( encrypted_data[ data_offset ] );
+
+		/* The metadata blocks end at the first empty block
+		 */
+		if( block_is_empty[ data_offset / 8192 ] != 0 )
 		{
 			break;
 		}
 		else
 		{
-			if( memory_set(
-			     tweak_value,
-			     0,
-			     16 ) == NULL )
+			if( window_is_decrypted != 0 )
 			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_MEMORY,
-				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-				 "%s: unable to copy block number to tweak value.",
-				 function );
-
-				return( -1 );
+				block_data = encrypted_metadata_data;
 			}
-			byte_stream_copy_from_uint64_little_endian(
-			 tweak_value,
-			 calculated_block_number );
-
-			if( libcaes_crypt_xts(
-			     xts_context,
-			     LIBCAES_CRYPT_MODE_DECRYPT,
-			     tweak_value,
-			     16,
-			     encrypted_metadata_data,
-			     8192,
-			     metadata_block_data,
-			     8192,
-			     error ) == -1 )
+			else
 			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
-				 LIBCERROR_ENCRYPTION_ERROR_DECRYPT_FAILED,
-				 "%s: unable to decrypt metadata data block: %" PRIu64 " data.",
-				 function,
+				if( memory_set(
+				     tweak_value,
+				     0,
+				     16 ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+					 "%s: unable to copy block number to tweak value.",
+					 function );
+
+					goto on_error;
+				}
+				byte_stream_copy_from_uint64_little_endian(
+				 tweak_value,
 				 calculated_block_number );
 
-				goto on_error;
+				if( libcaes_crypt_xts(
+				     xts_context,
+				     LIBCAES_CRYPT_MODE_DECRYPT,
+				     tweak_value,
+				     16,
+				     encrypted_metadata_data,
+				     8192,
+				     metadata_block_data,
+				     8192,
+				     error ) == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+					 LIBCERROR_ENCRYPTION_ERROR_DECRYPT_FAILED,
+					 "%s: unable to decrypt metadata data block: %" PRIu64 " data.",
+					 function,
+					 calculated_block_number );
+
+					goto on_error;
+				}
+				block_data = metadata_block_data;
 			}
 			if( libfvde_metadata_block_read_data(
 			     metadata_block,
-			     metadata_block_data,
+			     block_data,
 			     8192,
 			     error ) != 1 )
 			{
@@ -4356,7 +4486,8 @@ int libfvde_encrypted_metadata_read(
 
 				goto on_error;
 			}
-			if( metadata_block->is_lvf_wiped == 0 )
+			if( ( metadata_block->is_lvf_wiped == 0 )
+			 && ( ( parse_profile & libfvde_encrypted_metadata_get_parse_profile_flag( metadata_block->type ) ) != 0 ) )
 			{
 #if defined( HAVE_DEBUG_OUTPUT )
 				if( ( libcnotify_verbose != 0 )
@@ -4545,8 +4676,14 @@ int libfvde_encrypted_metadata_read(
 					goto on_error;
 				}
 			}
+			if( ( parse_profile == LIBFVDE_PARSE_PROFILE_KEYS_ONLY )
+			 && ( encrypted_metadata->encryption_context_plist_file_is_set != 0 )
+			 && ( encrypted_metadata->logical_volume_family_identifier_is_set != 0 ) )
+			{
+				break;
+			}
 		}
-		encrypted_metadata_data += 8192;
+		data_offset             += 8192;
 		encrypted_metadata_size -= 8192;
 
 		calculated_block_number += 1;
@@ -4613,28 +4750,49 @@ int libfvde_encrypted_metadata_read(
 
 		goto on_error;
 	}
+	/* The window can contain decrypted metadata
+	 */
+	if( memory_set(
+	     encrypted_data,
+	     0,
+	     window_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear encrypted metadata.",
+		 function );
+
+		goto on_error;
+	}
 	memory_free(
 	 encrypted_data );
 
 	encrypted_data = NULL;
 
-	if( encrypted_metadata->logical_volume_number_of_blocks_0x0505 != 0 )
-	{
-		encrypted_metadata->logical_volume_offset = encrypted_metadata->logical_volume_block_number_0x0505;
-		encrypted_metadata->logical_volume_size   = encrypted_metadata->logical_volume_number_of_blocks_0x0505;
-	}
-	else if( encrypted_metadata->logical_volume_number_of_blocks_0x0305 != 0 )
-	{
-		encrypted_metadata->logical_volume_offset = encrypted_metadata->logical_volume_block_number_0x0305;
-		encrypted_metadata->logical_volume_size   = encrypted_metadata->logical_volume_number_of_blocks_0x0305;
-	}
-	else if( encrypted_metadata->logical_volume_number_of_blocks_0x0405 != 0 )
+	/* The logical volume values are only determined when the layout blocks are read
+	 */
+	if( ( parse_profile & LIBFVDE_PARSE_PROFILE_FLAG_LAYOUT ) != 0 )
 	{
-		encrypted_metadata->logical_volume_offset = encrypted_metadata->logical_volume_block_number_0x0405;
-		encrypted_metadata->logical_volume_size   = encrypted_metadata->logical_volume_number_of_blocks_0x0405;
+		if( encrypted_metadata->logical_volume_number_of_blocks_0x0505 != 0 )
+		{
+			encrypted_metadata->logical_volume_offset = encrypted_metadata->logical_volume_block_number_0x0505;
+			encrypted_metadata->logical_volume_size   = encrypted_metadata->logical_volume_number_of_blocks_0x0505;
+		}
+		else if( encrypted_metadata->logical_volume_number_of_blocks_0x0305 != 0 )
+		{
+			encrypted_metadata->logical_volume_offset = encrypted_metadata->logical_volume_block_number_0x0305;
+			encrypted_metadata->logical_volume_size   = encrypted_metadata->logical_volume_number_of_blocks_0x0305;
+		}
+		else if( encrypted_metadata->logical_volume_number_of_blocks_0x0405 != 0 )
+		{
+			encrypted_metadata->logical_volume_offset = encrypted_metadata->logical_volume_block_number_0x0405;
+			encrypted_metadata->logical_volume_size   = encrypted_metadata->logical_volume_number_of_blocks_0x0405;
+		}
+		encrypted_metadata->logical_volume_offset *= io_handle->block_size;
+		encrypted_metadata->logical_volume_size   *= io_handle->block_size;
 	}
-	encrypted_metadata->logical_volume_offset *= io_handle->block_size;
-	encrypted_metadata->logical_volume_size   *= io_handle->block_size;
 
 	return( 1 );
 
@@ -4670,6 +4828,10 @@ on_error:
 	}
 	if( encrypted_data != NULL )
 	{
+		memory_set(
+		 encrypted_data,
+		 0,
+		 window_size );
 		memory_free(
 		 encrypted_data );
 	}
@@ -4691,6 +4853,96 @@ static inline void hex_encode(unsigned char *str, int len, unsigned char *out)
 }
 /* fvde2john hack ends */
 
+/* Retrieves a specific passphrase wrapped KEK from the encryption context plist
+ * Returns 1 if successful, 0 if no such passphrase wrapped KEK or -1 on error
+ */
+int libfvde_encrypted_metadata_get_passphrase_wrapped_kek(
+     libfvde_encryption_context_plist_t *encryption_context_plist,
+     int passphrase_wrapped_kek_index,
+     libfvde_passphrase_wrapped_kek_t *passphrase_wrapped_kek,
+     libcerror_error_t **error )
+{
+	uint8_t *passphrase_wrapped_kek_data    = NULL;
+	static char *function                   = "libfvde_encrypted_metadata_get_passphrase_wrapped_kek";
+	size_t passphrase_wrapped_kek_data_size = 0;
+	int result                              = 0;
+
+	if( passphrase_wrapped_kek == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid passphrase wrapped KEK.",
+		 function );
+
+		return( -1 );
+	}
+	result = libfvde_encryption_context_plist_get_passphrase_wrapped_kek(
+	          encryption_context_plist,
+	          passphrase_wrapped_kek_index,
+	          &passphrase_wrapped_kek_data,
+	          &passphrase_wrapped_kek_data_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to retrieve passphrase wrapped KEK: %d from encryption context plist.",
+		 function,
+		 passphrase_wrapped_kek_index );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( passphrase_wrapped_kek_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing passphrase wrapped KEK: %d.",
+		 function,
+		 passphrase_wrapped_kek_index );
+
+		goto on_error;
+	}
+	if( libfvde_passphrase_wrapped_kek_read_data(
+	     passphrase_wrapped_kek,
+	     passphrase_wrapped_kek_data,
+	     passphrase_wrapped_kek_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read passphrase wrapped KEK: %d.",
+		 function,
+		 passphrase_wrapped_kek_index );
+
+		goto on_error;
+	}
+	memory_free(
+	 passphrase_wrapped_kek_data );
+
+	return( 1 );
+
+on_error:
+	if( passphrase_wrapped_kek_data != NULL )
+	{
+		memory_free(
+		 passphrase_wrapped_kek_data );
+	}
+	return( -1 );
+}
+
 /* Retrieves the volume master key
  * Returns 1 if successful, 0 in not or -1 on error
  */
@@ -4705,22 +4957,17 @@ int libfvde_encrypted_metadata_get_volume_master_key(
 	uint8_t volume_key_wrapped_kek[ 24 ];
 	uint8_t volume_master_key_wrapped_kek[ 24 ];
 
-	uint8_t *kek_wrapped_volume_key    = NULL;
-	uint8_t *passphrase_wrapped_kek    = NULL;
-	static char *function              = "libfvde_encrypted_metadata_get_volume_master_key";
-	size_t kek_wrapped_volume_key_size = 0;
-	size_t passphrase_wrapped_kek_size = 0;
-	uint32_t number_of_iterations      = 0;
-	uint32_t value_size                = 0;
-	uint32_t value_type                = 0;
-	int found_key                      = 0;
-	int passphrase_wrapped_kek_index   = 0;
-	int result                         = 0;
+	libcaes_context_t *aes_context                           = NULL;
+	libfvde_passphrase_wrapped_kek_t *passphrase_wrapped_kek = NULL;
+	uint8_t *kek_wrapped_volume_key                          = NULL;
+	static char *function                                    = "libfvde_encrypted_metadata_get_volume_master_key";
+	size_t kek_wrapped_volume_key_size                       = 0;
+	int found_key                                            = 0;
+	int passphrase_wrapped_kek_index                         = 0;
+	int result                                               = 0;
 
 	/* fvde2john hack */
 	unsigned char salt_hex[32+1] = {0};
-	unsigned int salt_len = 0;
-	unsigned int iterations;
 	unsigned char wrapped_kek_hex[48+1] = {0};
 
 	if( metadata == NULL )
@@ -4770,22 +5017,49 @@ int libfvde_encrypted_metadata_get_volume_master_key(
 	if( ( io_handle->user_password_is_set != 0 )
 	 || ( io_handle->recovery_password_is_set != 0 ) )
 	{
+		if( libfvde_passphrase_wrapped_kek_initialize(
+		     &passphrase_wrapped_kek,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create passphrase wrapped KEK.",
+			 function );
+
+			goto on_error;
+		}
+		/* The same AES context is used to unwrap all keys
+		 */
+		if( libcaes_context_initialize(
+		     &aes_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize AES context.",
+			 function );
+
+			goto on_error;
+		}
 		do
 		{
-			result = libfvde_encryption_context_plist_get_passphrase_wrapped_kek(
+			result = libfvde_encrypted_metadata_get_passphrase_wrapped_kek(
 			          encryption_context_plist,
 			          passphrase_wrapped_kek_index,
-			          &passphrase_wrapped_kek,
-			          &passphrase_wrapped_kek_size,
+			          passphrase_wrapped_kek,
 			          error );
 
 			if( result == -1 )
 			{
 				libcerror_error_set(
 				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_GENERIC,
-				 "%s: unable to retrieve passphrase wrapped KEK: %d from encryption context plist.",
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve passphrase wrapped KEK: %d.",
 				 function,
 				 passphrase_wrapped_kek_index );
 
@@ -4795,113 +5069,19 @@ int libfvde_encrypted_metadata_get_volume_master_key(
 			{
 				break;
 			}
-			if( passphrase_wrapped_kek == NULL )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-				 "%s: missing passphrase wrapped KEK: %d.",
-				 function,
-				 passphrase_wrapped_kek_index );
-
-				goto on_error;
-			}
-			if( passphrase_wrapped_kek_size != 284 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-				 "%s: invalid passphrase wrapped KEK: %d size value out of bounds.",
-				 function,
-				 passphrase_wrapped_kek_index );
-
-				goto on_error;
-			}
-			byte_stream_copy_to_uint32_little_endian(
-			 &( passphrase_wrapped_kek[ 0 ] ),
-			 value_type );
-
-			byte_stream_copy_to_uint32_little_endian(
-			 &( passphrase_wrapped_kek[ 4 ] ),
-			 value_size );
-
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( libcnotify_verbose != 0 )
-			{
-				libcnotify_printf(
-				 "%s: value type\t\t: 0x%08" PRIx32 "\n",
-				 function,
-				 value_type );
-
-				libcnotify_printf(
-				 "%s: value size\t\t: %" PRIu32 "\n",
-				 function,
-				 value_size );
-			}
-#endif
-			if( value_type != 0x00000003UL )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-				 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-				 "%s: unsupported value type.",
-				 function );
-
-				goto on_error;
-			}
-			if( value_size != 16 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-				 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-				 "%s: unsupported value size.",
-				 function );
-
-				goto on_error;
-			}
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( libcnotify_verbose != 0 )
-			{
-				libcnotify_printf(
-				 "%s: salt:\n",
-				 function );
-				libcnotify_print_data(
-				 &( passphrase_wrapped_kek[ 8 ] ),
-				 value_size,
-				 0 );
-			}
-#endif
-			byte_stream_copy_to_uint32_little_endian(
-			 &( passphrase_wrapped_kek[ 168 ] ),
-			 number_of_iterations );
-
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( libcnotify_verbose != 0 )
-			{
-				libcnotify_printf(
-				 "%s: number of iterations\t: %" PRIu32 "\n",
-				 function,
-				 number_of_iterations );
-			}
-#endif
 			if( io_handle->user_password_is_set != 0 )
 			{
-				// fvde2john hack
-				if (value_size == 16) {
-					salt_len = 16;
-					hex_encode(&passphrase_wrapped_kek[8], 16, salt_hex);
-					iterations = number_of_iterations;
-				}
+				// fvde2john hack, use fvdeinfo -j to extract without a password
+				hex_encode(passphrase_wrapped_kek->salt, 16, salt_hex);
+				hex_encode(passphrase_wrapped_kek->wrapped_kek, 24, wrapped_kek_hex);
+				fprintf(stderr, "$fvde$%d$%d$%s$%d$%s\n", 1, 16, salt_hex, (int) passphrase_wrapped_kek->number_of_iterations, wrapped_kek_hex);
+
 				if( libfvde_password_pbkdf2(
 				     io_handle->user_password,
 				     io_handle->user_password_size - 1,
-				     &( passphrase_wrapped_kek[ 8 ] ),
-				     value_size,
-				     number_of_iterations,
+				     passphrase_wrapped_kek->salt,
+				     16,
+				     passphrase_wrapped_kek->number_of_iterations,
 				     passphrase_key,
 				     16,
 				     error ) == -1 )
@@ -4921,9 +5101,9 @@ int libfvde_encrypted_metadata_get_volume_master_key(
 				if( libfvde_password_pbkdf2(
 				     io_handle->recovery_password,
 				     io_handle->recovery_password_size - 1,
-				     &( passphrase_wrapped_kek[ 8 ] ),
-				     value_size,
-				     number_of_iterations,
+				     passphrase_wrapped_kek->salt,
+				     16,
+				     passphrase_wrapped_kek->number_of_iterations,
 				     passphrase_key,
 				     16,
 				     error ) == -1 )
@@ -4950,73 +5130,26 @@ int libfvde_encrypted_metadata_get_volume_master_key(
 				 0 );
 			}
 #endif
-			byte_stream_copy_to_uint32_little_endian(
-			 &( passphrase_wrapped_kek[ 24 ] ),
-			 value_type );
-
-			byte_stream_copy_to_uint32_little_endian(
-			 &( passphrase_wrapped_kek[ 28 ] ),
-			 value_size );
-
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( libcnotify_verbose != 0 )
-			{
-				libcnotify_printf(
-				 "%s: value type\t\t: 0x%08" PRIx32 "\n",
-				 function,
-				 value_type );
-
-				libcnotify_printf(
-				 "%s: value size\t\t: %" PRIu32 "\n",
-				 function,
-				 value_size );
-			}
-#endif
-			if( value_type != 0x00000010UL )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-				 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-				 "%s: unsupported value type.",
-				 function );
-
-				goto on_error;
-			}
-			if( value_size != 24 )
+			if( libcaes_context_set_key(
+			     aes_context,
+			     LIBCAES_CRYPT_MODE_DECRYPT,
+			     passphrase_key,
+			     16 * 8,
+			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
-				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-				 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-				 "%s: unsupported value size.",
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set passphrase key in AES context.",
 				 function );
 
 				goto on_error;
 			}
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( libcnotify_verbose != 0 )
-			{
-				libcnotify_printf(
-				 "%s: encrypted volume key wrapped KEK:\n",
-				 function );
-				libcnotify_print_data(
-				 &( passphrase_wrapped_kek[ 32 ] ),
-				 value_size,
-				 0 );
-			}
-#endif
-			// fvde2john hack
-			if (value_size == 24) {
-				int version = 1; // for future purposes
-				hex_encode(&passphrase_wrapped_kek[32], 24, wrapped_kek_hex);
-				fprintf(stderr, "$fvde$%d$%d$%s$%d$%s\n", version, salt_len, salt_hex, iterations, wrapped_kek_hex);
-			}
-			if( libfvde_encryption_aes_key_unwrap(
-			     passphrase_key,
-			     16 * 8,
-			     &( passphrase_wrapped_kek[ 32 ] ),
-			     value_size,
+			if( libfvde_encryption_aes_key_unwrap_with_context(
+			     aes_context,
+			     passphrase_wrapped_kek->wrapped_kek,
+			     24,
 			     volume_key_wrapped_kek,
 			     24,
 			     error ) == -1 )
@@ -5044,10 +5177,6 @@ int libfvde_encrypted_metadata_get_volume_master_key(
 
 				goto on_error;
 			}
-			memory_free(
-			 passphrase_wrapped_kek );
-
-			passphrase_wrapped_kek = NULL;
 
 #if defined( HAVE_DEBUG_OUTPUT )
 			if( libcnotify_verbose != 0 )
@@ -5129,9 +5258,24 @@ int libfvde_encrypted_metadata_get_volume_master_key(
  * in case it uses larger keys
  * the first 8 bytes of the KEK is the IV
  */
-			if( libfvde_encryption_aes_key_unwrap(
+			if( libcaes_context_set_key(
+			     aes_context,
+			     LIBCAES_CRYPT_MODE_DECRYPT,
 			     &( volume_key_wrapped_kek[ 8 ] ),
 			     16 * 8,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set volume key wrapped KEK in AES context.",
+				 function );
+
+				goto on_error;
+			}
+			if( libfvde_encryption_aes_key_unwrap_with_context(
+			     aes_context,
 			     &( kek_wrapped_volume_key[ 8 ] ),
 			     24,
 			     volume_master_key_wrapped_kek,
@@ -5213,10 +5357,42 @@ int libfvde_encrypted_metadata_get_volume_master_key(
 				goto on_error;
 			}
 		}
+		if( libcaes_context_free(
+		     &aes_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free AES context.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfvde_passphrase_wrapped_kek_free(
+		     &passphrase_wrapped_kek,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free passphrase wrapped KEK.",
+			 function );
+
+			goto on_error;
+		}
 	}
 	return( found_key );
 
 on_error:
+	if( aes_context != NULL )
+	{
+		libcaes_context_free(
+		 &aes_context,
+		 NULL );
+	}
 	if( kek_wrapped_volume_key != NULL )
 	{
 		memory_free(
@@ -5224,8 +5400,9 @@ on_error:
 	}
 	if( passphrase_wrapped_kek != NULL )
 	{
-		memory_free(
-		 passphrase_wrapped_kek );
+		libfvde_passphrase_wrapped_kek_free(
+		 &passphrase_wrapped_kek,
+		 NULL );
 	}
 	memory_set(
 	 volume_master_key_wrapped_kek,
@@ -27,12 +27,14 @@
 #include <types.h>
 
 #include "libfvde_data_area_descriptor.h"
+#include "libfvde_decryption_pool.h"
 #include "libfvde_encryption_context_plist.h"
 #include "libfvde_io_handle.h"
 #include "libfvde_keyring.h"
 #include "libfvde_libbfio.h"
 #include "libfvde_libcdata.h"
 #include "libfvde_libcerror.h"
+#include "libfvde_passphrase_wrapped_kek.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -60,6 +62,10 @@ struct libfvde_encrypted_metadata
 	 */
 	uint8_t logical_volume_family_identifier[ 16 ];
 
+	/* Value to indicate the logical volume family identifier is set
+	 */
+	uint8_t logical_volume_family_identifier_is_set;
+
 	/* The encryption context plist (com.apple.corestorage.lvf.encryption.context)
 	 */
 	libfvde_encryption_context_plist_t *encryption_context_plist;
@@ -246,12 +252,23 @@ int libfvde_encrypted_metadata_read_type_0x0505(
      uint64_t block_group,
      libcerror_error_t **error );
 
+uint8_t libfvde_encrypted_metadata_get_parse_profile_flag(
+     uint16_t block_type );
+
 int libfvde_encrypted_metadata_read(
      libfvde_encrypted_metadata_t *encrypted_metadata,
      libfvde_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
+     libfvde_decryption_pool_t *decryption_pool,
      off64_t file_offset,
      uint64_t encrypted_metadata_size,
+     uint8_t parse_profile,
+     libcerror_error_t **error );
+
+int libfvde_encrypted_metadata_get_passphrase_wrapped_kek(
+     libfvde_encryption_context_plist_t *encryption_context_plist,
+     int passphrase_wrapped_kek_index,
+     libfvde_passphrase_wrapped_kek_t *passphrase_wrapped_kek,
      libcerror_error_t **error );
 
 int libfvde_encrypted_metadata_get_volume_master_key(
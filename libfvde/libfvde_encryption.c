@@ -42,16 +42,8 @@ int libfvde_encryption_aes_key_unwrap(
      size_t unwrapped_data_size,
      libcerror_error_t **error )
 {
-	uint8_t block_data[ 16 ];
-	uint8_t vector_data[ 8 ];
-
 	libcaes_context_t *aes_context = NULL;
-	uint8_t *initialization_vector = NULL;
 	static char *function          = "libfvde_encryption_aes_key_unwrap";
-	size_t block_offset            = 0;
-	size_t number_of_blocks        = 0;
-	size_t block_index             = 0;
-	int8_t round_index             = 0;
 
 	if( key == NULL )
 	{
@@ -77,6 +69,111 @@ int libfvde_encryption_aes_key_unwrap(
 
 		return( -1 );
 	}
+	if( libcaes_context_initialize(
+	     &aes_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize AES context.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcaes_context_set_key(
+	     aes_context,
+	     LIBCAES_CRYPT_MODE_DECRYPT,
+	     key,
+	     key_bit_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set key in AES context.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfvde_encryption_aes_key_unwrap_with_context(
+	     aes_context,
+	     wrapped_data,
+	     wrapped_data_size,
+	     unwrapped_data,
+	     unwrapped_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+		 LIBCERROR_ENCRYPTION_ERROR_DECRYPT_FAILED,
+		 "%s: unable to unwrap data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcaes_context_free(
+	     &aes_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free AES context.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( aes_context != NULL )
+	{
+		libcaes_context_free(
+		 &aes_context,
+		 NULL);
+	}
+	return( -1 );
+}
+
+/* Unwrap data using AES Key Wrap (RFC3394)
+ * The AES context must be set with the key for decryption by the caller. This allows
+ * the context to be reused for multiple keys without allocating memory
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_encryption_aes_key_unwrap_with_context(
+     libcaes_context_t *aes_context,
+     const uint8_t *wrapped_data,
+     size_t wrapped_data_size,
+     uint8_t *unwrapped_data,
+     size_t unwrapped_data_size,
+     libcerror_error_t **error )
+{
+	uint8_t block_data[ 16 ];
+
+	static char *function   = "libfvde_encryption_aes_key_unwrap_with_context";
+	size_t block_offset     = 0;
+	size_t number_of_blocks = 0;
+	size_t block_index      = 0;
+	uint64_t value_64bit    = 0;
+	uint64_t step_index     = 0;
+	int8_t round_index      = 0;
+
+	if( aes_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid AES context.",
+		 function);
+
+		return( -1 );
+	}
 	if( wrapped_data == NULL )
 	{
 		libcerror_error_set(
@@ -154,35 +251,6 @@ int libfvde_encryption_aes_key_unwrap(
 
 		return( -1 );
 	}
-	if( libcaes_context_initialize(
-	     &aes_context,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to initialize AES context.",
-		 function );
-
-		goto on_error;
-	}
-	if( libcaes_context_set_key(
-	     aes_context,
-	     LIBCAES_CRYPT_MODE_DECRYPT,
-	     key,
-	     key_bit_size,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set key in AES context.",
-		 function );
-
-		goto on_error;
-	}
 	if( memory_copy(
 	     unwrapped_data,
 	     wrapped_data,
@@ -216,8 +284,10 @@ int libfvde_encryption_aes_key_unwrap(
 		 0 );
 	}
 #endif
-/* TODO make this code more readable */
-	initialization_vector = unwrapped_data;
+	/* The first 8 bytes of the unwrapped data contain the integrity check
+	 * value (A) and the remaining blocks the key data (R[1] to R[n])
+	 */
+	step_index = (uint64_t) 6 * ( number_of_blocks - 1 );
 
 	for( round_index = 5;
 	     round_index >= 0;
@@ -229,47 +299,26 @@ int libfvde_encryption_aes_key_unwrap(
 		{
 			block_offset = block_index * 8;
 
+			/* B = AES-1(K, (A ^ t) | R[i]) where t = n * j + i
+			 */
+			byte_stream_copy_to_uint64_big_endian(
+			 unwrapped_data,
+			 value_64bit );
+
+			value_64bit ^= step_index;
+
 			byte_stream_copy_from_uint64_big_endian(
-			 vector_data,
-			 (uint64_t) ( round_index * ( number_of_blocks - 1 ) + block_index ) );
-
-			vector_data[ 0 ] ^= initialization_vector[ 0 ];
-			vector_data[ 1 ] ^= initialization_vector[ 1 ];
-			vector_data[ 2 ] ^= initialization_vector[ 2 ];
-			vector_data[ 3 ] ^= initialization_vector[ 3 ];
-			vector_data[ 4 ] ^= initialization_vector[ 4 ];
-			vector_data[ 5 ] ^= initialization_vector[ 5 ];
-			vector_data[ 6 ] ^= initialization_vector[ 6 ];
-			vector_data[ 7 ] ^= initialization_vector[ 7 ];
-
-			if( memory_copy(
-			     &( block_data[ 0 ] ),
-			     vector_data,
-			     8 ) == NULL )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_MEMORY,
-				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-				 "%s: unable to copy vector data to block data.",
-				 function );
+			 &( block_data[ 0 ] ),
+			 value_64bit );
 
-				goto on_error;
-			}
-			if( memory_copy(
-			     &( block_data[ 8 ] ),
-			     &( unwrapped_data[ block_offset ] ),
-			     8 ) == NULL )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_MEMORY,
-				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-				 "%s: unable to copy unwrapped data to block data.",
-				 function );
+			byte_stream_copy_to_uint64_big_endian(
+			 &( unwrapped_data[ block_offset ] ),
+			 value_64bit );
+
+			byte_stream_copy_from_uint64_big_endian(
+			 &( block_data[ 8 ] ),
+			 value_64bit );
 
-				goto on_error;
-			}
 			if( libcaes_crypt_ecb(
 			     aes_context,
 			     LIBCAES_CRYPT_MODE_DECRYPT,
@@ -288,49 +337,32 @@ int libfvde_encryption_aes_key_unwrap(
 
 				goto on_error;
 			}
-			if( memory_copy(
-			     initialization_vector,
-			     &( block_data[ 0 ] ),
-			     8 ) == NULL )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_MEMORY,
-				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-				 "%s: unable to decrypted block data to initialization vector.",
-				 function );
+			/* A = MSB(64, B) and R[i] = LSB(64, B)
+			 */
+			byte_stream_copy_to_uint64_big_endian(
+			 &( block_data[ 0 ] ),
+			 value_64bit );
 
-				goto on_error;
-			}
-			if( memory_copy(
-			     &( unwrapped_data[ block_offset ] ),
-			     &( block_data[ 8 ] ),
-			     8 ) == NULL )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_MEMORY,
-				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-				 "%s: unable to copy decrypted block data to unwrapped data.",
-				 function );
+			byte_stream_copy_from_uint64_big_endian(
+			 unwrapped_data,
+			 value_64bit );
 
-				goto on_error;
-			}
+			byte_stream_copy_to_uint64_big_endian(
+			 &( block_data[ 8 ] ),
+			 value_64bit );
+
+			byte_stream_copy_from_uint64_big_endian(
+			 &( unwrapped_data[ block_offset ] ),
+			 value_64bit );
+
+			step_index--;
 		}
 	}
-	if( libcaes_context_free(
-	     &aes_context,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free AES context.",
-		 function );
+	memory_set(
+	 block_data,
+	 0,
+	 16 );
 
-		goto on_error;
-	}
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
@@ -346,12 +378,11 @@ int libfvde_encryption_aes_key_unwrap(
 	return( 1 );
 
 on_error:
-	if( aes_context != NULL )
-	{
-		libcaes_context_free(
-		 &aes_context,
-		 NULL);
-	}
+	memory_set(
+	 block_data,
+	 0,
+	 16 );
+
 	return( -1 );
 }
 
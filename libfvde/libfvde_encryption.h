@@ -42,6 +42,14 @@ int libfvde_encryption_aes_key_unwrap(
      size_t unwrapped_data_size,
      libcerror_error_t **error );
 
+int libfvde_encryption_aes_key_unwrap_with_context(
+     libcaes_context_t *aes_context,
+     const uint8_t *wrapped_data,
+     size_t wrapped_data_size,
+     uint8_t *unwrapped_data,
+     size_t unwrapped_data_size,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -1345,6 +1345,52 @@ on_error:
 	return( -1 );
 }
 
+/* Retrieves the number of passphrase wrapped KEKs
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_encryption_context_plist_get_number_of_passphrase_wrapped_keks(
+     libfvde_encryption_context_plist_t *plist,
+     int *number_of_passphrase_wrapped_keks,
+     libcerror_error_t **error )
+{
+	libfvde_internal_encryption_context_plist_t *internal_plist = NULL;
+	static char *function                                       = "libfvde_encryption_context_plist_get_number_of_passphrase_wrapped_keks";
+
+	if( plist == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid plist.",
+		 function );
+
+		return( -1 );
+	}
+	internal_plist = (libfvde_internal_encryption_context_plist_t *) plist;
+
+	if( number_of_passphrase_wrapped_keks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of passphrase wrapped KEKs.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_plist->crypto_users_property == NULL )
+	{
+		*number_of_passphrase_wrapped_keks = 0;
+	}
+	else
+	{
+		*number_of_passphrase_wrapped_keks = internal_plist->number_of_crypto_users_entries;
+	}
+	return( 1 );
+}
+
 /* Retrieves the index-specified passphrase wrapped kek from the given plist data.
  * Returns 1 if successful, 0 if no such value or -1 on error
  */
@@ -126,6 +126,11 @@ int libfvde_encryption_context_plist_get_conversion_status(
      size_t *conversion_status_size,
      libcerror_error_t **error );
 
+int libfvde_encryption_context_plist_get_number_of_passphrase_wrapped_keks(
+     libfvde_encryption_context_plist_t *plist,
+     int *number_of_passphrase_wrapped_keks,
+     libcerror_error_t **error );
+
 int libfvde_encryption_context_plist_get_passphrase_wrapped_kek(
      libfvde_encryption_context_plist_t *plist,
      int passphrase_wrapped_kek_index,
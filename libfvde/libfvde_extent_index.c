@@ -0,0 +1,673 @@
+/*
+ * Extent index functions
+ *
+ * Copyright (C) 2011-2018, Omar Choudary <choudary.omar@gmail.com>
+ *                          Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfvde_extent_index.h"
+#include "libfvde_libcdata.h"
+#include "libfvde_libcerror.h"
+#include "libfvde_libcnotify.h"
+#include "libfvde_segment_descriptor.h"
+
+/* Creates an extent index
+ * Make sure the value extent_index is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_extent_index_initialize(
+     libfvde_extent_index_t **extent_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libfvde_extent_index_initialize";
+
+	if( extent_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *extent_index != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid extent index value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*extent_index = memory_allocate_structure(
+	                 libfvde_extent_index_t );
+
+	if( *extent_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create extent index.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *extent_index,
+	     0,
+	     sizeof( libfvde_extent_index_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear extent index.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *extent_index != NULL )
+	{
+		memory_free(
+		 *extent_index );
+
+		*extent_index = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an extent index
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_extent_index_free(
+     libfvde_extent_index_t **extent_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libfvde_extent_index_free";
+
+	if( extent_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *extent_index != NULL )
+	{
+		if( ( *extent_index )->extents != NULL )
+		{
+			memory_free(
+			 ( *extent_index )->extents );
+		}
+		memory_free(
+		 *extent_index );
+
+		*extent_index = NULL;
+	}
+	return( 1 );
+}
+
+/* Determines the index of the first extent with a logical offset larger than the offset
+ * The extents are searched using a binary search
+ * Returns the index of the extent or the number of extents if there is no such extent
+ */
+int libfvde_extent_index_get_upper_bound(
+     libfvde_extent_index_t *extent_index,
+     off64_t logical_offset )
+{
+	int extent_index_value = 0;
+	int lower_extent_index = 0;
+	int upper_extent_index = 0;
+
+	if( extent_index == NULL )
+	{
+		return( 0 );
+	}
+	upper_extent_index = extent_index->number_of_extents;
+
+	while( lower_extent_index < upper_extent_index )
+	{
+		extent_index_value = lower_extent_index + ( ( upper_extent_index - lower_extent_index ) / 2 );
+
+		if( extent_index->extents[ extent_index_value ].logical_offset <= logical_offset )
+		{
+			lower_extent_index = extent_index_value + 1;
+		}
+		else
+		{
+			upper_extent_index = extent_index_value;
+		}
+	}
+	return( lower_extent_index );
+}
+
+/* Inserts an extent into the extent index
+ * The extents are kept sorted by logical offset and are not allowed to overlap
+ * An extent that is identical to an extent in the index is ignored
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_extent_index_insert_extent(
+     libfvde_extent_index_t *extent_index,
+     off64_t logical_offset,
+     size64_t size,
+     off64_t physical_offset,
+     libcerror_error_t **error )
+{
+	libfvde_extent_t *extents       = NULL;
+	static char *function           = "libfvde_extent_index_insert_extent";
+	size_t extents_size             = 0;
+	int extent_index_value          = 0;
+	int number_of_allocated_extents = 0;
+	int upper_extent_index          = 0;
+
+	if( extent_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent index.",
+		 function );
+
+		return( -1 );
+	}
+	if( logical_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid logical offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( size == 0 )
+	 || ( size > (size64_t) ( INT64_MAX - logical_offset ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( physical_offset < 0 )
+	 || ( size > (size64_t) ( INT64_MAX - physical_offset ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid physical offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	extent_index_value = libfvde_extent_index_get_upper_bound(
+	                      extent_index,
+	                      logical_offset );
+
+	if( extent_index_value > 0 )
+	{
+		if( ( extent_index->extents[ extent_index_value - 1 ].logical_offset == logical_offset )
+		 && ( extent_index->extents[ extent_index_value - 1 ].size == size )
+		 && ( extent_index->extents[ extent_index_value - 1 ].physical_offset == physical_offset ) )
+		{
+			return( 1 );
+		}
+		if( (size64_t) ( logical_offset - extent_index->extents[ extent_index_value - 1 ].logical_offset ) < extent_index->extents[ extent_index_value - 1 ].size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid extent at logical offset: %" PRIi64 " overlaps with previous extent.",
+			 function,
+			 logical_offset );
+
+			return( -1 );
+		}
+	}
+	if( extent_index_value < extent_index->number_of_extents )
+	{
+		if( size > (size64_t) ( extent_index->extents[ extent_index_value ].logical_offset - logical_offset ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid extent at logical offset: %" PRIi64 " overlaps with next extent.",
+			 function,
+			 logical_offset );
+
+			return( -1 );
+		}
+	}
+	if( extent_index->number_of_extents >= extent_index->number_of_allocated_extents )
+	{
+		if( extent_index->number_of_allocated_extents >= ( INT_MAX / 2 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid extent index - number of extents value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		number_of_allocated_extents = extent_index->number_of_allocated_extents * 2;
+
+		if( number_of_allocated_extents < 16 )
+		{
+			number_of_allocated_extents = 16;
+		}
+		if( (size_t) number_of_allocated_extents > ( (size_t) SSIZE_MAX / sizeof( libfvde_extent_t ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid extents size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		extents_size = sizeof( libfvde_extent_t ) * (size_t) number_of_allocated_extents;
+
+		extents = (libfvde_extent_t *) memory_reallocate(
+		                                extent_index->extents,
+		                                extents_size );
+
+		if( extents == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize extents.",
+			 function );
+
+			return( -1 );
+		}
+		extent_index->extents                     = extents;
+		extent_index->number_of_allocated_extents = number_of_allocated_extents;
+	}
+	/* The segment descriptors are commonly stored in logical order
+	 * hence most extents are appended and no extents need to be moved
+	 */
+	for( upper_extent_index = extent_index->number_of_extents;
+	     upper_extent_index > extent_index_value;
+	     upper_extent_index-- )
+	{
+		extent_index->extents[ upper_extent_index ] = extent_index->extents[ upper_extent_index - 1 ];
+	}
+	extent_index->extents[ extent_index_value ].logical_offset  = logical_offset;
+	extent_index->extents[ extent_index_value ].size            = size;
+	extent_index->extents[ extent_index_value ].physical_offset = physical_offset;
+
+	extent_index->number_of_extents += 1;
+
+	return( 1 );
+}
+
+/* Reads the extents from the segment descriptors
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_extent_index_read_segment_descriptors(
+     libfvde_extent_index_t *extent_index,
+     libcdata_array_t *segment_descriptors,
+     uint32_t block_size,
+     libcerror_error_t **error )
+{
+	libfvde_segment_descriptor_t *segment_descriptor = NULL;
+	static char *function                            = "libfvde_extent_index_read_segment_descriptors";
+	uint64_t maximum_number_of_blocks                = 0;
+	int number_of_segment_descriptors                = 0;
+	int segment_descriptor_index                     = 0;
+
+	if( extent_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent index.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     segment_descriptors,
+	     &number_of_segment_descriptors,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segment descriptors.",
+		 function );
+
+		return( -1 );
+	}
+	maximum_number_of_blocks = (uint64_t) INT64_MAX / block_size;
+
+	for( segment_descriptor_index = 0;
+	     segment_descriptor_index < number_of_segment_descriptors;
+	     segment_descriptor_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     segment_descriptors,
+		     segment_descriptor_index,
+		     (intptr_t **) &segment_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment descriptor: %d.",
+			 function,
+			 segment_descriptor_index );
+
+			return( -1 );
+		}
+		if( segment_descriptor == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing segment descriptor: %d.",
+			 function,
+			 segment_descriptor_index );
+
+			return( -1 );
+		}
+		if( ( segment_descriptor->logical_block_number > maximum_number_of_blocks )
+		 || ( segment_descriptor->number_of_blocks > maximum_number_of_blocks )
+		 || ( segment_descriptor->physical_block_number > maximum_number_of_blocks ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid segment descriptor: %d value out of bounds.",
+			 function,
+			 segment_descriptor_index );
+
+			return( -1 );
+		}
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: segment descriptor: %03d logical block number: %" PRIu64 ", number of blocks: %" PRIu64 ", physical block number: %" PRIu64 "\n",
+			 function,
+			 segment_descriptor_index,
+			 segment_descriptor->logical_block_number,
+			 segment_descriptor->number_of_blocks,
+			 segment_descriptor->physical_block_number );
+		}
+#endif
+		if( libfvde_extent_index_insert_extent(
+		     extent_index,
+		     (off64_t) ( segment_descriptor->logical_block_number * block_size ),
+		     (size64_t) ( segment_descriptor->number_of_blocks * block_size ),
+		     (off64_t) ( segment_descriptor->physical_block_number * block_size ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to insert extent of segment descriptor: %d.",
+			 function,
+			 segment_descriptor_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Retrieves the physical offset of a logical offset
+ * The physical size is set to the number of bytes that are stored consecutively from the physical offset
+ * If the logical offset is not mapped the physical size is set to the number of bytes until the next extent
+ * or 0 if there is no next extent
+ * Returns 1 if successful, 0 if the logical offset is not mapped or -1 on error
+ */
+int libfvde_extent_index_get_physical_offset(
+     libfvde_extent_index_t *extent_index,
+     off64_t logical_offset,
+     off64_t *physical_offset,
+     size64_t *physical_size,
+     libcerror_error_t **error )
+{
+	libfvde_extent_t *extent = NULL;
+	static char *function    = "libfvde_extent_index_get_physical_offset";
+	int extent_index_value   = 0;
+
+	if( extent_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent index.",
+		 function );
+
+		return( -1 );
+	}
+	if( logical_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid logical offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( physical_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid physical offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( physical_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid physical size.",
+		 function );
+
+		return( -1 );
+	}
+	extent_index_value = libfvde_extent_index_get_upper_bound(
+	                      extent_index,
+	                      logical_offset );
+
+	if( extent_index_value > 0 )
+	{
+		extent = &( extent_index->extents[ extent_index_value - 1 ] );
+
+		if( (size64_t) ( logical_offset - extent->logical_offset ) < extent->size )
+		{
+			*physical_offset = extent->physical_offset + ( logical_offset - extent->logical_offset );
+			*physical_size   = extent->size - (size64_t) ( logical_offset - extent->logical_offset );
+
+			return( 1 );
+		}
+	}
+	*physical_offset = 0;
+
+	if( extent_index_value < extent_index->number_of_extents )
+	{
+		*physical_size = (size64_t) ( extent_index->extents[ extent_index_value ].logical_offset - logical_offset );
+	}
+	else
+	{
+		*physical_size = 0;
+	}
+	return( 0 );
+}
+
+/* Retrieves the next mapped range
+ * The mapped range starts at the offset if the offset is mapped otherwise at the next extent
+ * Consecutive extents are combined into a single mapped range
+ * Returns 1 if successful, 0 if there is no mapped range at or after the offset or -1 on error
+ */
+int libfvde_extent_index_get_next_mapped_range(
+     libfvde_extent_index_t *extent_index,
+     off64_t logical_offset,
+     off64_t *range_offset,
+     size64_t *range_size,
+     libcerror_error_t **error )
+{
+	libfvde_extent_t *extent = NULL;
+	static char *function    = "libfvde_extent_index_get_next_mapped_range";
+	off64_t range_end_offset = 0;
+	int extent_index_value   = 0;
+
+	if( extent_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent index.",
+		 function );
+
+		return( -1 );
+	}
+	if( logical_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid logical offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range size.",
+		 function );
+
+		return( -1 );
+	}
+	extent_index_value = libfvde_extent_index_get_upper_bound(
+	                      extent_index,
+	                      logical_offset );
+
+	if( extent_index_value > 0 )
+	{
+		extent = &( extent_index->extents[ extent_index_value - 1 ] );
+
+		if( (size64_t) ( logical_offset - extent->logical_offset ) < extent->size )
+		{
+			extent_index_value -= 1;
+		}
+	}
+	if( extent_index_value >= extent_index->number_of_extents )
+	{
+		return( 0 );
+	}
+	extent = &( extent_index->extents[ extent_index_value ] );
+
+	if( logical_offset < extent->logical_offset )
+	{
+		logical_offset = extent->logical_offset;
+	}
+	range_end_offset = extent->logical_offset + (off64_t) extent->size;
+
+	for( extent_index_value += 1;
+	     extent_index_value < extent_index->number_of_extents;
+	     extent_index_value++ )
+	{
+		extent = &( extent_index->extents[ extent_index_value ] );
+
+		if( extent->logical_offset != range_end_offset )
+		{
+			break;
+		}
+		range_end_offset += (off64_t) extent->size;
+	}
+	*range_offset = logical_offset;
+	*range_size   = (size64_t) ( range_end_offset - logical_offset );
+
+	return( 1 );
+}
+
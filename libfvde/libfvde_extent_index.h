@@ -0,0 +1,114 @@
+/*
+ * Extent index functions
+ *
+ * Copyright (C) 2011-2018, Omar Choudary <choudary.omar@gmail.com>
+ *                          Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFVDE_EXTENT_INDEX_H )
+#define _LIBFVDE_EXTENT_INDEX_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfvde_libcdata.h"
+#include "libfvde_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfvde_extent libfvde_extent_t;
+
+struct libfvde_extent
+{
+	/* The logical offset
+	 */
+	off64_t logical_offset;
+
+	/* The size
+	 */
+	size64_t size;
+
+	/* The physical offset
+	 */
+	off64_t physical_offset;
+};
+
+typedef struct libfvde_extent_index libfvde_extent_index_t;
+
+struct libfvde_extent_index
+{
+	/* The extents sorted by logical offset
+	 */
+	libfvde_extent_t *extents;
+
+	/* The number of extents
+	 */
+	int number_of_extents;
+
+	/* The number of allocated extents
+	 */
+	int number_of_allocated_extents;
+};
+
+int libfvde_extent_index_initialize(
+     libfvde_extent_index_t **extent_index,
+     libcerror_error_t **error );
+
+int libfvde_extent_index_free(
+     libfvde_extent_index_t **extent_index,
+     libcerror_error_t **error );
+
+int libfvde_extent_index_get_upper_bound(
+     libfvde_extent_index_t *extent_index,
+     off64_t logical_offset );
+
+int libfvde_extent_index_insert_extent(
+     libfvde_extent_index_t *extent_index,
+     off64_t logical_offset,
+     size64_t size,
+     off64_t physical_offset,
+     libcerror_error_t **error );
+
+int libfvde_extent_index_read_segment_descriptors(
+     libfvde_extent_index_t *extent_index,
+     libcdata_array_t *segment_descriptors,
+     uint32_t block_size,
+     libcerror_error_t **error );
+
+int libfvde_extent_index_get_physical_offset(
+     libfvde_extent_index_t *extent_index,
+     off64_t logical_offset,
+     off64_t *physical_offset,
+     size64_t *physical_size,
+     libcerror_error_t **error );
+
+int libfvde_extent_index_get_next_mapped_range(
+     libfvde_extent_index_t *extent_index,
+     off64_t logical_offset,
+     off64_t *range_offset,
+     size64_t *range_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFVDE_EXTENT_INDEX_H ) */
+
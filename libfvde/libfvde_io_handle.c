@@ -27,10 +27,13 @@
 #include <types.h>
 
 #include "libfvde_checksum.h"
+#include "libfvde_decryption_pool.h"
 #include "libfvde_definitions.h"
 #include "libfvde_encryption.h"
+#include "libfvde_extent_index.h"
 #include "libfvde_io_handle.h"
 #include "libfvde_libbfio.h"
+#include "libfvde_libcaes.h"
 #include "libfvde_libcerror.h"
 #include "libfvde_libcnotify.h"
 #include "libfvde_libfcache.h"
@@ -199,6 +202,22 @@ int libfvde_io_handle_clear(
 			result = -1;
 		}
 	}
+	if( io_handle->extent_index != NULL )
+	{
+		if( libfvde_extent_index_free(
+		     &( io_handle->extent_index ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free extent index.",
+			 function );
+
+			result = -1;
+		}
+	}
 	if( io_handle->user_password != NULL )
 	{
 		if( memory_set(
@@ -831,6 +850,8 @@ int libfvde_io_handle_read_volume_header(
 
 		goto on_error;
 	}
+	io_handle->volume_header_checksum = stored_checksum;
+
 	if( block_type != 0x0010 )
        	{
                 libcerror_error_set(
@@ -899,29 +920,492 @@ on_error:
 	return( -1 );
 }
 
-/* Reads a sector
- * Callback function for the volume vector
+/* Determines if a logical volume offset is mapped onto the physical volume
+ * The range size is set to the number of bytes from the offset that are either all mapped or all unmapped
+ * Returns 1 if mapped, 0 if not or -1 on error
+ */
+int libfvde_io_handle_get_mapped_range(
+     libfvde_io_handle_t *io_handle,
+     off64_t offset,
+     size64_t *range_size,
+     libcerror_error_t **error )
+{
+	static char *function   = "libfvde_io_handle_get_mapped_range";
+	off64_t physical_offset = 0;
+	int result              = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range size.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->extent_index == NULL )
+	{
+		*range_size = (size64_t) ( INT64_MAX - offset );
+
+		return( 1 );
+	}
+	result = libfvde_extent_index_get_physical_offset(
+	          io_handle->extent_index,
+	          offset,
+	          &physical_offset,
+	          range_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve physical offset of logical offset: %" PRIi64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	/* The range after the last extent is not mapped
+	 */
+	if( *range_size == 0 )
+	{
+		*range_size = (size64_t) ( INT64_MAX - offset );
+	}
+	return( result );
+}
+
+/* Decrypts whole sectors of logical volume data
+ * The offset is relative to the start of the logical volume and must be sector aligned
+ * Sectors that are not mapped onto the physical volume are not decrypted but set to 0-byte values
+ * The decryption pool is only used if the data is decrypted in place
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_io_handle_decrypt_sectors(
+     libfvde_io_handle_t *io_handle,
+     libcaes_tweaked_context_t *xts_context,
+     libfvde_decryption_pool_t *decryption_pool LIBFVDE_ATTRIBUTE_UNUSED,
+     off64_t offset,
+     const uint8_t *encrypted_data,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libfvde_io_handle_decrypt_sectors";
+	size64_t range_size   = 0;
+	size_t data_offset    = 0;
+	size_t decrypt_size   = 0;
+	int result            = 0;
+
+#if !defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	LIBFVDE_UNREFERENCED_PARAMETER( decryption_pool )
+#endif
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->bytes_per_sector == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid IO handle - bytes per sector value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( offset < 0 )
+	 || ( ( offset % io_handle->bytes_per_sector ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( encrypted_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid encrypted data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size > (size_t) SSIZE_MAX )
+	 || ( ( data_size % io_handle->bytes_per_sector ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	while( data_offset < data_size )
+	{
+		result = libfvde_io_handle_get_mapped_range(
+		          io_handle,
+		          offset,
+		          &range_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if offset: %" PRIi64 " is mapped.",
+			 function,
+			 offset );
+
+			return( -1 );
+		}
+		decrypt_size = data_size - data_offset;
+
+		if( (size64_t) decrypt_size > range_size )
+		{
+			decrypt_size = (size_t) range_size;
+		}
+		if( ( decrypt_size % io_handle->bytes_per_sector ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid range at offset: %" PRIi64 " - size value not a multitude of bytes per sector.",
+			 function,
+			 offset );
+
+			return( -1 );
+		}
+		if( result == 0 )
+		{
+			if( memory_set(
+			     &( data[ data_offset ] ),
+			     0,
+			     decrypt_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear data of unmapped range at offset: %" PRIi64 ".",
+				 function,
+				 offset );
+
+				return( -1 );
+			}
+		}
+		else
+		{
+			result = 0;
+
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+			if( ( decryption_pool != NULL )
+			 && ( encrypted_data == data )
+			 && ( decrypt_size >= LIBFVDE_MINIMUM_PARALLEL_DECRYPTION_SIZE ) )
+			{
+				/* If the decryption pool is in use by another read
+				 * the sectors are decrypted by this thread
+				 */
+				result = libfvde_decryption_pool_decrypt(
+				          decryption_pool,
+				          xts_context,
+				          (uint64_t) ( offset / io_handle->bytes_per_sector ),
+				          (size_t) io_handle->bytes_per_sector,
+				          &( data[ data_offset ] ),
+				          decrypt_size,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+					 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+					 "%s: unable to decrypt sectors using decryption pool.",
+					 function );
+
+					return( -1 );
+				}
+			}
+#endif
+			if( result == 0 )
+			{
+				if( libcaes_crypt_xts_data_units(
+				     xts_context,
+				     LIBCAES_CRYPT_MODE_DECRYPT,
+				     (uint64_t) ( offset / io_handle->bytes_per_sector ),
+				     (size_t) io_handle->bytes_per_sector,
+				     &( encrypted_data[ data_offset ] ),
+				     decrypt_size,
+				     &( data[ data_offset ] ),
+				     decrypt_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+					 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+					 "%s: unable to decrypt sectors.",
+					 function );
+
+					return( -1 );
+				}
+			}
+		}
+		data_offset += decrypt_size;
+		offset      += (off64_t) decrypt_size;
+	}
+	return( 1 );
+}
+
+/* Reads (encrypted) logical volume data
+ * The offset is relative to the start of the logical volume
+ * The data is read from the physical extents that store the logical volume
+ * Ranges that are not mapped onto the physical volume are filled with 0-byte values
  * Returns 1 if successful or -1 on error
  */
-int libfvde_io_handle_read_sector(
+int libfvde_io_handle_read_logical_volume_data(
      libfvde_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
-     libfdata_vector_t *vector,
-     libfcache_cache_t *cache,
-     int element_index,
-     int element_data_file_index LIBFVDE_ATTRIBUTE_UNUSED,
-     off64_t element_data_offset,
-     size64_t element_data_size LIBFVDE_ATTRIBUTE_UNUSED,
-     uint32_t element_data_flags,
-     uint8_t read_flags LIBFVDE_ATTRIBUTE_UNUSED,
+     off64_t offset,
+     uint8_t *data,
+     size_t data_size,
      libcerror_error_t **error )
 {
-	libfvde_sector_data_t *sector_data = NULL;
-	static char *function              = "libfvde_io_handle_read_sector";
+	static char *function = "libfvde_io_handle_read_logical_volume_data";
+	size64_t extent_size  = 0;
+	size_t data_offset    = 0;
+	size_t read_size      = 0;
+	ssize_t read_count    = 0;
+	off64_t file_offset   = 0;
+	int result            = 0;
 
-	LIBFVDE_UNREFERENCED_PARAMETER( element_data_file_index );
-	LIBFVDE_UNREFERENCED_PARAMETER( element_data_size );
-	LIBFVDE_UNREFERENCED_PARAMETER( read_flags );
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	while( data_offset < data_size )
+	{
+		read_size = data_size - data_offset;
+
+		if( io_handle->extent_index == NULL )
+		{
+			file_offset = io_handle->logical_volume_offset + offset;
+		}
+		else
+		{
+			result = libfvde_extent_index_get_physical_offset(
+			          io_handle->extent_index,
+			          offset,
+			          &file_offset,
+			          &extent_size,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve physical offset of logical offset: %" PRIi64 ".",
+				 function,
+				 offset );
+
+				return( -1 );
+			}
+			if( ( extent_size != 0 )
+			 && ( (size64_t) read_size > extent_size ) )
+			{
+				read_size = (size_t) extent_size;
+			}
+			if( result == 0 )
+			{
+				if( memory_set(
+				     &( data[ data_offset ] ),
+				     0,
+				     read_size ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+					 "%s: unable to clear data of unmapped range at offset: %" PRIi64 ".",
+					 function,
+					 offset );
+
+					return( -1 );
+				}
+				data_offset += read_size;
+				offset      += (off64_t) read_size;
+
+				continue;
+			}
+		}
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: reading %" PRIzd " bytes of logical volume offset: %" PRIi64 " at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
+			 function,
+			 read_size,
+			 offset,
+			 file_offset,
+			 file_offset );
+		}
+#endif
+		if( libbfio_handle_seek_offset(
+		     file_io_handle,
+		     file_offset,
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek offset: %" PRIi64 ".",
+			 function,
+			 file_offset );
+
+			return( -1 );
+		}
+		read_count = libbfio_handle_read_buffer(
+			      file_io_handle,
+			      &( data[ data_offset ] ),
+			      read_size,
+			      error );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data at offset: %" PRIi64 ".",
+			 function,
+			 file_offset );
+
+			return( -1 );
+		}
+		data_offset += read_size;
+		offset      += (off64_t) read_size;
+	}
+	return( 1 );
+}
+
+/* Reads whole sectors directly into a buffer and decrypts them in place
+ * The offset is relative to the start of the logical volume and must be sector aligned
+ * If a decryption pool is provided large buffers are decrypted by its threads
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_io_handle_read_sectors_to_buffer(
+     libfvde_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libcaes_tweaked_context_t *xts_context,
+     libfvde_decryption_pool_t *decryption_pool,
+     off64_t offset,
+     uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libfvde_io_handle_read_sectors_to_buffer";
 
 	if( io_handle == NULL )
 	{
@@ -934,80 +1418,116 @@ int libfvde_io_handle_read_sector(
 
 		return( -1 );
 	}
-/* TODO handle virtual sectors, what about different sector sizes? */
-	if( libfvde_sector_data_initialize(
-	     &sector_data,
-	     (size_t) ( (libfvde_io_handle_t *) io_handle )->bytes_per_sector,
-	     error ) != 1 )
+	if( io_handle->bytes_per_sector == 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create sector data.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid IO handle - bytes per sector value out of bounds.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libfvde_sector_data_read(
-	     sector_data,
-	     (libfvde_io_handle_t *) io_handle,
-	     file_io_handle,
-	     element_data_offset,
-	     ( (libfvde_io_handle_t *) io_handle )->xts_context,
-	     error ) != 1 )
+	if( ( offset < 0 )
+	 || ( ( offset % io_handle->bytes_per_sector ) != 0 ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read sector data.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( element_data_flags == LIBFVDE_RANGE_FLAG_ENCRYPTED )
+	if( buffer == NULL )
 	{
-/* TODO decrypt */
-	}
-	if( libfdata_vector_set_element_value_by_index(
-	     vector,
-	     (intptr_t *) file_io_handle,
-	     cache,
-	     element_index,
-	     (intptr_t *) sector_data,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libfvde_sector_data_free,
-	     LIBFDATA_LIST_ELEMENT_VALUE_FLAG_MANAGED,
-	     error ) != 1 )
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) SSIZE_MAX )
+	 || ( ( buffer_size % io_handle->bytes_per_sector ) != 0 ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set sector data as element value.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	return( 1 );
+	if( (size64_t) buffer_size > ( io_handle->logical_volume_size - (size64_t) offset ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value exceeds logical volume size.",
+		 function );
 
-on_error:
-	if( sector_data != NULL )
+		return( -1 );
+	}
+	if( libfvde_io_handle_read_logical_volume_data(
+	     io_handle,
+	     file_io_handle,
+	     offset,
+	     buffer,
+	     buffer_size,
+	     error ) != 1 )
 	{
-		libfvde_sector_data_free(
-		 &sector_data,
-		 NULL );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read sectors at offset: %" PRIi64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
 	}
-	return( -1 );
+	if( io_handle->is_encrypted != 0 )
+	{
+		if( libfvde_io_handle_decrypt_sectors(
+		     io_handle,
+		     xts_context,
+		     decryption_pool,
+		     offset,
+		     buffer,
+		     buffer,
+		     buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+			 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+			 "%s: unable to decrypt sectors at offset: %" PRIi64 ".",
+			 function,
+			 offset );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
 }
 
 /* Reads the logical volume header
+ * The offset is relative to the start of the logical volume
  * Returns 1 if successful, 0 if not or -1 on error
  */
 int libfvde_io_handle_read_logical_volume_header(
      libfvde_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
-     off64_t file_offset,
+     off64_t offset,
      libcerror_error_t **error )
 {
 	libfvde_sector_data_t *sector_data = NULL;
@@ -1034,8 +1554,8 @@ int libfvde_io_handle_read_logical_volume_header(
 		libcnotify_printf(
 		 "%s: reading logical volume header at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
 		 function,
-		 file_offset,
-		 file_offset );
+		 offset,
+		 offset );
 	}
 #endif
 	if( libfvde_sector_data_initialize(
@@ -1056,7 +1576,7 @@ int libfvde_io_handle_read_logical_volume_header(
 	     sector_data,
 	     io_handle,
 	     file_io_handle,
-	     file_offset,
+	     offset,
 	     io_handle->xts_context,
 	     error ) != 1 )
 	{
@@ -26,6 +26,8 @@
 #include <common.h>
 #include <types.h>
 
+#include "libfvde_decryption_pool.h"
+#include "libfvde_extent_index.h"
 #include "libfvde_libbfio.h"
 #include "libfvde_libcaes.h"
 #include "libfvde_libcerror.h"
@@ -62,6 +64,10 @@ struct libfvde_io_handle
 	 */
 	uint32_t sectors_per_block;
 
+	/* The size of the sector data, which contains one or more consecutive sectors
+	 */
+	size_t sector_data_size;
+
 	/* The metadata size
 	 */
 	uint32_t metadata_size;
@@ -86,6 +92,10 @@ struct libfvde_io_handle
 	 */
 	uint32_t checksum_algorithm;
 
+	/* The (stored) checksum of the volume header
+	 */
+	uint32_t volume_header_checksum;
+
         /* The logical volume offset
          */
         off64_t logical_volume_offset;
@@ -94,6 +104,11 @@ struct libfvde_io_handle
 	 */
 	size64_t logical_volume_size;
 
+	/* The extent index that maps the logical volume onto the physical volume
+	 * if not set the logical volume is stored consecutively at the logical volume offset
+	 */
+	libfvde_extent_index_t *extent_index;
+
 	/* The encryption method of the logical volume
 	 */
 	uint32_t logical_volume_encryption_method;
@@ -177,23 +192,44 @@ int libfvde_io_handle_read_volume_header(
      off64_t file_offset,
      libcerror_error_t **error );
 
-int libfvde_io_handle_read_sector(
+int libfvde_io_handle_get_mapped_range(
+     libfvde_io_handle_t *io_handle,
+     off64_t offset,
+     size64_t *range_size,
+     libcerror_error_t **error );
+
+int libfvde_io_handle_decrypt_sectors(
+     libfvde_io_handle_t *io_handle,
+     libcaes_tweaked_context_t *xts_context,
+     libfvde_decryption_pool_t *decryption_pool,
+     off64_t offset,
+     const uint8_t *encrypted_data,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libfvde_io_handle_read_logical_volume_data(
+     libfvde_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     off64_t offset,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libfvde_io_handle_read_sectors_to_buffer(
      libfvde_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
-     libfdata_vector_t *vector,
-     libfcache_cache_t *cache,
-     int element_index,
-     int element_data_file_index,
-     off64_t element_data_offset,
-     size64_t element_data_size,
-     uint32_t element_data_flags,
-     uint8_t read_flags,
+     libcaes_tweaked_context_t *xts_context,
+     libfvde_decryption_pool_t *decryption_pool,
+     off64_t offset,
+     uint8_t *buffer,
+     size_t buffer_size,
      libcerror_error_t **error );
 
 int libfvde_io_handle_read_logical_volume_header(
      libfvde_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
-     off64_t file_offset,
+     off64_t offset,
      libcerror_error_t **error );
 
 #if defined( __cplusplus )
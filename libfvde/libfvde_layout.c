@@ -0,0 +1,2089 @@
+/*
+ * Layout functions
+ *
+ * Copyright (C) 2011-2018, Omar Choudary <choudary.omar@gmail.com>
+ *                          Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfvde_checksum.h"
+#include "libfvde_data_area_descriptor.h"
+#include "libfvde_definitions.h"
+#include "libfvde_encrypted_metadata.h"
+#include "libfvde_io_handle.h"
+#include "libfvde_layout.h"
+#include "libfvde_libbfio.h"
+#include "libfvde_libcdata.h"
+#include "libfvde_libcerror.h"
+#include "libfvde_libcnotify.h"
+#include "libfvde_metadata.h"
+#include "libfvde_segment_descriptor.h"
+
+#include "fvde_layout.h"
+#include "fvde_metadata.h"
+
+const char *libfvde_layout_signature = "fvdelayt";
+
+/* Creates a layout
+ * Make sure the value layout is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_layout_initialize(
+     libfvde_layout_t **layout,
+     libcerror_error_t **error )
+{
+	static char *function = "libfvde_layout_initialize";
+
+	if( layout == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid layout.",
+		 function );
+
+		return( -1 );
+	}
+	if( *layout != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid layout value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*layout = memory_allocate_structure(
+	           libfvde_layout_t );
+
+	if( *layout == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create layout.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *layout,
+	     0,
+	     sizeof( libfvde_layout_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear layout.",
+		 function );
+
+		memory_free(
+		 *layout );
+
+		*layout = NULL;
+
+		return( -1 );
+	}
+	if( libcdata_array_initialize(
+	     &( ( *layout )->segment_descriptors ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create segment descriptors array.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_initialize(
+	     &( ( *layout )->data_area_descriptors ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create data area descriptors array.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *layout != NULL )
+	{
+		if( ( *layout )->segment_descriptors != NULL )
+		{
+			libcdata_array_free(
+			 &( ( *layout )->segment_descriptors ),
+			 NULL,
+			 NULL );
+		}
+		memory_free(
+		 *layout );
+
+		*layout = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a layout
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_layout_free(
+     libfvde_layout_t **layout,
+     libcerror_error_t **error )
+{
+	static char *function = "libfvde_layout_free";
+	int result            = 1;
+
+	if( layout == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid layout.",
+		 function );
+
+		return( -1 );
+	}
+	if( *layout != NULL )
+	{
+		if( libcdata_array_free(
+		     &( ( *layout )->segment_descriptors ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libfvde_segment_descriptor_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free segment descriptors array.",
+			 function );
+
+			result = -1;
+		}
+		if( libcdata_array_free(
+		     &( ( *layout )->data_area_descriptors ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libfvde_data_area_descriptor_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free data area descriptors array.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *layout );
+
+		*layout = NULL;
+	}
+	return( result );
+}
+
+/* Copies the segment descriptors from a source array to a destination array
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_layout_copy_segment_descriptors(
+     libcdata_array_t *destination_array,
+     libcdata_array_t *source_array,
+     libcerror_error_t **error )
+{
+	libfvde_segment_descriptor_t *segment_descriptor        = NULL;
+	libfvde_segment_descriptor_t *source_segment_descriptor = NULL;
+	static char *function                                   = "libfvde_layout_copy_segment_descriptors";
+	int entry_index                                         = 0;
+	int number_of_segment_descriptors                       = 0;
+	int segment_descriptor_index                            = 0;
+
+	if( libcdata_array_empty(
+	     destination_array,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libfvde_segment_descriptor_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty destination segment descriptors array.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_get_number_of_entries(
+	     source_array,
+	     &number_of_segment_descriptors,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of source segment descriptors.",
+		 function );
+
+		goto on_error;
+	}
+	for( segment_descriptor_index = 0;
+	     segment_descriptor_index < number_of_segment_descriptors;
+	     segment_descriptor_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     source_array,
+		     segment_descriptor_index,
+		     (intptr_t **) &source_segment_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve source segment descriptor: %d.",
+			 function,
+			 segment_descriptor_index );
+
+			goto on_error;
+		}
+		if( source_segment_descriptor == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing source segment descriptor: %d.",
+			 function,
+			 segment_descriptor_index );
+
+			goto on_error;
+		}
+		if( libfvde_segment_descriptor_initialize(
+		     &segment_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create segment descriptor.",
+			 function );
+
+			goto on_error;
+		}
+		segment_descriptor->logical_block_number  = source_segment_descriptor->logical_block_number;
+		segment_descriptor->number_of_blocks      = source_segment_descriptor->number_of_blocks;
+		segment_descriptor->physical_block_number = source_segment_descriptor->physical_block_number;
+
+		if( libcdata_array_append_entry(
+		     destination_array,
+		     &entry_index,
+		     (intptr_t *) segment_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append segment descriptor to array.",
+			 function );
+
+			goto on_error;
+		}
+		segment_descriptor = NULL;
+	}
+	return( 1 );
+
+on_error:
+	if( segment_descriptor != NULL )
+	{
+		libfvde_segment_descriptor_free(
+		 &segment_descriptor,
+		 NULL );
+	}
+	libcdata_array_empty(
+	 destination_array,
+	 (int (*)(intptr_t **, libcerror_error_t **)) &libfvde_segment_descriptor_free,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Copies the data area descriptors from a source array to a destination array
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_layout_copy_data_area_descriptors(
+     libcdata_array_t *destination_array,
+     libcdata_array_t *source_array,
+     libcerror_error_t **error )
+{
+	libfvde_data_area_descriptor_t *data_area_descriptor        = NULL;
+	libfvde_data_area_descriptor_t *source_data_area_descriptor = NULL;
+	static char *function                                       = "libfvde_layout_copy_data_area_descriptors";
+	int data_area_descriptor_index                              = 0;
+	int entry_index                                             = 0;
+	int number_of_data_area_descriptors                         = 0;
+
+	if( libcdata_array_empty(
+	     destination_array,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libfvde_data_area_descriptor_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty destination data area descriptors array.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_get_number_of_entries(
+	     source_array,
+	     &number_of_data_area_descriptors,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of source data area descriptors.",
+		 function );
+
+		goto on_error;
+	}
+	for( data_area_descriptor_index = 0;
+	     data_area_descriptor_index < number_of_data_area_descriptors;
+	     data_area_descriptor_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     source_array,
+		     data_area_descriptor_index,
+		     (intptr_t **) &source_data_area_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve source data area descriptor: %d.",
+			 function,
+			 data_area_descriptor_index );
+
+			goto on_error;
+		}
+		if( source_data_area_descriptor == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing source data area descriptor: %d.",
+			 function,
+			 data_area_descriptor_index );
+
+			goto on_error;
+		}
+		if( libfvde_data_area_descriptor_initialize(
+		     &data_area_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create data area descriptor.",
+			 function );
+
+			goto on_error;
+		}
+		data_area_descriptor->offset        = source_data_area_descriptor->offset;
+		data_area_descriptor->size          = source_data_area_descriptor->size;
+		data_area_descriptor->data_type     = source_data_area_descriptor->data_type;
+		data_area_descriptor->mapped_offset = source_data_area_descriptor->mapped_offset;
+
+		if( libcdata_array_append_entry(
+		     destination_array,
+		     &entry_index,
+		     (intptr_t *) data_area_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append data area descriptor to array.",
+			 function );
+
+			goto on_error;
+		}
+		data_area_descriptor = NULL;
+	}
+	return( 1 );
+
+on_error:
+	if( data_area_descriptor != NULL )
+	{
+		libfvde_data_area_descriptor_free(
+		 &data_area_descriptor,
+		 NULL );
+	}
+	libcdata_array_empty(
+	 destination_array,
+	 (int (*)(intptr_t **, libcerror_error_t **)) &libfvde_data_area_descriptor_free,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Reads the (stored) checksums and transaction numbers of the metadata block headers
+ * of the metadata copies, without reading the rest of the metadata
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_layout_read_metadata_block_headers(
+     libfvde_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     uint32_t *checksums,
+     uint64_t *transaction_numbers,
+     libcerror_error_t **error )
+{
+	fvde_metadata_block_header_t metadata_block_header;
+
+	off64_t metadata_offsets[ LIBFVDE_MAXIMUM_NUMBER_OF_METADATA_COPIES ];
+
+	static char *function = "libfvde_layout_read_metadata_block_headers";
+	ssize_t read_count    = 0;
+	int copy_index        = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( checksums == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid checksums.",
+		 function );
+
+		return( -1 );
+	}
+	if( transaction_numbers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid transaction numbers.",
+		 function );
+
+		return( -1 );
+	}
+	metadata_offsets[ 0 ] = (off64_t) io_handle->first_metadata_offset;
+	metadata_offsets[ 1 ] = (off64_t) io_handle->second_metadata_offset;
+	metadata_offsets[ 2 ] = (off64_t) io_handle->third_metadata_offset;
+	metadata_offsets[ 3 ] = (off64_t) io_handle->fourth_metadata_offset;
+
+	for( copy_index = 0;
+	     copy_index < LIBFVDE_MAXIMUM_NUMBER_OF_METADATA_COPIES;
+	     copy_index++ )
+	{
+		if( libbfio_handle_seek_offset(
+		     file_io_handle,
+		     metadata_offsets[ copy_index ],
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek metadata block header: %d offset: %" PRIi64 ".",
+			 function,
+			 copy_index,
+			 metadata_offsets[ copy_index ] );
+
+			return( -1 );
+		}
+		read_count = libbfio_handle_read_buffer(
+		              file_io_handle,
+		              (uint8_t *) &metadata_block_header,
+		              sizeof( fvde_metadata_block_header_t ),
+		              error );
+
+		if( read_count != (ssize_t) sizeof( fvde_metadata_block_header_t ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read metadata block header: %d.",
+			 function,
+			 copy_index );
+
+			return( -1 );
+		}
+		byte_stream_copy_to_uint32_little_endian(
+		 metadata_block_header.checksum,
+		 checksums[ copy_index ] );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 metadata_block_header.number,
+		 transaction_numbers[ copy_index ] );
+	}
+	return( 1 );
+}
+
+/* Sets the layout values from the values of an opened volume
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_layout_set_values(
+     libfvde_layout_t *layout,
+     libfvde_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libfvde_metadata_t *metadata,
+     libfvde_encrypted_metadata_t *encrypted_metadata,
+     int metadata_copy_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libfvde_layout_set_values";
+
+	if( layout == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid layout.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( metadata == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata.",
+		 function );
+
+		return( -1 );
+	}
+	if( encrypted_metadata == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid encrypted metadata.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( metadata_copy_index < 0 )
+	 || ( metadata_copy_index >= LIBFVDE_MAXIMUM_NUMBER_OF_METADATA_COPIES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid metadata copy index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfvde_layout_read_metadata_block_headers(
+	     io_handle,
+	     file_io_handle,
+	     layout->metadata_checksums,
+	     layout->metadata_transaction_numbers,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read metadata block headers.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     layout->physical_volume_identifier,
+	     io_handle->physical_volume_identifier,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy physical volume identifier.",
+		 function );
+
+		return( -1 );
+	}
+	layout->volume_header_checksum              = io_handle->volume_header_checksum;
+	layout->serial_number                       = io_handle->serial_number;
+	layout->block_size                          = io_handle->block_size;
+	layout->metadata_copy_index                 = metadata_copy_index;
+	layout->encrypted_metadata_size             = metadata->encrypted_metadata_size;
+	layout->primary_encrypted_metadata_offset   = metadata->primary_encrypted_metadata_offset;
+	layout->secondary_encrypted_metadata_offset = metadata->secondary_encrypted_metadata_offset;
+	layout->logical_volume_offset               = encrypted_metadata->logical_volume_offset;
+	layout->logical_volume_size                 = encrypted_metadata->logical_volume_size;
+
+	if( libfvde_layout_copy_segment_descriptors(
+	     layout->segment_descriptors,
+	     encrypted_metadata->segment_descriptors,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy segment descriptors.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfvde_layout_copy_data_area_descriptors(
+	     layout->data_area_descriptors,
+	     encrypted_metadata->data_area_descriptors,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy data area descriptors.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Determines if the layout is valid for the volume, which is the case when
+ * the volume header and the metadata block headers did not change since the layout was exported
+ * Returns 1 if valid, 0 if not or -1 on error
+ */
+int libfvde_layout_is_valid(
+     libfvde_layout_t *layout,
+     libfvde_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	uint64_t transaction_numbers[ LIBFVDE_MAXIMUM_NUMBER_OF_METADATA_COPIES ];
+	uint32_t checksums[ LIBFVDE_MAXIMUM_NUMBER_OF_METADATA_COPIES ];
+
+	static char *function = "libfvde_layout_is_valid";
+	int copy_index        = 0;
+
+	if( layout == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid layout.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( layout->volume_header_checksum != io_handle->volume_header_checksum )
+	 || ( layout->serial_number != io_handle->serial_number )
+	 || ( layout->block_size != io_handle->block_size ) )
+	{
+		return( 0 );
+	}
+	if( memory_compare(
+	     layout->physical_volume_identifier,
+	     io_handle->physical_volume_identifier,
+	     16 ) != 0 )
+	{
+		return( 0 );
+	}
+	if( libfvde_layout_read_metadata_block_headers(
+	     io_handle,
+	     file_io_handle,
+	     checksums,
+	     transaction_numbers,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read metadata block headers.",
+		 function );
+
+		return( -1 );
+	}
+	for( copy_index = 0;
+	     copy_index < LIBFVDE_MAXIMUM_NUMBER_OF_METADATA_COPIES;
+	     copy_index++ )
+	{
+		if( ( checksums[ copy_index ] != layout->metadata_checksums[ copy_index ] )
+		 || ( transaction_numbers[ copy_index ] != layout->metadata_transaction_numbers[ copy_index ] ) )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: metadata block header: %d changed.\n",
+				 function,
+				 copy_index );
+			}
+#endif
+			return( 0 );
+		}
+	}
+	return( 1 );
+}
+
+/* Retrieves the metadata and encrypted metadata values from the layout
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_layout_get_values(
+     libfvde_layout_t *layout,
+     libfvde_metadata_t *metadata,
+     libfvde_encrypted_metadata_t *encrypted_metadata,
+     libcerror_error_t **error )
+{
+	static char *function = "libfvde_layout_get_values";
+
+	if( layout == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid layout.",
+		 function );
+
+		return( -1 );
+	}
+	if( metadata == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata.",
+		 function );
+
+		return( -1 );
+	}
+	if( encrypted_metadata == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid encrypted metadata.",
+		 function );
+
+		return( -1 );
+	}
+	metadata->encrypted_metadata_size             = layout->encrypted_metadata_size;
+	metadata->primary_encrypted_metadata_offset   = layout->primary_encrypted_metadata_offset;
+	metadata->secondary_encrypted_metadata_offset = layout->secondary_encrypted_metadata_offset;
+
+	encrypted_metadata->logical_volume_offset = layout->logical_volume_offset;
+	encrypted_metadata->logical_volume_size   = layout->logical_volume_size;
+
+	if( libfvde_layout_copy_segment_descriptors(
+	     encrypted_metadata->segment_descriptors,
+	     layout->segment_descriptors,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy segment descriptors.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfvde_layout_copy_data_area_descriptors(
+	     encrypted_metadata->data_area_descriptors,
+	     layout->data_area_descriptors,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy data area descriptors.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the size of the layout data
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_layout_get_data_size(
+     libfvde_layout_t *layout,
+     size_t *data_size,
+     libcerror_error_t **error )
+{
+	static char *function               = "libfvde_layout_get_data_size";
+	size64_t safe_data_size             = 0;
+	int number_of_data_area_descriptors = 0;
+	int number_of_segment_descriptors   = 0;
+
+	if( layout == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid layout.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     layout->segment_descriptors,
+	     &number_of_segment_descriptors,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segment descriptors.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     layout->data_area_descriptors,
+	     &number_of_data_area_descriptors,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of data area descriptors.",
+		 function );
+
+		return( -1 );
+	}
+	safe_data_size = sizeof( fvde_layout_file_header_t )
+	               + sizeof( fvde_layout_volume_t )
+	               + ( (size64_t) number_of_segment_descriptors * sizeof( fvde_layout_segment_descriptor_t ) )
+	               + ( (size64_t) number_of_data_area_descriptors * sizeof( fvde_layout_data_area_descriptor_t ) );
+
+	if( safe_data_size > (size64_t) LIBFVDE_MAXIMUM_LAYOUT_DATA_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*data_size = (size_t) safe_data_size;
+
+	return( 1 );
+}
+
+/* Reads the layout data
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_layout_read_data(
+     libfvde_layout_t *layout,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	libfvde_data_area_descriptor_t *data_area_descriptor = NULL;
+	libfvde_segment_descriptor_t *segment_descriptor     = NULL;
+	fvde_layout_file_header_t *file_header               = NULL;
+	fvde_layout_volume_t *layout_volume                  = NULL;
+	static char *function                                = "libfvde_layout_read_data";
+	size64_t calculated_data_size                        = 0;
+	size_t data_offset                                   = 0;
+	uint32_t calculated_checksum                         = 0;
+	uint32_t format_version                              = 0;
+	uint32_t number_of_data_area_descriptors             = 0;
+	uint32_t number_of_segment_descriptors               = 0;
+	uint32_t stored_checksum                             = 0;
+	uint32_t stored_data_size                            = 0;
+	uint32_t value_32bit                                 = 0;
+	uint32_t value_index                                 = 0;
+	int copy_index                                       = 0;
+	int entry_index                                      = 0;
+
+	if( layout == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid layout.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size < ( sizeof( fvde_layout_file_header_t ) + sizeof( fvde_layout_volume_t ) ) )
+	 || ( data_size > (size_t) LIBFVDE_MAXIMUM_LAYOUT_DATA_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	file_header = (fvde_layout_file_header_t *) data;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: file header data:\n",
+		 function );
+		libcnotify_print_data(
+		 data,
+		 sizeof( fvde_layout_file_header_t ),
+		 0 );
+	}
+#endif
+	if( memory_compare(
+	     file_header->signature,
+	     libfvde_layout_signature,
+	     8 ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid signature.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 file_header->format_version,
+	 format_version );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 file_header->data_size,
+	 stored_data_size );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 file_header->checksum,
+	 stored_checksum );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 file_header->number_of_segment_descriptors,
+	 number_of_segment_descriptors );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 file_header->number_of_data_area_descriptors,
+	 number_of_data_area_descriptors );
+
+	if( format_version != LIBFVDE_LAYOUT_FORMAT_VERSION )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported format version: %" PRIu32 ".",
+		 function,
+		 format_version );
+
+		goto on_error;
+	}
+	calculated_data_size = sizeof( fvde_layout_volume_t )
+	                     + ( (size64_t) number_of_segment_descriptors * sizeof( fvde_layout_segment_descriptor_t ) )
+	                     + ( (size64_t) number_of_data_area_descriptors * sizeof( fvde_layout_data_area_descriptor_t ) );
+
+	if( ( (size64_t) stored_data_size != calculated_data_size )
+	 || ( (size_t) stored_data_size != ( data_size - sizeof( fvde_layout_file_header_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	data_offset = sizeof( fvde_layout_file_header_t );
+
+	if( libfvde_checksum_calculate_weak_crc32(
+	     &calculated_checksum,
+	     &( data[ data_offset ] ),
+	     (size_t) stored_data_size,
+	     0xffffffffUL,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to calculate weak CRC-32.",
+		 function );
+
+		goto on_error;
+	}
+	if( stored_checksum != calculated_checksum )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_INPUT,
+		 LIBCERROR_INPUT_ERROR_CHECKSUM_MISMATCH,
+		 "%s: mismatch in checksum ( 0x%08" PRIx32 " != 0x%08" PRIx32 " ).",
+		 function,
+		 stored_checksum,
+		 calculated_checksum );
+
+		goto on_error;
+	}
+	layout_volume = (fvde_layout_volume_t *) &( data[ data_offset ] );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 layout_volume->volume_header_checksum,
+	 layout->volume_header_checksum );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 layout_volume->serial_number,
+	 layout->serial_number );
+
+	if( memory_copy(
+	     layout->physical_volume_identifier,
+	     layout_volume->physical_volume_identifier,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy physical volume identifier.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 layout_volume->block_size,
+	 layout->block_size );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 layout_volume->metadata_copy_index,
+	 value_32bit );
+
+	if( value_32bit >= (uint32_t) LIBFVDE_MAXIMUM_NUMBER_OF_METADATA_COPIES )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid metadata copy index value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	layout->metadata_copy_index = (int) value_32bit;
+
+	for( copy_index = 0;
+	     copy_index < LIBFVDE_MAXIMUM_NUMBER_OF_METADATA_COPIES;
+	     copy_index++ )
+	{
+		byte_stream_copy_to_uint32_little_endian(
+		 &( layout_volume->metadata_checksums[ copy_index * 4 ] ),
+		 layout->metadata_checksums[ copy_index ] );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 &( layout_volume->metadata_transaction_numbers[ copy_index * 8 ] ),
+		 layout->metadata_transaction_numbers[ copy_index ] );
+	}
+	byte_stream_copy_to_uint64_little_endian(
+	 layout_volume->encrypted_metadata_size,
+	 layout->encrypted_metadata_size );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 layout_volume->primary_encrypted_metadata_offset,
+	 layout->primary_encrypted_metadata_offset );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 layout_volume->secondary_encrypted_metadata_offset,
+	 layout->secondary_encrypted_metadata_offset );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 layout_volume->logical_volume_offset,
+	 layout->logical_volume_offset );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 layout_volume->logical_volume_size,
+	 layout->logical_volume_size );
+
+	data_offset += sizeof( fvde_layout_volume_t );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: metadata copy index\t\t\t: %d\n",
+		 function,
+		 layout->metadata_copy_index );
+
+		libcnotify_printf(
+		 "%s: logical volume offset\t\t\t: 0x%08" PRIx64 "\n",
+		 function,
+		 layout->logical_volume_offset );
+
+		libcnotify_printf(
+		 "%s: logical volume size\t\t\t: %" PRIu64 "\n",
+		 function,
+		 layout->logical_volume_size );
+
+		libcnotify_printf(
+		 "%s: number of segment descriptors\t\t: %" PRIu32 "\n",
+		 function,
+		 number_of_segment_descriptors );
+
+		libcnotify_printf(
+		 "%s: number of data area descriptors\t: %" PRIu32 "\n",
+		 function,
+		 number_of_data_area_descriptors );
+
+		libcnotify_printf(
+		 "\n" );
+	}
+#endif
+	if( libcdata_array_empty(
+	     layout->segment_descriptors,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libfvde_segment_descriptor_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty segment descriptors array.",
+		 function );
+
+		goto on_error;
+	}
+	for( value_index = 0;
+	     value_index < number_of_segment_descriptors;
+	     value_index++ )
+	{
+		if( libfvde_segment_descriptor_initialize(
+		     &segment_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create segment descriptor.",
+			 function );
+
+			goto on_error;
+		}
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (fvde_layout_segment_descriptor_t *) &( data[ data_offset ] ) )->logical_block_number,
+		 segment_descriptor->logical_block_number );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (fvde_layout_segment_descriptor_t *) &( data[ data_offset ] ) )->number_of_blocks,
+		 segment_descriptor->number_of_blocks );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (fvde_layout_segment_descriptor_t *) &( data[ data_offset ] ) )->physical_block_number,
+		 segment_descriptor->physical_block_number );
+
+		data_offset += sizeof( fvde_layout_segment_descriptor_t );
+
+		if( libcdata_array_append_entry(
+		     layout->segment_descriptors,
+		     &entry_index,
+		     (intptr_t *) segment_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append segment descriptor to array.",
+			 function );
+
+			goto on_error;
+		}
+		segment_descriptor = NULL;
+	}
+	if( libcdata_array_empty(
+	     layout->data_area_descriptors,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libfvde_data_area_descriptor_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty data area descriptors array.",
+		 function );
+
+		goto on_error;
+	}
+	for( value_index = 0;
+	     value_index < number_of_data_area_descriptors;
+	     value_index++ )
+	{
+		if( libfvde_data_area_descriptor_initialize(
+		     &data_area_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create data area descriptor.",
+			 function );
+
+			goto on_error;
+		}
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (fvde_layout_data_area_descriptor_t *) &( data[ data_offset ] ) )->offset,
+		 data_area_descriptor->offset );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (fvde_layout_data_area_descriptor_t *) &( data[ data_offset ] ) )->size,
+		 data_area_descriptor->size );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (fvde_layout_data_area_descriptor_t *) &( data[ data_offset ] ) )->data_type,
+		 data_area_descriptor->data_type );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (fvde_layout_data_area_descriptor_t *) &( data[ data_offset ] ) )->mapped_offset,
+		 data_area_descriptor->mapped_offset );
+
+		data_offset += sizeof( fvde_layout_data_area_descriptor_t );
+
+		if( libcdata_array_append_entry(
+		     layout->data_area_descriptors,
+		     &entry_index,
+		     (intptr_t *) data_area_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append data area descriptor to array.",
+			 function );
+
+			goto on_error;
+		}
+		data_area_descriptor = NULL;
+	}
+	return( 1 );
+
+on_error:
+	if( data_area_descriptor != NULL )
+	{
+		libfvde_data_area_descriptor_free(
+		 &data_area_descriptor,
+		 NULL );
+	}
+	if( segment_descriptor != NULL )
+	{
+		libfvde_segment_descriptor_free(
+		 &segment_descriptor,
+		 NULL );
+	}
+	libcdata_array_empty(
+	 layout->data_area_descriptors,
+	 (int (*)(intptr_t **, libcerror_error_t **)) &libfvde_data_area_descriptor_free,
+	 NULL );
+
+	libcdata_array_empty(
+	 layout->segment_descriptors,
+	 (int (*)(intptr_t **, libcerror_error_t **)) &libfvde_segment_descriptor_free,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Writes the layout data
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_layout_write_data(
+     libfvde_layout_t *layout,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	libfvde_data_area_descriptor_t *data_area_descriptor = NULL;
+	libfvde_segment_descriptor_t *segment_descriptor     = NULL;
+	fvde_layout_file_header_t *file_header               = NULL;
+	fvde_layout_volume_t *layout_volume                  = NULL;
+	static char *function                                = "libfvde_layout_write_data";
+	size_t data_offset                                   = 0;
+	size_t required_data_size                            = 0;
+	uint32_t calculated_checksum                         = 0;
+	int copy_index                                       = 0;
+	int entry_index                                      = 0;
+	int number_of_data_area_descriptors                  = 0;
+	int number_of_segment_descriptors                    = 0;
+
+	if( layout == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid layout.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfvde_layout_get_data_size(
+	     layout,
+	     &required_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size != required_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     layout->segment_descriptors,
+	     &number_of_segment_descriptors,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segment descriptors.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     layout->data_area_descriptors,
+	     &number_of_data_area_descriptors,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of data area descriptors.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     data,
+	     0,
+	     data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear data.",
+		 function );
+
+		return( -1 );
+	}
+	data_offset = sizeof( fvde_layout_file_header_t );
+
+	layout_volume = (fvde_layout_volume_t *) &( data[ data_offset ] );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 layout_volume->volume_header_checksum,
+	 layout->volume_header_checksum );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 layout_volume->serial_number,
+	 layout->serial_number );
+
+	if( memory_copy(
+	     layout_volume->physical_volume_identifier,
+	     layout->physical_volume_identifier,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy physical volume identifier.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 layout_volume->block_size,
+	 layout->block_size );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 layout_volume->metadata_copy_index,
+	 (uint32_t) layout->metadata_copy_index );
+
+	for( copy_index = 0;
+	     copy_index < LIBFVDE_MAXIMUM_NUMBER_OF_METADATA_COPIES;
+	     copy_index++ )
+	{
+		byte_stream_copy_from_uint32_little_endian(
+		 &( layout_volume->metadata_checksums[ copy_index * 4 ] ),
+		 layout->metadata_checksums[ copy_index ] );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 &( layout_volume->metadata_transaction_numbers[ copy_index * 8 ] ),
+		 layout->metadata_transaction_numbers[ copy_index ] );
+	}
+	byte_stream_copy_from_uint64_little_endian(
+	 layout_volume->encrypted_metadata_size,
+	 layout->encrypted_metadata_size );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 layout_volume->primary_encrypted_metadata_offset,
+	 layout->primary_encrypted_metadata_offset );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 layout_volume->secondary_encrypted_metadata_offset,
+	 layout->secondary_encrypted_metadata_offset );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 layout_volume->logical_volume_offset,
+	 (uint64_t) layout->logical_volume_offset );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 layout_volume->logical_volume_size,
+	 layout->logical_volume_size );
+
+	data_offset += sizeof( fvde_layout_volume_t );
+
+	for( entry_index = 0;
+	     entry_index < number_of_segment_descriptors;
+	     entry_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     layout->segment_descriptors,
+		     entry_index,
+		     (intptr_t **) &segment_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment descriptor: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		if( segment_descriptor == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing segment descriptor: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		byte_stream_copy_from_uint64_little_endian(
+		 ( (fvde_layout_segment_descriptor_t *) &( data[ data_offset ] ) )->logical_block_number,
+		 segment_descriptor->logical_block_number );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 ( (fvde_layout_segment_descriptor_t *) &( data[ data_offset ] ) )->number_of_blocks,
+		 segment_descriptor->number_of_blocks );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 ( (fvde_layout_segment_descriptor_t *) &( data[ data_offset ] ) )->physical_block_number,
+		 segment_descriptor->physical_block_number );
+
+		data_offset += sizeof( fvde_layout_segment_descriptor_t );
+	}
+	for( entry_index = 0;
+	     entry_index < number_of_data_area_descriptors;
+	     entry_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     layout->data_area_descriptors,
+		     entry_index,
+		     (intptr_t **) &data_area_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve data area descriptor: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		if( data_area_descriptor == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing data area descriptor: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		byte_stream_copy_from_uint64_little_endian(
+		 ( (fvde_layout_data_area_descriptor_t *) &( data[ data_offset ] ) )->offset,
+		 (uint64_t) data_area_descriptor->offset );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 ( (fvde_layout_data_area_descriptor_t *) &( data[ data_offset ] ) )->size,
+		 data_area_descriptor->size );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 ( (fvde_layout_data_area_descriptor_t *) &( data[ data_offset ] ) )->data_type,
+		 data_area_descriptor->data_type );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 ( (fvde_layout_data_area_descriptor_t *) &( data[ data_offset ] ) )->mapped_offset,
+		 (uint64_t) data_area_descriptor->mapped_offset );
+
+		data_offset += sizeof( fvde_layout_data_area_descriptor_t );
+	}
+	if( libfvde_checksum_calculate_weak_crc32(
+	     &calculated_checksum,
+	     &( data[ sizeof( fvde_layout_file_header_t ) ] ),
+	     data_size - sizeof( fvde_layout_file_header_t ),
+	     0xffffffffUL,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to calculate weak CRC-32.",
+		 function );
+
+		return( -1 );
+	}
+	file_header = (fvde_layout_file_header_t *) data;
+
+	if( memory_copy(
+	     file_header->signature,
+	     libfvde_layout_signature,
+	     8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy signature.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 file_header->format_version,
+	 LIBFVDE_LAYOUT_FORMAT_VERSION );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 file_header->data_size,
+	 (uint32_t) ( data_size - sizeof( fvde_layout_file_header_t ) ) );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 file_header->checksum,
+	 calculated_checksum );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 file_header->number_of_segment_descriptors,
+	 (uint32_t) number_of_segment_descriptors );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 file_header->number_of_data_area_descriptors,
+	 (uint32_t) number_of_data_area_descriptors );
+
+	return( 1 );
+}
+
+/* Reads a layout file using a Basic File IO (bfio) handle
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_layout_read_file_io_handle(
+     libfvde_layout_t *layout,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	uint8_t *data              = NULL;
+	static char *function      = "libfvde_layout_read_file_io_handle";
+	size64_t file_size         = 0;
+	ssize_t read_count         = 0;
+	int file_io_handle_is_open = 0;
+
+	if( layout == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid layout.",
+		 function );
+
+		return( -1 );
+	}
+	file_io_handle_is_open = libbfio_handle_is_open(
+	                          file_io_handle,
+	                          error );
+
+	if( file_io_handle_is_open == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file.",
+		 function );
+
+		goto on_error;
+	}
+	else if( file_io_handle_is_open == 0 )
+	{
+		if( libbfio_handle_open(
+		     file_io_handle,
+		     LIBBFIO_OPEN_READ,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open file.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libbfio_handle_get_size(
+	     file_io_handle,
+	     &file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine file size.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( file_size < (size64_t) ( sizeof( fvde_layout_file_header_t ) + sizeof( fvde_layout_volume_t ) ) )
+	 || ( file_size > (size64_t) LIBFVDE_MAXIMUM_LAYOUT_DATA_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid layout file size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	data = (uint8_t *) memory_allocate(
+	                    sizeof( uint8_t ) * (size_t) file_size );
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create layout data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_seek_offset(
+	     file_io_handle,
+	     0,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek file header offset: 0.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libbfio_handle_read_buffer(
+	              file_io_handle,
+	              data,
+	              (size_t) file_size,
+	              error );
+
+	if( read_count != (ssize_t) file_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read layout file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfvde_layout_read_data(
+	     layout,
+	     data,
+	     (size_t) file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read layout data.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 data );
+
+	data = NULL;
+
+	if( file_io_handle_is_open == 0 )
+	{
+		if( libbfio_handle_close(
+		     file_io_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close file.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	if( file_io_handle_is_open == 0 )
+	{
+		libbfio_handle_close(
+		 file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Writes a layout file using a Basic File IO (bfio) handle
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_layout_write_file_io_handle(
+     libfvde_layout_t *layout,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	uint8_t *data              = NULL;
+	static char *function      = "libfvde_layout_write_file_io_handle";
+	size_t data_size           = 0;
+	ssize_t write_count        = 0;
+	int file_io_handle_is_open = 0;
+
+	if( layout == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid layout.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfvde_layout_get_data_size(
+	     layout,
+	     &data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve data size.",
+		 function );
+
+		return( -1 );
+	}
+	data = (uint8_t *) memory_allocate(
+	                    sizeof( uint8_t ) * data_size );
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create layout data.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfvde_layout_write_data(
+	     layout,
+	     data,
+	     data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write layout data.",
+		 function );
+
+		goto on_error;
+	}
+	file_io_handle_is_open = libbfio_handle_is_open(
+	                          file_io_handle,
+	                          error );
+
+	if( file_io_handle_is_open == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file.",
+		 function );
+
+		goto on_error;
+	}
+	else if( file_io_handle_is_open == 0 )
+	{
+		if( libbfio_handle_open(
+		     file_io_handle,
+		     LIBBFIO_OPEN_WRITE_TRUNCATE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open file.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libbfio_handle_seek_offset(
+	     file_io_handle,
+	     0,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek file header offset: 0.",
+		 function );
+
+		goto on_error;
+	}
+	write_count = libbfio_handle_write_buffer(
+	               file_io_handle,
+	               data,
+	               data_size,
+	               error );
+
+	if( write_count != (ssize_t) data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write layout file.",
+		 function );
+
+		goto on_error;
+	}
+	if( file_io_handle_is_open == 0 )
+	{
+		if( libbfio_handle_close(
+		     file_io_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close file.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	memory_free(
+	 data );
+
+	return( 1 );
+
+on_error:
+	if( file_io_handle_is_open == 0 )
+	{
+		libbfio_handle_close(
+		 file_io_handle,
+		 NULL );
+	}
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	return( -1 );
+}
+
@@ -0,0 +1,175 @@
+/*
+ * Layout functions
+ *
+ * Copyright (C) 2011-2018, Omar Choudary <choudary.omar@gmail.com>
+ *                          Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFVDE_LAYOUT_H )
+#define _LIBFVDE_LAYOUT_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfvde_definitions.h"
+#include "libfvde_encrypted_metadata.h"
+#include "libfvde_io_handle.h"
+#include "libfvde_libbfio.h"
+#include "libfvde_libcdata.h"
+#include "libfvde_libcerror.h"
+#include "libfvde_metadata.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+extern const char *libfvde_layout_signature;
+
+typedef struct libfvde_layout libfvde_layout_t;
+
+/* The layout contains the values of the metadata and encrypted metadata
+ * that are needed to map the logical volume, but no key material
+ */
+struct libfvde_layout
+{
+	/* The (stored) checksum of the volume header
+	 */
+	uint32_t volume_header_checksum;
+
+	/* The serial number
+	 */
+	uint32_t serial_number;
+
+	/* The physical volume identifier
+	 */
+	uint8_t physical_volume_identifier[ 16 ];
+
+	/* The block size
+	 */
+	uint32_t block_size;
+
+	/* The index of the metadata copy that was used
+	 */
+	int metadata_copy_index;
+
+	/* The (stored) checksums of the metadata block headers of the metadata copies
+	 */
+	uint32_t metadata_checksums[ LIBFVDE_MAXIMUM_NUMBER_OF_METADATA_COPIES ];
+
+	/* The transaction numbers of the metadata block headers of the metadata copies
+	 */
+	uint64_t metadata_transaction_numbers[ LIBFVDE_MAXIMUM_NUMBER_OF_METADATA_COPIES ];
+
+	/* The encrypted metadata size
+	 */
+	uint64_t encrypted_metadata_size;
+
+	/* The primary encrypted metadata offset
+	 */
+	uint64_t primary_encrypted_metadata_offset;
+
+	/* The secondary encrypted metadata offset
+	 */
+	uint64_t secondary_encrypted_metadata_offset;
+
+	/* The logical volume offset
+	 */
+	off64_t logical_volume_offset;
+
+	/* The logical volume size
+	 */
+	size64_t logical_volume_size;
+
+	/* The segment descriptors
+	 */
+	libcdata_array_t *segment_descriptors;
+
+	/* The data area descriptors
+	 */
+	libcdata_array_t *data_area_descriptors;
+};
+
+int libfvde_layout_initialize(
+     libfvde_layout_t **layout,
+     libcerror_error_t **error );
+
+int libfvde_layout_free(
+     libfvde_layout_t **layout,
+     libcerror_error_t **error );
+
+int libfvde_layout_read_metadata_block_headers(
+     libfvde_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     uint32_t *checksums,
+     uint64_t *transaction_numbers,
+     libcerror_error_t **error );
+
+int libfvde_layout_set_values(
+     libfvde_layout_t *layout,
+     libfvde_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libfvde_metadata_t *metadata,
+     libfvde_encrypted_metadata_t *encrypted_metadata,
+     int metadata_copy_index,
+     libcerror_error_t **error );
+
+int libfvde_layout_is_valid(
+     libfvde_layout_t *layout,
+     libfvde_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libfvde_layout_get_values(
+     libfvde_layout_t *layout,
+     libfvde_metadata_t *metadata,
+     libfvde_encrypted_metadata_t *encrypted_metadata,
+     libcerror_error_t **error );
+
+int libfvde_layout_get_data_size(
+     libfvde_layout_t *layout,
+     size_t *data_size,
+     libcerror_error_t **error );
+
+int libfvde_layout_read_data(
+     libfvde_layout_t *layout,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libfvde_layout_write_data(
+     libfvde_layout_t *layout,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libfvde_layout_read_file_io_handle(
+     libfvde_layout_t *layout,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libfvde_layout_write_file_io_handle(
+     libfvde_layout_t *layout,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFVDE_LAYOUT_H ) */
+
@@ -27,6 +27,7 @@
 #include <types.h>
 
 #include "libfvde_checksum.h"
+#include "libfvde_definitions.h"
 #include "libfvde_io_handle.h"
 #include "libfvde_libbfio.h"
 #include "libfvde_libcerror.h"
@@ -1115,3 +1116,294 @@ on_error:
 	return( -1 );
 }
 
+/* Reads the newest valid copy of the metadata
+ * The header and checksum of the first metadata block of every copy are validated
+ * before only the copy with the highest transaction and serial number is read,
+ * the other valid copies are only read if the newer copies cannot be read
+ * Returns 1 if successful, 0 if no valid copy was found or -1 on error
+ */
+int libfvde_metadata_read_newest(
+     libfvde_metadata_t *metadata,
+     libfvde_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     const off64_t *file_offsets,
+     int number_of_copies,
+     int *copy_index,
+     libcerror_error_t **error )
+{
+	uint64_t transaction_numbers[ LIBFVDE_MAXIMUM_NUMBER_OF_METADATA_COPIES ];
+	uint32_t serial_numbers[ LIBFVDE_MAXIMUM_NUMBER_OF_METADATA_COPIES ];
+	uint8_t copy_is_valid[ LIBFVDE_MAXIMUM_NUMBER_OF_METADATA_COPIES ];
+
+	libfvde_metadata_block_t *metadata_block = NULL;
+	uint8_t *metadata_block_data             = NULL;
+	static char *function                    = "libfvde_metadata_read_newest";
+	size_t metadata_block_data_size          = 8192;
+	ssize_t read_count                       = 0;
+	int copy_iterator                        = 0;
+	int newest_copy_index                    = 0;
+	int result                               = 0;
+
+	if( metadata == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file offsets.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_copies <= 0 )
+	 || ( number_of_copies > LIBFVDE_MAXIMUM_NUMBER_OF_METADATA_COPIES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of copies value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( copy_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid copy index.",
+		 function );
+
+		return( -1 );
+	}
+	metadata_block_data = (uint8_t *) memory_allocate(
+	                                   sizeof( uint8_t ) * metadata_block_data_size );
+
+	if( metadata_block_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create metadata block data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfvde_metadata_block_initialize(
+	     &metadata_block,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create metadata block.",
+		 function );
+
+		goto on_error;
+	}
+	for( copy_iterator = 0;
+	     copy_iterator < number_of_copies;
+	     copy_iterator++ )
+	{
+		copy_is_valid[ copy_iterator ]       = 0;
+		transaction_numbers[ copy_iterator ] = 0;
+		serial_numbers[ copy_iterator ]      = 0;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: reading metadata block header of copy: %d at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
+			 function,
+			 copy_iterator,
+			 file_offsets[ copy_iterator ],
+			 file_offsets[ copy_iterator ] );
+		}
+#endif
+		read_count = -1;
+
+		if( libbfio_handle_seek_offset(
+		     file_io_handle,
+		     file_offsets[ copy_iterator ],
+		     SEEK_SET,
+		     error ) != -1 )
+		{
+			read_count = libbfio_handle_read_buffer(
+			              file_io_handle,
+			              metadata_block_data,
+			              metadata_block_data_size,
+			              error );
+		}
+		if( read_count == (ssize_t) metadata_block_data_size )
+		{
+			result = libfvde_metadata_block_read_data(
+			          metadata_block,
+			          metadata_block_data,
+			          metadata_block_data_size,
+			          error );
+		}
+		else
+		{
+			result = -1;
+		}
+		/* A copy that cannot be read or has an invalid header or checksum is ignored
+		 */
+		if( result != 1 )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( ( libcnotify_verbose != 0 )
+			 && ( error != NULL ) )
+			{
+				libcnotify_print_error_backtrace(
+				 *error );
+			}
+#endif
+			libcerror_error_free(
+			 error );
+
+			continue;
+		}
+		if( metadata_block->type != 0x0011 )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: unsupported metadata block type: 0x%04" PRIx16 " of copy: %d.\n",
+				 function,
+				 metadata_block->type,
+				 copy_iterator );
+			}
+#endif
+			continue;
+		}
+		copy_is_valid[ copy_iterator ]       = 1;
+		transaction_numbers[ copy_iterator ] = metadata_block->number;
+		serial_numbers[ copy_iterator ]      = metadata_block->serial_number;
+	}
+	memory_free(
+	 metadata_block_data );
+
+	metadata_block_data = NULL;
+
+	if( libfvde_metadata_block_free(
+	     &metadata_block,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free metadata block.",
+		 function );
+
+		goto on_error;
+	}
+	result = 0;
+
+	while( result == 0 )
+	{
+		newest_copy_index = -1;
+
+		for( copy_iterator = 0;
+		     copy_iterator < number_of_copies;
+		     copy_iterator++ )
+		{
+			if( copy_is_valid[ copy_iterator ] == 0 )
+			{
+				continue;
+			}
+			if( ( newest_copy_index == -1 )
+			 || ( transaction_numbers[ copy_iterator ] > transaction_numbers[ newest_copy_index ] )
+			 || ( ( transaction_numbers[ copy_iterator ] == transaction_numbers[ newest_copy_index ] )
+			  &&  ( serial_numbers[ copy_iterator ] > serial_numbers[ newest_copy_index ] ) ) )
+			{
+				newest_copy_index = copy_iterator;
+			}
+		}
+		if( newest_copy_index == -1 )
+		{
+			break;
+		}
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: reading metadata of copy: %d with transaction number: %" PRIu64 "\n",
+			 function,
+			 newest_copy_index,
+			 transaction_numbers[ newest_copy_index ] );
+		}
+#endif
+		result = libfvde_metadata_read(
+		          metadata,
+		          io_handle,
+		          file_io_handle,
+		          file_offsets[ newest_copy_index ],
+		          error );
+
+		if( result != 1 )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( ( libcnotify_verbose != 0 )
+			 && ( error != NULL ) )
+			{
+				libcnotify_print_error_backtrace(
+				 *error );
+			}
+#endif
+			libcerror_error_free(
+			 error );
+
+			copy_is_valid[ newest_copy_index ] = 0;
+
+			result = 0;
+		}
+	}
+	if( result == 1 )
+	{
+		*copy_index = newest_copy_index;
+	}
+	return( result );
+
+on_error:
+	if( metadata_block != NULL )
+	{
+		libfvde_metadata_block_free(
+		 &metadata_block,
+		 NULL );
+	}
+	if( metadata_block_data != NULL )
+	{
+		memory_free(
+		 metadata_block_data );
+	}
+	return( -1 );
+}
+
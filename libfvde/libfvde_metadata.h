@@ -78,6 +78,15 @@ int libfvde_metadata_read(
      off64_t file_offset,
      libcerror_error_t **error );
 
+int libfvde_metadata_read_newest(
+     libfvde_metadata_t *metadata,
+     libfvde_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     const off64_t *file_offsets,
+     int number_of_copies,
+     int *copy_index,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
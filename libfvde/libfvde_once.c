@@ -0,0 +1,69 @@
+/*
+ * Once functions
+ *
+ * Copyright (C) 2011-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <types.h>
+
+#include "libfvde_once.h"
+
+/* Calls a function once
+ * Other threads that call this function with the same once value wait until the function has been called
+ */
+void libfvde_once_call(
+      libfvde_once_t *once,
+      void (*function)( void ) )
+{
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && defined( WINAPI )
+	/* State 0 represents not called, 1 calling and 2 called
+	 */
+	if( InterlockedCompareExchange(
+	     once,
+	     1,
+	     0 ) == 0 )
+	{
+		function();
+
+		InterlockedExchange(
+		 once,
+		 2 );
+	}
+	while( InterlockedCompareExchange(
+	        once,
+	        2,
+	        2 ) != 2 )
+	{
+		Sleep(
+		 0 );
+	}
+#elif defined( HAVE_MULTI_THREAD_SUPPORT ) && defined( HAVE_PTHREAD_H )
+	pthread_once(
+	 once,
+	 function );
+#else
+	if( *once == 0 )
+	{
+		function();
+
+		*once = 1;
+	}
+#endif
+}
+
@@ -0,0 +1,64 @@
+/*
+ * Once functions
+ *
+ * Copyright (C) 2011-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFVDE_ONCE_H )
+#define _LIBFVDE_ONCE_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
+#include <pthread.h>
+#endif
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The once value, the function is called only once, also when used by multiple threads
+ */
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && defined( WINAPI )
+typedef LONG volatile libfvde_once_t;
+
+#define LIBFVDE_ONCE_INITIALIZER	0
+
+#elif defined( HAVE_MULTI_THREAD_SUPPORT ) && defined( HAVE_PTHREAD_H )
+typedef pthread_once_t libfvde_once_t;
+
+#define LIBFVDE_ONCE_INITIALIZER	PTHREAD_ONCE_INIT
+
+#else
+typedef int libfvde_once_t;
+
+#define LIBFVDE_ONCE_INITIALIZER	0
+
+#endif
+
+void libfvde_once_call(
+      libfvde_once_t *once,
+      void (*function)( void ) );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFVDE_ONCE_H ) */
+
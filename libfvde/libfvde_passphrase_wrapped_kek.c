@@ -0,0 +1,614 @@
+/*
+ * Passphrase wrapped KEK functions
+ *
+ * Copyright (C) 2011-2018, Omar Choudary <choudary.omar@gmail.com>
+ *                          Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfvde_encryption.h"
+#include "libfvde_libcaes.h"
+#include "libfvde_libcerror.h"
+#include "libfvde_libcnotify.h"
+#include "libfvde_passphrase_wrapped_kek.h"
+#include "libfvde_password.h"
+
+/* The initialization vector of an AES key wrapped KEK
+ */
+static const uint8_t libfvde_passphrase_wrapped_kek_initialization_vector[ 8 ] = \
+	{ 0xa6, 0xa6, 0xa6, 0xa6, 0xa6, 0xa6, 0xa6, 0xa6 };
+
+/* Creates a passphrase wrapped KEK
+ * Make sure the value passphrase_wrapped_kek is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_passphrase_wrapped_kek_initialize(
+     libfvde_passphrase_wrapped_kek_t **passphrase_wrapped_kek,
+     libcerror_error_t **error )
+{
+	static char *function = "libfvde_passphrase_wrapped_kek_initialize";
+
+	if( passphrase_wrapped_kek == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid passphrase wrapped KEK.",
+		 function );
+
+		return( -1 );
+	}
+	if( *passphrase_wrapped_kek != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid passphrase wrapped KEK value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*passphrase_wrapped_kek = memory_allocate_structure(
+	                           libfvde_passphrase_wrapped_kek_t );
+
+	if( *passphrase_wrapped_kek == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create passphrase wrapped KEK.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *passphrase_wrapped_kek,
+	     0,
+	     sizeof( libfvde_passphrase_wrapped_kek_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear passphrase wrapped KEK.",
+		 function );
+
+		memory_free(
+		 *passphrase_wrapped_kek );
+
+		*passphrase_wrapped_kek = NULL;
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	if( *passphrase_wrapped_kek != NULL )
+	{
+		memory_free(
+		 *passphrase_wrapped_kek );
+
+		*passphrase_wrapped_kek = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a passphrase wrapped KEK
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_passphrase_wrapped_kek_free(
+     libfvde_passphrase_wrapped_kek_t **passphrase_wrapped_kek,
+     libcerror_error_t **error )
+{
+	static char *function = "libfvde_passphrase_wrapped_kek_free";
+	int result            = 1;
+
+	if( passphrase_wrapped_kek == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid passphrase wrapped KEK.",
+		 function );
+
+		return( -1 );
+	}
+	if( *passphrase_wrapped_kek != NULL )
+	{
+		if( memory_set(
+		     *passphrase_wrapped_kek,
+		     0,
+		     sizeof( libfvde_passphrase_wrapped_kek_t ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear passphrase wrapped KEK.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *passphrase_wrapped_kek );
+
+		*passphrase_wrapped_kek = NULL;
+	}
+	return( result );
+}
+
+/* Reads a passphrase wrapped KEK
+ * The data is the PassphraseWrappedKEKStruct value of a crypto user
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_passphrase_wrapped_kek_read_data(
+     libfvde_passphrase_wrapped_kek_t *passphrase_wrapped_kek,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libfvde_passphrase_wrapped_kek_read_data";
+	uint32_t value_size   = 0;
+	uint32_t value_type   = 0;
+
+	if( passphrase_wrapped_kek == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid passphrase wrapped KEK.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size != 284 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 &( data[ 0 ] ),
+	 value_type );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 &( data[ 4 ] ),
+	 value_size );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: value type\t\t: 0x%08" PRIx32 "\n",
+		 function,
+		 value_type );
+
+		libcnotify_printf(
+		 "%s: value size\t\t: %" PRIu32 "\n",
+		 function,
+		 value_size );
+	}
+#endif
+	if( value_type != 0x00000003UL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported salt value type.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_size != 16 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported salt value size.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     passphrase_wrapped_kek->salt,
+	     &( data[ 8 ] ),
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy salt.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: salt:\n",
+		 function );
+		libcnotify_print_data(
+		 passphrase_wrapped_kek->salt,
+		 16,
+		 0 );
+	}
+#endif
+	byte_stream_copy_to_uint32_little_endian(
+	 &( data[ 24 ] ),
+	 value_type );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 &( data[ 28 ] ),
+	 value_size );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: value type\t\t: 0x%08" PRIx32 "\n",
+		 function,
+		 value_type );
+
+		libcnotify_printf(
+		 "%s: value size\t\t: %" PRIu32 "\n",
+		 function,
+		 value_size );
+	}
+#endif
+	if( value_type != 0x00000010UL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported wrapped KEK value type.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_size != 24 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported wrapped KEK value size.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     passphrase_wrapped_kek->wrapped_kek,
+	     &( data[ 32 ] ),
+	     24 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy wrapped KEK.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 &( data[ 168 ] ),
+	 passphrase_wrapped_kek->number_of_iterations );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: wrapped KEK:\n",
+		 function );
+		libcnotify_print_data(
+		 passphrase_wrapped_kek->wrapped_kek,
+		 24,
+		 0 );
+
+		libcnotify_printf(
+		 "%s: number of iterations\t: %" PRIu32 "\n",
+		 function,
+		 passphrase_wrapped_kek->number_of_iterations );
+
+		libcnotify_printf(
+		 "\n" );
+	}
+#endif
+	return( 1 );
+}
+
+/* Determines which of multiple passwords unwraps the passphrase wrapped KEK
+ * The password keys are derived in a batch, using the multi-buffer PBKDF2 if supported by the CPU
+ * Returns 1 if one of the passwords unwraps the KEK, 0 if none or -1 on error
+ */
+int libfvde_passphrase_wrapped_kek_check_passwords(
+     libfvde_passphrase_wrapped_kek_t *passphrase_wrapped_kek,
+     const uint8_t **passwords,
+     const size_t *password_sizes,
+     int number_of_passwords,
+     int *password_index,
+     libcerror_error_t **error )
+{
+	uint8_t unwrapped_kek[ 24 ];
+
+	libcaes_context_t *aes_context = NULL;
+	uint8_t *password_keys         = NULL;
+	static char *function          = "libfvde_passphrase_wrapped_kek_check_passwords";
+	size_t password_keys_size      = 0;
+	int result                     = 0;
+	int safe_password_index        = 0;
+
+	if( passphrase_wrapped_kek == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid passphrase wrapped KEK.",
+		 function );
+
+		return( -1 );
+	}
+	if( passwords == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid passwords.",
+		 function );
+
+		return( -1 );
+	}
+	if( password_sizes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid password sizes.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_passwords <= 0 )
+	 || ( (size_t) number_of_passwords > ( (size_t) SSIZE_MAX / 16 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of passwords value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( password_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid password index.",
+		 function );
+
+		return( -1 );
+	}
+	password_keys_size = (size_t) number_of_passwords * 16;
+
+	password_keys = (uint8_t *) memory_allocate(
+	                             sizeof( uint8_t ) * password_keys_size );
+
+	if( password_keys == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create password keys.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfvde_password_pbkdf2_batch(
+	     passwords,
+	     password_sizes,
+	     number_of_passwords,
+	     passphrase_wrapped_kek->salt,
+	     16,
+	     passphrase_wrapped_kek->number_of_iterations,
+	     password_keys,
+	     password_keys_size,
+	     16,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine password keys.",
+		 function );
+
+		goto on_error;
+	}
+	/* The same AES context is used to unwrap the KEK with all password keys
+	 */
+	if( libcaes_context_initialize(
+	     &aes_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize AES context.",
+		 function );
+
+		goto on_error;
+	}
+	for( safe_password_index = 0;
+	     safe_password_index < number_of_passwords;
+	     safe_password_index++ )
+	{
+		if( libcaes_context_set_key(
+		     aes_context,
+		     LIBCAES_CRYPT_MODE_DECRYPT,
+		     &( password_keys[ safe_password_index * 16 ] ),
+		     16 * 8,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set password key: %d in AES context.",
+			 function,
+			 safe_password_index );
+
+			goto on_error;
+		}
+		if( libfvde_encryption_aes_key_unwrap_with_context(
+		     aes_context,
+		     passphrase_wrapped_kek->wrapped_kek,
+		     24,
+		     unwrapped_kek,
+		     24,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to unwrap KEK with password key: %d.",
+			 function,
+			 safe_password_index );
+
+			goto on_error;
+		}
+		if( memory_compare(
+		     unwrapped_kek,
+		     libfvde_passphrase_wrapped_kek_initialization_vector,
+		     8 ) == 0 )
+		{
+			*password_index = safe_password_index;
+
+			result = 1;
+
+			break;
+		}
+	}
+	if( libcaes_context_free(
+	     &aes_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free AES context.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     unwrapped_kek,
+	     0,
+	     24 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear unwrapped KEK.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     password_keys,
+	     0,
+	     password_keys_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear password keys.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 password_keys );
+
+	return( result );
+
+on_error:
+	if( aes_context != NULL )
+	{
+		libcaes_context_free(
+		 &aes_context,
+		 NULL );
+	}
+	memory_set(
+	 unwrapped_kek,
+	 0,
+	 24 );
+
+	if( password_keys != NULL )
+	{
+		memory_set(
+		 password_keys,
+		 0,
+		 password_keys_size );
+		memory_free(
+		 password_keys );
+	}
+	return( -1 );
+}
+
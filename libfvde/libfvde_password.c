@@ -30,6 +30,7 @@
 #include "libfvde_libcnotify.h"
 #include "libfvde_libhmac.h"
 #include "libfvde_password.h"
+#include "libfvde_sha256_multi_buffer.h"
 
 /* Compute a PBKDF2-derived key from the given input.
  * Returns 1 if successful or -1 on error
@@ -46,18 +47,19 @@ int libfvde_password_pbkdf2(
 {
 	uint8_t hash_buffer[ LIBHMAC_SHA256_HASH_SIZE ];
 
-	uint8_t *data_buffer       = NULL;
-	uint8_t *output_ptr        = NULL;
-	static char *function      = "libfvde_password_pbkdf2";
-	size_t block_offset        = 0;
-	size_t data_buffer_size    = 0;
-	size_t hash_size           = LIBHMAC_SHA256_HASH_SIZE;
-	size_t remaining_data_size = 0;
-	uint32_t block_index       = 0;
-	uint32_t byte_index        = 0;
-	uint32_t number_of_blocks  = 0;
-	uint32_t password_iterator = 0;
-	int result                 = 0;
+	libhmac_sha256_hmac_context_t *hmac_context = NULL;
+	uint8_t *data_buffer                        = NULL;
+	uint8_t *output_ptr                         = NULL;
+	static char *function                       = "libfvde_password_pbkdf2";
+	size_t block_offset                         = 0;
+	size_t data_buffer_size                     = 0;
+	size_t hash_size                            = LIBHMAC_SHA256_HASH_SIZE;
+	size_t remaining_data_size                  = 0;
+	uint32_t block_index                        = 0;
+	uint32_t byte_index                         = 0;
+	uint32_t number_of_blocks                   = 0;
+	uint32_t password_iterator                  = 0;
+	int result                                  = 0;
 
 	if( password == NULL )
 	{
@@ -235,6 +237,23 @@ int libfvde_password_pbkdf2(
 		 "\n" );
 	}
 #endif
+	/* The password is the HMAC key of every iteration, pad and hash it only once
+	 */
+	if( libhmac_sha256_hmac_initialize(
+	     &hmac_context,
+	     password,
+	     password_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create HMAC context.",
+		 function );
+
+		goto on_error;
+	}
 	for( block_index = 0;
 	     block_index < number_of_blocks;
 	     block_index++ )
@@ -245,9 +264,8 @@ int libfvde_password_pbkdf2(
 		 &( data_buffer[ salt_size ] ),
 		 block_index + 1 );
 
-               	result = libhmac_sha256_calculate_hmac(
-		          password,
-		          password_size,
+		result = libhmac_sha256_hmac_calculate(
+		          hmac_context,
 		          data_buffer,
 		          data_buffer_size,
 		          hash_buffer,
@@ -284,9 +302,8 @@ int libfvde_password_pbkdf2(
 		     password_iterator < number_of_iterations - 1;
 		     password_iterator++ )
 		{
-			result = libhmac_sha256_calculate_hmac(
-			          password,
-			          password_size,
+			result = libhmac_sha256_hmac_calculate(
+			          hmac_context,
 			          hash_buffer,
 			          hash_size,
 			          hash_buffer,
@@ -322,9 +339,8 @@ int libfvde_password_pbkdf2(
 		 &( data_buffer[ salt_size ] ),
 		 block_index + 1 );
 
-		result = libhmac_sha256_calculate_hmac(
-		          password,
-		          password_size,
+		result = libhmac_sha256_hmac_calculate(
+		          hmac_context,
 		          data_buffer,
 		          data_buffer_size,
 		          hash_buffer,
@@ -361,9 +377,8 @@ int libfvde_password_pbkdf2(
 		     password_iterator < number_of_iterations - 1;
 		     password_iterator++ )
 		{
-			result = libhmac_sha256_calculate_hmac(
-			          password,
-			          password_size,
+			result = libhmac_sha256_hmac_calculate(
+			          hmac_context,
 			          hash_buffer,
 			          hash_size,
 			          hash_buffer,
@@ -390,6 +405,19 @@ int libfvde_password_pbkdf2(
 			}
 		}
 	}
+	if( libhmac_sha256_hmac_free(
+	     &hmac_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free HMAC context.",
+		 function );
+
+		goto on_error;
+	}
 	if( data_buffer != NULL )
 	{
 		memory_free(
@@ -398,6 +426,12 @@ int libfvde_password_pbkdf2(
 	return( 1 );
 
 on_error:
+	if( hmac_context != NULL )
+	{
+		libhmac_sha256_hmac_free(
+		 &hmac_context,
+		 NULL );
+	}
 	if( data_buffer != NULL )
 	{
 		memory_free(
@@ -406,3 +440,603 @@ on_error:
 	return( -1 );
 }
 
+/* Compute PBKDF2-derived keys for multiple passwords that share the same salt and number of iterations
+ * The keys are stored consecutively in the output data, each key is key_size bytes
+ * If the CPU supports it the passwords are processed in parallel, one password per SIMD lane
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_password_pbkdf2_batch(
+     const uint8_t **passwords,
+     const size_t *password_sizes,
+     int number_of_passwords,
+     const uint8_t *salt,
+     size_t salt_size,
+     uint32_t number_of_iterations,
+     uint8_t *output_data,
+     size_t output_data_size,
+     size_t key_size,
+     libcerror_error_t **error )
+{
+	uint32_t block_values[ 16 * LIBFVDE_SHA256_MULTI_BUFFER_MAXIMUM_NUMBER_OF_LANES ];
+	uint32_t hash_values[ 8 * LIBFVDE_SHA256_MULTI_BUFFER_MAXIMUM_NUMBER_OF_LANES ];
+	uint32_t inner_hash_values[ 8 * LIBFVDE_SHA256_MULTI_BUFFER_MAXIMUM_NUMBER_OF_LANES ];
+	uint32_t key_values[ 16 * LIBFVDE_SHA256_MULTI_BUFFER_MAXIMUM_NUMBER_OF_LANES ];
+	uint32_t outer_hash_values[ 8 * LIBFVDE_SHA256_MULTI_BUFFER_MAXIMUM_NUMBER_OF_LANES ];
+	uint32_t xor_values[ 8 * LIBFVDE_SHA256_MULTI_BUFFER_MAXIMUM_NUMBER_OF_LANES ];
+	uint8_t hash_buffer[ LIBHMAC_SHA256_HASH_SIZE ];
+	uint8_t key_data[ 64 ];
+
+	const uint8_t *password     = NULL;
+	uint8_t *salt_data          = NULL;
+	static char *function       = "libfvde_password_pbkdf2_batch";
+	size_t block_offset         = 0;
+	size_t copy_size            = 0;
+	size_t password_size        = 0;
+	size_t salt_data_offset     = 0;
+	size_t salt_data_size       = 0;
+	uint64_t message_size       = 0;
+	uint32_t block_index        = 0;
+	uint32_t password_iterator  = 0;
+	uint32_t value_32bit        = 0;
+	int lane_index              = 0;
+	int number_of_lanes         = 0;
+	int number_of_used_lanes    = 0;
+	int password_index          = 0;
+	int value_index             = 0;
+
+	if( passwords == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid passwords.",
+		 function );
+
+		return( -1 );
+	}
+	if( password_sizes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid password sizes.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_passwords < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of passwords value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( salt == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid salt.",
+		 function );
+
+		return( -1 );
+	}
+	if( salt_size > (size_t) ( SSIZE_MAX - 128 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid salt size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_iterations == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of iterations value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output data.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid output data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( key_size == 0 )
+	 || ( key_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid key size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size_t) number_of_passwords > ( output_data_size / key_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid output data size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	for( password_index = 0;
+	     password_index < number_of_passwords;
+	     password_index++ )
+	{
+		if( passwords[ password_index ] == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid password: %d.",
+			 function,
+			 password_index );
+
+			return( -1 );
+		}
+	}
+	number_of_lanes = libfvde_sha256_multi_buffer_get_number_of_lanes();
+
+	if( number_of_lanes == 0 )
+	{
+		for( password_index = 0;
+		     password_index < number_of_passwords;
+		     password_index++ )
+		{
+			if( libfvde_password_pbkdf2(
+			     passwords[ password_index ],
+			     password_sizes[ password_index ],
+			     salt,
+			     salt_size,
+			     number_of_iterations,
+			     &( output_data[ password_index * key_size ] ),
+			     key_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to compute PBKDF2 of password: %d.",
+				 function,
+				 password_index );
+
+				return( -1 );
+			}
+		}
+		return( 1 );
+	}
+	/* The first HMAC of every block hashes the salt and the block number
+	 * the resulting message is the same in all lanes
+	 */
+	salt_data_size = ( ( salt_size + 4 + 1 + 8 + 63 ) / 64 ) * 64;
+
+	salt_data = (uint8_t *) memory_allocate(
+	                         sizeof( uint8_t ) * salt_data_size );
+
+	if( salt_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create salt data.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     salt_data,
+	     0,
+	     salt_data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear salt data.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     salt_data,
+	     salt,
+	     salt_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy salt into salt data.",
+		 function );
+
+		goto on_error;
+	}
+	salt_data[ salt_size + 4 ] = 0x80;
+
+	/* The message size in bits includes the key block
+	 */
+	message_size = (uint64_t) ( 64 + salt_size + 4 ) * 8;
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( salt_data[ salt_data_size - 8 ] ),
+	 message_size );
+
+	if( memory_set(
+	     key_values,
+	     0,
+	     sizeof( uint32_t ) * 16 * LIBFVDE_SHA256_MULTI_BUFFER_MAXIMUM_NUMBER_OF_LANES ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear key values.",
+		 function );
+
+		goto on_error;
+	}
+	for( password_index = 0;
+	     password_index < number_of_passwords;
+	     password_index += number_of_lanes )
+	{
+		number_of_used_lanes = number_of_passwords - password_index;
+
+		if( number_of_used_lanes > number_of_lanes )
+		{
+			number_of_used_lanes = number_of_lanes;
+		}
+		/* Unused lanes repeat the first password of the group
+		 */
+		for( lane_index = 0;
+		     lane_index < number_of_lanes;
+		     lane_index++ )
+		{
+			if( lane_index < number_of_used_lanes )
+			{
+				password      = passwords[ password_index + lane_index ];
+				password_size = password_sizes[ password_index + lane_index ];
+			}
+			else
+			{
+				password      = passwords[ password_index ];
+				password_size = password_sizes[ password_index ];
+			}
+			if( memory_set(
+			     key_data,
+			     0,
+			     64 ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear key data.",
+				 function );
+
+				goto on_error;
+			}
+			if( password_size <= 64 )
+			{
+				if( memory_copy(
+				     key_data,
+				     password,
+				     password_size ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+					 "%s: unable to copy password into key data.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			else if( libhmac_sha256_calculate(
+			          password,
+			          password_size,
+			          key_data,
+			          LIBHMAC_SHA256_HASH_SIZE,
+			          error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to calculate password hash.",
+				 function );
+
+				goto on_error;
+			}
+			for( value_index = 0;
+			     value_index < 16;
+			     value_index++ )
+			{
+				byte_stream_copy_to_uint32_big_endian(
+				 &( key_data[ value_index * 4 ] ),
+				 key_values[ ( value_index * LIBFVDE_SHA256_MULTI_BUFFER_MAXIMUM_NUMBER_OF_LANES ) + lane_index ] );
+			}
+		}
+		/* Calculate the inner and outer HMAC states of the keys
+		 */
+		for( value_index = 0;
+		     value_index < 16 * LIBFVDE_SHA256_MULTI_BUFFER_MAXIMUM_NUMBER_OF_LANES;
+		     value_index++ )
+		{
+			block_values[ value_index ] = key_values[ value_index ] ^ 0x36363636UL;
+		}
+		libfvde_sha256_multi_buffer_initialize_hash_values(
+		 inner_hash_values );
+
+		libfvde_sha256_multi_buffer_transform(
+		 inner_hash_values,
+		 block_values );
+
+		for( value_index = 0;
+		     value_index < 16 * LIBFVDE_SHA256_MULTI_BUFFER_MAXIMUM_NUMBER_OF_LANES;
+		     value_index++ )
+		{
+			block_values[ value_index ] = key_values[ value_index ] ^ 0x5c5c5c5cUL;
+		}
+		libfvde_sha256_multi_buffer_initialize_hash_values(
+		 outer_hash_values );
+
+		libfvde_sha256_multi_buffer_transform(
+		 outer_hash_values,
+		 block_values );
+
+		for( block_offset = 0;
+		     block_offset < key_size;
+		     block_offset += LIBHMAC_SHA256_HASH_SIZE )
+		{
+			block_index = (uint32_t) ( block_offset / LIBHMAC_SHA256_HASH_SIZE ) + 1;
+
+			byte_stream_copy_from_uint32_big_endian(
+			 &( salt_data[ salt_size ] ),
+			 block_index );
+
+			/* U1 = HMAC( password, salt || block number )
+			 */
+			if( memory_copy(
+			     hash_values,
+			     inner_hash_values,
+			     sizeof( uint32_t ) * 8 * LIBFVDE_SHA256_MULTI_BUFFER_MAXIMUM_NUMBER_OF_LANES ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy inner hash values.",
+				 function );
+
+				goto on_error;
+			}
+			for( salt_data_offset = 0;
+			     salt_data_offset < salt_data_size;
+			     salt_data_offset += 64 )
+			{
+				for( value_index = 0;
+				     value_index < 16;
+				     value_index++ )
+				{
+					byte_stream_copy_to_uint32_big_endian(
+					 &( salt_data[ salt_data_offset + ( value_index * 4 ) ] ),
+					 value_32bit );
+
+					for( lane_index = 0;
+					     lane_index < number_of_lanes;
+					     lane_index++ )
+					{
+						block_values[ ( value_index * LIBFVDE_SHA256_MULTI_BUFFER_MAXIMUM_NUMBER_OF_LANES ) + lane_index ] = value_32bit;
+					}
+				}
+				libfvde_sha256_multi_buffer_transform(
+				 hash_values,
+				 block_values );
+			}
+			/* From here on every block contains a 32 byte hash and the padding
+			 * of a 96 byte message, of which only the hash changes
+			 */
+			for( value_index = 8;
+			     value_index < 16;
+			     value_index++ )
+			{
+				if( value_index == 8 )
+				{
+					value_32bit = 0x80000000UL;
+				}
+				else if( value_index == 15 )
+				{
+					value_32bit = ( 64 + LIBHMAC_SHA256_HASH_SIZE ) * 8;
+				}
+				else
+				{
+					value_32bit = 0;
+				}
+				for( lane_index = 0;
+				     lane_index < number_of_lanes;
+				     lane_index++ )
+				{
+					block_values[ ( value_index * LIBFVDE_SHA256_MULTI_BUFFER_MAXIMUM_NUMBER_OF_LANES ) + lane_index ] = value_32bit;
+				}
+			}
+			for( password_iterator = 0;
+			     password_iterator < number_of_iterations;
+			     password_iterator++ )
+			{
+				if( password_iterator > 0 )
+				{
+					/* Ui = HMAC( password, Ui-1 ) inner hash
+					 */
+					memory_copy(
+					 block_values,
+					 hash_values,
+					 sizeof( uint32_t ) * 8 * LIBFVDE_SHA256_MULTI_BUFFER_MAXIMUM_NUMBER_OF_LANES );
+
+					memory_copy(
+					 hash_values,
+					 inner_hash_values,
+					 sizeof( uint32_t ) * 8 * LIBFVDE_SHA256_MULTI_BUFFER_MAXIMUM_NUMBER_OF_LANES );
+
+					libfvde_sha256_multi_buffer_transform(
+					 hash_values,
+					 block_values );
+				}
+				/* Outer hash
+				 */
+				memory_copy(
+				 block_values,
+				 hash_values,
+				 sizeof( uint32_t ) * 8 * LIBFVDE_SHA256_MULTI_BUFFER_MAXIMUM_NUMBER_OF_LANES );
+
+				memory_copy(
+				 hash_values,
+				 outer_hash_values,
+				 sizeof( uint32_t ) * 8 * LIBFVDE_SHA256_MULTI_BUFFER_MAXIMUM_NUMBER_OF_LANES );
+
+				libfvde_sha256_multi_buffer_transform(
+				 hash_values,
+				 block_values );
+
+				if( password_iterator == 0 )
+				{
+					memory_copy(
+					 xor_values,
+					 hash_values,
+					 sizeof( uint32_t ) * 8 * LIBFVDE_SHA256_MULTI_BUFFER_MAXIMUM_NUMBER_OF_LANES );
+				}
+				else
+				{
+					for( value_index = 0;
+					     value_index < 8 * LIBFVDE_SHA256_MULTI_BUFFER_MAXIMUM_NUMBER_OF_LANES;
+					     value_index++ )
+					{
+						xor_values[ value_index ] ^= hash_values[ value_index ];
+					}
+				}
+			}
+			copy_size = key_size - block_offset;
+
+			if( copy_size > LIBHMAC_SHA256_HASH_SIZE )
+			{
+				copy_size = LIBHMAC_SHA256_HASH_SIZE;
+			}
+			for( lane_index = 0;
+			     lane_index < number_of_used_lanes;
+			     lane_index++ )
+			{
+				for( value_index = 0;
+				     value_index < 8;
+				     value_index++ )
+				{
+					byte_stream_copy_from_uint32_big_endian(
+					 &( hash_buffer[ value_index * 4 ] ),
+					 xor_values[ ( value_index * LIBFVDE_SHA256_MULTI_BUFFER_MAXIMUM_NUMBER_OF_LANES ) + lane_index ] );
+				}
+				if( memory_copy(
+				     &( output_data[ ( ( password_index + lane_index ) * key_size ) + block_offset ] ),
+				     hash_buffer,
+				     copy_size ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+					 "%s: unable to copy hash buffer into output data.",
+					 function );
+
+					goto on_error;
+				}
+			}
+		}
+	}
+	memory_free(
+	 salt_data );
+
+	/* Prevent sensitive data from leaking
+	 */
+	memory_set(
+	 key_data,
+	 0,
+	 64 );
+
+	memory_set(
+	 key_values,
+	 0,
+	 sizeof( uint32_t ) * 16 * LIBFVDE_SHA256_MULTI_BUFFER_MAXIMUM_NUMBER_OF_LANES );
+
+	memory_set(
+	 block_values,
+	 0,
+	 sizeof( uint32_t ) * 16 * LIBFVDE_SHA256_MULTI_BUFFER_MAXIMUM_NUMBER_OF_LANES );
+
+	memory_set(
+	 inner_hash_values,
+	 0,
+	 sizeof( uint32_t ) * 8 * LIBFVDE_SHA256_MULTI_BUFFER_MAXIMUM_NUMBER_OF_LANES );
+
+	memory_set(
+	 outer_hash_values,
+	 0,
+	 sizeof( uint32_t ) * 8 * LIBFVDE_SHA256_MULTI_BUFFER_MAXIMUM_NUMBER_OF_LANES );
+
+	return( 1 );
+
+on_error:
+	if( salt_data != NULL )
+	{
+		memory_free(
+		 salt_data );
+	}
+	memory_set(
+	 key_data,
+	 0,
+	 64 );
+
+	memory_set(
+	 key_values,
+	 0,
+	 sizeof( uint32_t ) * 16 * LIBFVDE_SHA256_MULTI_BUFFER_MAXIMUM_NUMBER_OF_LANES );
+
+	return( -1 );
+}
+
@@ -42,6 +42,18 @@ int libfvde_password_pbkdf2(
      size_t output_data_size,
      libcerror_error_t **error );
 
+int libfvde_password_pbkdf2_batch(
+     const uint8_t **passwords,
+     const size_t *password_sizes,
+     int number_of_passwords,
+     const uint8_t *salt,
+     size_t salt_size,
+     uint32_t number_of_iterations,
+     uint8_t *output_data,
+     size_t output_data_size,
+     size_t key_size,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
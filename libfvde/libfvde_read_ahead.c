@@ -0,0 +1,1204 @@
+/*
+ * Read-ahead functions
+ *
+ * Copyright (C) 2011-2018, Omar Choudary <choudary.omar@gmail.com>
+ *                          Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfvde_definitions.h"
+#include "libfvde_io_handle.h"
+#include "libfvde_libbfio.h"
+#include "libfvde_libcaes.h"
+#include "libfvde_libcerror.h"
+#include "libfvde_libcnotify.h"
+#include "libfvde_libcthreads.h"
+#include "libfvde_read_ahead.h"
+
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+
+/* Creates a read-ahead
+ * Make sure the value read_ahead is referencing, is set to NULL
+ * The read-ahead uses a clone of the file IO handle and its own XTS context
+ * so that the read-ahead thread does not share state with the volume
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_read_ahead_initialize(
+     libfvde_read_ahead_t **read_ahead,
+     libfvde_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     const uint8_t *key,
+     const uint8_t *tweak_key,
+     size_t maximum_window_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libfvde_read_ahead_initialize";
+	int window_index      = 0;
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_ahead != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid read-ahead value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->bytes_per_sector == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid IO handle - bytes per sector value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->is_encrypted != 0 )
+	{
+		if( key == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid key.",
+			 function );
+
+			return( -1 );
+		}
+		if( tweak_key == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid tweak key.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( ( maximum_window_size == 0 )
+	 || ( maximum_window_size > (size_t) LIBFVDE_MAXIMUM_READ_AHEAD_SIZE )
+	 || ( ( maximum_window_size % io_handle->bytes_per_sector ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum window size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*read_ahead = memory_allocate_structure(
+	               libfvde_read_ahead_t );
+
+	if( *read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read-ahead.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *read_ahead,
+	     0,
+	     sizeof( libfvde_read_ahead_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear read-ahead.",
+		 function );
+
+		memory_free(
+		 *read_ahead );
+
+		*read_ahead = NULL;
+
+		return( -1 );
+	}
+	( *read_ahead )->io_handle            = io_handle;
+	( *read_ahead )->maximum_window_size  = maximum_window_size;
+	( *read_ahead )->last_read_end_offset = (off64_t) -1;
+
+	/* The first window is the size of the sector data
+	 * subsequent windows grow while reads remain sequential
+	 */
+	( *read_ahead )->minimum_window_size = io_handle->sector_data_size;
+
+	if( ( ( *read_ahead )->minimum_window_size == 0 )
+	 || ( ( ( *read_ahead )->minimum_window_size % io_handle->bytes_per_sector ) != 0 ) )
+	{
+		( *read_ahead )->minimum_window_size = (size_t) io_handle->bytes_per_sector;
+	}
+	if( ( *read_ahead )->minimum_window_size > maximum_window_size )
+	{
+		( *read_ahead )->minimum_window_size = maximum_window_size;
+	}
+	( *read_ahead )->window_size = ( *read_ahead )->minimum_window_size;
+
+	if( libbfio_handle_clone(
+	     &( ( *read_ahead )->file_io_handle ),
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( io_handle->is_encrypted != 0 )
+	{
+		if( libcaes_tweaked_context_initialize(
+		     &( ( *read_ahead )->xts_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create XTS context.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcaes_tweaked_context_set_keys(
+		     ( *read_ahead )->xts_context,
+		     LIBCAES_CRYPT_MODE_DECRYPT,
+		     key,
+		     128,
+		     tweak_key,
+		     128,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set keys in XTS context.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	for( window_index = 0;
+	     window_index < LIBFVDE_READ_AHEAD_NUMBER_OF_WINDOWS;
+	     window_index++ )
+	{
+		( *read_ahead )->windows[ window_index ].data = (uint8_t *) memory_allocate(
+		                                                             sizeof( uint8_t ) * maximum_window_size );
+
+		if( ( *read_ahead )->windows[ window_index ].data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create window: %d data.",
+			 function,
+			 window_index );
+
+			goto on_error;
+		}
+		( *read_ahead )->windows[ window_index ].state = LIBFVDE_READ_AHEAD_WINDOW_STATE_EMPTY;
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *read_ahead )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *read_ahead )->condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_thread_create(
+	     &( ( *read_ahead )->thread ),
+	     NULL,
+	     &libfvde_read_ahead_thread_callback,
+	     (void *) *read_ahead,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create thread.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *read_ahead != NULL )
+	{
+		libfvde_read_ahead_free(
+		 read_ahead,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a read-ahead
+ * Stops and joins the read-ahead thread if it was started
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_read_ahead_free(
+     libfvde_read_ahead_t **read_ahead,
+     libcerror_error_t **error )
+{
+	static char *function = "libfvde_read_ahead_free";
+	int result            = 1;
+	int window_index      = 0;
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_ahead != NULL )
+	{
+		if( ( *read_ahead )->thread != NULL )
+		{
+			if( libcthreads_mutex_grab(
+			     ( *read_ahead )->mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to grab mutex.",
+				 function );
+
+				return( -1 );
+			}
+			( *read_ahead )->stop_thread = 1;
+
+			if( libcthreads_condition_broadcast(
+			     ( *read_ahead )->condition,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to broadcast condition.",
+				 function );
+
+				result = -1;
+			}
+			if( libcthreads_mutex_release(
+			     ( *read_ahead )->mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release mutex.",
+				 function );
+
+				return( -1 );
+			}
+			if( libcthreads_thread_join(
+			     &( ( *read_ahead )->thread ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join thread.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		if( ( *read_ahead )->condition != NULL )
+		{
+			if( libcthreads_condition_free(
+			     &( ( *read_ahead )->condition ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free condition.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *read_ahead )->mutex != NULL )
+		{
+			if( libcthreads_mutex_free(
+			     &( ( *read_ahead )->mutex ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free mutex.",
+				 function );
+
+				result = -1;
+			}
+		}
+		for( window_index = 0;
+		     window_index < LIBFVDE_READ_AHEAD_NUMBER_OF_WINDOWS;
+		     window_index++ )
+		{
+			if( ( *read_ahead )->windows[ window_index ].data != NULL )
+			{
+				memory_set(
+				 ( *read_ahead )->windows[ window_index ].data,
+				 0,
+				 ( *read_ahead )->maximum_window_size );
+
+				memory_free(
+				 ( *read_ahead )->windows[ window_index ].data );
+			}
+		}
+		if( ( *read_ahead )->xts_context != NULL )
+		{
+			if( libcaes_tweaked_context_free(
+			     &( ( *read_ahead )->xts_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free XTS context.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *read_ahead )->file_io_handle != NULL )
+		{
+			if( libbfio_handle_close(
+			     ( *read_ahead )->file_io_handle,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close file IO handle.",
+				 function );
+
+				result = -1;
+			}
+			if( libbfio_handle_free(
+			     &( ( *read_ahead )->file_io_handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free file IO handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *read_ahead );
+
+		*read_ahead = NULL;
+	}
+	return( result );
+}
+
+/* Reads and decrypts the data of a window
+ * This function is called by the read-ahead thread without holding the mutex
+ * The offset is relative to the start of the logical volume and must be sector aligned
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_read_ahead_read_window(
+     libfvde_read_ahead_t *read_ahead,
+     off64_t offset,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libfvde_read_ahead_read_window";
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( offset < 0 )
+	 || ( ( offset % read_ahead->io_handle->bytes_per_sector ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size == 0 )
+	 || ( data_size > read_ahead->maximum_window_size )
+	 || ( ( data_size % read_ahead->io_handle->bytes_per_sector ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfvde_io_handle_read_logical_volume_data(
+	     read_ahead->io_handle,
+	     read_ahead->file_io_handle,
+	     offset,
+	     data,
+	     data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read window data at offset: %" PRIi64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	if( read_ahead->xts_context != NULL )
+	{
+		if( libfvde_io_handle_decrypt_sectors(
+		     read_ahead->io_handle,
+		     read_ahead->xts_context,
+		     NULL,
+		     offset,
+		     data,
+		     data,
+		     data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+			 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+			 "%s: unable to decrypt window data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* The read-ahead thread callback function
+ * Reads the pending windows, lowest offset first, until the thread is stopped
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_read_ahead_thread_callback(
+     void *arguments )
+{
+	libcerror_error_t *error         = NULL;
+	libfvde_read_ahead_t *read_ahead = NULL;
+	uint8_t *window_data             = NULL;
+	static char *function            = "libfvde_read_ahead_thread_callback";
+	off64_t window_offset            = 0;
+	size_t window_size               = 0;
+	int result                       = 1;
+	int window_index                 = 0;
+	int pending_window_index         = 0;
+
+	if( arguments == NULL )
+	{
+		return( -1 );
+	}
+	read_ahead = (libfvde_read_ahead_t *) arguments;
+
+	if( libcthreads_mutex_grab(
+	     read_ahead->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+	while( read_ahead->stop_thread == 0 )
+	{
+		pending_window_index = -1;
+
+		for( window_index = 0;
+		     window_index < LIBFVDE_READ_AHEAD_NUMBER_OF_WINDOWS;
+		     window_index++ )
+		{
+			if( read_ahead->windows[ window_index ].state != LIBFVDE_READ_AHEAD_WINDOW_STATE_PENDING )
+			{
+				continue;
+			}
+			if( ( pending_window_index == -1 )
+			 || ( read_ahead->windows[ window_index ].offset < read_ahead->windows[ pending_window_index ].offset ) )
+			{
+				pending_window_index = window_index;
+			}
+		}
+		if( pending_window_index == -1 )
+		{
+			if( libcthreads_condition_wait(
+			     read_ahead->condition,
+			     read_ahead->mutex,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to wait for condition.",
+				 function );
+
+				result = -1;
+
+				break;
+			}
+			continue;
+		}
+		read_ahead->windows[ pending_window_index ].state = LIBFVDE_READ_AHEAD_WINDOW_STATE_READING;
+
+		window_data   = read_ahead->windows[ pending_window_index ].data;
+		window_offset = read_ahead->windows[ pending_window_index ].offset;
+		window_size   = read_ahead->windows[ pending_window_index ].size;
+
+		if( libcthreads_mutex_release(
+		     read_ahead->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			goto on_error;
+		}
+		result = libfvde_read_ahead_read_window(
+		          read_ahead,
+		          window_offset,
+		          window_data,
+		          window_size,
+		          &error );
+
+		/* A window that failed is read again by the volume
+		 * which reports the error
+		 */
+		if( result != 1 )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_print_error_backtrace(
+				 error );
+			}
+#endif
+			libcerror_error_free(
+			 &error );
+		}
+		if( libcthreads_mutex_grab(
+		     read_ahead->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			goto on_error;
+		}
+		if( result == 1 )
+		{
+			read_ahead->windows[ pending_window_index ].state = LIBFVDE_READ_AHEAD_WINDOW_STATE_READY;
+		}
+		else
+		{
+			read_ahead->windows[ pending_window_index ].state = LIBFVDE_READ_AHEAD_WINDOW_STATE_FAILED;
+		}
+		result = 1;
+
+		if( libcthreads_condition_broadcast(
+		     read_ahead->condition,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast condition.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     read_ahead->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+	}
+#endif
+	libcerror_error_free(
+	 &error );
+
+	return( -1 );
+}
+
+/* Reads data that has been read ahead into a buffer
+ * Waits for windows that are pending or being read
+ * The offset is relative to the start of the logical volume
+ * Returns the number of bytes read, 0 if the data was not read ahead or -1 on error
+ */
+ssize_t libfvde_read_ahead_read_buffer(
+         libfvde_read_ahead_t *read_ahead,
+         off64_t offset,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libfvde_read_ahead_window_t *window = NULL;
+	static char *function               = "libfvde_read_ahead_read_buffer";
+	size_t buffer_offset                = 0;
+	size_t read_size                    = 0;
+	int window_index                    = 0;
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     read_ahead->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_offset < buffer_size )
+	{
+		window = NULL;
+
+		for( window_index = 0;
+		     window_index < LIBFVDE_READ_AHEAD_NUMBER_OF_WINDOWS;
+		     window_index++ )
+		{
+			if( ( read_ahead->windows[ window_index ].state == LIBFVDE_READ_AHEAD_WINDOW_STATE_EMPTY )
+			 || ( read_ahead->windows[ window_index ].state == LIBFVDE_READ_AHEAD_WINDOW_STATE_FAILED ) )
+			{
+				continue;
+			}
+			if( ( offset >= read_ahead->windows[ window_index ].offset )
+			 && ( offset < ( read_ahead->windows[ window_index ].offset + (off64_t) read_ahead->windows[ window_index ].size ) ) )
+			{
+				window = &( read_ahead->windows[ window_index ] );
+
+				break;
+			}
+		}
+		if( window == NULL )
+		{
+			break;
+		}
+		if( window->state != LIBFVDE_READ_AHEAD_WINDOW_STATE_READY )
+		{
+			if( libcthreads_condition_wait(
+			     read_ahead->condition,
+			     read_ahead->mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to wait for condition.",
+				 function );
+
+				goto on_error;
+			}
+			continue;
+		}
+		read_size = (size_t) ( window->offset + (off64_t) window->size - offset );
+
+		if( read_size > ( buffer_size - buffer_offset ) )
+		{
+			read_size = buffer_size - buffer_offset;
+		}
+		if( memory_copy(
+		     &( buffer[ buffer_offset ] ),
+		     &( window->data[ offset - window->offset ] ),
+		     read_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy window data to buffer.",
+			 function );
+
+			goto on_error;
+		}
+		buffer_offset += read_size;
+		offset        += (off64_t) read_size;
+	}
+	if( libcthreads_mutex_release(
+	     read_ahead->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( (ssize_t) buffer_offset );
+
+on_error:
+	libcthreads_mutex_release(
+	 read_ahead->mutex,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Updates the read-ahead after a read of the volume
+ * When reads are sequential the windows following the read are scheduled
+ * for the read-ahead thread and the window size is increased
+ * The offset is relative to the start of the logical volume
+ * The detection of sequential reads is protected by the mutex, reads from
+ * multiple threads that do not follow each other only reset the window size
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_read_ahead_update(
+     libfvde_read_ahead_t *read_ahead,
+     off64_t offset,
+     size_t read_size,
+     libcerror_error_t **error )
+{
+	libfvde_read_ahead_window_t *window = NULL;
+	static char *function               = "libfvde_read_ahead_update";
+	off64_t end_offset                  = 0;
+	off64_t window_offset               = 0;
+	size_t window_size                  = 0;
+	int iteration                       = 0;
+	int window_index                    = 0;
+	int windows_scheduled               = 0;
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid read size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	end_offset = offset + (off64_t) read_size;
+
+	if( libcthreads_mutex_grab(
+	     read_ahead->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset == read_ahead->last_read_end_offset )
+	{
+		read_ahead->number_of_sequential_reads += 1;
+	}
+	else
+	{
+		read_ahead->number_of_sequential_reads = 0;
+		read_ahead->window_size                = read_ahead->minimum_window_size;
+	}
+	read_ahead->last_read_end_offset = end_offset;
+
+	/* Only read ahead after two consecutive reads
+	 */
+	if( read_ahead->number_of_sequential_reads == 0 )
+	{
+		if( libcthreads_mutex_release(
+		     read_ahead->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	/* A window should at least cover the size of a read
+	 */
+	if( read_ahead->window_size < read_size )
+	{
+		read_ahead->window_size = read_size;
+
+		if( ( read_ahead->window_size % read_ahead->io_handle->bytes_per_sector ) != 0 )
+		{
+			read_ahead->window_size += read_ahead->io_handle->bytes_per_sector
+			                         - ( read_ahead->window_size % read_ahead->io_handle->bytes_per_sector );
+		}
+		if( read_ahead->window_size > read_ahead->maximum_window_size )
+		{
+			read_ahead->window_size = read_ahead->maximum_window_size;
+		}
+	}
+	/* Determine the end of the windows that already follow the read
+	 */
+	window_offset = end_offset - ( end_offset % read_ahead->io_handle->bytes_per_sector );
+
+	for( iteration = 0;
+	     iteration < LIBFVDE_READ_AHEAD_NUMBER_OF_WINDOWS;
+	     iteration++ )
+	{
+		window = NULL;
+
+		for( window_index = 0;
+		     window_index < LIBFVDE_READ_AHEAD_NUMBER_OF_WINDOWS;
+		     window_index++ )
+		{
+			if( ( read_ahead->windows[ window_index ].state == LIBFVDE_READ_AHEAD_WINDOW_STATE_EMPTY )
+			 || ( read_ahead->windows[ window_index ].state == LIBFVDE_READ_AHEAD_WINDOW_STATE_FAILED ) )
+			{
+				continue;
+			}
+			if( ( window_offset >= read_ahead->windows[ window_index ].offset )
+			 && ( window_offset < ( read_ahead->windows[ window_index ].offset + (off64_t) read_ahead->windows[ window_index ].size ) ) )
+			{
+				window = &( read_ahead->windows[ window_index ] );
+
+				break;
+			}
+		}
+		if( window == NULL )
+		{
+			break;
+		}
+		window_offset = window->offset + (off64_t) window->size;
+	}
+	/* Windows that are not being read and that do not follow the read are reused
+	 */
+	for( window_index = 0;
+	     window_index < LIBFVDE_READ_AHEAD_NUMBER_OF_WINDOWS;
+	     window_index++ )
+	{
+		if( (size64_t) window_offset >= read_ahead->io_handle->logical_volume_size )
+		{
+			break;
+		}
+		window = &( read_ahead->windows[ window_index ] );
+
+		if( window->state == LIBFVDE_READ_AHEAD_WINDOW_STATE_READING )
+		{
+			continue;
+		}
+		if( ( window->state != LIBFVDE_READ_AHEAD_WINDOW_STATE_EMPTY )
+		 && ( window->state != LIBFVDE_READ_AHEAD_WINDOW_STATE_FAILED )
+		 && ( ( window->offset + (off64_t) window->size ) > end_offset )
+		 && ( window->offset < window_offset ) )
+		{
+			continue;
+		}
+		window_size = read_ahead->window_size;
+
+		if( (size64_t) window_size > ( read_ahead->io_handle->logical_volume_size - (size64_t) window_offset ) )
+		{
+			window_size  = (size_t) ( read_ahead->io_handle->logical_volume_size - (size64_t) window_offset );
+			window_size -= window_size % read_ahead->io_handle->bytes_per_sector;
+
+			if( window_size == 0 )
+			{
+				break;
+			}
+		}
+		window->offset = window_offset;
+		window->size   = window_size;
+		window->state  = LIBFVDE_READ_AHEAD_WINDOW_STATE_PENDING;
+
+		window_offset += (off64_t) window_size;
+
+		if( read_ahead->window_size < read_ahead->maximum_window_size )
+		{
+			read_ahead->window_size *= 2;
+
+			if( read_ahead->window_size > read_ahead->maximum_window_size )
+			{
+				read_ahead->window_size = read_ahead->maximum_window_size;
+			}
+		}
+		windows_scheduled++;
+	}
+	if( windows_scheduled > 0 )
+	{
+		if( libcthreads_condition_broadcast(
+		     read_ahead->condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast condition.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     read_ahead->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	libcthreads_mutex_release(
+	 read_ahead->mutex,
+	 NULL );
+
+	return( -1 );
+}
+
+#endif /* defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT ) */
+
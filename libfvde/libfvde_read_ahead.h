@@ -0,0 +1,163 @@
+/*
+ * Read-ahead functions
+ *
+ * Copyright (C) 2011-2018, Omar Choudary <choudary.omar@gmail.com>
+ *                          Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFVDE_READ_AHEAD_H )
+#define _LIBFVDE_READ_AHEAD_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfvde_definitions.h"
+#include "libfvde_io_handle.h"
+#include "libfvde_libbfio.h"
+#include "libfvde_libcaes.h"
+#include "libfvde_libcerror.h"
+#include "libfvde_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+
+typedef struct libfvde_read_ahead_window libfvde_read_ahead_window_t;
+
+struct libfvde_read_ahead_window
+{
+	/* The (decrypted) data
+	 */
+	uint8_t *data;
+
+	/* The offset relative to the start of the logical volume
+	 */
+	off64_t offset;
+
+	/* The size
+	 */
+	size_t size;
+
+	/* The state
+	 */
+	int state;
+};
+
+typedef struct libfvde_read_ahead libfvde_read_ahead_t;
+
+struct libfvde_read_ahead
+{
+	/* The IO handle
+	 */
+	libfvde_io_handle_t *io_handle;
+
+	/* The file IO handle, which is a clone of the volume file IO handle
+	 */
+	libbfio_handle_t *file_io_handle;
+
+	/* The XTS context
+	 */
+	libcaes_tweaked_context_t *xts_context;
+
+	/* The minimum window size
+	 */
+	size_t minimum_window_size;
+
+	/* The maximum window size
+	 */
+	size_t maximum_window_size;
+
+	/* The current window size
+	 */
+	size_t window_size;
+
+	/* The end offset of the last read
+	 */
+	off64_t last_read_end_offset;
+
+	/* The number of sequential reads
+	 */
+	int number_of_sequential_reads;
+
+	/* The windows
+	 */
+	libfvde_read_ahead_window_t windows[ LIBFVDE_READ_AHEAD_NUMBER_OF_WINDOWS ];
+
+	/* Value to indicate the read-ahead thread should stop
+	 */
+	uint8_t stop_thread;
+
+	/* The mutex that protects the windows
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition that signals a change of the window states
+	 */
+	libcthreads_condition_t *condition;
+
+	/* The read-ahead thread
+	 */
+	libcthreads_thread_t *thread;
+};
+
+int libfvde_read_ahead_initialize(
+     libfvde_read_ahead_t **read_ahead,
+     libfvde_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     const uint8_t *key,
+     const uint8_t *tweak_key,
+     size_t maximum_window_size,
+     libcerror_error_t **error );
+
+int libfvde_read_ahead_free(
+     libfvde_read_ahead_t **read_ahead,
+     libcerror_error_t **error );
+
+int libfvde_read_ahead_read_window(
+     libfvde_read_ahead_t *read_ahead,
+     off64_t offset,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libfvde_read_ahead_thread_callback(
+     void *arguments );
+
+ssize_t libfvde_read_ahead_read_buffer(
+         libfvde_read_ahead_t *read_ahead,
+         off64_t offset,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error );
+
+int libfvde_read_ahead_update(
+     libfvde_read_ahead_t *read_ahead,
+     off64_t offset,
+     size_t read_size,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFVDE_READ_AHEAD_H ) */
+
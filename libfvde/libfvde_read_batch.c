@@ -0,0 +1,509 @@
+/*
+ * Read batch functions
+ *
+ * Copyright (C) 2011-2018, Omar Choudary <choudary.omar@gmail.com>
+ *                          Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "libfvde_extent_index.h"
+#include "libfvde_io_handle.h"
+#include "libfvde_libcerror.h"
+#include "libfvde_read_batch.h"
+
+/* Creates a read batch
+ * Make sure the value read_batch is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_read_batch_initialize(
+     libfvde_read_batch_t **read_batch,
+     int number_of_requests,
+     libcerror_error_t **error )
+{
+	static char *function = "libfvde_read_batch_initialize";
+
+	if( read_batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read batch.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_batch != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid read batch value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_requests <= 0 )
+	 || ( (size_t) number_of_requests > ( (size_t) SSIZE_MAX / sizeof( libfvde_read_batch_range_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of requests value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*read_batch = memory_allocate_structure(
+	               libfvde_read_batch_t );
+
+	if( *read_batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read batch.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *read_batch,
+	     0,
+	     sizeof( libfvde_read_batch_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear read batch.",
+		 function );
+
+		memory_free(
+		 *read_batch );
+
+		*read_batch = NULL;
+
+		return( -1 );
+	}
+	( *read_batch )->entries = (libfvde_read_batch_entry_t *) memory_allocate(
+	                                                           sizeof( libfvde_read_batch_entry_t ) * number_of_requests );
+
+	if( ( *read_batch )->entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create entries.",
+		 function );
+
+		goto on_error;
+	}
+	( *read_batch )->ranges = (libfvde_read_batch_range_t *) memory_allocate(
+	                                                          sizeof( libfvde_read_batch_range_t ) * number_of_requests );
+
+	if( ( *read_batch )->ranges == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create ranges.",
+		 function );
+
+		goto on_error;
+	}
+	( *read_batch )->maximum_number_of_requests = number_of_requests;
+
+	return( 1 );
+
+on_error:
+	if( *read_batch != NULL )
+	{
+		if( ( *read_batch )->entries != NULL )
+		{
+			memory_free(
+			 ( *read_batch )->entries );
+		}
+		memory_free(
+		 *read_batch );
+
+		*read_batch = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a read batch
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_read_batch_free(
+     libfvde_read_batch_t **read_batch,
+     libcerror_error_t **error )
+{
+	static char *function = "libfvde_read_batch_free";
+
+	if( read_batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read batch.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_batch != NULL )
+	{
+		memory_free(
+		 ( *read_batch )->ranges );
+
+		memory_free(
+		 ( *read_batch )->entries );
+
+		memory_free(
+		 *read_batch );
+
+		*read_batch = NULL;
+	}
+	return( 1 );
+}
+
+/* Compares two read batch entries by offset
+ * Returns -1 if the first entry is smaller, 1 if it is larger or 0 if they are equal
+ */
+static int libfvde_read_batch_compare_entries(
+            const void *first_entry,
+            const void *second_entry )
+{
+	const libfvde_read_batch_entry_t *first  = (const libfvde_read_batch_entry_t *) first_entry;
+	const libfvde_read_batch_entry_t *second = (const libfvde_read_batch_entry_t *) second_entry;
+
+	if( first->offset != second->offset )
+	{
+		return( ( first->offset < second->offset ) ? -1 : 1 );
+	}
+	if( first->request_index != second->request_index )
+	{
+		return( ( first->request_index < second->request_index ) ? -1 : 1 );
+	}
+	return( 0 );
+}
+
+/* Compares two read batch ranges by physical offset
+ * Returns -1 if the first range is smaller, 1 if it is larger or 0 if they are equal
+ */
+static int libfvde_read_batch_compare_ranges(
+            const void *first_range,
+            const void *second_range )
+{
+	const libfvde_read_batch_range_t *first  = (const libfvde_read_batch_range_t *) first_range;
+	const libfvde_read_batch_range_t *second = (const libfvde_read_batch_range_t *) second_range;
+
+	if( first->physical_offset != second->physical_offset )
+	{
+		return( ( first->physical_offset < second->physical_offset ) ? -1 : 1 );
+	}
+	if( first->offset != second->offset )
+	{
+		return( ( first->offset < second->offset ) ? -1 : 1 );
+	}
+	return( 0 );
+}
+
+/* Sets the requests of a read batch
+ * The requests are widened to whole sector data, sorted by offset and coalesced
+ * into ranges, which are sorted by the physical offset of their start
+ * The read counts are set to the number of bytes every request reads from the logical volume
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_read_batch_set_requests(
+     libfvde_read_batch_t *read_batch,
+     libfvde_io_handle_t *io_handle,
+     const off64_t *offsets,
+     const size_t *sizes,
+     ssize_t *read_counts,
+     int number_of_requests,
+     libcerror_error_t **error )
+{
+	libfvde_read_batch_entry_t *entry = NULL;
+	libfvde_read_batch_range_t *range = NULL;
+	static char *function             = "libfvde_read_batch_set_requests";
+	size64_t physical_size            = 0;
+	size_t read_size                  = 0;
+	off64_t end_offset                = 0;
+	off64_t range_end_offset          = 0;
+	int entry_index                   = 0;
+	int range_index                   = 0;
+	int request_index                 = 0;
+	int result                        = 0;
+
+	if( read_batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read batch.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->sector_data_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid IO handle - sector data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offsets.",
+		 function );
+
+		return( -1 );
+	}
+	if( sizes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sizes.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_counts == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read counts.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_requests < 0 )
+	 || ( number_of_requests > read_batch->maximum_number_of_requests ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of requests value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	read_batch->number_of_entries  = 0;
+	read_batch->number_of_ranges   = 0;
+	read_batch->maximum_range_size = 0;
+
+	for( request_index = 0;
+	     request_index < number_of_requests;
+	     request_index++ )
+	{
+		if( offsets[ request_index ] < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid offset: %d value out of bounds.",
+			 function,
+			 request_index );
+
+			return( -1 );
+		}
+		if( sizes[ request_index ] > (size_t) SSIZE_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid size: %d value exceeds maximum.",
+			 function,
+			 request_index );
+
+			return( -1 );
+		}
+		read_counts[ request_index ] = 0;
+
+		if( ( sizes[ request_index ] == 0 )
+		 || ( (size64_t) offsets[ request_index ] >= io_handle->logical_volume_size ) )
+		{
+			continue;
+		}
+		read_size = sizes[ request_index ];
+
+		if( (size64_t) read_size > ( io_handle->logical_volume_size - (size64_t) offsets[ request_index ] ) )
+		{
+			read_size = (size_t) ( io_handle->logical_volume_size - (size64_t) offsets[ request_index ] );
+		}
+		read_counts[ request_index ] = (ssize_t) read_size;
+
+		end_offset = offsets[ request_index ] + (off64_t) read_size;
+
+		if( ( end_offset % io_handle->sector_data_size ) != 0 )
+		{
+			end_offset += io_handle->sector_data_size - ( end_offset % io_handle->sector_data_size );
+		}
+		if( (size64_t) end_offset > io_handle->logical_volume_size )
+		{
+			end_offset = (off64_t) io_handle->logical_volume_size;
+		}
+		entry = &( read_batch->entries[ read_batch->number_of_entries ] );
+
+		entry->offset        = offsets[ request_index ] - ( offsets[ request_index ] % io_handle->sector_data_size );
+		entry->end_offset    = end_offset;
+		entry->request_index = request_index;
+
+		read_batch->number_of_entries += 1;
+	}
+	if( read_batch->number_of_entries == 0 )
+	{
+		return( 1 );
+	}
+	qsort(
+	 read_batch->entries,
+	 (size_t) read_batch->number_of_entries,
+	 sizeof( libfvde_read_batch_entry_t ),
+	 &libfvde_read_batch_compare_entries );
+
+	/* Requests that overlap or are adjacent are coalesced into a single range
+	 * the entries of the requests of a range are consecutive
+	 */
+	range = NULL;
+
+	for( entry_index = 0;
+	     entry_index < read_batch->number_of_entries;
+	     entry_index++ )
+	{
+		entry = &( read_batch->entries[ entry_index ] );
+
+		if( ( range != NULL )
+		 && ( entry->offset <= range_end_offset ) )
+		{
+			if( entry->end_offset > range_end_offset )
+			{
+				range_end_offset = entry->end_offset;
+			}
+			range->number_of_entries += 1;
+		}
+		else
+		{
+			if( range != NULL )
+			{
+				range->size = (size64_t) ( range_end_offset - range->offset );
+			}
+			range = &( read_batch->ranges[ read_batch->number_of_ranges ] );
+
+			range->offset            = entry->offset;
+			range->first_entry_index = entry_index;
+			range->number_of_entries = 1;
+
+			range_end_offset = entry->end_offset;
+
+			read_batch->number_of_ranges += 1;
+		}
+	}
+	range->size = (size64_t) ( range_end_offset - range->offset );
+
+	for( range_index = 0;
+	     range_index < read_batch->number_of_ranges;
+	     range_index++ )
+	{
+		range = &( read_batch->ranges[ range_index ] );
+
+		if( range->size > read_batch->maximum_range_size )
+		{
+			read_batch->maximum_range_size = range->size;
+		}
+		if( io_handle->extent_index == NULL )
+		{
+			range->physical_offset = io_handle->logical_volume_offset + range->offset;
+
+			continue;
+		}
+		result = libfvde_extent_index_get_physical_offset(
+		          io_handle->extent_index,
+		          range->offset,
+		          &( range->physical_offset ),
+		          &physical_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve physical offset of range: %d.",
+			 function,
+			 range_index );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			range->physical_offset = -1;
+		}
+	}
+	/* The ranges are read in the order of their physical offset
+	 */
+	qsort(
+	 read_batch->ranges,
+	 (size_t) read_batch->number_of_ranges,
+	 sizeof( libfvde_read_batch_range_t ),
+	 &libfvde_read_batch_compare_ranges );
+
+	return( 1 );
+}
+
@@ -0,0 +1,131 @@
+/*
+ * Read batch functions
+ *
+ * Copyright (C) 2011-2018, Omar Choudary <choudary.omar@gmail.com>
+ *                          Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFVDE_READ_BATCH_H )
+#define _LIBFVDE_READ_BATCH_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfvde_io_handle.h"
+#include "libfvde_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfvde_read_batch_entry libfvde_read_batch_entry_t;
+
+struct libfvde_read_batch_entry
+{
+	/* The offset of the first sector data of the request
+	 */
+	off64_t offset;
+
+	/* The end offset of the last sector data of the request
+	 */
+	off64_t end_offset;
+
+	/* The index of the request
+	 */
+	int request_index;
+};
+
+typedef struct libfvde_read_batch_range libfvde_read_batch_range_t;
+
+struct libfvde_read_batch_range
+{
+	/* The offset relative to the start of the logical volume
+	 */
+	off64_t offset;
+
+	/* The size
+	 */
+	size64_t size;
+
+	/* The physical offset of the start of the range
+	 * or -1 if the start of the range is not mapped
+	 */
+	off64_t physical_offset;
+
+	/* The index of the first entry of the requests in the range
+	 */
+	int first_entry_index;
+
+	/* The number of entries of the requests in the range
+	 */
+	int number_of_entries;
+};
+
+typedef struct libfvde_read_batch libfvde_read_batch_t;
+
+struct libfvde_read_batch
+{
+	/* The maximum number of requests
+	 */
+	int maximum_number_of_requests;
+
+	/* The entries of the requests sorted by offset
+	 */
+	libfvde_read_batch_entry_t *entries;
+
+	/* The number of entries
+	 */
+	int number_of_entries;
+
+	/* The ranges sorted by physical offset
+	 */
+	libfvde_read_batch_range_t *ranges;
+
+	/* The number of ranges
+	 */
+	int number_of_ranges;
+
+	/* The size of the largest range
+	 */
+	size64_t maximum_range_size;
+};
+
+int libfvde_read_batch_initialize(
+     libfvde_read_batch_t **read_batch,
+     int number_of_requests,
+     libcerror_error_t **error );
+
+int libfvde_read_batch_free(
+     libfvde_read_batch_t **read_batch,
+     libcerror_error_t **error );
+
+int libfvde_read_batch_set_requests(
+     libfvde_read_batch_t *read_batch,
+     libfvde_io_handle_t *io_handle,
+     const off64_t *offsets,
+     const size_t *sizes,
+     ssize_t *read_counts,
+     int number_of_requests,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFVDE_READ_BATCH_H ) */
+
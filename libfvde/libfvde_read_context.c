@@ -0,0 +1,271 @@
+/*
+ * Read context functions
+ *
+ * Copyright (C) 2011-2018, Omar Choudary <choudary.omar@gmail.com>
+ *                          Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfvde_libbfio.h"
+#include "libfvde_libcaes.h"
+#include "libfvde_libcerror.h"
+#include "libfvde_read_context.h"
+
+/* Creates a read context
+ * Make sure the value read_context is referencing, is set to NULL
+ * The key and tweak key are only used when set, for an unencrypted volume they can be NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_read_context_initialize(
+     libfvde_read_context_t **read_context,
+     libbfio_handle_t *file_io_handle,
+     const uint8_t *key,
+     const uint8_t *tweak_key,
+     libcerror_error_t **error )
+{
+	static char *function = "libfvde_read_context_initialize";
+
+	if( read_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_context != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid read context value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( key == NULL )
+	 && ( tweak_key != NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( key != NULL )
+	 && ( tweak_key == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tweak key.",
+		 function );
+
+		return( -1 );
+	}
+	*read_context = memory_allocate_structure(
+	                 libfvde_read_context_t );
+
+	if( *read_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read context.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *read_context,
+	     0,
+	     sizeof( libfvde_read_context_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear read context.",
+		 function );
+
+		memory_free(
+		 *read_context );
+
+		*read_context = NULL;
+
+		return( -1 );
+	}
+	if( libbfio_handle_clone(
+	     &( ( *read_context )->file_io_handle ),
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( key != NULL )
+	{
+		if( libcaes_tweaked_context_initialize(
+		     &( ( *read_context )->xts_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create XTS context.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcaes_tweaked_context_set_keys(
+		     ( *read_context )->xts_context,
+		     LIBCAES_CRYPT_MODE_DECRYPT,
+		     key,
+		     128,
+		     tweak_key,
+		     128,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set keys in XTS context.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( *read_context != NULL )
+	{
+		libfvde_read_context_free(
+		 read_context,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a read context
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_read_context_free(
+     libfvde_read_context_t **read_context,
+     libcerror_error_t **error )
+{
+	static char *function = "libfvde_read_context_free";
+	int result            = 1;
+
+	if( read_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_context != NULL )
+	{
+		if( ( *read_context )->xts_context != NULL )
+		{
+			if( libcaes_tweaked_context_free(
+			     &( ( *read_context )->xts_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free XTS context.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *read_context )->file_io_handle != NULL )
+		{
+			if( libbfio_handle_close(
+			     ( *read_context )->file_io_handle,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close file IO handle.",
+				 function );
+
+				result = -1;
+			}
+			if( libbfio_handle_free(
+			     &( ( *read_context )->file_io_handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free file IO handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *read_context );
+
+		*read_context = NULL;
+	}
+	return( result );
+}
+
@@ -0,0 +1,69 @@
+/*
+ * Read context functions
+ *
+ * Copyright (C) 2011-2018, Omar Choudary <choudary.omar@gmail.com>
+ *                          Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFVDE_READ_CONTEXT_H )
+#define _LIBFVDE_READ_CONTEXT_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfvde_libbfio.h"
+#include "libfvde_libcaes.h"
+#include "libfvde_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfvde_read_context libfvde_read_context_t;
+
+/* The state needed by a single thread to read and decrypt data
+ * independent of other threads reading the same volume
+ */
+struct libfvde_read_context
+{
+	/* The file IO handle, which is a clone of the volume file IO handle
+	 */
+	libbfio_handle_t *file_io_handle;
+
+	/* The XTS context
+	 */
+	libcaes_tweaked_context_t *xts_context;
+};
+
+int libfvde_read_context_initialize(
+     libfvde_read_context_t **read_context,
+     libbfio_handle_t *file_io_handle,
+     const uint8_t *key,
+     const uint8_t *tweak_key,
+     libcerror_error_t **error );
+
+int libfvde_read_context_free(
+     libfvde_read_context_t **read_context,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFVDE_READ_CONTEXT_H ) */
+
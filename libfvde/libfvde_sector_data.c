@@ -36,6 +36,8 @@
 
 /* Creates sector data
  * Make sure the value sector_data is referencing, is set to NULL
+ * The sector data and its data are allocated as a single block
+ * where the data is aligned to LIBFVDE_SECTOR_DATA_ALIGNMENT
  * Returns 1 if successful or -1 on error
  */
 int libfvde_sector_data_initialize(
@@ -43,7 +45,9 @@ int libfvde_sector_data_initialize(
      size_t data_size,
      libcerror_error_t **error )
 {
-	static char *function = "libfvde_sector_data_initialize";
+	static char *function  = "libfvde_sector_data_initialize";
+	size_t allocation_size = 0;
+	intptr_t data_address  = 0;
 
 	if( sector_data == NULL )
 	{
@@ -78,8 +82,14 @@ int libfvde_sector_data_initialize(
 
 		return( -1 );
 	}
-	*sector_data = memory_allocate_structure(
-	                libfvde_sector_data_t );
+	allocation_size = sizeof( libfvde_sector_data_t );
+
+	if( data_size > 0 )
+	{
+		allocation_size += ( LIBFVDE_SECTOR_DATA_ALIGNMENT - 1 ) + data_size;
+	}
+	*sector_data = (libfvde_sector_data_t *) memory_allocate(
+	                                          allocation_size );
 
 	if( *sector_data == NULL )
 	{
@@ -90,7 +100,7 @@ int libfvde_sector_data_initialize(
 		 "%s: unable to sector data.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
 	if( memory_set(
 	     *sector_data,
@@ -113,55 +123,18 @@ int libfvde_sector_data_initialize(
 	}
 	if( data_size > 0 )
 	{
-		( *sector_data )->encrypted_data = (uint8_t *) memory_allocate(
-		                                                sizeof( uint8_t ) * data_size );
-
-		if( ( *sector_data )->encrypted_data == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-			 "%s: unable to create encrypted data.",
-			 function );
-
-			goto on_error;
-		}
-		( *sector_data )->data = (uint8_t *) memory_allocate(
-		                                      sizeof( uint8_t ) * data_size );
+		data_address = (intptr_t) &( ( *sector_data )[ 1 ] );
+		data_address = ( data_address + ( LIBFVDE_SECTOR_DATA_ALIGNMENT - 1 ) ) & ~( (intptr_t) LIBFVDE_SECTOR_DATA_ALIGNMENT - 1 );
 
-		if( ( *sector_data )->data == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-			 "%s: unable to create data.",
-			 function );
-
-			goto on_error;
-		}
-		( *sector_data )->data_size = data_size;
+		( *sector_data )->data                = (uint8_t *) data_address;
+		( *sector_data )->data_size           = data_size;
+		( *sector_data )->allocated_data_size = data_size;
 	}
 	return( 1 );
-
-on_error:
-	if( *sector_data != NULL )
-	{
-		if( ( *sector_data )->encrypted_data != NULL )
-		{
-			memory_free(
-			 ( *sector_data )->encrypted_data );
-		}
-		memory_free(
-		 *sector_data );
-
-		*sector_data = NULL;
-	}
-	return( -1 );
 }
 
 /* Frees sector data
+ * Sector data that is managed by a sector data pool should be released to the pool instead
  * Returns 1 if successful or -1 on error
  */
 int libfvde_sector_data_free(
@@ -189,7 +162,7 @@ int libfvde_sector_data_free(
 			if( memory_set(
 			     ( *sector_data )->data,
 			     0,
-			     ( *sector_data )->data_size ) == NULL )
+			     ( *sector_data )->allocated_data_size ) == NULL )
 			{
 				libcerror_error_set(
 				 error,
@@ -200,13 +173,6 @@ int libfvde_sector_data_free(
 
 				result = -1;
 			}
-			memory_free(
-			 ( *sector_data )->data );
-		}
-		if( ( *sector_data )->encrypted_data != NULL )
-		{
-			memory_free(
-			 ( *sector_data )->encrypted_data );
 		}
 		memory_free(
 		 *sector_data );
@@ -217,22 +183,20 @@ int libfvde_sector_data_free(
 }
 
 /* Reads sector data
+ * The offset is relative to the start of the logical volume
+ * Encrypted sector data is decrypted in place
+ * The sector data size must be a multitude of the bytes per sector
  * Returns 1 if successful or -1 on error
  */
 int libfvde_sector_data_read(
      libfvde_sector_data_t *sector_data,
      libfvde_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
-     off64_t file_offset,
+     off64_t offset,
      libcaes_tweaked_context_t *xts_context,
      libcerror_error_t **error )
 {
-	uint8_t tweak_value[ 16 ];
-
 	static char *function = "libfvde_sector_data_read";
-	off64_t block_offset  = 0;
-	uint64_t block_number = 0;
-	ssize_t read_count    = 0;
 
 	if( sector_data == NULL )
 	{
@@ -245,17 +209,6 @@ int libfvde_sector_data_read(
 
 		return( -1 );
 	}
-	if( sector_data->encrypted_data == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid sector data - missing encrypted data.",
-		 function );
-
-		return( -1 );
-	}
 	if( sector_data->data == NULL )
 	{
 		libcerror_error_set(
@@ -284,45 +237,29 @@ int libfvde_sector_data_read(
 		libcnotify_printf(
 		 "%s: reading sector data at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
 		 function,
-		 file_offset,
-		 file_offset );
+		 offset,
+		 offset );
 	}
 #endif
-	if( libbfio_handle_seek_offset(
+	if( libfvde_io_handle_read_logical_volume_data(
+	     io_handle,
 	     file_io_handle,
-	     file_offset,
-	     SEEK_SET,
-	     error ) == -1 )
+	     offset,
+	     sector_data->data,
+	     sector_data->data_size,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek sector data offset: %" PRIi64 ".",
-		 function,
-		 file_offset );
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read sector data.",
+		 function );
 
 		return( -1 );
 	}
 	if( io_handle->is_encrypted != 0 )
 	{
-		read_count = libbfio_handle_read_buffer(
-			      file_io_handle,
-			      sector_data->encrypted_data,
-			      sector_data->data_size,
-			      error );
-
-		if( read_count != (ssize_t) sector_data->data_size )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read sector data.",
-			 function );
-
-			return( -1 );
-		}
 #if defined( HAVE_DEBUG_OUTPUT )
 		if( libcnotify_verbose != 0 )
 		{
@@ -330,40 +267,20 @@ int libfvde_sector_data_read(
 			 "%s: encrypted sector data:\n",
 			 function );
 			libcnotify_print_data(
-			 sector_data->encrypted_data,
+			 sector_data->data,
 			 sector_data->data_size,
 			 0 );
 		}
 #endif
-		block_offset = file_offset - io_handle->logical_volume_offset;
-
-		block_number = (uint64_t) ( block_offset / io_handle->bytes_per_sector );
-
-		if( memory_set(
-		     tweak_value,
-		     0,
-		     16 ) == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-			 "%s: unable to copy block number to tweak value.",
-			 function );
-
-			return( -1 );
-		}
-		byte_stream_copy_from_uint64_little_endian(
-		 tweak_value,
-		 block_number );
-
-		if( libcaes_crypt_xts(
+		/* The sector data can contain multiple consecutive sectors,
+		 * where each sector uses its own sector number as tweak value
+		 */
+		if( libfvde_io_handle_decrypt_sectors(
+		     io_handle,
 		     xts_context,
-		     LIBCAES_CRYPT_MODE_DECRYPT,
-		     tweak_value,
-		     16,
-		     sector_data->encrypted_data,
-		     sector_data->data_size,
+		     NULL,
+		     offset,
+		     sector_data->data,
 		     sector_data->data,
 		     sector_data->data_size,
 		     error ) != 1 )
@@ -378,26 +295,6 @@ int libfvde_sector_data_read(
 			return( -1 );
 		}
 	}
-	else
-	{
-		read_count = libbfio_handle_read_buffer(
-			      file_io_handle,
-			      sector_data->data,
-			      sector_data->data_size,
-			      error );
-
-		if( read_count != (ssize_t) sector_data->data_size )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read sector data.",
-			 function );
-
-			return( -1 );
-		}
-	}
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
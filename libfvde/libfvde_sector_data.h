@@ -40,17 +40,21 @@ typedef struct libfvde_sector_data libfvde_sector_data_t;
 
 struct libfvde_sector_data
 {
-	/* The encrypted data
-	 */
-	uint8_t *encrypted_data;
-
-	/* The data
+	/* The data, which is decrypted in place
 	 */
 	uint8_t *data;
 
 	/* The data size
 	 */
 	size_t data_size;
+
+	/* The allocated data size
+	 */
+	size_t allocated_data_size;
+
+	/* The sector data pool the sector data is returned to when released
+	 */
+	struct libfvde_sector_data_pool *sector_data_pool;
 };
 
 int libfvde_sector_data_initialize(
@@ -66,7 +70,7 @@ int libfvde_sector_data_read(
      libfvde_sector_data_t *sector_data,
      libfvde_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
-     off64_t file_offset,
+     off64_t offset,
      libcaes_tweaked_context_t *xts_context,
      libcerror_error_t **error );
 
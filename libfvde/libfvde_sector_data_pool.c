@@ -0,0 +1,470 @@
+/*
+ * Sector data pool functions
+ *
+ * Copyright (C) 2011-2018, Omar Choudary <choudary.omar@gmail.com>
+ *                          Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfvde_libcerror.h"
+#include "libfvde_libcthreads.h"
+#include "libfvde_sector_data.h"
+#include "libfvde_sector_data_pool.h"
+
+/* Creates a sector data pool
+ * Make sure the value sector_data_pool is referencing, is set to NULL
+ * The pool keeps up to the maximum number of released sector data for reuse
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_sector_data_pool_initialize(
+     libfvde_sector_data_pool_t **sector_data_pool,
+     size_t data_size,
+     int maximum_number_of_free_sector_data,
+     libcerror_error_t **error )
+{
+	static char *function = "libfvde_sector_data_pool_initialize";
+
+	if( sector_data_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector data pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *sector_data_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid sector data pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size == 0 )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_number_of_free_sector_data <= 0 )
+	 || ( (size_t) maximum_number_of_free_sector_data > ( (size_t) SSIZE_MAX / sizeof( libfvde_sector_data_t * ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of free sector data value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*sector_data_pool = memory_allocate_structure(
+	                     libfvde_sector_data_pool_t );
+
+	if( *sector_data_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create sector data pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *sector_data_pool,
+	     0,
+	     sizeof( libfvde_sector_data_pool_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear sector data pool.",
+		 function );
+
+		memory_free(
+		 *sector_data_pool );
+
+		*sector_data_pool = NULL;
+
+		return( -1 );
+	}
+	( *sector_data_pool )->free_sector_data = (libfvde_sector_data_t **) memory_allocate(
+	                                                                      sizeof( libfvde_sector_data_t * ) * maximum_number_of_free_sector_data );
+
+	if( ( *sector_data_pool )->free_sector_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create free sector data.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *sector_data_pool )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	( *sector_data_pool )->data_size                          = data_size;
+	( *sector_data_pool )->maximum_number_of_free_sector_data = maximum_number_of_free_sector_data;
+
+	return( 1 );
+
+on_error:
+	if( *sector_data_pool != NULL )
+	{
+		if( ( *sector_data_pool )->free_sector_data != NULL )
+		{
+			memory_free(
+			 ( *sector_data_pool )->free_sector_data );
+		}
+		memory_free(
+		 *sector_data_pool );
+
+		*sector_data_pool = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a sector data pool
+ * Sector data that is still in use must be released before the pool is freed
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_sector_data_pool_free(
+     libfvde_sector_data_pool_t **sector_data_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "libfvde_sector_data_pool_free";
+	int result            = 1;
+	int sector_data_index = 0;
+
+	if( sector_data_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector data pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *sector_data_pool != NULL )
+	{
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *sector_data_pool )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		for( sector_data_index = 0;
+		     sector_data_index < ( *sector_data_pool )->number_of_free_sector_data;
+		     sector_data_index++ )
+		{
+			if( libfvde_sector_data_free(
+			     &( ( *sector_data_pool )->free_sector_data[ sector_data_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free sector data: %d.",
+				 function,
+				 sector_data_index );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 ( *sector_data_pool )->free_sector_data );
+
+		memory_free(
+		 *sector_data_pool );
+
+		*sector_data_pool = NULL;
+	}
+	return( result );
+}
+
+/* Retrieves sector data from the pool
+ * Sector data that was released to the pool is reused, otherwise new sector data is created
+ * The data size must not exceed the data size of the pool
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_sector_data_pool_get_sector_data(
+     libfvde_sector_data_pool_t *sector_data_pool,
+     size_t data_size,
+     libfvde_sector_data_t **sector_data,
+     libcerror_error_t **error )
+{
+	libfvde_sector_data_t *safe_sector_data = NULL;
+	static char *function                   = "libfvde_sector_data_pool_get_sector_data";
+
+	if( sector_data_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector data pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size == 0 )
+	 || ( data_size > sector_data_pool->data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( sector_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector data.",
+		 function );
+
+		return( -1 );
+	}
+	if( *sector_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid sector data value already set.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     sector_data_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( sector_data_pool->number_of_free_sector_data > 0 )
+	{
+		sector_data_pool->number_of_free_sector_data -= 1;
+
+		safe_sector_data = sector_data_pool->free_sector_data[ sector_data_pool->number_of_free_sector_data ];
+
+		sector_data_pool->free_sector_data[ sector_data_pool->number_of_free_sector_data ] = NULL;
+	}
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     sector_data_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( safe_sector_data == NULL )
+	{
+		if( libfvde_sector_data_initialize(
+		     &safe_sector_data,
+		     sector_data_pool->data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create sector data.",
+			 function );
+
+			goto on_error;
+		}
+		safe_sector_data->sector_data_pool = sector_data_pool;
+	}
+	safe_sector_data->data_size = data_size;
+
+	*sector_data = safe_sector_data;
+
+	return( 1 );
+
+on_error:
+	if( safe_sector_data != NULL )
+	{
+		libfvde_sector_data_free(
+		 &safe_sector_data,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Releases sector data
+ * Sector data of a pool is kept by the pool for reuse unless the pool is full,
+ * other sector data is freed
+ * This function can be used as the free function of managed sector data
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_sector_data_pool_release_sector_data(
+     libfvde_sector_data_t **sector_data,
+     libcerror_error_t **error )
+{
+	libfvde_sector_data_pool_t *sector_data_pool = NULL;
+	static char *function                        = "libfvde_sector_data_pool_release_sector_data";
+	int is_reused                                = 0;
+
+	if( sector_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector data.",
+		 function );
+
+		return( -1 );
+	}
+	if( *sector_data == NULL )
+	{
+		return( 1 );
+	}
+	sector_data_pool = ( *sector_data )->sector_data_pool;
+
+	if( sector_data_pool != NULL )
+	{
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     sector_data_pool->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		if( sector_data_pool->number_of_free_sector_data < sector_data_pool->maximum_number_of_free_sector_data )
+		{
+			( *sector_data )->data_size = ( *sector_data )->allocated_data_size;
+
+			sector_data_pool->free_sector_data[ sector_data_pool->number_of_free_sector_data ] = *sector_data;
+
+			sector_data_pool->number_of_free_sector_data += 1;
+
+			is_reused = 1;
+		}
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_release(
+		     sector_data_pool->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+	}
+	if( is_reused != 0 )
+	{
+		*sector_data = NULL;
+
+		return( 1 );
+	}
+	if( libfvde_sector_data_free(
+	     sector_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free sector data.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
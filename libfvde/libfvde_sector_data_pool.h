@@ -0,0 +1,89 @@
+/*
+ * Sector data pool functions
+ *
+ * Copyright (C) 2011-2018, Omar Choudary <choudary.omar@gmail.com>
+ *                          Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFVDE_SECTOR_DATA_POOL_H )
+#define _LIBFVDE_SECTOR_DATA_POOL_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfvde_libcerror.h"
+#include "libfvde_libcthreads.h"
+#include "libfvde_sector_data.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfvde_sector_data_pool libfvde_sector_data_pool_t;
+
+struct libfvde_sector_data_pool
+{
+	/* The data size of the sector data
+	 */
+	size_t data_size;
+
+	/* The sector data that is not in use
+	 */
+	libfvde_sector_data_t **free_sector_data;
+
+	/* The number of sector data that is not in use
+	 */
+	int number_of_free_sector_data;
+
+	/* The maximum number of sector data that is not in use
+	 */
+	int maximum_number_of_free_sector_data;
+
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	/* The mutex that protects the sector data that is not in use
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+int libfvde_sector_data_pool_initialize(
+     libfvde_sector_data_pool_t **sector_data_pool,
+     size_t data_size,
+     int maximum_number_of_free_sector_data,
+     libcerror_error_t **error );
+
+int libfvde_sector_data_pool_free(
+     libfvde_sector_data_pool_t **sector_data_pool,
+     libcerror_error_t **error );
+
+int libfvde_sector_data_pool_get_sector_data(
+     libfvde_sector_data_pool_t *sector_data_pool,
+     size_t data_size,
+     libfvde_sector_data_t **sector_data,
+     libcerror_error_t **error );
+
+int libfvde_sector_data_pool_release_sector_data(
+     libfvde_sector_data_t **sector_data,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFVDE_SECTOR_DATA_POOL_H ) */
+
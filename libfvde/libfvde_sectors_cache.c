@@ -0,0 +1,550 @@
+/*
+ * Sectors cache functions
+ *
+ * Copyright (C) 2011-2018, Omar Choudary <choudary.omar@gmail.com>
+ *                          Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfvde_definitions.h"
+#include "libfvde_libcerror.h"
+#include "libfvde_libcthreads.h"
+#include "libfvde_libfcache.h"
+#include "libfvde_sector_data.h"
+#include "libfvde_sector_data_pool.h"
+#include "libfvde_sectors_cache.h"
+
+/* Creates a sectors cache
+ * Make sure the value sectors_cache is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_sectors_cache_initialize(
+     libfvde_sectors_cache_t **sectors_cache,
+     int number_of_cache_entries,
+     libcerror_error_t **error )
+{
+	static char *function                 = "libfvde_sectors_cache_initialize";
+	int number_of_remaining_cache_entries = 0;
+	int number_of_shard_cache_entries     = 0;
+	int shard_index                       = 0;
+
+	if( sectors_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sectors cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *sectors_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid sectors cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_cache_entries <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of cache entries value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	*sectors_cache = memory_allocate_structure(
+	                  libfvde_sectors_cache_t );
+
+	if( *sectors_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create sectors cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *sectors_cache,
+	     0,
+	     sizeof( libfvde_sectors_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear sectors cache.",
+		 function );
+
+		memory_free(
+		 *sectors_cache );
+
+		*sectors_cache = NULL;
+
+		return( -1 );
+	}
+	/* The cache entries are divided over the shards
+	 * so that concurrent reads of different sector data rarely contend for the same lock.
+	 * Every shard is a least recently used cache, hence the number of shards is a power of 2
+	 * that leaves enough entries per shard to prevent conflicting sector data from evicting each other
+	 */
+	( *sectors_cache )->number_of_shards = 1;
+
+	while( ( ( *sectors_cache )->number_of_shards < LIBFVDE_SECTORS_CACHE_MAXIMUM_NUMBER_OF_SHARDS )
+	    && ( ( ( *sectors_cache )->number_of_shards * 2 * LIBFVDE_SECTORS_CACHE_MINIMUM_NUMBER_OF_SHARD_ENTRIES ) <= number_of_cache_entries ) )
+	{
+		( *sectors_cache )->number_of_shards *= 2;
+	}
+	number_of_shard_cache_entries     = number_of_cache_entries / ( *sectors_cache )->number_of_shards;
+	number_of_remaining_cache_entries = number_of_cache_entries % ( *sectors_cache )->number_of_shards;
+
+	for( shard_index = 0;
+	     shard_index < ( *sectors_cache )->number_of_shards;
+	     shard_index++ )
+	{
+		/* The remaining cache entries are divided over the first shards
+		 */
+		if( libfcache_cache_initialize(
+		     &( ( *sectors_cache )->shards[ shard_index ] ),
+		     number_of_shard_cache_entries + ( ( shard_index < number_of_remaining_cache_entries ) ? 1 : 0 ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create shard: %d cache.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_initialize(
+		     &( ( *sectors_cache )->mutexes[ shard_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create shard: %d mutex.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+#endif
+	}
+	return( 1 );
+
+on_error:
+	if( *sectors_cache != NULL )
+	{
+		libfvde_sectors_cache_free(
+		 sectors_cache,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a sectors cache
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_sectors_cache_free(
+     libfvde_sectors_cache_t **sectors_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libfvde_sectors_cache_free";
+	int result            = 1;
+	int shard_index       = 0;
+
+	if( sectors_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sectors cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *sectors_cache != NULL )
+	{
+		for( shard_index = 0;
+		     shard_index < LIBFVDE_SECTORS_CACHE_MAXIMUM_NUMBER_OF_SHARDS;
+		     shard_index++ )
+		{
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+			if( ( *sectors_cache )->mutexes[ shard_index ] != NULL )
+			{
+				if( libcthreads_mutex_free(
+				     &( ( *sectors_cache )->mutexes[ shard_index ] ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free shard: %d mutex.",
+					 function,
+					 shard_index );
+
+					result = -1;
+				}
+			}
+#endif
+			if( ( *sectors_cache )->shards[ shard_index ] != NULL )
+			{
+				if( libfcache_cache_free(
+				     &( ( *sectors_cache )->shards[ shard_index ] ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free shard: %d cache.",
+					 function,
+					 shard_index );
+
+					result = -1;
+				}
+			}
+		}
+		memory_free(
+		 *sectors_cache );
+
+		*sectors_cache = NULL;
+	}
+	return( result );
+}
+
+/* Copies data of cached sector data into a buffer
+ * The data is copied while the shard is locked, hence the sector data
+ * cannot be evicted by another thread while it is being copied
+ * Returns 1 if successful, 0 if the sector data is not cached or -1 on error
+ */
+int libfvde_sectors_cache_copy_data(
+     libfvde_sectors_cache_t *sectors_cache,
+     uint64_t sector_data_index,
+     size_t data_offset,
+     uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	libfcache_cache_value_t *cache_value = NULL;
+	libfvde_sector_data_t *sector_data   = NULL;
+	static char *function                = "libfvde_sectors_cache_copy_data";
+	int result                           = 0;
+	int shard_index                      = 0;
+
+	if( sectors_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sectors cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( sectors_cache->number_of_shards <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid sectors cache - number of shards value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	shard_index = (int) ( sector_data_index % (uint64_t) sectors_cache->number_of_shards );
+
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     sectors_cache->mutexes[ shard_index ],
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab shard: %d mutex.",
+		 function,
+		 shard_index );
+
+		return( -1 );
+	}
+#endif
+	result = libfcache_cache_get_value_by_identifier(
+	          sectors_cache->shards[ shard_index ],
+	          0,
+	          (off64_t) sector_data_index,
+	          0,
+	          &cache_value,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cache value: %" PRIu64 " from shard: %d.",
+		 function,
+		 sector_data_index,
+		 shard_index );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		if( libfcache_cache_value_get_value(
+		     cache_value,
+		     (intptr_t **) &sector_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve sector data from cache value.",
+			 function );
+
+			goto on_error;
+		}
+		if( sector_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing sector data.",
+			 function );
+
+			goto on_error;
+		}
+		if( ( data_offset > sector_data->data_size )
+		 || ( buffer_size > ( sector_data->data_size - data_offset ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid data offset or buffer size value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     buffer,
+		     &( ( sector_data->data )[ data_offset ] ),
+		     buffer_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy sector data to buffer.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     sectors_cache->mutexes[ shard_index ],
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release shard: %d mutex.",
+		 function,
+		 shard_index );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+
+on_error:
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_release(
+	 sectors_cache->mutexes[ shard_index ],
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Sets sector data in the sectors cache
+ * The sectors cache takes over management of the sector data
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_sectors_cache_set_sector_data(
+     libfvde_sectors_cache_t *sectors_cache,
+     uint64_t sector_data_index,
+     libfvde_sector_data_t *sector_data,
+     libcerror_error_t **error )
+{
+	static char *function = "libfvde_sectors_cache_set_sector_data";
+	int shard_index       = 0;
+
+	if( sectors_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sectors cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( sectors_cache->number_of_shards <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid sectors cache - number of shards value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( sector_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector data.",
+		 function );
+
+		return( -1 );
+	}
+	shard_index = (int) ( sector_data_index % (uint64_t) sectors_cache->number_of_shards );
+
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     sectors_cache->mutexes[ shard_index ],
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab shard: %d mutex.",
+		 function,
+		 shard_index );
+
+		return( -1 );
+	}
+#endif
+	/* If another thread cached the same sector data in the meantime
+	 * its value is replaced
+	 */
+	if( libfcache_cache_set_value_by_identifier(
+	     sectors_cache->shards[ shard_index ],
+	     0,
+	     (off64_t) sector_data_index,
+	     0,
+	     (intptr_t *) sector_data,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libfvde_sector_data_pool_release_sector_data,
+	     LIBFCACHE_CACHE_VALUE_FLAG_MANAGED,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set sector data: %" PRIu64 " in shard: %d.",
+		 function,
+		 sector_data_index,
+		 shard_index );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     sectors_cache->mutexes[ shard_index ],
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release shard: %d mutex.",
+		 function,
+		 shard_index );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_release(
+	 sectors_cache->mutexes[ shard_index ],
+	 NULL );
+#endif
+	return( -1 );
+}
+
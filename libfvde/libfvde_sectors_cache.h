@@ -0,0 +1,87 @@
+/*
+ * Sectors cache functions
+ *
+ * Copyright (C) 2011-2018, Omar Choudary <choudary.omar@gmail.com>
+ *                          Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFVDE_SECTORS_CACHE_H )
+#define _LIBFVDE_SECTORS_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfvde_definitions.h"
+#include "libfvde_libcerror.h"
+#include "libfvde_libcthreads.h"
+#include "libfvde_libfcache.h"
+#include "libfvde_sector_data.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfvde_sectors_cache libfvde_sectors_cache_t;
+
+struct libfvde_sectors_cache
+{
+	/* The number of shards
+	 */
+	int number_of_shards;
+
+	/* The shards, every shard is a least recently used cache
+	 * of the sector data with an index modulo the number of shards
+	 */
+	libfcache_cache_t *shards[ LIBFVDE_SECTORS_CACHE_MAXIMUM_NUMBER_OF_SHARDS ];
+
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	/* The mutexes that protect the shards
+	 */
+	libcthreads_mutex_t *mutexes[ LIBFVDE_SECTORS_CACHE_MAXIMUM_NUMBER_OF_SHARDS ];
+#endif
+};
+
+int libfvde_sectors_cache_initialize(
+     libfvde_sectors_cache_t **sectors_cache,
+     int number_of_cache_entries,
+     libcerror_error_t **error );
+
+int libfvde_sectors_cache_free(
+     libfvde_sectors_cache_t **sectors_cache,
+     libcerror_error_t **error );
+
+int libfvde_sectors_cache_copy_data(
+     libfvde_sectors_cache_t *sectors_cache,
+     uint64_t sector_data_index,
+     size_t data_offset,
+     uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+int libfvde_sectors_cache_set_sector_data(
+     libfvde_sectors_cache_t *sectors_cache,
+     uint64_t sector_data_index,
+     libfvde_sector_data_t *sector_data,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFVDE_SECTORS_CACHE_H ) */
+
@@ -0,0 +1,509 @@
+/*
+ * Multi-buffer SHA-256 functions
+ *
+ * Copyright (C) 2011-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <common.h>
+#include <types.h>
+
+#include "libfvde_once.h"
+#include "libfvde_sha256_multi_buffer.h"
+
+/* The multi-buffer SHA-256 functions calculate the SHA-256 block transform
+ * of multiple independent messages in parallel, one message per SIMD lane
+ *
+ * The hash values and block values are stored per 32-bit value, e.g.
+ * hash_values[ value_index * LIBFVDE_SHA256_MULTI_BUFFER_MAXIMUM_NUMBER_OF_LANES + lane_index ]
+ */
+
+#if defined( __GNUC__ ) && ( defined( __x86_64__ ) || defined( __i386__ ) ) && ( ( __GNUC__ >= 5 ) || defined( __clang__ ) )
+#include <cpuid.h>
+#include <immintrin.h>
+
+#define LIBFVDE_HAVE_SHA256_MULTI_BUFFER	1
+#define LIBFVDE_SHA256_MULTI_BUFFER_AVX2_TARGET	__attribute__((target("avx2")))
+#define LIBFVDE_SHA256_MULTI_BUFFER_AVX512_TARGET	__attribute__((target("avx512f")))
+
+#elif defined( _MSC_VER ) && ( _MSC_VER >= 1910 ) && defined( _M_X64 )
+#include <intrin.h>
+#include <immintrin.h>
+
+#define LIBFVDE_HAVE_SHA256_MULTI_BUFFER	1
+#define LIBFVDE_SHA256_MULTI_BUFFER_AVX2_TARGET
+#define LIBFVDE_SHA256_MULTI_BUFFER_AVX512_TARGET
+
+#endif
+
+/* The first 32-bits of the fractional parts of the square roots of the first 8 primes [ 2, 19 ]
+ */
+static const uint32_t libfvde_sha256_multi_buffer_prime_square_roots[ 8 ] = {
+	0x6a09e667UL, 0xbb67ae85UL, 0x3c6ef372UL, 0xa54ff53aUL,
+	0x510e527fUL, 0x9b05688cUL, 0x1f83d9abUL, 0x5be0cd19UL };
+
+#if defined( LIBFVDE_HAVE_SHA256_MULTI_BUFFER )
+
+/* The first 32-bits of the fractional parts of the cube roots of the first 64 primes [ 2, 311 ]
+ */
+static const uint32_t libfvde_sha256_multi_buffer_prime_cube_roots[ 64 ] = {
+	0x428a2f98UL, 0x71374491UL, 0xb5c0fbcfUL, 0xe9b5dba5UL, 0x3956c25bUL, 0x59f111f1UL, 0x923f82a4UL, 0xab1c5ed5UL,
+	0xd807aa98UL, 0x12835b01UL, 0x243185beUL, 0x550c7dc3UL, 0x72be5d74UL, 0x80deb1feUL, 0x9bdc06a7UL, 0xc19bf174UL,
+	0xe49b69c1UL, 0xefbe4786UL, 0x0fc19dc6UL, 0x240ca1ccUL, 0x2de92c6fUL, 0x4a7484aaUL, 0x5cb0a9dcUL, 0x76f988daUL,
+	0x983e5152UL, 0xa831c66dUL, 0xb00327c8UL, 0xbf597fc7UL, 0xc6e00bf3UL, 0xd5a79147UL, 0x06ca6351UL, 0x14292967UL,
+	0x27b70a85UL, 0x2e1b2138UL, 0x4d2c6dfcUL, 0x53380d13UL, 0x650a7354UL, 0x766a0abbUL, 0x81c2c92eUL, 0x92722c85UL,
+	0xa2bfe8a1UL, 0xa81a664bUL, 0xc24b8b70UL, 0xc76c51a3UL, 0xd192e819UL, 0xd6990624UL, 0xf40e3585UL, 0x106aa070UL,
+	0x19a4c116UL, 0x1e376c08UL, 0x2748774cUL, 0x34b0bcb5UL, 0x391c0cb3UL, 0x4ed8aa4aUL, 0x5b9cca4fUL, 0x682e6ff3UL,
+	0x748f82eeUL, 0x78a5636fUL, 0x84c87814UL, 0x8cc70208UL, 0x90befffaUL, 0xa4506cebUL, 0xbef9a3f7UL, 0xc67178f2UL };
+
+#define libfvde_sha256_multi_buffer_avx2_rotate_right( value, number_of_bits ) \
+	_mm256_or_si256( _mm256_srli_epi32( value, number_of_bits ), _mm256_slli_epi32( value, 32 - number_of_bits ) )
+
+/* Calculates the SHA-256 block transform of 8 lanes using AVX2
+ */
+LIBFVDE_SHA256_MULTI_BUFFER_AVX2_TARGET \
+static void libfvde_sha256_multi_buffer_transform_avx2(
+             uint32_t *hash_values,
+             const uint32_t *block_values )
+{
+	__m256i values_32bit[ 16 ];
+	__m256i working_values[ 8 ];
+
+	__m256i s0           = _mm256_setzero_si256();
+	__m256i s1           = _mm256_setzero_si256();
+	__m256i t1           = _mm256_setzero_si256();
+	__m256i t2           = _mm256_setzero_si256();
+	__m256i value_256bit = _mm256_setzero_si256();
+	uint8_t value_index  = 0;
+
+	for( value_index = 0;
+	     value_index < 8;
+	     value_index++ )
+	{
+		working_values[ value_index ] = _mm256_loadu_si256(
+		                                 (const __m256i *) &( hash_values[ value_index * LIBFVDE_SHA256_MULTI_BUFFER_MAXIMUM_NUMBER_OF_LANES ] ) );
+	}
+	for( value_index = 0;
+	     value_index < 64;
+	     value_index++ )
+	{
+		if( value_index < 16 )
+		{
+			value_256bit = _mm256_loadu_si256(
+			                (const __m256i *) &( block_values[ value_index * LIBFVDE_SHA256_MULTI_BUFFER_MAXIMUM_NUMBER_OF_LANES ] ) );
+		}
+		else
+		{
+			/* Extend the message schedule in a 16 x 32-bit values ring
+			 */
+			value_256bit = values_32bit[ ( value_index - 15 ) & 0x0f ];
+
+			s0 = _mm256_xor_si256(
+			      _mm256_xor_si256(
+			       libfvde_sha256_multi_buffer_avx2_rotate_right( value_256bit, 7 ),
+			       libfvde_sha256_multi_buffer_avx2_rotate_right( value_256bit, 18 ) ),
+			      _mm256_srli_epi32( value_256bit, 3 ) );
+
+			value_256bit = values_32bit[ ( value_index - 2 ) & 0x0f ];
+
+			s1 = _mm256_xor_si256(
+			      _mm256_xor_si256(
+			       libfvde_sha256_multi_buffer_avx2_rotate_right( value_256bit, 17 ),
+			       libfvde_sha256_multi_buffer_avx2_rotate_right( value_256bit, 19 ) ),
+			      _mm256_srli_epi32( value_256bit, 10 ) );
+
+			value_256bit = _mm256_add_epi32(
+			                _mm256_add_epi32(
+			                 values_32bit[ value_index & 0x0f ],
+			                 s0 ),
+			                _mm256_add_epi32(
+			                 values_32bit[ ( value_index - 7 ) & 0x0f ],
+			                 s1 ) );
+		}
+		values_32bit[ value_index & 0x0f ] = value_256bit;
+
+		s1 = _mm256_xor_si256(
+		      _mm256_xor_si256(
+		       libfvde_sha256_multi_buffer_avx2_rotate_right( working_values[ 4 ], 6 ),
+		       libfvde_sha256_multi_buffer_avx2_rotate_right( working_values[ 4 ], 11 ) ),
+		      libfvde_sha256_multi_buffer_avx2_rotate_right( working_values[ 4 ], 25 ) );
+
+		t1 = _mm256_add_epi32(
+		      _mm256_add_epi32(
+		       working_values[ 7 ],
+		       s1 ),
+		      _mm256_xor_si256(
+		       _mm256_and_si256(
+		        working_values[ 4 ],
+		        working_values[ 5 ] ),
+		       _mm256_andnot_si256(
+		        working_values[ 4 ],
+		        working_values[ 6 ] ) ) );
+
+		t1 = _mm256_add_epi32(
+		      t1,
+		      _mm256_add_epi32(
+		       _mm256_set1_epi32( (int) libfvde_sha256_multi_buffer_prime_cube_roots[ value_index ] ),
+		       value_256bit ) );
+
+		s0 = _mm256_xor_si256(
+		      _mm256_xor_si256(
+		       libfvde_sha256_multi_buffer_avx2_rotate_right( working_values[ 0 ], 2 ),
+		       libfvde_sha256_multi_buffer_avx2_rotate_right( working_values[ 0 ], 13 ) ),
+		      libfvde_sha256_multi_buffer_avx2_rotate_right( working_values[ 0 ], 22 ) );
+
+		t2 = _mm256_add_epi32(
+		      s0,
+		      _mm256_or_si256(
+		       _mm256_and_si256(
+		        working_values[ 0 ],
+		        working_values[ 1 ] ),
+		       _mm256_and_si256(
+		        working_values[ 2 ],
+		        _mm256_or_si256(
+		         working_values[ 0 ],
+		         working_values[ 1 ] ) ) ) );
+
+		working_values[ 7 ] = working_values[ 6 ];
+		working_values[ 6 ] = working_values[ 5 ];
+		working_values[ 5 ] = working_values[ 4 ];
+		working_values[ 4 ] = _mm256_add_epi32( working_values[ 3 ], t1 );
+		working_values[ 3 ] = working_values[ 2 ];
+		working_values[ 2 ] = working_values[ 1 ];
+		working_values[ 1 ] = working_values[ 0 ];
+		working_values[ 0 ] = _mm256_add_epi32( t1, t2 );
+	}
+	for( value_index = 0;
+	     value_index < 8;
+	     value_index++ )
+	{
+		value_256bit = _mm256_loadu_si256(
+		                (const __m256i *) &( hash_values[ value_index * LIBFVDE_SHA256_MULTI_BUFFER_MAXIMUM_NUMBER_OF_LANES ] ) );
+
+		_mm256_storeu_si256(
+		 (__m256i *) &( hash_values[ value_index * LIBFVDE_SHA256_MULTI_BUFFER_MAXIMUM_NUMBER_OF_LANES ] ),
+		 _mm256_add_epi32(
+		  value_256bit,
+		  working_values[ value_index ] ) );
+	}
+}
+
+/* Calculates the SHA-256 block transform of 16 lanes using AVX-512
+ */
+LIBFVDE_SHA256_MULTI_BUFFER_AVX512_TARGET \
+static void libfvde_sha256_multi_buffer_transform_avx512(
+             uint32_t *hash_values,
+             const uint32_t *block_values )
+{
+	__m512i values_32bit[ 16 ];
+	__m512i working_values[ 8 ];
+
+	__m512i s0           = _mm512_setzero_si512();
+	__m512i s1           = _mm512_setzero_si512();
+	__m512i t1           = _mm512_setzero_si512();
+	__m512i t2           = _mm512_setzero_si512();
+	__m512i value_512bit = _mm512_setzero_si512();
+	uint8_t value_index  = 0;
+
+	for( value_index = 0;
+	     value_index < 8;
+	     value_index++ )
+	{
+		working_values[ value_index ] = _mm512_loadu_si512(
+		                                 (const void *) &( hash_values[ value_index * LIBFVDE_SHA256_MULTI_BUFFER_MAXIMUM_NUMBER_OF_LANES ] ) );
+	}
+	for( value_index = 0;
+	     value_index < 64;
+	     value_index++ )
+	{
+		if( value_index < 16 )
+		{
+			value_512bit = _mm512_loadu_si512(
+			                (const void *) &( block_values[ value_index * LIBFVDE_SHA256_MULTI_BUFFER_MAXIMUM_NUMBER_OF_LANES ] ) );
+		}
+		else
+		{
+			/* Extend the message schedule in a 16 x 32-bit values ring
+			 */
+			value_512bit = values_32bit[ ( value_index - 15 ) & 0x0f ];
+
+			s0 = _mm512_ternarylogic_epi32(
+			      _mm512_ror_epi32( value_512bit, 7 ),
+			      _mm512_ror_epi32( value_512bit, 18 ),
+			      _mm512_srli_epi32( value_512bit, 3 ),
+			      0x96 );
+
+			value_512bit = values_32bit[ ( value_index - 2 ) & 0x0f ];
+
+			s1 = _mm512_ternarylogic_epi32(
+			      _mm512_ror_epi32( value_512bit, 17 ),
+			      _mm512_ror_epi32( value_512bit, 19 ),
+			      _mm512_srli_epi32( value_512bit, 10 ),
+			      0x96 );
+
+			value_512bit = _mm512_add_epi32(
+			                _mm512_add_epi32(
+			                 values_32bit[ value_index & 0x0f ],
+			                 s0 ),
+			                _mm512_add_epi32(
+			                 values_32bit[ ( value_index - 7 ) & 0x0f ],
+			                 s1 ) );
+		}
+		values_32bit[ value_index & 0x0f ] = value_512bit;
+
+		/* 0x96 is the truth table of a XOR b XOR c
+		 * 0xca is the truth table of a ? b : c
+		 * 0xe8 is the truth table of majority( a, b, c )
+		 */
+		s1 = _mm512_ternarylogic_epi32(
+		      _mm512_ror_epi32( working_values[ 4 ], 6 ),
+		      _mm512_ror_epi32( working_values[ 4 ], 11 ),
+		      _mm512_ror_epi32( working_values[ 4 ], 25 ),
+		      0x96 );
+
+		t1 = _mm512_add_epi32(
+		      _mm512_add_epi32(
+		       working_values[ 7 ],
+		       s1 ),
+		      _mm512_ternarylogic_epi32(
+		       working_values[ 4 ],
+		       working_values[ 5 ],
+		       working_values[ 6 ],
+		       0xca ) );
+
+		t1 = _mm512_add_epi32(
+		      t1,
+		      _mm512_add_epi32(
+		       _mm512_set1_epi32( (int) libfvde_sha256_multi_buffer_prime_cube_roots[ value_index ] ),
+		       value_512bit ) );
+
+		s0 = _mm512_ternarylogic_epi32(
+		      _mm512_ror_epi32( working_values[ 0 ], 2 ),
+		      _mm512_ror_epi32( working_values[ 0 ], 13 ),
+		      _mm512_ror_epi32( working_values[ 0 ], 22 ),
+		      0x96 );
+
+		t2 = _mm512_add_epi32(
+		      s0,
+		      _mm512_ternarylogic_epi32(
+		       working_values[ 0 ],
+		       working_values[ 1 ],
+		       working_values[ 2 ],
+		       0xe8 ) );
+
+		working_values[ 7 ] = working_values[ 6 ];
+		working_values[ 6 ] = working_values[ 5 ];
+		working_values[ 5 ] = working_values[ 4 ];
+		working_values[ 4 ] = _mm512_add_epi32( working_values[ 3 ], t1 );
+		working_values[ 3 ] = working_values[ 2 ];
+		working_values[ 2 ] = working_values[ 1 ];
+		working_values[ 1 ] = working_values[ 0 ];
+		working_values[ 0 ] = _mm512_add_epi32( t1, t2 );
+	}
+	for( value_index = 0;
+	     value_index < 8;
+	     value_index++ )
+	{
+		value_512bit = _mm512_loadu_si512(
+		                (const void *) &( hash_values[ value_index * LIBFVDE_SHA256_MULTI_BUFFER_MAXIMUM_NUMBER_OF_LANES ] ) );
+
+		_mm512_storeu_si512(
+		 (void *) &( hash_values[ value_index * LIBFVDE_SHA256_MULTI_BUFFER_MAXIMUM_NUMBER_OF_LANES ] ),
+		 _mm512_add_epi32(
+		  value_512bit,
+		  working_values[ value_index ] ) );
+	}
+}
+
+/* Retrieves the extended control register 0
+ * The operating system must enable the AVX register state before it can be used
+ */
+static uint64_t libfvde_sha256_multi_buffer_get_xcr0(
+                 void )
+{
+#if defined( _MSC_VER )
+	return( (uint64_t) _xgetbv( 0 ) );
+#else
+	uint32_t eax = 0;
+	uint32_t edx = 0;
+
+	__asm__ __volatile__ (
+	 "xgetbv"
+	 : "=a" ( eax ), "=d" ( edx )
+	 : "c" ( 0 ) );
+
+	return( ( (uint64_t) edx << 32 ) | eax );
+#endif
+}
+
+#endif /* defined( LIBFVDE_HAVE_SHA256_MULTI_BUFFER ) */
+
+/* The block transform function and its number of lanes
+ * These values are determined once by libfvde_sha256_multi_buffer_initialize
+ */
+static void (*libfvde_sha256_multi_buffer_transform_function)( uint32_t *hash_values, const uint32_t *block_values ) = NULL;
+
+static int libfvde_sha256_multi_buffer_number_of_lanes = 0;
+
+/* The once value of libfvde_sha256_multi_buffer_initialize
+ */
+static libfvde_once_t libfvde_sha256_multi_buffer_initialize_once = LIBFVDE_ONCE_INITIALIZER;
+
+/* Selects the widest multi-buffer transform supported by the CPU and operating system
+ */
+static void libfvde_sha256_multi_buffer_select(
+             void )
+{
+#if defined( LIBFVDE_HAVE_SHA256_MULTI_BUFFER )
+	int cpu_information[ 4 ];
+
+	uint64_t xcr0 = 0;
+
+#if !defined( _MSC_VER )
+	unsigned int eax = 0;
+	unsigned int ebx = 0;
+	unsigned int ecx = 0;
+	unsigned int edx = 0;
+#endif
+#endif /* defined( LIBFVDE_HAVE_SHA256_MULTI_BUFFER ) */
+
+#if defined( LIBFVDE_HAVE_SHA256_MULTI_BUFFER )
+#if defined( _MSC_VER )
+	__cpuid(
+	 cpu_information,
+	 0 );
+
+	if( cpu_information[ 0 ] >= 7 )
+	{
+		__cpuid(
+		 cpu_information,
+		 1 );
+#else
+	if( __get_cpuid_max(
+	     0,
+	     NULL ) >= 7 )
+	{
+		__cpuid(
+		 1,
+		 eax,
+		 ebx,
+		 ecx,
+		 edx );
+
+		cpu_information[ 2 ] = (int) ecx;
+#endif
+		/* OSXSAVE (ECX bit 27) and AVX (ECX bit 28)
+		 */
+		if( ( cpu_information[ 2 ] & 0x18000000UL ) == 0x18000000UL )
+		{
+			xcr0 = libfvde_sha256_multi_buffer_get_xcr0();
+		}
+#if defined( _MSC_VER )
+		__cpuidex(
+		 cpu_information,
+		 7,
+		 0 );
+#else
+		__cpuid_count(
+		 7,
+		 0,
+		 eax,
+		 ebx,
+		 ecx,
+		 edx );
+
+		cpu_information[ 1 ] = (int) ebx;
+#endif
+		/* AVX-512F (EBX bit 16) with the opmask, ZMM and YMM register state (XCR0 bits 1, 2, 5, 6 and 7)
+		 */
+		if( ( ( cpu_information[ 1 ] & 0x00010000UL ) != 0 )
+		 && ( ( xcr0 & 0xe6 ) == 0xe6 ) )
+		{
+			libfvde_sha256_multi_buffer_transform_function = &libfvde_sha256_multi_buffer_transform_avx512;
+			libfvde_sha256_multi_buffer_number_of_lanes    = 16;
+		}
+		/* AVX2 (EBX bit 5) with the YMM register state (XCR0 bits 1 and 2)
+		 */
+		else if( ( ( cpu_information[ 1 ] & 0x00000020UL ) != 0 )
+		      && ( ( xcr0 & 0x06 ) == 0x06 ) )
+		{
+			libfvde_sha256_multi_buffer_transform_function = &libfvde_sha256_multi_buffer_transform_avx2;
+			libfvde_sha256_multi_buffer_number_of_lanes    = 8;
+		}
+	}
+#endif /* defined( LIBFVDE_HAVE_SHA256_MULTI_BUFFER ) */
+}
+
+/* Selects the multi-buffer transform once
+ */
+void libfvde_sha256_multi_buffer_initialize(
+      void )
+{
+	libfvde_once_call(
+	 &libfvde_sha256_multi_buffer_initialize_once,
+	 &libfvde_sha256_multi_buffer_select );
+}
+
+/* Retrieves the number of lanes of the multi-buffer transform
+ * Returns the number of lanes or 0 if no multi-buffer transform is supported
+ */
+int libfvde_sha256_multi_buffer_get_number_of_lanes(
+     void )
+{
+	libfvde_sha256_multi_buffer_initialize();
+
+	return( libfvde_sha256_multi_buffer_number_of_lanes );
+}
+
+/* Sets the initial SHA-256 hash values in all lanes
+ */
+void libfvde_sha256_multi_buffer_initialize_hash_values(
+      uint32_t *hash_values )
+{
+	int lane_index      = 0;
+	uint8_t value_index = 0;
+
+	for( value_index = 0;
+	     value_index < 8;
+	     value_index++ )
+	{
+		for( lane_index = 0;
+		     lane_index < LIBFVDE_SHA256_MULTI_BUFFER_MAXIMUM_NUMBER_OF_LANES;
+		     lane_index++ )
+		{
+			hash_values[ ( value_index * LIBFVDE_SHA256_MULTI_BUFFER_MAXIMUM_NUMBER_OF_LANES ) + lane_index ] = libfvde_sha256_multi_buffer_prime_square_roots[ value_index ];
+		}
+	}
+}
+
+/* Calculates the SHA-256 block transform of 64 byte sized blocks in all lanes
+ * libfvde_sha256_multi_buffer_get_number_of_lanes must return a non-zero value
+ * before this function is used
+ */
+void libfvde_sha256_multi_buffer_transform(
+      uint32_t *hash_values,
+      const uint32_t *block_values )
+{
+	if( libfvde_sha256_multi_buffer_transform_function != NULL )
+	{
+		libfvde_sha256_multi_buffer_transform_function(
+		 hash_values,
+		 block_values );
+	}
+}
+
@@ -0,0 +1,55 @@
+/*
+ * Multi-buffer SHA-256 functions
+ *
+ * Copyright (C) 2011-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#if !defined( _LIBFVDE_SHA256_MULTI_BUFFER_H )
+#define _LIBFVDE_SHA256_MULTI_BUFFER_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The maximum number of lanes, the stride of the multi-buffer hash and block values
+ */
+#define LIBFVDE_SHA256_MULTI_BUFFER_MAXIMUM_NUMBER_OF_LANES	16
+
+void libfvde_sha256_multi_buffer_initialize(
+      void );
+
+int libfvde_sha256_multi_buffer_get_number_of_lanes(
+     void );
+
+void libfvde_sha256_multi_buffer_initialize_hash_values(
+      uint32_t *hash_values );
+
+void libfvde_sha256_multi_buffer_transform(
+      uint32_t *hash_values,
+      const uint32_t *block_values );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFVDE_SHA256_MULTI_BUFFER_H ) */
+
@@ -28,12 +28,17 @@
 
 #include "libfvde_codepage.h"
 #include "libfvde_debug.h"
+#include "libfvde_decryption_pool.h"
 #include "libfvde_definitions.h"
 #include "libfvde_encrypted_metadata.h"
 #include "libfvde_encryption_context_plist.h"
 #include "libfvde_encryption.h"
+#include "libfvde_extent_index.h"
 #include "libfvde_io_handle.h"
+#include "libfvde_layout.h"
 #include "libfvde_libbfio.h"
+#include "libfvde_libcaes.h"
+#include "libfvde_libcdata.h"
 #include "libfvde_libcerror.h"
 #include "libfvde_libcnotify.h"
 #include "libfvde_libcthreads.h"
@@ -41,8 +46,13 @@
 #include "libfvde_libfdata.h"
 #include "libfvde_libhmac.h"
 #include "libfvde_metadata.h"
+#include "libfvde_passphrase_wrapped_kek.h"
 #include "libfvde_password.h"
+#include "libfvde_read_ahead.h"
+#include "libfvde_read_batch.h"
+#include "libfvde_read_context.h"
 #include "libfvde_sector_data.h"
+#include "libfvde_sectors_cache.h"
 #include "libfvde_volume.h"
 
 #include "fvde_metadata.h"
@@ -230,7 +240,8 @@ int libfvde_volume_initialize(
 		goto on_error;
 	}
 #endif
-	internal_volume->is_locked = 1;
+	internal_volume->is_locked     = 1;
+	internal_volume->parse_profile = LIBFVDE_PARSE_PROFILE_FULL;
 
 	*volume = (libfvde_volume_t *) internal_volume;
 
@@ -434,6 +445,22 @@ int libfvde_volume_free(
 				result = -1;
 			}
 		}
+		if( internal_volume->layout != NULL )
+		{
+			if( libfvde_layout_free(
+			     &( internal_volume->layout ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free layout.",
+				 function );
+
+				result = -1;
+			}
+		}
 		if( libfvde_io_handle_free(
 		     &( internal_volume->io_handle ),
 		     error ) != 1 )
@@ -1118,6 +1145,11 @@ int libfvde_volume_close(
 	static char *function                      = "libfvde_volume_close";
 	int result                                 = 0;
 
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	libfvde_read_context_t *read_context       = NULL;
+	int queue_result                           = 0;
+#endif
+
 	if( volume == NULL )
 	{
 		libcerror_error_set(
@@ -1175,6 +1207,98 @@ int libfvde_volume_close(
 			}
 		}
 	}
+#endif
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	if( internal_volume->read_ahead != NULL )
+	{
+		if( libfvde_read_ahead_free(
+		     &( internal_volume->read_ahead ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read-ahead.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_volume->decryption_pool != NULL )
+	{
+		if( libfvde_decryption_pool_free(
+		     &( internal_volume->decryption_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free decryption pool.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_volume->read_contexts != NULL )
+	{
+		/* The read contexts are popped from the queue since the values
+		 * of a queue that has wrapped around are not freed correctly
+		 * by libcthreads_queue_free
+		 */
+		do
+		{
+			queue_result = libcthreads_queue_try_pop(
+			                internal_volume->read_contexts,
+			                (intptr_t **) &read_context,
+			                error );
+
+			if( queue_result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to pop read context from queue.",
+				 function );
+
+				result = -1;
+			}
+			else if( queue_result != 0 )
+			{
+				if( libfvde_read_context_free(
+				     &read_context,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free read context.",
+					 function );
+
+					result = -1;
+				}
+			}
+		}
+		while( queue_result == 1 );
+
+		if( libcthreads_queue_free(
+		     &( internal_volume->read_contexts ),
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read contexts queue.",
+			 function );
+
+			result = -1;
+		}
+	}
 #endif
 	if( internal_volume->file_io_handle_opened_in_library != 0 )
 	{
@@ -1210,9 +1334,11 @@ int libfvde_volume_close(
 		}
 		internal_volume->file_io_handle_created_in_library = 0;
 	}
-	internal_volume->file_io_handle = NULL;
-	internal_volume->current_offset = 0;
-	internal_volume->is_locked      = 1;
+	internal_volume->file_io_handle      = NULL;
+	internal_volume->current_offset      = 0;
+	internal_volume->is_locked           = 1;
+	internal_volume->encrypted_metadata  = NULL;
+	internal_volume->metadata_copy_index = 0;
 
 	if( libfvde_io_handle_clear(
 	     internal_volume->io_handle,
@@ -1227,28 +1353,31 @@ int libfvde_volume_close(
 
 		result = -1;
 	}
-	if( libfdata_vector_free(
-	     &( internal_volume->sectors_vector ),
+	if( libfvde_sectors_cache_free(
+	     &( internal_volume->sectors_cache ),
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free sectors vector.",
+		 "%s: unable to free sectors cache.",
 		 function );
 
 		result = -1;
 	}
-	if( libfcache_cache_free(
-	     &( internal_volume->sectors_cache ),
+	/* The sector data pool is freed after the sectors cache
+	 * since the sectors cache releases its sector data to the pool
+	 */
+	if( libfvde_sector_data_pool_free(
+	     &( internal_volume->sector_data_pool ),
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free sectors cache.",
+		 "%s: unable to free sector data pool.",
 		 function );
 
 		result = -1;
@@ -1279,9 +1408,25 @@ int libfvde_volume_open_read(
      libbfio_handle_t *file_io_handle,
      libcerror_error_t **error )
 {
-	static char *function = "libfvde_volume_open_read";
-	int result            = 0;
-	int segment_index     = 0;
+	off64_t metadata_offsets[ LIBFVDE_MAXIMUM_NUMBER_OF_METADATA_COPIES ];
+
+	libfvde_decryption_pool_t *metadata_decryption_pool = NULL;
+	libfvde_encrypted_metadata_t *encrypted_metadata    = NULL;
+	static char *function                               = "libfvde_volume_open_read";
+	size_t sector_data_size                             = 0;
+	uint8_t layout_is_valid                             = 0;
+	uint8_t parse_profile                               = 0;
+	uint8_t primary_encrypted_metadata_is_read          = 0;
+	uint8_t secondary_encrypted_metadata_is_read        = 0;
+	int metadata_copy_index                             = 0;
+	int number_of_cache_entries                         = 0;
+	int number_of_segment_descriptors                   = 0;
+	int result                                          = 0;
+
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	libbfio_handle_t *cloned_file_io_handle             = NULL;
+	uint8_t file_io_handle_can_be_cloned                = 0;
+#endif
 
 	if( internal_volume == NULL )
 	{
@@ -1371,17 +1516,6 @@ int libfvde_volume_open_read(
 
 		return( -1 );
 	}
-	if( internal_volume->sectors_vector != NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid file - sectors vector already set.",
-		 function );
-
-		return( -1 );
-	}
 	if( internal_volume->sectors_cache != NULL )
 	{
 		libcerror_error_set(
@@ -1430,190 +1564,98 @@ int libfvde_volume_open_read(
 
 		goto on_error;
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "Reading primary metadata:\n" );
-	}
-#endif
-	if( libfvde_metadata_read(
-	     internal_volume->primary_metadata,
-	     internal_volume->io_handle,
-	     file_io_handle,
-	     (off64_t) internal_volume->io_handle->first_metadata_offset,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read primary metadata.",
-		 function );
-
-		goto on_error;
-	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "Reading secondary metadata:\n" );
-	}
-#endif
-	if( libfvde_metadata_read(
-	     internal_volume->secondary_metadata,
-	     internal_volume->io_handle,
-	     file_io_handle,
-	     (off64_t) internal_volume->io_handle->second_metadata_offset,
-	     error ) != 1 )
+	if( internal_volume->layout != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read secondary metadata.",
-		 function );
+		result = libfvde_layout_is_valid(
+		          internal_volume->layout,
+		          internal_volume->io_handle,
+		          file_io_handle,
+		          error );
 
-		goto on_error;
-	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "Reading tertiary metadata:\n" );
-	}
-#endif
-	if( libfvde_metadata_read(
-	     internal_volume->tertiary_metadata,
-	     internal_volume->io_handle,
-	     file_io_handle,
-	     (off64_t) internal_volume->io_handle->third_metadata_offset,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read tertiary metadata.",
-		 function );
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to determine if layout is valid.",
+			 function );
 
-		goto on_error;
-	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "Reading quaternary metadata:\n" );
-	}
-#endif
-	if( libfvde_metadata_read(
-	     internal_volume->quaternary_metadata,
-	     internal_volume->io_handle,
-	     file_io_handle,
-	     (off64_t) internal_volume->io_handle->fourth_metadata_offset,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read quaternary metadata.",
-		 function );
+			goto on_error;
+		}
+		layout_is_valid = (uint8_t) result;
 
-		goto on_error;
-	}
-/* TODO clean up and check */
 #if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "Reading encrypted metadata:\n" );
-	}
+		if( ( libcnotify_verbose != 0 )
+		 && ( layout_is_valid == 0 ) )
+		{
+			libcnotify_printf(
+			 "%s: layout is stale and is ignored.\n",
+			 function );
+		}
 #endif
-/* TODO compare all 4 offsets */
-	if( libfvde_encrypted_metadata_read(
-	     internal_volume->primary_encrypted_metadata,
-	     internal_volume->io_handle,
-	     file_io_handle,
-	     (off64_t) internal_volume->primary_metadata->primary_encrypted_metadata_offset,
-	     internal_volume->primary_metadata->encrypted_metadata_size,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read primary encrypted metadata.",
-		 function );
-
-		goto on_error;
 	}
-	if( libfvde_encrypted_metadata_read(
-	     internal_volume->secondary_encrypted_metadata,
-	     internal_volume->io_handle,
-	     file_io_handle,
-	     (off64_t) internal_volume->primary_metadata->secondary_encrypted_metadata_offset,
-	     internal_volume->primary_metadata->encrypted_metadata_size,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read secondary encrypted metadata.",
-		 function );
+	parse_profile = internal_volume->parse_profile;
 
-		goto on_error;
-	}
-	if( internal_volume->primary_encrypted_metadata->logical_volume_size > 0 )
-	{
-		internal_volume->io_handle->logical_volume_offset = internal_volume->primary_encrypted_metadata->logical_volume_offset;
-		internal_volume->io_handle->logical_volume_size   = internal_volume->primary_encrypted_metadata->logical_volume_size;
-	}
-	else if( internal_volume->secondary_encrypted_metadata->logical_volume_size > 0 )
-	{
-		internal_volume->io_handle->logical_volume_offset = internal_volume->secondary_encrypted_metadata->logical_volume_offset;
-		internal_volume->io_handle->logical_volume_size   = internal_volume->secondary_encrypted_metadata->logical_volume_size;
-	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	if( layout_is_valid != 0 )
 	{
-		libcnotify_printf(
-		 "%s: physical volume size\t\t\t\t: %" PRIu64 "\n",
-		 function,
-		 internal_volume->io_handle->physical_volume_size );
+		/* The metadata is not read and the layout of the logical volume
+		 * is taken from the layout instead of the encrypted metadata
+		 */
+		if( libfvde_layout_get_values(
+		     internal_volume->layout,
+		     internal_volume->primary_metadata,
+		     internal_volume->primary_encrypted_metadata,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve values from layout.",
+			 function );
 
-		libcnotify_printf(
-		 "%s: logical volume offset\t\t\t\t: 0x%08" PRIx64 "\n",
-		 function,
-		 internal_volume->io_handle->logical_volume_offset );
+			goto on_error;
+		}
+		metadata_copy_index = internal_volume->layout->metadata_copy_index;
 
-		libcnotify_printf(
-		 "%s: logical volume size\t\t\t\t: %" PRIu64 "\n",
-		 function,
-		 internal_volume->io_handle->logical_volume_size );
+		/* Only the encrypted metadata blocks that contain the keys are read
+		 */
+		parse_profile &= LIBFVDE_PARSE_PROFILE_FLAG_KEYS;
 
-		libcnotify_printf(
-		 "\n" );
-	}
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: using layout of metadata copy\t\t\t: %d\n",
+			 function,
+			 metadata_copy_index );
+		}
 #endif
-	if( internal_volume->io_handle->logical_volume_size == 0 )
-	{
-		result = 1;
 	}
-	else
+	else if( internal_volume->lazy_open != 0 )
 	{
+		metadata_offsets[ 0 ] = (off64_t) internal_volume->io_handle->first_metadata_offset;
+		metadata_offsets[ 1 ] = (off64_t) internal_volume->io_handle->second_metadata_offset;
+		metadata_offsets[ 2 ] = (off64_t) internal_volume->io_handle->third_metadata_offset;
+		metadata_offsets[ 3 ] = (off64_t) internal_volume->io_handle->fourth_metadata_offset;
+
 #if defined( HAVE_DEBUG_OUTPUT )
 		if( libcnotify_verbose != 0 )
 		{
 			libcnotify_printf(
-			 "Reading logical volume header:\n" );
+			 "Reading newest metadata:\n" );
 		}
 #endif
-		result = libfvde_io_handle_read_logical_volume_header(
+		/* Only the newest valid copy of the metadata is parsed into the primary metadata
+		 */
+		result = libfvde_metadata_read_newest(
+		          internal_volume->primary_metadata,
 		          internal_volume->io_handle,
 		          file_io_handle,
-		          internal_volume->io_handle->logical_volume_offset + 1024,
+		          metadata_offsets,
+		          4,
+		          &metadata_copy_index,
 		          error );
 
 		if( result == -1 )
@@ -1622,34 +1664,379 @@ int libfvde_volume_open_read(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_IO,
 			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read logical volume header.",
+			 "%s: unable to read newest metadata.",
 			 function );
 
 			goto on_error;
 		}
 		else if( result == 0 )
 		{
-			result = libfvde_volume_open_read_keys_from_encrypted_metadata(
-				  internal_volume,
-				  internal_volume->primary_encrypted_metadata,
-				  error );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing valid metadata.",
+			 function );
 
-			if( result == -1 )
+			goto on_error;
+		}
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: using metadata copy\t\t\t\t: %d\n",
+			 function,
+			 metadata_copy_index );
+		}
+#endif
+	}
+	else
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "Reading primary metadata:\n" );
+		}
+#endif
+		if( libfvde_metadata_read(
+		     internal_volume->primary_metadata,
+		     internal_volume->io_handle,
+		     file_io_handle,
+		     (off64_t) internal_volume->io_handle->first_metadata_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read primary metadata.",
+			 function );
+
+			goto on_error;
+		}
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "Reading secondary metadata:\n" );
+		}
+#endif
+		if( libfvde_metadata_read(
+		     internal_volume->secondary_metadata,
+		     internal_volume->io_handle,
+		     file_io_handle,
+		     (off64_t) internal_volume->io_handle->second_metadata_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read secondary metadata.",
+			 function );
+
+			goto on_error;
+		}
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "Reading tertiary metadata:\n" );
+		}
+#endif
+		if( libfvde_metadata_read(
+		     internal_volume->tertiary_metadata,
+		     internal_volume->io_handle,
+		     file_io_handle,
+		     (off64_t) internal_volume->io_handle->third_metadata_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read tertiary metadata.",
+			 function );
+
+			goto on_error;
+		}
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "Reading quaternary metadata:\n" );
+		}
+#endif
+		if( libfvde_metadata_read(
+		     internal_volume->quaternary_metadata,
+		     internal_volume->io_handle,
+		     file_io_handle,
+		     (off64_t) internal_volume->io_handle->fourth_metadata_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read quaternary metadata.",
+			 function );
+
+			goto on_error;
+		}
+	}
+/* TODO clean up and check */
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "Reading encrypted metadata:\n" );
+	}
+#endif
+/* TODO compare all 4 offsets */
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	/* The blocks of the encrypted metadata are decrypted by the decryption threads
+	 */
+	if( ( parse_profile != 0 )
+	 && ( internal_volume->number_of_decryption_threads != 0 ) )
+	{
+		if( libfvde_decryption_pool_initialize(
+		     &metadata_decryption_pool,
+		     internal_volume->number_of_decryption_threads,
+		     internal_volume->io_handle->key_data,
+		     internal_volume->io_handle->physical_volume_identifier,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create metadata decryption pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
+	if( parse_profile != 0 )
+	{
+		result = libfvde_encrypted_metadata_read(
+		          internal_volume->primary_encrypted_metadata,
+		          internal_volume->io_handle,
+		          file_io_handle,
+		          metadata_decryption_pool,
+		          (off64_t) internal_volume->primary_metadata->primary_encrypted_metadata_offset,
+		          internal_volume->primary_metadata->encrypted_metadata_size,
+		          parse_profile,
+		          error );
+
+		if( result == 1 )
+		{
+			primary_encrypted_metadata_is_read = 1;
+		}
+		else if( ( internal_volume->lazy_open == 0 )
+		      && ( layout_is_valid == 0 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read primary encrypted metadata.",
+			 function );
+
+			goto on_error;
+		}
+		else
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( ( libcnotify_verbose != 0 )
+			 && ( error != NULL ) )
+			{
+				libcnotify_print_error_backtrace(
+				 *error );
+			}
+#endif
+			libcerror_error_free(
+			 error );
+		}
+	}
+	/* When opening lazily or using the layout the secondary encrypted metadata
+	 * is only read if the primary encrypted metadata cannot be used
+	 */
+	if( ( parse_profile != 0 )
+	 && ( ( primary_encrypted_metadata_is_read == 0 )
+	  || ( ( layout_is_valid == 0 )
+	   && ( ( internal_volume->lazy_open == 0 )
+	    || ( ( ( parse_profile & LIBFVDE_PARSE_PROFILE_FLAG_LAYOUT ) != 0 )
+	     && ( internal_volume->primary_encrypted_metadata->logical_volume_size == 0 ) ) ) ) ) )
+	{
+		if( libfvde_encrypted_metadata_read(
+		     internal_volume->secondary_encrypted_metadata,
+		     internal_volume->io_handle,
+		     file_io_handle,
+		     metadata_decryption_pool,
+		     (off64_t) internal_volume->primary_metadata->secondary_encrypted_metadata_offset,
+		     internal_volume->primary_metadata->encrypted_metadata_size,
+		     parse_profile,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read secondary encrypted metadata.",
+			 function );
+
+			goto on_error;
+		}
+		secondary_encrypted_metadata_is_read = 1;
+	}
+	if( layout_is_valid != 0 )
+	{
+		encrypted_metadata = internal_volume->primary_encrypted_metadata;
+	}
+	else if( ( primary_encrypted_metadata_is_read != 0 )
+	      && ( internal_volume->primary_encrypted_metadata->logical_volume_size > 0 ) )
+	{
+		encrypted_metadata = internal_volume->primary_encrypted_metadata;
+	}
+	else if( ( secondary_encrypted_metadata_is_read != 0 )
+	      && ( internal_volume->secondary_encrypted_metadata->logical_volume_size > 0 ) )
+	{
+		encrypted_metadata = internal_volume->secondary_encrypted_metadata;
+	}
+	if( encrypted_metadata != NULL )
+	{
+		internal_volume->io_handle->logical_volume_offset = encrypted_metadata->logical_volume_offset;
+		internal_volume->io_handle->logical_volume_size   = encrypted_metadata->logical_volume_size;
+
+		if( libcdata_array_get_number_of_entries(
+		     encrypted_metadata->segment_descriptors,
+		     &number_of_segment_descriptors,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of segment descriptors.",
+			 function );
+
+			goto on_error;
+		}
+		/* The extent index maps the logical volume onto the segments of the physical volume
+		 * if there are no segment descriptors the logical volume is stored consecutively
+		 */
+		if( libfvde_extent_index_initialize(
+		     &( internal_volume->io_handle->extent_index ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create extent index.",
+			 function );
+
+			goto on_error;
+		}
+		if( number_of_segment_descriptors > 0 )
+		{
+			if( libfvde_extent_index_read_segment_descriptors(
+			     internal_volume->io_handle->extent_index,
+			     encrypted_metadata->segment_descriptors,
+			     internal_volume->io_handle->block_size,
+			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_IO,
 				 LIBCERROR_IO_ERROR_READ_FAILED,
-				 "%s: unable to read keys from primary encrypted metadata.",
+				 "%s: unable to read extent index from segment descriptors.",
 				 function );
 
 				goto on_error;
 			}
-			else if( result == 0 )
+		}
+		else
+		{
+			if( libfvde_extent_index_insert_extent(
+			     internal_volume->io_handle->extent_index,
+			     0,
+			     internal_volume->io_handle->logical_volume_size,
+			     internal_volume->io_handle->logical_volume_offset,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to insert logical volume extent.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: physical volume size\t\t\t\t: %" PRIu64 "\n",
+		 function,
+		 internal_volume->io_handle->physical_volume_size );
+
+		libcnotify_printf(
+		 "%s: logical volume offset\t\t\t\t: 0x%08" PRIx64 "\n",
+		 function,
+		 internal_volume->io_handle->logical_volume_offset );
+
+		libcnotify_printf(
+		 "%s: logical volume size\t\t\t\t: %" PRIu64 "\n",
+		 function,
+		 internal_volume->io_handle->logical_volume_size );
+
+		libcnotify_printf(
+		 "\n" );
+	}
+#endif
+	if( internal_volume->io_handle->logical_volume_size == 0 )
+	{
+		result = 1;
+	}
+	else
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "Reading logical volume header:\n" );
+		}
+#endif
+		result = libfvde_io_handle_read_logical_volume_header(
+		          internal_volume->io_handle,
+		          file_io_handle,
+		          1024,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read logical volume header.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			if( primary_encrypted_metadata_is_read != 0 )
 			{
 				result = libfvde_volume_open_read_keys_from_encrypted_metadata(
 					  internal_volume,
-					  internal_volume->secondary_encrypted_metadata,
+					  internal_volume->primary_encrypted_metadata,
 					  error );
 
 				if( result == -1 )
@@ -1658,99 +2045,284 @@ int libfvde_volume_open_read(
 					 error,
 					 LIBCERROR_ERROR_DOMAIN_IO,
 					 LIBCERROR_IO_ERROR_READ_FAILED,
-					 "%s: unable to read keys from secondary encrypted metadata.",
+					 "%s: unable to read keys from primary encrypted metadata.",
 					 function );
 
 					goto on_error;
 				}
 			}
-			if( result != 0 )
+			if( ( result == 0 )
+			 && ( parse_profile != 0 )
+			 && ( secondary_encrypted_metadata_is_read == 0 ) )
 			{
 #if defined( HAVE_DEBUG_OUTPUT )
 				if( libcnotify_verbose != 0 )
 				{
 					libcnotify_printf(
-					 "Reading logical volume header:\n" );
+					 "Reading secondary encrypted metadata:\n" );
 				}
 #endif
-				result = libfvde_io_handle_read_logical_volume_header(
-					  internal_volume->io_handle,
-					  file_io_handle,
-					  internal_volume->io_handle->logical_volume_offset + 1024,
-					  error );
-
-				if( result == -1 )
+				if( libfvde_encrypted_metadata_read(
+				     internal_volume->secondary_encrypted_metadata,
+				     internal_volume->io_handle,
+				     file_io_handle,
+				     metadata_decryption_pool,
+				     (off64_t) internal_volume->primary_metadata->secondary_encrypted_metadata_offset,
+				     internal_volume->primary_metadata->encrypted_metadata_size,
+				     parse_profile,
+				     error ) != 1 )
 				{
 					libcerror_error_set(
 					 error,
 					 LIBCERROR_ERROR_DOMAIN_IO,
 					 LIBCERROR_IO_ERROR_READ_FAILED,
-					 "%s: unable to read logical volume header.",
+					 "%s: unable to read secondary encrypted metadata.",
 					 function );
 
 					goto on_error;
 				}
+				secondary_encrypted_metadata_is_read = 1;
 			}
-		}
-		if( result != 0 )
-		{
-/* TODO clone function ? */
-			if( libfdata_vector_initialize(
-			     &( internal_volume->sectors_vector ),
-			     (size64_t) internal_volume->io_handle->bytes_per_sector,
-			     (intptr_t *) internal_volume->io_handle,
-			     NULL,
-			     NULL,
-			     (int (*)(intptr_t *, intptr_t *, libfdata_vector_t *, libfcache_cache_t *, int, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &libfvde_io_handle_read_sector,
-			     NULL,
-			     LIBFDATA_DATA_HANDLE_FLAG_NON_MANAGED,
-			     error ) != 1 )
+			if( result == 0 )
 			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-				 "%s: unable to create sectors vector.",
-				 function );
+				result = libfvde_volume_open_read_keys_from_encrypted_metadata(
+					  internal_volume,
+					  internal_volume->secondary_encrypted_metadata,
+					  error );
 
-				goto on_error;
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read keys from secondary encrypted metadata.",
+					 function );
+
+					goto on_error;
+				}
 			}
-			if( libfdata_vector_append_segment(
-			     internal_volume->sectors_vector,
-			     &segment_index,
-			     0,
-			     internal_volume->io_handle->logical_volume_offset,
-			     internal_volume->io_handle->logical_volume_size,
-			     LIBFVDE_RANGE_FLAG_ENCRYPTED,
+			if( result != 0 )
+			{
+#if defined( HAVE_DEBUG_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					libcnotify_printf(
+					 "Reading logical volume header:\n" );
+				}
+#endif
+				result = libfvde_io_handle_read_logical_volume_header(
+					  internal_volume->io_handle,
+					  file_io_handle,
+					  1024,
+					  error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read logical volume header.",
+					 function );
+
+					goto on_error;
+				}
+			}
+		}
+		if( result != 0 )
+		{
+			/* The sector data in the sectors cache contains multiple sectors to reduce
+			 * the number of reads and decrypt operations, by default a block
+			 */
+			sector_data_size = internal_volume->sector_data_size;
+
+			if( sector_data_size == 0 )
+			{
+				sector_data_size = (size_t) internal_volume->io_handle->block_size;
+			}
+			if( ( sector_data_size == 0 )
+			 || ( sector_data_size > (size_t) LIBFVDE_MAXIMUM_SECTOR_DATA_SIZE )
+			 || ( ( sector_data_size % internal_volume->io_handle->bytes_per_sector ) != 0 ) )
+			{
+				sector_data_size = (size_t) internal_volume->io_handle->bytes_per_sector;
+			}
+			internal_volume->io_handle->sector_data_size = sector_data_size;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: sector data size\t\t\t: %" PRIzd "\n",
+				 function,
+				 sector_data_size );
+			}
+#endif
+			/* The sectors cache is managed as a least recently used cache
+			 * per shard and can be accessed by multiple threads
+			 */
+			number_of_cache_entries = LIBFVDE_MAXIMUM_CACHE_ENTRIES_SECTORS;
+
+			if( internal_volume->cache_size != 0 )
+			{
+				number_of_cache_entries = (int) ( internal_volume->cache_size / sector_data_size );
+
+				if( number_of_cache_entries == 0 )
+				{
+					number_of_cache_entries = 1;
+				}
+			}
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: number of cache entries\t\t: %d\n",
+				 function,
+				 number_of_cache_entries );
+			}
+#endif
+			if( libfvde_sectors_cache_initialize(
+			     &( internal_volume->sectors_cache ),
+			     number_of_cache_entries,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-				 "%s: unable to append segment to sectors vector.",
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create sectors cache.",
 				 function );
 
 				goto on_error;
 			}
-			if( libfcache_cache_initialize(
-			     &( internal_volume->sectors_cache ),
-			     LIBFVDE_MAXIMUM_CACHE_ENTRIES_SECTORS,
+			/* The sector data evicted from the sectors cache is reused for the sector data
+			 * that is read next, hence the pool needs to keep at most one sector data per cache entry
+			 */
+			if( libfvde_sector_data_pool_initialize(
+			     &( internal_volume->sector_data_pool ),
+			     sector_data_size,
+			     number_of_cache_entries,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-				 "%s: unable to create sectors cache.",
+				 "%s: unable to create sector data pool.",
 				 function );
 
 				goto on_error;
 			}
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+			/* Read contexts and the read-ahead read using a clone of the file IO handle,
+			 * which is only supported if the file IO handle can be cloned
+			 */
+			if( libbfio_handle_clone(
+			     &cloned_file_io_handle,
+			     file_io_handle,
+			     NULL ) == 1 )
+			{
+				file_io_handle_can_be_cloned = 1;
+			}
+			if( cloned_file_io_handle != NULL )
+			{
+				if( libbfio_handle_free(
+				     &cloned_file_io_handle,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free cloned file IO handle.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			if( ( file_io_handle_can_be_cloned != 0 )
+			 && ( internal_volume->read_ahead_size != 0 ) )
+			{
+				if( libfvde_read_ahead_initialize(
+				     &( internal_volume->read_ahead ),
+				     internal_volume->io_handle,
+				     file_io_handle,
+				     internal_volume->keyring->volume_master_key,
+				     internal_volume->keyring->volume_tweak_key,
+				     internal_volume->read_ahead_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+					 "%s: unable to create read-ahead.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			if( ( internal_volume->io_handle->is_encrypted != 0 )
+			 && ( internal_volume->number_of_decryption_threads != 0 ) )
+			{
+				if( libfvde_decryption_pool_initialize(
+				     &( internal_volume->decryption_pool ),
+				     internal_volume->number_of_decryption_threads,
+				     internal_volume->keyring->volume_master_key,
+				     internal_volume->keyring->volume_tweak_key,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+					 "%s: unable to create decryption pool.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			if( file_io_handle_can_be_cloned != 0 )
+			{
+				if( libcthreads_queue_initialize(
+				     &( internal_volume->read_contexts ),
+				     LIBFVDE_MAXIMUM_NUMBER_OF_READ_CONTEXTS,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+					 "%s: unable to create read contexts queue.",
+					 function );
+
+					goto on_error;
+				}
+			}
+#endif
 			internal_volume->is_locked = 0;
 		}
 	}
+	internal_volume->encrypted_metadata  = encrypted_metadata;
+	internal_volume->metadata_copy_index = metadata_copy_index;
+
 #if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	if( metadata_decryption_pool != NULL )
+	{
+		if( libfvde_decryption_pool_free(
+		     &metadata_decryption_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free metadata decryption pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
@@ -1768,16 +2340,49 @@ int libfvde_volume_open_read(
 	return( result );
 
 on_error:
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	if( metadata_decryption_pool != NULL )
+	{
+		libfvde_decryption_pool_free(
+		 &metadata_decryption_pool,
+		 NULL );
+	}
+	if( internal_volume->read_contexts != NULL )
+	{
+		libcthreads_queue_free(
+		 &( internal_volume->read_contexts ),
+		 NULL,
+		 NULL );
+	}
+	if( internal_volume->decryption_pool != NULL )
+	{
+		libfvde_decryption_pool_free(
+		 &( internal_volume->decryption_pool ),
+		 NULL );
+	}
+	if( internal_volume->read_ahead != NULL )
+	{
+		libfvde_read_ahead_free(
+		 &( internal_volume->read_ahead ),
+		 NULL );
+	}
+#endif
 	if( internal_volume->sectors_cache != NULL )
 	{
-		libfcache_cache_free(
+		libfvde_sectors_cache_free(
 		 &( internal_volume->sectors_cache ),
 		 NULL );
 	}
-	if( internal_volume->sectors_vector != NULL )
+	if( internal_volume->sector_data_pool != NULL )
+	{
+		libfvde_sector_data_pool_free(
+		 &( internal_volume->sector_data_pool ),
+		 NULL );
+	}
+	if( internal_volume->io_handle->extent_index != NULL )
 	{
-		libfdata_vector_free(
-		 &( internal_volume->sectors_vector ),
+		libfvde_extent_index_free(
+		 &( internal_volume->io_handle->extent_index ),
 		 NULL );
 	}
 #if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
@@ -2139,72 +2744,2865 @@ int libfvde_volume_is_locked(
 	static char *function                      = "libfvde_volume_is_locked";
 	uint8_t is_locked                          = 0;
 
-	if( volume == NULL )
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfvde_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	is_locked = internal_volume->is_locked;
+
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( is_locked );
+}
+
+/* Reads (volume) data at a specific offset into a buffer using a Basic File IO (bfio) handle
+ * The file IO handle and XTS context cannot be used by another thread during the call,
+ * the sectors cache and read-ahead can be shared with other threads
+ * This function does not change the current offset
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libfvde_internal_volume_read_buffer_at_offset_from_file_io_handle(
+         libfvde_internal_volume_t *internal_volume,
+         libbfio_handle_t *file_io_handle,
+         libcaes_tweaked_context_t *xts_context,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libfvde_sector_data_t *sector_data = NULL;
+	static char *function              = "libfvde_internal_volume_read_buffer_at_offset_from_file_io_handle";
+	off64_t sector_data_offset         = 0;
+	size64_t range_size                = 0;
+	size_t buffer_offset               = 0;
+	size_t data_offset                 = 0;
+	size_t read_size                   = 0;
+	size_t sector_data_size            = 0;
+	ssize_t total_read_count           = 0;
+	uint64_t sector_data_index         = 0;
+	int result                         = 0;
+
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	off64_t read_offset                = 0;
+	ssize_t read_count                 = 0;
+#endif
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->io_handle->sector_data_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid volume - invalid IO handle - sector data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->sectors_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing sectors cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->sector_data_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing sector data pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) offset >= internal_volume->io_handle->logical_volume_size )
+	{
+		return( 0 );
+	}
+	if( (size64_t) ( offset + buffer_size ) >= internal_volume->io_handle->logical_volume_size )
+	{
+		buffer_size = (size_t) ( internal_volume->io_handle->logical_volume_size - offset );
+	}
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	read_offset = offset;
+
+	if( internal_volume->read_ahead != NULL )
+	{
+		read_count = libfvde_read_ahead_read_buffer(
+		              internal_volume->read_ahead,
+		              offset,
+		              (uint8_t *) buffer,
+		              buffer_size,
+		              error );
+
+		if( read_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data from read-ahead at offset: %" PRIi64 ".",
+			 function,
+			 offset );
+
+			goto on_error;
+		}
+		buffer_offset    += (size_t) read_count;
+		buffer_size      -= (size_t) read_count;
+		total_read_count += read_count;
+
+		offset += (off64_t) read_count;
+	}
+#endif
+	while( buffer_size > 0 )
+	{
+		result = libfvde_io_handle_get_mapped_range(
+		          internal_volume->io_handle,
+		          offset,
+		          &range_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if offset: %" PRIi64 " is mapped.",
+			 function,
+			 offset );
+
+			goto on_error;
+		}
+		/* Ranges that are not mapped onto the physical volume are read as 0-byte values
+		 * without reading or decrypting data
+		 */
+		if( result == 0 )
+		{
+			read_size = buffer_size;
+
+			if( (size64_t) read_size > range_size )
+			{
+				read_size = (size_t) range_size;
+			}
+			if( memory_set(
+			     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+			     0,
+			     read_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear buffer of unmapped range at offset: %" PRIi64 ".",
+				 function,
+				 offset );
+
+				goto on_error;
+			}
+		}
+		/* Reads that cover whole sector data bypass the sectors cache
+		 * and are decrypted in place in the buffer
+		 */
+		else if( ( ( offset % internal_volume->io_handle->bytes_per_sector ) == 0 )
+		      && ( buffer_size >= internal_volume->io_handle->sector_data_size ) )
+		{
+			read_size = buffer_size - ( buffer_size % internal_volume->io_handle->bytes_per_sector );
+
+			if( libfvde_io_handle_read_sectors_to_buffer(
+			     internal_volume->io_handle,
+			     file_io_handle,
+			     xts_context,
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+			     internal_volume->decryption_pool,
+#else
+			     NULL,
+#endif
+			     offset,
+			     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+			     read_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read sectors at offset: %" PRIi64 ".",
+				 function,
+				 offset );
+
+				goto on_error;
+			}
+		}
+		else
+		{
+			sector_data_index  = (uint64_t) offset / internal_volume->io_handle->sector_data_size;
+			sector_data_offset = (off64_t) ( sector_data_index * internal_volume->io_handle->sector_data_size );
+			data_offset        = (size_t) ( offset - sector_data_offset );
+
+			/* The last sector data can be smaller than the sector data size
+			 */
+			sector_data_size = internal_volume->io_handle->sector_data_size;
+
+			if( (size64_t) sector_data_size > ( internal_volume->io_handle->logical_volume_size - (size64_t) sector_data_offset ) )
+			{
+				sector_data_size = (size_t) ( internal_volume->io_handle->logical_volume_size - (size64_t) sector_data_offset );
+			}
+			read_size = sector_data_size - data_offset;
+
+			if( read_size > buffer_size )
+			{
+				read_size = buffer_size;
+			}
+			result = libfvde_sectors_cache_copy_data(
+			          internal_volume->sectors_cache,
+			          sector_data_index,
+			          data_offset,
+			          &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+			          read_size,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to copy data of sector data: %" PRIu64 " from sectors cache.",
+				 function,
+				 sector_data_index );
+
+				goto on_error;
+			}
+			else if( result == 0 )
+			{
+				/* The sector data is read without holding a lock of the sectors cache
+				 * hence concurrent reads of the same sector data can read it more than once
+				 */
+				if( libfvde_sector_data_pool_get_sector_data(
+				     internal_volume->sector_data_pool,
+				     sector_data_size,
+				     &sector_data,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve sector data from pool.",
+					 function );
+
+					goto on_error;
+				}
+				if( libfvde_sector_data_read(
+				     sector_data,
+				     internal_volume->io_handle,
+				     file_io_handle,
+				     sector_data_offset,
+				     xts_context,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read sector data: %" PRIu64 ".",
+					 function,
+					 sector_data_index );
+
+					goto on_error;
+				}
+				if( memory_copy(
+				     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+				     &( ( sector_data->data )[ data_offset ] ),
+				     read_size ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+					 "%s: unable to copy sector data to buffer.",
+					 function );
+
+					goto on_error;
+				}
+				if( libfvde_sectors_cache_set_sector_data(
+				     internal_volume->sectors_cache,
+				     sector_data_index,
+				     sector_data,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to set sector data: %" PRIu64 " in sectors cache.",
+					 function,
+					 sector_data_index );
+
+					goto on_error;
+				}
+				sector_data = NULL;
+			}
+		}
+		buffer_offset    += read_size;
+		buffer_size      -= read_size;
+		total_read_count += (ssize_t) read_size;
+
+		offset += (off64_t) read_size;
+
+		if( internal_volume->io_handle->abort != 0 )
+		{
+			break;
+		}
+	}
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	if( internal_volume->read_ahead != NULL )
+	{
+		if( libfvde_read_ahead_update(
+		     internal_volume->read_ahead,
+		     read_offset,
+		     (size_t) total_read_count,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update read-ahead.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
+	return( total_read_count );
+
+on_error:
+	if( sector_data != NULL )
+	{
+		libfvde_sector_data_pool_release_sector_data(
+		 &sector_data,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads (volume) data from the last current into a buffer using a Basic File IO (bfio) handle
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libfvde_internal_volume_read_buffer_from_file_io_handle(
+         libfvde_internal_volume_t *internal_volume,
+         libbfio_handle_t *file_io_handle,
+         void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	static char *function = "libfvde_internal_volume_read_buffer_from_file_io_handle";
+	ssize_t read_count    = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid volume - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	read_count = libfvde_internal_volume_read_buffer_at_offset_from_file_io_handle(
+	              internal_volume,
+	              file_io_handle,
+	              internal_volume->io_handle->xts_context,
+	              buffer,
+	              buffer_size,
+	              internal_volume->current_offset,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer at offset: %" PRIi64 ".",
+		 function,
+		 internal_volume->current_offset );
+
+		return( -1 );
+	}
+	internal_volume->current_offset += (off64_t) read_count;
+
+	return( read_count );
+}
+
+/* Reads data at the current offset into a buffer
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libfvde_volume_read_buffer(
+         libfvde_volume_t *volume,
+         void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libfvde_internal_volume_t *internal_volume = NULL;
+	static char *function                      = "libfvde_volume_read_buffer";
+	ssize_t read_count                         = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfvde_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	read_count = libfvde_internal_volume_read_buffer_from_file_io_handle(
+		      internal_volume,
+		      internal_volume->file_io_handle,
+		      buffer,
+		      buffer_size,
+		      error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
+		 function );
+
+		read_count = -1;
+	}
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Reads (media) data at a specific offset
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libfvde_volume_read_buffer_at_offset(
+         libfvde_volume_t *volume,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libfvde_internal_volume_t *internal_volume = NULL;
+	static char *function                      = "libfvde_volume_read_buffer_at_offset";
+	ssize_t read_count                         = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfvde_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfvde_internal_volume_seek_offset(
+	     internal_volume,
+	     offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libfvde_internal_volume_read_buffer_from_file_io_handle(
+		      internal_volume,
+		      internal_volume->file_io_handle,
+		      buffer,
+		      buffer_size,
+		      error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+
+on_error:
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_volume->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+
+/* Retrieves a read context to read from the volume
+ * An idle read context is reused, otherwise a new read context is created
+ * This function is not multi-thread safe acquire read lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_internal_volume_get_read_context(
+     libfvde_internal_volume_t *internal_volume,
+     libfvde_read_context_t **read_context,
+     libcerror_error_t **error )
+{
+	static char *function    = "libfvde_internal_volume_get_read_context";
+	const uint8_t *key       = NULL;
+	const uint8_t *tweak_key = NULL;
+	int result               = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->read_contexts == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing read contexts queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read context.",
+		 function );
+
+		return( -1 );
+	}
+	result = libcthreads_queue_try_pop(
+	          internal_volume->read_contexts,
+	          (intptr_t **) read_context,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to pop read context from queue.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		if( internal_volume->io_handle->is_encrypted != 0 )
+		{
+			key       = internal_volume->keyring->volume_master_key;
+			tweak_key = internal_volume->keyring->volume_tweak_key;
+		}
+		if( libfvde_read_context_initialize(
+		     read_context,
+		     internal_volume->file_io_handle,
+		     key,
+		     tweak_key,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create read context.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Releases a read context after reading from the volume
+ * The read context is kept for reuse, unless the queue is full
+ * This function is not multi-thread safe acquire read lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_internal_volume_release_read_context(
+     libfvde_internal_volume_t *internal_volume,
+     libfvde_read_context_t **read_context,
+     libcerror_error_t **error )
+{
+	static char *function = "libfvde_internal_volume_release_read_context";
+	int result            = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->read_contexts == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing read contexts queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read context.",
+		 function );
+
+		return( -1 );
+	}
+	result = libcthreads_queue_try_push(
+	          internal_volume->read_contexts,
+	          (intptr_t *) *read_context,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push read context onto queue.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		*read_context = NULL;
+	}
+	else if( libfvde_read_context_free(
+	          read_context,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free read context.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT ) */
+
+/* Reads (media) data at a specific offset without using the current offset
+ * This function does not change the current offset, when multi-threading support
+ * is enabled multiple threads can read from the volume concurrently
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libfvde_volume_read_buffer_at_offset_positional(
+         libfvde_volume_t *volume,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libfvde_internal_volume_t *internal_volume = NULL;
+	static char *function                      = "libfvde_volume_read_buffer_at_offset_positional";
+	ssize_t read_count                         = 0;
+
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	libfvde_read_context_t *read_context       = NULL;
+	int grabbed_for_write                      = 0;
+#endif
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfvde_internal_volume_t *) volume;
+
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	/* The read/write lock is only grabbed for reading, the sectors cache
+	 * and read-ahead are protected by their own locks and every thread
+	 * reads using its own read context
+	 */
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->read_contexts == NULL )
+	{
+		/* The file IO handle cannot be cloned into a read context,
+		 * hence the read is serialized on the file IO handle of the volume
+		 */
+		if( libcthreads_read_write_lock_release_for_read(
+		     internal_volume->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock for reading.",
+			 function );
+
+			return( -1 );
+		}
+		if( libcthreads_read_write_lock_grab_for_write(
+		     internal_volume->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read/write lock for writing.",
+			 function );
+
+			return( -1 );
+		}
+		grabbed_for_write = 1;
+
+		read_count = libfvde_internal_volume_read_buffer_at_offset_from_file_io_handle(
+			      internal_volume,
+			      internal_volume->file_io_handle,
+			      internal_volume->io_handle->xts_context,
+			      buffer,
+			      buffer_size,
+			      offset,
+			      error );
+	}
+	else
+	{
+		if( libfvde_internal_volume_get_read_context(
+		     internal_volume,
+		     &read_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve read context.",
+			 function );
+
+			goto on_error;
+		}
+		read_count = libfvde_internal_volume_read_buffer_at_offset_from_file_io_handle(
+			      internal_volume,
+			      read_context->file_io_handle,
+			      read_context->xts_context,
+			      buffer,
+			      buffer_size,
+			      offset,
+			      error );
+	}
+#else
+	read_count = libfvde_internal_volume_read_buffer_at_offset_from_file_io_handle(
+		      internal_volume,
+		      internal_volume->file_io_handle,
+		      internal_volume->io_handle->xts_context,
+		      buffer,
+		      buffer_size,
+		      offset,
+		      error );
+#endif
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	if( read_context != NULL )
+	{
+		if( libfvde_internal_volume_release_read_context(
+		     internal_volume,
+		     &read_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read context.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( grabbed_for_write != 0 )
+	{
+		if( libcthreads_read_write_lock_release_for_write(
+		     internal_volume->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock for writing.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else if( libcthreads_read_write_lock_release_for_read(
+	          internal_volume->read_write_lock,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+
+on_error:
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	if( read_context != NULL )
+	{
+		libfvde_read_context_free(
+		 &read_context,
+		 NULL );
+	}
+	if( grabbed_for_write != 0 )
+	{
+		libcthreads_read_write_lock_release_for_write(
+		 internal_volume->read_write_lock,
+		 NULL );
+	}
+	else
+	{
+		libcthreads_read_write_lock_release_for_read(
+		 internal_volume->read_write_lock,
+		 NULL );
+	}
+#endif
+	return( -1 );
+}
+
+/* Reads sector data that is not cached into a buffer
+ * The offset is relative to the start of the logical volume and must be aligned to the sector data size
+ * The sector data is added to the sectors cache, unless the buffer is large enough to be decrypted in parallel
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_internal_volume_read_uncached_sector_data(
+     libfvde_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     libcaes_tweaked_context_t *xts_context,
+     off64_t offset,
+     uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	libfvde_sector_data_t *sector_data = NULL;
+	static char *function              = "libfvde_internal_volume_read_uncached_sector_data";
+	size_t buffer_offset               = 0;
+	size_t sector_data_size            = 0;
+	uint64_t sector_data_index         = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->io_handle->sector_data_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid volume - invalid IO handle - sector data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( offset < 0 )
+	 || ( ( offset % internal_volume->io_handle->sector_data_size ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfvde_io_handle_read_sectors_to_buffer(
+	     internal_volume->io_handle,
+	     file_io_handle,
+	     xts_context,
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	     internal_volume->decryption_pool,
+#else
+	     NULL,
+#endif
+	     offset,
+	     buffer,
+	     buffer_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read sectors at offset: %" PRIi64 ".",
+		 function,
+		 offset );
+
+		goto on_error;
+	}
+	/* Large reads bypass the sectors cache, as the direct reads of whole sector data do
+	 */
+	if( buffer_size >= LIBFVDE_MINIMUM_PARALLEL_DECRYPTION_SIZE )
+	{
+		return( 1 );
+	}
+	sector_data_index = (uint64_t) offset / internal_volume->io_handle->sector_data_size;
+
+	while( buffer_offset < buffer_size )
+	{
+		sector_data_size = buffer_size - buffer_offset;
+
+		if( sector_data_size > internal_volume->io_handle->sector_data_size )
+		{
+			sector_data_size = internal_volume->io_handle->sector_data_size;
+		}
+		if( libfvde_sector_data_pool_get_sector_data(
+		     internal_volume->sector_data_pool,
+		     sector_data_size,
+		     &sector_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve sector data from pool.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     sector_data->data,
+		     &( buffer[ buffer_offset ] ),
+		     sector_data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy buffer to sector data.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfvde_sectors_cache_set_sector_data(
+		     internal_volume->sectors_cache,
+		     sector_data_index,
+		     sector_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set sector data: %" PRIu64 " in sectors cache.",
+			 function,
+			 sector_data_index );
+
+			goto on_error;
+		}
+		sector_data = NULL;
+
+		buffer_offset     += sector_data_size;
+		sector_data_index += 1;
+	}
+	return( 1 );
+
+on_error:
+	if( sector_data != NULL )
+	{
+		libfvde_sector_data_pool_release_sector_data(
+		 &sector_data,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads (volume) data at specific offsets into buffers using a Basic File IO (bfio) handle
+ * The requests are coalesced into ranges of sector data that are read in the order of their physical offset
+ * The file IO handle and XTS context cannot be used by another thread during the call
+ * This function does not change the current offset
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_internal_volume_read_buffers_at_offsets_from_file_io_handle(
+     libfvde_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     libcaes_tweaked_context_t *xts_context,
+     void **buffers,
+     const size_t *buffer_sizes,
+     const off64_t *offsets,
+     ssize_t *read_counts,
+     int number_of_buffers,
+     libcerror_error_t **error )
+{
+	libfvde_read_batch_entry_t *entry  = NULL;
+	libfvde_read_batch_range_t *range  = NULL;
+	libfvde_read_batch_t *read_batch   = NULL;
+	uint8_t *range_data                = NULL;
+	static char *function              = "libfvde_internal_volume_read_buffers_at_offsets_from_file_io_handle";
+	size64_t remaining_range_size      = 0;
+	size_t chunk_size                  = 0;
+	size_t maximum_chunk_size          = 0;
+	size_t range_data_offset           = 0;
+	size_t sector_data_size            = 0;
+	size_t uncached_size               = 0;
+	off64_t chunk_end_offset           = 0;
+	off64_t chunk_offset               = 0;
+	off64_t copy_end_offset            = 0;
+	off64_t copy_offset                = 0;
+	off64_t sector_data_offset         = 0;
+	uint64_t sector_data_index         = 0;
+	int buffer_index                   = 0;
+	int entry_index                    = 0;
+	int range_index                    = 0;
+	int result                         = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->io_handle->sector_data_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid volume - invalid IO handle - sector data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->sectors_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing sectors cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->sector_data_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing sector data pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffers.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_sizes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer sizes.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_buffers <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of buffers value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	for( buffer_index = 0;
+	     buffer_index < number_of_buffers;
+	     buffer_index++ )
+	{
+		if( ( buffers[ buffer_index ] == NULL )
+		 && ( buffer_sizes[ buffer_index ] > 0 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid buffer: %d.",
+			 function,
+			 buffer_index );
+
+			return( -1 );
+		}
+	}
+	if( libfvde_read_batch_initialize(
+	     &read_batch,
+	     number_of_buffers,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create read batch.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfvde_read_batch_set_requests(
+	     read_batch,
+	     internal_volume->io_handle,
+	     offsets,
+	     buffer_sizes,
+	     read_counts,
+	     number_of_buffers,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set read batch requests.",
+		 function );
+
+		goto on_error;
+	}
+	if( read_batch->number_of_ranges == 0 )
+	{
+		libfvde_read_batch_free(
+		 &read_batch,
+		 NULL );
+
+		return( 1 );
+	}
+	/* Ranges larger than the maximum batch data size are read in multiple chunks
+	 */
+	maximum_chunk_size = LIBFVDE_MAXIMUM_READ_BATCH_DATA_SIZE - ( LIBFVDE_MAXIMUM_READ_BATCH_DATA_SIZE % internal_volume->io_handle->sector_data_size );
+
+	if( (size64_t) maximum_chunk_size > read_batch->maximum_range_size )
+	{
+		maximum_chunk_size = (size_t) read_batch->maximum_range_size;
+	}
+	range_data = (uint8_t *) memory_allocate(
+	                          sizeof( uint8_t ) * maximum_chunk_size );
+
+	if( range_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create range data.",
+		 function );
+
+		goto on_error;
+	}
+	for( range_index = 0;
+	     range_index < read_batch->number_of_ranges;
+	     range_index++ )
+	{
+		range = &( read_batch->ranges[ range_index ] );
+
+		chunk_offset         = range->offset;
+		remaining_range_size = range->size;
+
+		while( remaining_range_size > 0 )
+		{
+			chunk_size = maximum_chunk_size;
+
+			if( (size64_t) chunk_size > remaining_range_size )
+			{
+				chunk_size = (size_t) remaining_range_size;
+			}
+			chunk_end_offset = chunk_offset + (off64_t) chunk_size;
+
+			/* Cached sector data is copied, consecutive sector data that is not cached
+			 * is read and decrypted with a single call
+			 */
+			uncached_size     = 0;
+			range_data_offset = 0;
+
+			while( range_data_offset < chunk_size )
+			{
+				sector_data_offset = chunk_offset + (off64_t) range_data_offset;
+				sector_data_index  = (uint64_t) sector_data_offset / internal_volume->io_handle->sector_data_size;
+				sector_data_size   = chunk_size - range_data_offset;
+
+				if( sector_data_size > internal_volume->io_handle->sector_data_size )
+				{
+					sector_data_size = internal_volume->io_handle->sector_data_size;
+				}
+				result = libfvde_sectors_cache_copy_data(
+				          internal_volume->sectors_cache,
+				          sector_data_index,
+				          0,
+				          &( range_data[ range_data_offset ] ),
+				          sector_data_size,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to copy data of sector data: %" PRIu64 " from sectors cache.",
+					 function,
+					 sector_data_index );
+
+					goto on_error;
+				}
+				else if( result == 0 )
+				{
+					uncached_size += sector_data_size;
+				}
+				range_data_offset += sector_data_size;
+
+				if( ( uncached_size > 0 )
+				 && ( ( result != 0 )
+				  || ( range_data_offset >= chunk_size ) ) )
+				{
+					if( result != 0 )
+					{
+						sector_data_offset -= (off64_t) uncached_size;
+					}
+					else
+					{
+						sector_data_offset = chunk_end_offset - (off64_t) uncached_size;
+					}
+					if( libfvde_internal_volume_read_uncached_sector_data(
+					     internal_volume,
+					     file_io_handle,
+					     xts_context,
+					     sector_data_offset,
+					     &( range_data[ sector_data_offset - chunk_offset ] ),
+					     uncached_size,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_READ_FAILED,
+						 "%s: unable to read sector data at offset: %" PRIi64 ".",
+						 function,
+						 sector_data_offset );
+
+						goto on_error;
+					}
+					uncached_size = 0;
+				}
+			}
+			/* Copy the part of every request of the range that is in the chunk
+			 */
+			for( entry_index = range->first_entry_index;
+			     entry_index < ( range->first_entry_index + range->number_of_entries );
+			     entry_index++ )
+			{
+				entry        = &( read_batch->entries[ entry_index ] );
+				buffer_index = entry->request_index;
+
+				copy_offset     = offsets[ buffer_index ];
+				copy_end_offset = copy_offset + (off64_t) read_counts[ buffer_index ];
+
+				if( copy_offset < chunk_offset )
+				{
+					copy_offset = chunk_offset;
+				}
+				if( copy_end_offset > chunk_end_offset )
+				{
+					copy_end_offset = chunk_end_offset;
+				}
+				if( copy_offset >= copy_end_offset )
+				{
+					continue;
+				}
+				if( memory_copy(
+				     &( ( (uint8_t *) buffers[ buffer_index ] )[ copy_offset - offsets[ buffer_index ] ] ),
+				     &( range_data[ copy_offset - chunk_offset ] ),
+				     (size_t) ( copy_end_offset - copy_offset ) ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+					 "%s: unable to copy range data to buffer: %d.",
+					 function,
+					 buffer_index );
+
+					goto on_error;
+				}
+			}
+			chunk_offset          = chunk_end_offset;
+			remaining_range_size -= chunk_size;
+
+			if( internal_volume->io_handle->abort != 0 )
+			{
+				break;
+			}
+		}
+		if( internal_volume->io_handle->abort != 0 )
+		{
+			break;
+		}
+	}
+	/* When aborted the requests of the ranges that were not read completely read no data
+	 */
+	for( ;
+	     range_index < read_batch->number_of_ranges;
+	     range_index++ )
+	{
+		range = &( read_batch->ranges[ range_index ] );
+
+		for( entry_index = range->first_entry_index;
+		     entry_index < ( range->first_entry_index + range->number_of_entries );
+		     entry_index++ )
+		{
+			read_counts[ read_batch->entries[ entry_index ].request_index ] = 0;
+		}
+	}
+	memory_free(
+	 range_data );
+
+	if( libfvde_read_batch_free(
+	     &read_batch,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free read batch.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	if( range_data != NULL )
+	{
+		memory_free(
+		 range_data );
+	}
+	if( read_batch != NULL )
+	{
+		libfvde_read_batch_free(
+		 &read_batch,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads (media) data at specific offsets into buffers
+ * The number of bytes read into each buffer is returned in read counts
+ * This function does not change the current offset
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_volume_read_buffers_at_offsets(
+     libfvde_volume_t *volume,
+     void **buffers,
+     const size_t *buffer_sizes,
+     const off64_t *offsets,
+     ssize_t *read_counts,
+     int number_of_buffers,
+     libcerror_error_t **error )
+{
+	libfvde_internal_volume_t *internal_volume = NULL;
+	static char *function                      = "libfvde_volume_read_buffers_at_offsets";
+	int read_result                            = 0;
+
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	libfvde_read_context_t *read_context       = NULL;
+	int grabbed_for_write                      = 0;
+#endif
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfvde_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	/* The read/write lock is grabbed once for all the buffers
+	 */
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->read_contexts == NULL )
+	{
+		/* The file IO handle cannot be cloned into a read context,
+		 * hence the read is serialized on the file IO handle of the volume
+		 */
+		if( libcthreads_read_write_lock_release_for_read(
+		     internal_volume->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock for reading.",
+			 function );
+
+			return( -1 );
+		}
+		if( libcthreads_read_write_lock_grab_for_write(
+		     internal_volume->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read/write lock for writing.",
+			 function );
+
+			return( -1 );
+		}
+		grabbed_for_write = 1;
+
+		read_result = libfvde_internal_volume_read_buffers_at_offsets_from_file_io_handle(
+			       internal_volume,
+			       internal_volume->file_io_handle,
+			       internal_volume->io_handle->xts_context,
+			       buffers,
+			       buffer_sizes,
+			       offsets,
+			       read_counts,
+			       number_of_buffers,
+			       error );
+	}
+	else
+	{
+		if( libfvde_internal_volume_get_read_context(
+		     internal_volume,
+		     &read_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve read context.",
+			 function );
+
+			goto on_error;
+		}
+		read_result = libfvde_internal_volume_read_buffers_at_offsets_from_file_io_handle(
+			       internal_volume,
+			       read_context->file_io_handle,
+			       read_context->xts_context,
+			       buffers,
+			       buffer_sizes,
+			       offsets,
+			       read_counts,
+			       number_of_buffers,
+			       error );
+	}
+#else
+	read_result = libfvde_internal_volume_read_buffers_at_offsets_from_file_io_handle(
+		       internal_volume,
+		       internal_volume->file_io_handle,
+		       internal_volume->io_handle->xts_context,
+		       buffers,
+		       buffer_sizes,
+		       offsets,
+		       read_counts,
+		       number_of_buffers,
+		       error );
+#endif
+	if( read_result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffers.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	if( read_context != NULL )
+	{
+		if( libfvde_internal_volume_release_read_context(
+		     internal_volume,
+		     &read_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read context.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( grabbed_for_write != 0 )
+	{
+		if( libcthreads_read_write_lock_release_for_write(
+		     internal_volume->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock for writing.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else if( libcthreads_read_write_lock_release_for_read(
+	          internal_volume->read_write_lock,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	if( read_context != NULL )
+	{
+		libfvde_read_context_free(
+		 &read_context,
+		 NULL );
+	}
+	if( grabbed_for_write != 0 )
+	{
+		libcthreads_read_write_lock_release_for_write(
+		 internal_volume->read_write_lock,
+		 NULL );
+	}
+	else
+	{
+		libcthreads_read_write_lock_release_for_read(
+		 internal_volume->read_write_lock,
+		 NULL );
+	}
+#endif
+	return( -1 );
+}
+
+#ifdef TODO_WRITE_SUPPORT
+
+/* Writes (media) data at the current offset
+ * Returns the number of input bytes written, 0 when no longer bytes can be written or -1 on error
+ */
+ssize_t libfvde_volume_write_buffer(
+         libfvde_volume_t *volume,
+         void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	return( -1 );
+}
+
+/* Writes (media) data at a specific offset,
+ * Returns the number of input bytes written, 0 when no longer bytes can be written or -1 on error
+ */
+ssize_t libfvde_volume_write_buffer_at_offset(
+         libfvde_volume_t *volume,
+         const void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	static char *function = "libfvde_volume_write_buffer_at_offset";
+	ssize_t write_count   = 0;
+
+	if( libfvde_volume_seek_offset(
+	     volume,
+	     offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
+		 function );
+
+		return( -1 );
+	}
+	write_count = libfvde_volume_write_buffer(
+	               volume,
+	               buffer,
+	               buffer_size,
+	               error );
+
+	if( write_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write buffer.",
+		 function );
+
+		return( -1 );
+	}
+	return( write_count );
+}
+
+#endif /* TODO_WRITE_SUPPORT */
+
+/* Seeks a certain offset of the (volume) data
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the offset if seek is successful or -1 on error
+ */
+off64_t libfvde_internal_volume_seek_offset(
+         libfvde_internal_volume_t *internal_volume,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	static char *function = "libfvde_internal_volume_seek_offset";
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( whence != SEEK_CUR )
+	 && ( whence != SEEK_END )
+	 && ( whence != SEEK_SET ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		return( -1 );
+	}
+	if( whence == SEEK_CUR )
+	{	
+		offset += internal_volume->current_offset;
+	}
+	else if( whence == SEEK_END )
+	{	
+		offset += (off64_t) internal_volume->io_handle->logical_volume_size;
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: seeking media data offset: %" PRIi64 ".\n",
+		 function,
+		 offset );
+	}
+#endif
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume->current_offset = offset;
+
+	return( offset );
+}
+
+/* Seeks a certain offset of the data
+ * Returns the offset if seek is successful or -1 on error
+ */
+off64_t libfvde_volume_seek_offset(
+         libfvde_volume_t *volume,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	libfvde_internal_volume_t *internal_volume = NULL;
+	static char *function                      = "libfvde_volume_seek_offset";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfvde_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	offset = libfvde_internal_volume_seek_offset(
+	          internal_volume,
+	          offset,
+	          whence,
+	          error );
+
+	if( offset == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
+		 function );
+
+		offset = -1;
+	}
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( offset );
+}
+
+/* Retrieves the current offset of the (volume) data
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_volume_get_offset(
+     libfvde_volume_t *volume,
+     off64_t *offset,
+     libcerror_error_t **error )
+{
+	libfvde_internal_volume_t *internal_volume = NULL;
+	static char *function                      = "libfvde_volume_get_offset";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfvde_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*offset = internal_volume->current_offset;
+
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the logical volume size
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_volume_get_logical_volume_size(
+     libfvde_volume_t *volume,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	libfvde_internal_volume_t *internal_volume = NULL;
+	static char *function                      = "libfvde_volume_get_logical_volume_size";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfvde_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*size = internal_volume->io_handle->logical_volume_size;
+
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the next range of the logical volume that is mapped onto the physical volume
+ * The range starts at or after the offset, logically adjacent mapped extents form a single range
+ * Data outside the mapped ranges is read as 0-byte values
+ * Returns 1 if successful, 0 if no mapped data at or after the offset or -1 on error
+ */
+int libfvde_volume_get_next_mapped_range(
+     libfvde_volume_t *volume,
+     off64_t offset,
+     off64_t *range_offset,
+     size64_t *range_size,
+     libcerror_error_t **error )
+{
+	libfvde_internal_volume_t *internal_volume = NULL;
+	static char *function                      = "libfvde_volume_get_next_mapped_range";
+	off64_t safe_range_offset                  = 0;
+	size64_t safe_range_size                   = 0;
+	int result                                 = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfvde_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( (size64_t) offset < internal_volume->io_handle->logical_volume_size )
+	{
+		if( internal_volume->io_handle->extent_index == NULL )
+		{
+			safe_range_offset = offset;
+			safe_range_size   = internal_volume->io_handle->logical_volume_size - (size64_t) offset;
+
+			result = 1;
+		}
+		else
+		{
+			result = libfvde_extent_index_get_next_mapped_range(
+			          internal_volume->io_handle->extent_index,
+			          offset,
+			          &safe_range_offset,
+			          &safe_range_size,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve next mapped range at offset: %" PRIi64 ".",
+				 function,
+				 offset );
+			}
+			else if( result != 0 )
+			{
+				/* Extents beyond the end of the logical volume are not read
+				 */
+				if( (size64_t) safe_range_offset >= internal_volume->io_handle->logical_volume_size )
+				{
+					result = 0;
+				}
+				else if( safe_range_size > ( internal_volume->io_handle->logical_volume_size - (size64_t) safe_range_offset ) )
+				{
+					safe_range_size = internal_volume->io_handle->logical_volume_size - (size64_t) safe_range_offset;
+				}
+			}
+		}
+	}
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( result == 1 )
+	{
+		*range_offset = safe_range_offset;
+		*range_size   = safe_range_size;
+	}
+	return( result );
+}
+
+/* Retrieves the encryption method of the logical volume
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_volume_get_logical_volume_encryption_method(
+     libfvde_volume_t *volume,
+     uint32_t *encryption_method,
+     libcerror_error_t **error )
+{
+	libfvde_internal_volume_t *internal_volume = NULL;
+	static char *function                      = "libfvde_volume_get_logical_volume_encryption_method";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfvde_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( encryption_method == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid encryption method.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*encryption_method = internal_volume->io_handle->logical_volume_encryption_method;
+
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the logical volume identifier
+ * The identifier is a UUID and is 16 bytes of size
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_volume_get_logical_volume_identifier(
+     libfvde_volume_t *volume,
+     uint8_t *identifier,
+     size_t size,
+     libcerror_error_t **error )
+{
+	libfvde_internal_volume_t *internal_volume = NULL;
+	static char *function                      = "libfvde_volume_get_logical_volume_identifier";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfvde_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( identifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid identifier.",
+		 function );
+
+		return( -1 );
+	}
+	if( size < 16 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: identifier too small.",
+		 function );
+
+		return( -1 );
+	}
+/* TODO HAVE_LIBFVDE_MULTI_THREAD_SUPPORT */
+	if( memory_copy(
+	     identifier,
+	     internal_volume->io_handle->logical_volume_identifier,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to set identifier.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the logical volume group identifier
+ * The identifier is a UUID and is 16 bytes of size
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_volume_get_logical_volume_group_identifier(
+     libfvde_volume_t *volume,
+     uint8_t *group_identifier,
+     size_t size,
+     libcerror_error_t **error )
+{
+	libfvde_internal_volume_t *internal_volume = NULL;
+	static char *function                      = "libfvde_volume_get_logical_volume_group_identifier";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfvde_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( group_identifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid group identifier.",
+		 function );
+
+		return( -1 );
+	}
+	if( size < 16 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: identifier too small.",
+		 function );
+
+		return( -1 );
+	}
+/* TODO HAVE_LIBFVDE_MULTI_THREAD_SUPPORT */
+	if( memory_copy(
+	     group_identifier,
+	     internal_volume->io_handle->logical_volume_group_identifier,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to set group identifier.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the physical volume size
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_volume_get_physical_volume_size(
+     libfvde_volume_t *volume,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	libfvde_internal_volume_t *internal_volume = NULL;
+	static char *function                      = "libfvde_volume_get_physical_volume_size";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfvde_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+/* TODO HAVE_LIBFVDE_MULTI_THREAD_SUPPORT */
+	*size = internal_volume->io_handle->physical_volume_size;
+
+	return( 1 );
+}
+
+/* Retrieves the encryption method of the physical volume
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_volume_get_physical_volume_encryption_method(
+     libfvde_volume_t *volume,
+     uint32_t *encryption_method,
+     libcerror_error_t **error )
+{
+	libfvde_internal_volume_t *internal_volume = NULL;
+	static char *function                      = "libfvde_volume_get_physical_volume_encryption_method";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfvde_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( encryption_method == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid encryption method.",
+		 function );
+
+		return( -1 );
+	}
+/* TODO HAVE_LIBFVDE_MULTI_THREAD_SUPPORT */
+	*encryption_method = internal_volume->io_handle->physical_volume_encryption_method;
+
+	return( 1 );
+}
+
+/* Retrieves the physical volume identifier
+ * The identifier is a UUID and is 16 bytes of size
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_volume_get_physical_volume_identifier(
+     libfvde_volume_t *volume,
+     uint8_t *identifier,
+     size_t size,
+     libcerror_error_t **error )
+{
+	libfvde_internal_volume_t *internal_volume = NULL;
+	static char *function                      = "libfvde_volume_get_physical_volume_identifier";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfvde_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( identifier == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid volume.",
+		 "%s: invalid identifier.",
 		 function );
 
 		return( -1 );
 	}
-	internal_volume = (libfvde_internal_volume_t *) volume;
-
-#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
+	if( size < 16 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: identifier too small.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	is_locked = internal_volume->is_locked;
-
-#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
+/* TODO HAVE_LIBFVDE_MULTI_THREAD_SUPPORT */
+	if( memory_copy(
+	     identifier,
+	     internal_volume->io_handle->physical_volume_identifier,
+	     16 ) == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to set identifier.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	return( is_locked );
+	return( 1 );
 }
 
-/* Reads (volume) data from the last current into a buffer using a Basic File IO (bfio) handle
- * This function is not multi-thread safe acquire write lock before call
- * Returns the number of bytes read or -1 on error
+/* Retrieves the encryption context plist that contains the passphrase wrapped KEKs
+ * The encrypted root plist is decrypted with the volume header key data if needed
+ * Returns 1 if successful, 0 if not available or -1 on error
  */
-ssize_t libfvde_internal_volume_read_buffer_from_file_io_handle(
-         libfvde_internal_volume_t *internal_volume,
-         libbfio_handle_t *file_io_handle,
-         void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
+int libfvde_internal_volume_get_encryption_context_plist(
+     libfvde_internal_volume_t *internal_volume,
+     libfvde_encryption_context_plist_t **encryption_context_plist,
+     libcerror_error_t **error )
 {
-	libfvde_sector_data_t *sector_data = NULL;
-	static char *function              = "libfvde_internal_volume_read_buffer_from_file_io_handle";
-	off64_t element_data_offset        = 0;
-	size_t buffer_offset               = 0;
-	size_t read_size                   = 0;
-	size_t sector_data_offset          = 0;
-	ssize_t total_read_count           = 0;
+	static char *function = "libfvde_internal_volume_get_encryption_context_plist";
+	int result            = 0;
 
 	if( internal_volume == NULL )
 	{
@@ -2228,174 +5626,266 @@ ssize_t libfvde_internal_volume_read_buffer_from_file_io_handle(
 
 		return( -1 );
 	}
-	if( internal_volume->sectors_vector == NULL )
+	if( encryption_context_plist == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid file - missing sectors vector.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid encryption context plist.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_volume->sectors_cache == NULL )
+	*encryption_context_plist = NULL;
+
+	if( ( internal_volume->primary_encrypted_metadata != NULL )
+	 && ( internal_volume->primary_encrypted_metadata->encryption_context_plist_file_is_set != 0 ) )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid file - missing sectors cache.",
-		 function );
+		*encryption_context_plist = internal_volume->primary_encrypted_metadata->encryption_context_plist;
+	}
+	else if( ( internal_volume->secondary_encrypted_metadata != NULL )
+	      && ( internal_volume->secondary_encrypted_metadata->encryption_context_plist_file_is_set != 0 ) )
+	{
+		*encryption_context_plist = internal_volume->secondary_encrypted_metadata->encryption_context_plist;
+	}
+	else if( internal_volume->encrypted_root_plist_file_is_set != 0 )
+	{
+		if( internal_volume->encrypted_root_plist_file_is_decrypted == 0 )
+		{
+			result = libfvde_encryption_context_plist_decrypt(
+			          internal_volume->encrypted_root_plist,
+			          internal_volume->io_handle->key_data,
+			          128,
+			          error );
 
-		return( -1 );
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+				 LIBCERROR_ENCRYPTION_ERROR_DECRYPT_FAILED,
+				 "%s: unable to decrypt encrypted root plist.",
+				 function );
+
+				return( -1 );
+			}
+			internal_volume->encrypted_root_plist_file_is_decrypted = result;
+		}
+		if( internal_volume->encrypted_root_plist_file_is_decrypted != 0 )
+		{
+			*encryption_context_plist = internal_volume->encrypted_root_plist;
+		}
 	}
-	if( internal_volume->current_offset < 0 )
+	if( *encryption_context_plist == NULL )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the number of passphrase wrapped KEKs
+ * The volume needs to be opened but does not need to be unlocked
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_volume_get_number_of_passphrase_wrapped_keks(
+     libfvde_volume_t *volume,
+     int *number_of_passphrase_wrapped_keks,
+     libcerror_error_t **error )
+{
+	libfvde_encryption_context_plist_t *encryption_context_plist = NULL;
+	libfvde_internal_volume_t *internal_volume                   = NULL;
+	static char *function                                        = "libfvde_volume_get_number_of_passphrase_wrapped_keks";
+	int result                                                   = 0;
+
+	if( volume == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid volume - current offset value out of bounds.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
 		 function );
 
 		return( -1 );
 	}
-	if( buffer == NULL )
+	internal_volume = (libfvde_internal_volume_t *) volume;
+
+	if( number_of_passphrase_wrapped_keks == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid buffer.",
+		 "%s: invalid number of passphrase wrapped KEKs.",
 		 function );
 
 		return( -1 );
 	}
-	if( buffer_size > (size_t) SSIZE_MAX )
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid buffer size value exceeds maximum.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( (size64_t) internal_volume->current_offset >= internal_volume->io_handle->logical_volume_size )
+#endif
+	result = libfvde_internal_volume_get_encryption_context_plist(
+	          internal_volume,
+	          &encryption_context_plist,
+	          error );
+
+	if( result == -1 )
 	{
-		return( 0 );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve encryption context plist.",
+		 function );
+
+		goto on_error;
 	}
-	if( (size64_t) ( internal_volume->current_offset + buffer_size ) >= internal_volume->io_handle->logical_volume_size )
+	else if( result == 0 )
 	{
-		buffer_size = (size_t) ( internal_volume->io_handle->logical_volume_size - internal_volume->current_offset );
+		*number_of_passphrase_wrapped_keks = 0;
 	}
-	sector_data_offset = (size_t) ( internal_volume->current_offset % internal_volume->io_handle->bytes_per_sector );
+	else if( libfvde_encryption_context_plist_get_number_of_passphrase_wrapped_keks(
+	          encryption_context_plist,
+	          number_of_passphrase_wrapped_keks,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of passphrase wrapped KEKs.",
+		 function );
 
-	while( buffer_size > 0 )
+		goto on_error;
+	}
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
 	{
-		if( libfdata_vector_get_element_value_at_offset(
-		     internal_volume->sectors_vector,
-		     (intptr_t *) file_io_handle,
-		     internal_volume->sectors_cache,
-		     internal_volume->current_offset,
-		     &element_data_offset,
-		     (intptr_t **) &sector_data,
-		     0,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve sector data at offset: %" PRIi64 ".",
-			 function,
-			 internal_volume->current_offset );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
 
-			return( -1 );
-		}
-		if( sector_data == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing sector data at offset: %" PRIi64 ".",
-			 function,
-			 internal_volume->current_offset );
+		return( -1 );
+	}
+#endif
+	return( 1 );
 
-			return( -1 );
-		}
-		read_size = sector_data->data_size - sector_data_offset;
+on_error:
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_volume->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
 
-		if( read_size > buffer_size )
-		{
-			read_size = buffer_size;
-		}
-		if( read_size == 0 )
-		{
-			break;
-		}
-		if( memory_copy(
-		     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
-		     &( ( sector_data->data )[ sector_data_offset ] ),
-		     read_size ) == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-			 "%s: unable to copy sector data to buffer.",
-			 function );
+/* Retrieves a specific passphrase wrapped KEK
+ * This provides the values needed to verify a password without deriving any key
+ * The volume needs to be opened but does not need to be unlocked
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_volume_get_passphrase_wrapped_kek_by_index(
+     libfvde_volume_t *volume,
+     int passphrase_wrapped_kek_index,
+     uint8_t *salt,
+     size_t salt_size,
+     uint32_t *number_of_iterations,
+     uint8_t *wrapped_kek,
+     size_t wrapped_kek_size,
+     libcerror_error_t **error )
+{
+	libfvde_encryption_context_plist_t *encryption_context_plist = NULL;
+	libfvde_internal_volume_t *internal_volume                   = NULL;
+	libfvde_passphrase_wrapped_kek_t *passphrase_wrapped_kek     = NULL;
+	static char *function                                        = "libfvde_volume_get_passphrase_wrapped_kek_by_index";
+	int result                                                   = 0;
 
-			return( -1 );
-		}
-		buffer_offset     += read_size;
-		buffer_size       -= read_size;
-		total_read_count  += (ssize_t) read_size;
-		sector_data_offset = 0;
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
 
-		internal_volume->current_offset += (off64_t) read_size;
+		return( -1 );
+	}
+	internal_volume = (libfvde_internal_volume_t *) volume;
 
-		if( (size64_t) internal_volume->current_offset >= internal_volume->io_handle->logical_volume_size )
-		{
-			break;
-		}
-		if( internal_volume->io_handle->abort != 0 )
-		{
-			break;
-		}
+	if( salt == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid salt.",
+		 function );
+
+		return( -1 );
 	}
-	return( total_read_count );
-}
+	if( salt_size < 16 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: salt too small.",
+		 function );
 
-/* Reads data at the current offset into a buffer
- * Returns the number of bytes read or -1 on error
- */
-ssize_t libfvde_volume_read_buffer(
-         libfvde_volume_t *volume,
-         void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
-{
-	libfvde_internal_volume_t *internal_volume = NULL;
-	static char *function                      = "libfvde_volume_read_buffer";
-	ssize_t read_count                         = 0;
+		return( -1 );
+	}
+	if( number_of_iterations == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of iterations.",
+		 function );
 
-	if( volume == NULL )
+		return( -1 );
+	}
+	if( wrapped_kek == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid volume.",
+		 "%s: invalid wrapped KEK.",
 		 function );
 
 		return( -1 );
 	}
-	internal_volume = (libfvde_internal_volume_t *) volume;
+	if( wrapped_kek_size < 24 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: wrapped KEK too small.",
+		 function );
 
+		return( -1 );
+	}
 #if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_volume->read_write_lock,
@@ -2411,23 +5901,93 @@ ssize_t libfvde_volume_read_buffer(
 		return( -1 );
 	}
 #endif
-	read_count = libfvde_internal_volume_read_buffer_from_file_io_handle(
-		      internal_volume,
-		      internal_volume->file_io_handle,
-		      buffer,
-		      buffer_size,
-		      error );
+	if( libfvde_internal_volume_get_encryption_context_plist(
+	     internal_volume,
+	     &encryption_context_plist,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve encryption context plist.",
+		 function );
 
-	if( read_count == -1 )
+		goto on_error;
+	}
+	if( libfvde_passphrase_wrapped_kek_initialize(
+	     &passphrase_wrapped_kek,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read buffer.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create passphrase wrapped KEK.",
 		 function );
 
-		read_count = -1;
+		goto on_error;
+	}
+	result = libfvde_encrypted_metadata_get_passphrase_wrapped_kek(
+	          encryption_context_plist,
+	          passphrase_wrapped_kek_index,
+	          passphrase_wrapped_kek,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve passphrase wrapped KEK: %d.",
+		 function,
+		 passphrase_wrapped_kek_index );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     salt,
+	     passphrase_wrapped_kek->salt,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy salt.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     wrapped_kek,
+	     passphrase_wrapped_kek->wrapped_kek,
+	     24 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy wrapped KEK.",
+		 function );
+
+		goto on_error;
+	}
+	*number_of_iterations = passphrase_wrapped_kek->number_of_iterations;
+
+	if( libfvde_passphrase_wrapped_kek_free(
+	     &passphrase_wrapped_kek,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free passphrase wrapped KEK.",
+		 function );
+
+		goto on_error;
 	}
 #if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -2444,22 +6004,42 @@ ssize_t libfvde_volume_read_buffer(
 		return( -1 );
 	}
 #endif
-	return( read_count );
+	return( 1 );
+
+on_error:
+	if( passphrase_wrapped_kek != NULL )
+	{
+		libfvde_passphrase_wrapped_kek_free(
+		 &passphrase_wrapped_kek,
+		 NULL );
+	}
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_volume->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
 }
 
-/* Reads (media) data at a specific offset
- * Returns the number of bytes read or -1 on error
+/* Determines which of multiple UTF-8 encoded passwords unwraps a specific passphrase wrapped KEK
+ * The password keys are derived in a batch, using the multi-buffer PBKDF2 if supported by the CPU
+ * The volume needs to be opened but does not need to be unlocked
+ * Returns 1 if one of the passwords unwraps the KEK, 0 if none or -1 on error
  */
-ssize_t libfvde_volume_read_buffer_at_offset(
-         libfvde_volume_t *volume,
-         void *buffer,
-         size_t buffer_size,
-         off64_t offset,
-         libcerror_error_t **error )
+int libfvde_volume_check_utf8_passwords(
+     libfvde_volume_t *volume,
+     int passphrase_wrapped_kek_index,
+     const uint8_t **utf8_strings,
+     const size_t *utf8_string_lengths,
+     int number_of_passwords,
+     int *password_index,
+     libcerror_error_t **error )
 {
-	libfvde_internal_volume_t *internal_volume = NULL;
-	static char *function                      = "libfvde_volume_read_buffer_at_offset";
-	ssize_t read_count                         = 0;
+	libfvde_encryption_context_plist_t *encryption_context_plist = NULL;
+	libfvde_internal_volume_t *internal_volume                   = NULL;
+	libfvde_passphrase_wrapped_kek_t *passphrase_wrapped_kek     = NULL;
+	static char *function                                        = "libfvde_volume_check_utf8_passwords";
+	int result                                                   = 0;
 
 	if( volume == NULL )
 	{
@@ -2474,53 +6054,66 @@ ssize_t libfvde_volume_read_buffer_at_offset(
 	}
 	internal_volume = (libfvde_internal_volume_t *) volume;
 
-#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_volume->read_write_lock,
+	if( libfvde_passphrase_wrapped_kek_initialize(
+	     &passphrase_wrapped_kek,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create passphrase wrapped KEK.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( libfvde_internal_volume_seek_offset(
-	     internal_volume,
-	     offset,
-	     SEEK_SET,
-	     error ) == -1 )
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		goto on_error;
 	}
-	read_count = libfvde_internal_volume_read_buffer_from_file_io_handle(
-		      internal_volume,
-		      internal_volume->file_io_handle,
-		      buffer,
-		      buffer_size,
-		      error );
+#endif
+	result = libfvde_internal_volume_get_encryption_context_plist(
+	          internal_volume,
+	          &encryption_context_plist,
+	          error );
 
-	if( read_count == -1 )
+	if( result != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read buffer.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve encryption context plist.",
 		 function );
+	}
+	else
+	{
+		result = libfvde_encrypted_metadata_get_passphrase_wrapped_kek(
+		          encryption_context_plist,
+		          passphrase_wrapped_kek_index,
+		          passphrase_wrapped_kek,
+		          error );
 
-		goto on_error;
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve passphrase wrapped KEK: %d.",
+			 function,
+			 passphrase_wrapped_kek_index );
+		}
 	}
 #if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -2534,97 +6127,185 @@ ssize_t libfvde_volume_read_buffer_at_offset(
 		 "%s: unable to release read/write lock for writing.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 #endif
-	return( read_count );
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	/* The password keys are derived without holding the lock
+	 */
+	result = libfvde_passphrase_wrapped_kek_check_passwords(
+	          passphrase_wrapped_kek,
+	          utf8_strings,
+	          utf8_string_lengths,
+	          number_of_passwords,
+	          password_index,
+	          error );
 
-on_error:
-#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_volume->read_write_lock,
-	 NULL );
-#endif
-	return( -1 );
-}
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to check passwords.",
+		 function );
 
-#ifdef TODO_WRITE_SUPPORT
+		goto on_error;
+	}
+	if( libfvde_passphrase_wrapped_kek_free(
+	     &passphrase_wrapped_kek,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free passphrase wrapped KEK.",
+		 function );
 
-/* Writes (media) data at the current offset
- * Returns the number of input bytes written, 0 when no longer bytes can be written or -1 on error
- */
-ssize_t libfvde_volume_write_buffer(
-         libfvde_volume_t *volume,
-         void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
-{
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( passphrase_wrapped_kek != NULL )
+	{
+		libfvde_passphrase_wrapped_kek_free(
+		 &passphrase_wrapped_kek,
+		 NULL );
+	}
 	return( -1 );
 }
 
-/* Writes (media) data at a specific offset,
- * Returns the number of input bytes written, 0 when no longer bytes can be written or -1 on error
+/* Sets the keys
+ * This function needs to be used before one of the open functions
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libfvde_volume_write_buffer_at_offset(
-         libfvde_volume_t *volume,
-         const void *buffer,
-         size_t buffer_size,
-         off64_t offset,
-         libcerror_error_t **error )
+int libfvde_volume_set_keys(
+     libfvde_volume_t *volume,
+     const uint8_t *volume_master_key,
+     size_t volume_master_key_size,
+     libcerror_error_t **error )
 {
-	static char *function = "libfvde_volume_write_buffer_at_offset";
-	ssize_t write_count   = 0;
+	libfvde_internal_volume_t *internal_volume = NULL;
+	static char *function                      = "libfvde_volume_set_keys";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfvde_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->keyring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing keyring handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - file IO handle already set.",
+		 function );
 
-	if( libfvde_volume_seek_offset(
-	     volume,
-	     offset,
-	     SEEK_SET,
-	     error ) == -1 )
+		return( -1 );
+	}
+	if( volume_master_key == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume master key.",
 		 function );
 
 		return( -1 );
 	}
-	write_count = libfvde_volume_write_buffer(
-	               volume,
-	               buffer,
-	               buffer_size,
-	               error );
+	if( volume_master_key_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid volume master key size value exceeds maximum.",
+		 function );
 
-	if( write_count < 0 )
+		return( -1 );
+	}
+	if( volume_master_key_size != 16 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_WRITE_FAILED,
-		 "%s: unable to write buffer.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported volume master key size.",
 		 function );
 
 		return( -1 );
 	}
-	return( write_count );
-}
+/* TODO HAVE_LIBFVDE_MULTI_THREAD_SUPPORT */
+	if( memory_copy(
+	     internal_volume->keyring->volume_master_key,
+	     volume_master_key,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy volume master key to keyring.",
+		 function );
 
-#endif /* TODO_WRITE_SUPPORT */
+		return( -1 );
+	}
+	internal_volume->volume_master_key_is_set = 1;
 
-/* Seeks a certain offset of the (volume) data
- * This function is not multi-thread safe acquire write lock before call
- * Returns the offset if seek is successful or -1 on error
+	return( 1 );
+}
+
+/* Sets an UTF-8 formatted password
+ * This function needs to be used before one of the open functions
+ * Returns 1 if successful, 0 if password is invalid or -1 on error
  */
-off64_t libfvde_internal_volume_seek_offset(
-         libfvde_internal_volume_t *internal_volume,
-         off64_t offset,
-         int whence,
-         libcerror_error_t **error )
+int libfvde_volume_set_utf8_password(
+     libfvde_volume_t *volume,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libcerror_error_t **error )
 {
-	static char *function = "libfvde_internal_volume_seek_offset";
+	libfvde_internal_volume_t *internal_volume = NULL;
+	static char *function                      = "libfvde_volume_set_utf8_password";
 
-	if( internal_volume == NULL )
+	if( volume == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -2635,6 +6316,8 @@ off64_t libfvde_internal_volume_seek_offset(
 
 		return( -1 );
 	}
+	internal_volume = (libfvde_internal_volume_t *) volume;
+
 	if( internal_volume->io_handle == NULL )
 	{
 		libcerror_error_set(
@@ -2646,63 +6329,133 @@ off64_t libfvde_internal_volume_seek_offset(
 
 		return( -1 );
 	}
-	if( ( whence != SEEK_CUR )
-	 && ( whence != SEEK_END )
-	 && ( whence != SEEK_SET ) )
+	if( internal_volume->file_io_handle != NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported whence.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - file IO handle already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( whence == SEEK_CUR )
-	{	
-		offset += internal_volume->current_offset;
+/* TODO HAVE_LIBFVDE_MULTI_THREAD_SUPPORT */
+	if( internal_volume->io_handle->user_password != NULL )
+	{
+		if( memory_set(
+		     internal_volume->io_handle->user_password,
+		     0,
+		     internal_volume->io_handle->user_password_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear user password.",
+			 function );
+
+			return( -1 );
+		}
+		memory_free(
+		 internal_volume->io_handle->user_password );
+
+		internal_volume->io_handle->user_password      = NULL;
+		internal_volume->io_handle->user_password_size = 0;
 	}
-	else if( whence == SEEK_END )
-	{	
-		offset += (off64_t) internal_volume->io_handle->logical_volume_size;
+	if( libuna_byte_stream_size_from_utf8(
+	     utf8_string,
+	     utf8_string_length,
+	     LIBFVDE_CODEPAGE_US_ASCII,
+	     &( internal_volume->io_handle->user_password_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set password size.",
+		 function );
+
+		goto on_error;
+	}
+	internal_volume->io_handle->user_password_size += 1;
+
+	internal_volume->io_handle->user_password = (uint8_t *) memory_allocate(
+	                                                         sizeof( uint8_t ) * internal_volume->io_handle->user_password_size );
+
+	if( internal_volume->io_handle->user_password == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to create user password.",
+		 function );
+
+		goto on_error;
+	}
+	if( libuna_byte_stream_copy_from_utf8(
+	     internal_volume->io_handle->user_password,
+	     internal_volume->io_handle->user_password_size,
+	     LIBFVDE_CODEPAGE_US_ASCII,
+	     utf8_string,
+	     utf8_string_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to copy user password.",
+		 function );
+
+		goto on_error;
 	}
+	internal_volume->io_handle->user_password[ internal_volume->io_handle->user_password_size - 1 ] = 0;
+
+	internal_volume->io_handle->user_password_is_set = 1;
+
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
 		libcnotify_printf(
-		 "%s: seeking media data offset: %" PRIi64 ".\n",
+		 "%s: user password: %s\n",
 		 function,
-		 offset );
+		 internal_volume->io_handle->user_password );
 	}
 #endif
-	if( offset < 0 )
+	return( 1 );
+
+on_error:
+	if( internal_volume->io_handle->user_password != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid offset value out of bounds.",
-		 function );
+		memory_set(
+		 internal_volume->io_handle->user_password,
+		 0,
+		 internal_volume->io_handle->user_password_size );
+		memory_free(
+		 internal_volume->io_handle->user_password );
 
-		return( -1 );
+		internal_volume->io_handle->user_password = NULL;
 	}
-	internal_volume->current_offset = offset;
+	internal_volume->io_handle->user_password_size = 0;
 
-	return( offset );
+	return( -1 );
 }
 
-/* Seeks a certain offset of the data
- * Returns the offset if seek is successful or -1 on error
+/* Sets an UTF-16 formatted password
+ * This function needs to be used before one of the open functions
+ * Returns 1 if successful, 0 if password is invalid or -1 on error
  */
-off64_t libfvde_volume_seek_offset(
-         libfvde_volume_t *volume,
-         off64_t offset,
-         int whence,
-         libcerror_error_t **error )
+int libfvde_volume_set_utf16_password(
+     libfvde_volume_t *volume,
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     libcerror_error_t **error )
 {
 	libfvde_internal_volume_t *internal_volume = NULL;
-	static char *function                      = "libfvde_volume_seek_offset";
+	static char *function                      = "libfvde_volume_set_utf16_password";
 
 	if( volume == NULL )
 	{
@@ -2726,68 +6479,135 @@ off64_t libfvde_volume_seek_offset(
 		 "%s: invalid volume - missing IO handle.",
 		 function );
 
-		return( -1 );
+		return( -1 );
+	}
+	if( internal_volume->file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - file IO handle already set.",
+		 function );
+
+		return( -1 );
+	}
+/* TODO HAVE_LIBFVDE_MULTI_THREAD_SUPPORT */
+	if( internal_volume->io_handle->user_password != NULL )
+	{
+		if( memory_set(
+		     internal_volume->io_handle->user_password,
+		     0,
+		     internal_volume->io_handle->user_password_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear user password.",
+			 function );
+
+			return( -1 );
+		}
+		memory_free(
+		 internal_volume->io_handle->user_password );
+
+		internal_volume->io_handle->user_password      = NULL;
+		internal_volume->io_handle->user_password_size = 0;
 	}
-#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_volume->read_write_lock,
+	if( libuna_byte_stream_size_from_utf16(
+	     utf16_string,
+	     utf16_string_length,
+	     LIBFVDE_CODEPAGE_US_ASCII,
+	     &( internal_volume->io_handle->user_password_size ),
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to set password length.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
-	offset = libfvde_internal_volume_seek_offset(
-	          internal_volume,
-	          offset,
-	          whence,
-	          error );
+	internal_volume->io_handle->user_password_size += 1;
 
-	if( offset == -1 )
+	internal_volume->io_handle->user_password = (uint8_t *) memory_allocate(
+	                                                         sizeof( uint8_t ) * internal_volume->io_handle->user_password_size );
+
+	if( internal_volume->io_handle->user_password == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to create user password.",
 		 function );
 
-		offset = -1;
+		goto on_error;
 	}
-#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_volume->read_write_lock,
+	if( libuna_byte_stream_copy_from_utf16(
+	     internal_volume->io_handle->user_password,
+	     internal_volume->io_handle->user_password_size,
+	     LIBFVDE_CODEPAGE_US_ASCII,
+	     utf16_string,
+	     utf16_string_length,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to copy user password.",
 		 function );
 
-		return( -1 );
+		goto on_error;
+	}
+	internal_volume->io_handle->user_password[ internal_volume->io_handle->user_password_size - 1 ] = 0;
+
+	internal_volume->io_handle->user_password_is_set = 1;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: user password: %s\n",
+		 function,
+		 internal_volume->io_handle->user_password );
 	}
 #endif
-	return( offset );
+	return( 1 );
+
+on_error:
+	if( internal_volume->io_handle->user_password != NULL )
+	{
+		memory_set(
+		 internal_volume->io_handle->user_password,
+		 0,
+		 internal_volume->io_handle->user_password_size );
+		memory_free(
+		 internal_volume->io_handle->user_password );
+
+		internal_volume->io_handle->user_password = NULL;
+	}
+	internal_volume->io_handle->user_password_size = 0;
+
+	return( -1 );
 }
 
-/* Retrieves the current offset of the (volume) data
- * Returns 1 if successful or -1 on error
+/* Sets an UTF-8 formatted recovery password
+ * This function needs to be used before one of the open functions
+ * Returns 1 if successful, 0 if recovery password is invalid or -1 on error
  */
-int libfvde_volume_get_offset(
+int libfvde_volume_set_utf8_recovery_password(
      libfvde_volume_t *volume,
-     off64_t *offset,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
      libcerror_error_t **error )
 {
 	libfvde_internal_volume_t *internal_volume = NULL;
-	static char *function                      = "libfvde_volume_get_offset";
+	static char *function                      = "libfvde_volume_set_utf8_recovery_password";
 
 	if( volume == NULL )
 	{
@@ -2813,62 +6633,133 @@ int libfvde_volume_get_offset(
 
 		return( -1 );
 	}
-	if( offset == NULL )
+	if( internal_volume->file_io_handle != NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid offset.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - file IO handle already set.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_volume->read_write_lock,
+/* TODO HAVE_LIBFVDE_MULTI_THREAD_SUPPORT */
+	if( internal_volume->io_handle->recovery_password != NULL )
+	{
+		if( memory_set(
+		     internal_volume->io_handle->recovery_password,
+		     0,
+		     internal_volume->io_handle->recovery_password_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear recovery password.",
+			 function );
+
+			return( -1 );
+		}
+		memory_free(
+		 internal_volume->io_handle->recovery_password );
+
+		internal_volume->io_handle->recovery_password      = NULL;
+		internal_volume->io_handle->recovery_password_size = 0;
+	}
+	if( libuna_byte_stream_size_from_utf8(
+	     utf8_string,
+	     utf8_string_length,
+	     LIBFVDE_CODEPAGE_US_ASCII,
+	     &( internal_volume->io_handle->recovery_password_size ),
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to set recovery pasword size.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
-	*offset = internal_volume->current_offset;
+	internal_volume->io_handle->recovery_password_size += 1;
 
-#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     internal_volume->read_write_lock,
+	internal_volume->io_handle->recovery_password = (uint8_t *) memory_allocate(
+	                                                             sizeof( uint8_t ) * internal_volume->io_handle->recovery_password_size );
+
+	if( internal_volume->io_handle->recovery_password == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to create recovery password.",
+		 function );
+
+		goto on_error;
+	}
+	if( libuna_byte_stream_copy_from_utf8(
+	     internal_volume->io_handle->recovery_password,
+	     internal_volume->io_handle->recovery_password_size,
+	     LIBFVDE_CODEPAGE_US_ASCII,
+	     utf8_string,
+	     utf8_string_length,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to copy recovery password.",
 		 function );
 
-		return( -1 );
+		goto on_error;
+	}
+	internal_volume->io_handle->recovery_password[ internal_volume->io_handle->recovery_password_size - 1 ] = 0;
+
+	internal_volume->io_handle->recovery_password_is_set = 1;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: recovery password: %s\n",
+		 function,
+		 internal_volume->io_handle->recovery_password );
 	}
 #endif
 	return( 1 );
+
+on_error:
+	if( internal_volume->io_handle->recovery_password != NULL )
+	{
+		memory_set(
+		 internal_volume->io_handle->recovery_password,
+		 0,
+		 internal_volume->io_handle->recovery_password_size );
+		memory_free(
+		 internal_volume->io_handle->recovery_password );
+
+		internal_volume->io_handle->recovery_password = NULL;
+	}
+	internal_volume->io_handle->recovery_password_size = 0;
+
+	return( -1 );
 }
 
-/* Retrieves the logical volume size
- * Returns 1 if successful or -1 on error
+/* Sets an UTF-16 formatted recovery password
+ * This function needs to be used before one of the open functions
+ * Returns 1 if successful, 0 if recovery password is invalid or -1 on error
  */
-int libfvde_volume_get_logical_volume_size(
+int libfvde_volume_set_utf16_recovery_password(
      libfvde_volume_t *volume,
-     size64_t *size,
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
      libcerror_error_t **error )
 {
 	libfvde_internal_volume_t *internal_volume = NULL;
-	static char *function                      = "libfvde_volume_get_logical_volume_size";
+	static char *function                     = "libfvde_volume_set_utf16_recovery_password";
 
 	if( volume == NULL )
 	{
@@ -2894,62 +6785,133 @@ int libfvde_volume_get_logical_volume_size(
 
 		return( -1 );
 	}
-	if( size == NULL )
+	if( internal_volume->file_io_handle != NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid size.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - file IO handle already set.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_volume->read_write_lock,
+/* TODO HAVE_LIBFVDE_MULTI_THREAD_SUPPORT */
+	if( internal_volume->io_handle->recovery_password != NULL )
+	{
+		if( memory_set(
+		     internal_volume->io_handle->recovery_password,
+		     0,
+		     internal_volume->io_handle->recovery_password_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear recovery password.",
+			 function );
+
+			return( -1 );
+		}
+		memory_free(
+		 internal_volume->io_handle->recovery_password );
+
+		internal_volume->io_handle->recovery_password      = NULL;
+		internal_volume->io_handle->recovery_password_size = 0;
+	}
+	if( libuna_byte_stream_size_from_utf16(
+	     utf16_string,
+	     utf16_string_length,
+	     LIBFVDE_CODEPAGE_US_ASCII,
+	     &(internal_volume->io_handle->recovery_password_size ),
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to set recovery size.",
+		 function );
+
+		goto on_error;
+	}
+	internal_volume->io_handle->recovery_password_size += 1;
+
+	internal_volume->io_handle->recovery_password = (uint8_t *) memory_allocate(
+	                                                             sizeof( uint8_t ) * internal_volume->io_handle->recovery_password_size );
+
+	if( internal_volume->io_handle->recovery_password == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to create recovery password.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
-	*size = internal_volume->io_handle->logical_volume_size;
-
-#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     internal_volume->read_write_lock,
+	if( libuna_byte_stream_copy_from_utf16(
+	     internal_volume->io_handle->recovery_password,
+	     internal_volume->io_handle->recovery_password_size,
+	     LIBFVDE_CODEPAGE_US_ASCII,
+	     utf16_string,
+	     utf16_string_length,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to copy recovery password.",
 		 function );
 
-		return( -1 );
+		goto on_error;
+	}
+	internal_volume->io_handle->recovery_password[ internal_volume->io_handle->recovery_password_size - 1 ] = 0;
+
+	internal_volume->io_handle->recovery_password_is_set = 1;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: recovery password: %s\n",
+		 function,
+		 internal_volume->io_handle->recovery_password );
 	}
 #endif
 	return( 1 );
+
+on_error:
+	if( internal_volume->io_handle->recovery_password != NULL )
+	{
+		memory_set(
+		 internal_volume->io_handle->recovery_password,
+		 0,
+		 internal_volume->io_handle->recovery_password_size );
+		memory_free(
+		 internal_volume->io_handle->recovery_password );
+
+		internal_volume->io_handle->recovery_password = NULL;
+	}
+	internal_volume->io_handle->recovery_password_size = 0;
+
+	return( -1 );
 }
 
-/* Retrieves the encryption method of the logical volume
+/* Sets the size of the data read and decrypted at once
+ * The size must be a multiple of 512, 0 represents the block size of the volume
+ * This function needs to be used before one of the open functions
  * Returns 1 if successful or -1 on error
  */
-int libfvde_volume_get_logical_volume_encryption_method(
+int libfvde_volume_set_sector_data_size(
      libfvde_volume_t *volume,
-     uint32_t *encryption_method,
+     size_t sector_data_size,
      libcerror_error_t **error )
 {
 	libfvde_internal_volume_t *internal_volume = NULL;
-	static char *function                      = "libfvde_volume_get_logical_volume_encryption_method";
+	static char *function                      = "libfvde_volume_set_sector_data_size";
 
 	if( volume == NULL )
 	{
@@ -2964,75 +6926,56 @@ int libfvde_volume_get_logical_volume_encryption_method(
 	}
 	internal_volume = (libfvde_internal_volume_t *) volume;
 
-	if( internal_volume->io_handle == NULL )
+	if( internal_volume->file_io_handle != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - file IO handle already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( encryption_method == NULL )
+	if( sector_data_size > (size_t) LIBFVDE_MAXIMUM_SECTOR_DATA_SIZE )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid encryption method.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid sector data size value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
+	if( ( sector_data_size % 512 ) != 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported sector data size value not a multiple of 512.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	*encryption_method = internal_volume->io_handle->logical_volume_encryption_method;
-
-#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
-		 function );
+	internal_volume->sector_data_size = sector_data_size;
 
-		return( -1 );
-	}
-#endif
 	return( 1 );
 }
 
-/* Retrieves the logical volume identifier
- * The identifier is a UUID and is 16 bytes of size
+/* Sets the size of the sectors cache in bytes
+ * 0 represents the default number of cache entries
+ * This function needs to be used before one of the open functions
  * Returns 1 if successful or -1 on error
  */
-int libfvde_volume_get_logical_volume_identifier(
+int libfvde_volume_set_cache_size(
      libfvde_volume_t *volume,
-     uint8_t *identifier,
-     size_t size,
+     size_t cache_size,
      libcerror_error_t **error )
 {
 	libfvde_internal_volume_t *internal_volume = NULL;
-	static char *function                      = "libfvde_volume_get_logical_volume_identifier";
+	static char *function                      = "libfvde_volume_set_cache_size";
 
 	if( volume == NULL )
 	{
@@ -3047,69 +6990,47 @@ int libfvde_volume_get_logical_volume_identifier(
 	}
 	internal_volume = (libfvde_internal_volume_t *) volume;
 
-	if( internal_volume->io_handle == NULL )
+	if( internal_volume->file_io_handle != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing IO handle.",
-		 function );
-
-		return( -1 );
-	}
-	if( identifier == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid identifier.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - file IO handle already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( size < 16 )
+	if( cache_size > (size_t) LIBFVDE_MAXIMUM_CACHE_SIZE )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
-		 "%s: identifier too small.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid cache size value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
-/* TODO HAVE_LIBFVDE_MULTI_THREAD_SUPPORT */
-	if( memory_copy(
-	     identifier,
-	     internal_volume->io_handle->logical_volume_identifier,
-	     16 ) == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-		 "%s: unable to set identifier.",
-		 function );
+	internal_volume->cache_size = cache_size;
 
-		return( -1 );
-	}
 	return( 1 );
 }
 
-/* Retrieves the logical volume group identifier
- * The identifier is a UUID and is 16 bytes of size
+/* Sets the maximum size of the data read ahead at once in bytes
+ * The size must be a multiple of 512, 0 disables read-ahead
+ * Read-ahead is only used if the library was built with multi-threading support
+ * and the file IO handle can be cloned
+ * This function needs to be used before one of the open functions
  * Returns 1 if successful or -1 on error
  */
-int libfvde_volume_get_logical_volume_group_identifier(
+int libfvde_volume_set_read_ahead_size(
      libfvde_volume_t *volume,
-     uint8_t *group_identifier,
-     size_t size,
+     size_t read_ahead_size,
      libcerror_error_t **error )
 {
 	libfvde_internal_volume_t *internal_volume = NULL;
-	static char *function                      = "libfvde_volume_get_logical_volume_group_identifier";
+	static char *function                      = "libfvde_volume_set_read_ahead_size";
 
 	if( volume == NULL )
 	{
@@ -3124,67 +7045,57 @@ int libfvde_volume_get_logical_volume_group_identifier(
 	}
 	internal_volume = (libfvde_internal_volume_t *) volume;
 
-	if( internal_volume->io_handle == NULL )
+	if( internal_volume->file_io_handle != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - file IO handle already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( group_identifier == NULL )
+	if( read_ahead_size > (size_t) LIBFVDE_MAXIMUM_READ_AHEAD_SIZE )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid group identifier.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid read-ahead size value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
-	if( size < 16 )
+	if( ( read_ahead_size % 512 ) != 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
-		 "%s: identifier too small.",
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported read-ahead size value not a multiple of 512.",
 		 function );
 
 		return( -1 );
 	}
-/* TODO HAVE_LIBFVDE_MULTI_THREAD_SUPPORT */
-	if( memory_copy(
-	     group_identifier,
-	     internal_volume->io_handle->logical_volume_group_identifier,
-	     16 ) == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-		 "%s: unable to set group identifier.",
-		 function );
+	internal_volume->read_ahead_size = read_ahead_size;
 
-		return( -1 );
-	}
 	return( 1 );
 }
 
-/* Retrieves the physical volume size
+/* Sets the number of threads used to decrypt large reads
+ * 0 disables decrypting large reads using multiple threads
+ * Multiple threads are only used if the library was built with multi-threading support
+ * This function needs to be used before one of the open functions
  * Returns 1 if successful or -1 on error
  */
-int libfvde_volume_get_physical_volume_size(
+int libfvde_volume_set_number_of_decryption_threads(
      libfvde_volume_t *volume,
-     size64_t *size,
+     int number_of_threads,
      libcerror_error_t **error )
 {
 	libfvde_internal_volume_t *internal_volume = NULL;
-	static char *function                      = "libfvde_volume_get_physical_volume_size";
+	static char *function                      = "libfvde_volume_set_number_of_decryption_threads";
 
 	if( volume == NULL )
 	{
@@ -3199,44 +7110,47 @@ int libfvde_volume_get_physical_volume_size(
 	}
 	internal_volume = (libfvde_internal_volume_t *) volume;
 
-	if( internal_volume->io_handle == NULL )
+	if( internal_volume->file_io_handle != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - file IO handle already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( size == NULL )
+	if( ( number_of_threads < 0 )
+	 || ( number_of_threads > LIBFVDE_MAXIMUM_NUMBER_OF_DECRYPTION_THREADS ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid size.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-/* TODO HAVE_LIBFVDE_MULTI_THREAD_SUPPORT */
-	*size = internal_volume->io_handle->physical_volume_size;
+	internal_volume->number_of_decryption_threads = number_of_threads;
 
 	return( 1 );
 }
 
-/* Retrieves the encryption method of the physical volume
+/* Sets if the volume is opened lazily
+ * When opened lazily the header and checksum of every copy of the metadata
+ * are validated and only the newest valid copy is parsed
+ * This function needs to be used before one of the open functions
  * Returns 1 if successful or -1 on error
  */
-int libfvde_volume_get_physical_volume_encryption_method(
+int libfvde_volume_set_lazy_open(
      libfvde_volume_t *volume,
-     uint32_t *encryption_method,
+     uint8_t lazy_open,
      libcerror_error_t **error )
 {
 	libfvde_internal_volume_t *internal_volume = NULL;
-	static char *function                      = "libfvde_volume_get_physical_volume_encryption_method";
+	static char *function                      = "libfvde_volume_set_lazy_open";
 
 	if( volume == NULL )
 	{
@@ -3251,46 +7165,40 @@ int libfvde_volume_get_physical_volume_encryption_method(
 	}
 	internal_volume = (libfvde_internal_volume_t *) volume;
 
-	if( internal_volume->io_handle == NULL )
+	if( internal_volume->file_io_handle != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - file IO handle already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( encryption_method == NULL )
+	if( lazy_open != 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid encryption method.",
-		 function );
-
-		return( -1 );
+		internal_volume->lazy_open = 1;
+	}
+	else
+	{
+		internal_volume->lazy_open = 0;
 	}
-/* TODO HAVE_LIBFVDE_MULTI_THREAD_SUPPORT */
-	*encryption_method = internal_volume->io_handle->physical_volume_encryption_method;
-
 	return( 1 );
 }
 
-/* Retrieves the physical volume identifier
- * The identifier is a UUID and is 16 bytes of size
+/* Sets the metadata parse profile
+ * Only the encrypted metadata block types of the parse profile are read
+ * This function needs to be used before one of the open functions
  * Returns 1 if successful or -1 on error
  */
-int libfvde_volume_get_physical_volume_identifier(
+int libfvde_volume_set_parse_profile(
      libfvde_volume_t *volume,
-     uint8_t *identifier,
-     size_t size,
+     uint8_t parse_profile,
      libcerror_error_t **error )
 {
 	libfvde_internal_volume_t *internal_volume = NULL;
-	static char *function                      = "libfvde_volume_get_physical_volume_identifier";
+	static char *function                      = "libfvde_volume_set_parse_profile";
 
 	if( volume == NULL )
 	{
@@ -3305,69 +7213,47 @@ int libfvde_volume_get_physical_volume_identifier(
 	}
 	internal_volume = (libfvde_internal_volume_t *) volume;
 
-	if( internal_volume->io_handle == NULL )
+	if( internal_volume->file_io_handle != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing IO handle.",
-		 function );
-
-		return( -1 );
-	}
-	if( identifier == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid identifier.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - file IO handle already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( size < 16 )
+	if( ( parse_profile == 0 )
+	 || ( ( parse_profile & ~( LIBFVDE_PARSE_PROFILE_FULL ) ) != 0 ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
-		 "%s: identifier too small.",
-		 function );
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported parse profile: 0x%02" PRIx8 ".",
+		 function,
+		 parse_profile );
 
 		return( -1 );
 	}
-/* TODO HAVE_LIBFVDE_MULTI_THREAD_SUPPORT */
-	if( memory_copy(
-	     identifier,
-	     internal_volume->io_handle->physical_volume_identifier,
-	     16 ) == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-		 "%s: unable to set identifier.",
-		 function );
+	internal_volume->parse_profile = parse_profile;
 
-		return( -1 );
-	}
 	return( 1 );
 }
 
-/* Sets the keys
- * This function needs to be used before one of the open functions
+/* Reads the EncryptedRoot.plist file
+ * This function needs to be used before one of the open functions.
  * Returns 1 if successful or -1 on error
  */
-int libfvde_volume_set_keys(
+int libfvde_volume_read_encrypted_root_plist(
      libfvde_volume_t *volume,
-     const uint8_t *volume_master_key,
-     size_t volume_master_key_size,
+     const char *filename,
      libcerror_error_t **error )
 {
-	libfvde_internal_volume_t *internal_volume = NULL;
-	static char *function                      = "libfvde_volume_set_keys";
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "libfvde_volume_read_encrypted_root_plist";
+	size_t filename_length           = 0;
 
 	if( volume == NULL )
 	{
@@ -3380,106 +7266,103 @@ int libfvde_volume_set_keys(
 
 		return( -1 );
 	}
-	internal_volume = (libfvde_internal_volume_t *) volume;
+/* TODO HAVE_LIBFVDE_MULTI_THREAD_SUPPORT */
+	filename_length = narrow_string_length(
+	                   filename );
 
-	if( internal_volume->io_handle == NULL )
+	if( filename_length == 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( internal_volume->keyring == NULL )
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing keyring handle.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( internal_volume->file_io_handle != NULL )
+	if( libbfio_file_set_name(
+	     file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid volume - file IO handle already set.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename in file IO handle.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( volume_master_key == NULL )
+	if( libfvde_volume_read_encrypted_root_plist_file_io_handle(
+	     volume,
+	     file_io_handle,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid volume master key.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read encrypted root plist file: %s.",
+		 function,
+		 filename );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( volume_master_key_size > (size_t) SSIZE_MAX )
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid volume master key size value exceeds maximum.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( volume_master_key_size != 16 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported volume master key size.",
-		 function );
+	return( 1 );
 
-		return( -1 );
-	}
-/* TODO HAVE_LIBFVDE_MULTI_THREAD_SUPPORT */
-	if( memory_copy(
-	     internal_volume->keyring->volume_master_key,
-	     volume_master_key,
-	     16 ) == NULL )
+on_error:
+	if( file_io_handle != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-		 "%s: unable to copy volume master key to keyring.",
-		 function );
-
-		return( -1 );
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
 	}
-	internal_volume->volume_master_key_is_set = 1;
-
-	return( 1 );
+	return( -1 );
 }
 
-/* Sets an UTF-8 formatted password
- * This function needs to be used before one of the open functions
- * Returns 1 if successful, 0 if password is invalid or -1 on error
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Reads the EncryptedRoot.plist file
+ * This function needs to be used before one of the open functions.
+ * Returns 1 if successful or -1 on error
  */
-int libfvde_volume_set_utf8_password(
+int libfvde_volume_read_encrypted_root_plist_wide(
      libfvde_volume_t *volume,
-     const uint8_t *utf8_string,
-     size_t utf8_string_length,
+     const wchar_t *filename,
      libcerror_error_t **error )
 {
-	libfvde_internal_volume_t *internal_volume = NULL;
-	static char *function                      = "libfvde_volume_set_utf8_password";
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "libfvde_volume_read_encrypted_root_plist_wide";
+	size_t filename_length           = 0;
 
 	if( volume == NULL )
 	{
@@ -3492,146 +7375,102 @@ int libfvde_volume_set_utf8_password(
 
 		return( -1 );
 	}
-	internal_volume = (libfvde_internal_volume_t *) volume;
+/* TODO HAVE_LIBFVDE_MULTI_THREAD_SUPPORT */
+	filename_length = wide_string_length(
+	                   filename );
 
-	if( internal_volume->io_handle == NULL )
+	if( filename_length == 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( internal_volume->file_io_handle != NULL )
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid volume - file IO handle already set.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
 		 function );
 
-		return( -1 );
-	}
-/* TODO HAVE_LIBFVDE_MULTI_THREAD_SUPPORT */
-	if( internal_volume->io_handle->user_password != NULL )
-	{
-		if( memory_set(
-		     internal_volume->io_handle->user_password,
-		     0,
-		     internal_volume->io_handle->user_password_size ) == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-			 "%s: unable to clear user password.",
-			 function );
-
-			return( -1 );
-		}
-		memory_free(
-		 internal_volume->io_handle->user_password );
-
-		internal_volume->io_handle->user_password      = NULL;
-		internal_volume->io_handle->user_password_size = 0;
+		goto on_error;
 	}
-	if( libuna_byte_stream_size_from_utf8(
-	     utf8_string,
-	     utf8_string_length,
-	     LIBFVDE_CODEPAGE_US_ASCII,
-	     &( internal_volume->io_handle->user_password_size ),
+	if( libbfio_file_set_name_wide(
+	     file_io_handle,
+	     filename,
+	     filename_length,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set password size.",
+		 "%s: unable to set filename in file IO handle.",
 		 function );
 
 		goto on_error;
 	}
-	internal_volume->io_handle->user_password_size += 1;
-
-	internal_volume->io_handle->user_password = (uint8_t *) memory_allocate(
-	                                                         sizeof( uint8_t ) * internal_volume->io_handle->user_password_size );
-
-	if( internal_volume->io_handle->user_password == NULL )
+	if( libfvde_volume_read_encrypted_root_plist_file_io_handle(
+	     volume,
+	     file_io_handle,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to create user password.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read encrypted root plist file: %s.",
+		 function,
+		 filename );
 
 		goto on_error;
 	}
-	if( libuna_byte_stream_copy_from_utf8(
-	     internal_volume->io_handle->user_password,
-	     internal_volume->io_handle->user_password_size,
-	     LIBFVDE_CODEPAGE_US_ASCII,
-	     utf8_string,
-	     utf8_string_length,
+	if( libbfio_handle_free(
+	     &file_io_handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to copy user password.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
 		 function );
 
 		goto on_error;
 	}
-	internal_volume->io_handle->user_password[ internal_volume->io_handle->user_password_size - 1 ] = 0;
-
-	internal_volume->io_handle->user_password_is_set = 1;
-
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "%s: user password: %s\n",
-		 function,
-		 internal_volume->io_handle->user_password );
-	}
-#endif
 	return( 1 );
 
 on_error:
-	if( internal_volume->io_handle->user_password != NULL )
+	if( file_io_handle != NULL )
 	{
-		memory_set(
-		 internal_volume->io_handle->user_password,
-		 0,
-		 internal_volume->io_handle->user_password_size );
-		memory_free(
-		 internal_volume->io_handle->user_password );
-
-		internal_volume->io_handle->user_password = NULL;
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
 	}
-	internal_volume->io_handle->user_password_size = 0;
-
 	return( -1 );
 }
 
-/* Sets an UTF-16 formatted password
- * This function needs to be used before one of the open functions
- * Returns 1 if successful, 0 if password is invalid or -1 on error
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Reads the EncryptedRoot.plist file using a Basic File IO (bfio) handle
+ * This function needs to be used before one of the open functions.
+ * Returns 1 if successful or -1 on error
  */
-int libfvde_volume_set_utf16_password(
+int libfvde_volume_read_encrypted_root_plist_file_io_handle(
      libfvde_volume_t *volume,
-     const uint16_t *utf16_string,
-     size_t utf16_string_length,
+     libbfio_handle_t *file_io_handle,
      libcerror_error_t **error )
 {
 	libfvde_internal_volume_t *internal_volume = NULL;
-	static char *function                      = "libfvde_volume_set_utf16_password";
+	static char *function                      = "libfvde_volume_read_encrypted_root_plist_file_io_handle";
 
 	if( volume == NULL )
 	{
@@ -3669,121 +7508,194 @@ int libfvde_volume_set_utf16_password(
 		return( -1 );
 	}
 /* TODO HAVE_LIBFVDE_MULTI_THREAD_SUPPORT */
-	if( internal_volume->io_handle->user_password != NULL )
+	if( internal_volume->encrypted_root_plist != NULL )
 	{
-		if( memory_set(
-		     internal_volume->io_handle->user_password,
-		     0,
-		     internal_volume->io_handle->user_password_size ) == NULL )
+		if( libfvde_encryption_context_plist_free(
+		     &( internal_volume->encrypted_root_plist ),
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-			 "%s: unable to clear user password.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free encrypted root plist.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
-		memory_free(
-		 internal_volume->io_handle->user_password );
-
-		internal_volume->io_handle->user_password      = NULL;
-		internal_volume->io_handle->user_password_size = 0;
 	}
-	if( libuna_byte_stream_size_from_utf16(
-	     utf16_string,
-	     utf16_string_length,
-	     LIBFVDE_CODEPAGE_US_ASCII,
-	     &( internal_volume->io_handle->user_password_size ),
+	if( libfvde_encryption_context_plist_initialize(
+	     &( internal_volume->encrypted_root_plist ),
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set password length.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create encrypted root plist.",
 		 function );
 
 		goto on_error;
 	}
-	internal_volume->io_handle->user_password_size += 1;
+	if( libfvde_encryption_context_plist_read_file_io_handle(
+	     internal_volume->encrypted_root_plist,
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to read encrypted root plist.",
+		 function );
 
-	internal_volume->io_handle->user_password = (uint8_t *) memory_allocate(
-	                                                         sizeof( uint8_t ) * internal_volume->io_handle->user_password_size );
+		goto on_error;
+	}
+	internal_volume->encrypted_root_plist_file_is_set = 1;
 
-	if( internal_volume->io_handle->user_password == NULL )
+	return( 1 );
+
+on_error:
+	if( internal_volume->encrypted_root_plist != NULL )
+	{
+		libfvde_encryption_context_plist_free(
+		 &( internal_volume->encrypted_root_plist ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Exports the layout of the volume to a (sidecar) layout file
+ * This function needs to be used after one of the open functions.
+ * Returns 1 if successful or -1 on error
+ */
+int libfvde_volume_export_layout(
+     libfvde_volume_t *volume,
+     const char *filename,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "libfvde_volume_export_layout";
+	size_t filename_length           = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = narrow_string_length(
+	                   filename );
+
+	if( filename_length == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to create user password.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
 		 function );
 
 		goto on_error;
 	}
-	if( libuna_byte_stream_copy_from_utf16(
-	     internal_volume->io_handle->user_password,
-	     internal_volume->io_handle->user_password_size,
-	     LIBFVDE_CODEPAGE_US_ASCII,
-	     utf16_string,
-	     utf16_string_length,
+	if( libbfio_file_set_name(
+	     file_io_handle,
+	     filename,
+	     filename_length,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to copy user password.",
+		 "%s: unable to set filename in file IO handle.",
 		 function );
 
 		goto on_error;
 	}
-	internal_volume->io_handle->user_password[ internal_volume->io_handle->user_password_size - 1 ] = 0;
-
-	internal_volume->io_handle->user_password_is_set = 1;
-
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	if( libfvde_volume_export_layout_file_io_handle(
+	     volume,
+	     file_io_handle,
+	     error ) != 1 )
 	{
-		libcnotify_printf(
-		 "%s: user password: %s\n",
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to export layout to file: %s.",
 		 function,
-		 internal_volume->io_handle->user_password );
+		 filename );
+
+		goto on_error;
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		goto on_error;
 	}
-#endif
 	return( 1 );
 
 on_error:
-	if( internal_volume->io_handle->user_password != NULL )
+	if( file_io_handle != NULL )
 	{
-		memory_set(
-		 internal_volume->io_handle->user_password,
-		 0,
-		 internal_volume->io_handle->user_password_size );
-		memory_free(
-		 internal_volume->io_handle->user_password );
-
-		internal_volume->io_handle->user_password = NULL;
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
 	}
-	internal_volume->io_handle->user_password_size = 0;
-
 	return( -1 );
 }
 
-/* Sets an UTF-8 formatted recovery password
- * This function needs to be used before one of the open functions
- * Returns 1 if successful, 0 if recovery password is invalid or -1 on error
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Exports the layout of the volume to a (sidecar) layout file
+ * This function needs to be used after one of the open functions.
+ * Returns 1 if successful or -1 on error
  */
-int libfvde_volume_set_utf8_recovery_password(
+int libfvde_volume_export_layout_wide(
      libfvde_volume_t *volume,
-     const uint8_t *utf8_string,
-     size_t utf8_string_length,
+     const wchar_t *filename,
      libcerror_error_t **error )
 {
-	libfvde_internal_volume_t *internal_volume = NULL;
-	static char *function                      = "libfvde_volume_set_utf8_recovery_password";
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "libfvde_volume_export_layout_wide";
+	size_t filename_length           = 0;
 
 	if( volume == NULL )
 	{
@@ -3796,146 +7708,113 @@ int libfvde_volume_set_utf8_recovery_password(
 
 		return( -1 );
 	}
-	internal_volume = (libfvde_internal_volume_t *) volume;
-
-	if( internal_volume->io_handle == NULL )
+	if( filename == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_volume->file_io_handle != NULL )
+	filename_length = wide_string_length(
+	                   filename );
+
+	if( filename_length == 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid volume - file IO handle already set.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-/* TODO HAVE_LIBFVDE_MULTI_THREAD_SUPPORT */
-	if( internal_volume->io_handle->recovery_password != NULL )
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
 	{
-		if( memory_set(
-		     internal_volume->io_handle->recovery_password,
-		     0,
-		     internal_volume->io_handle->recovery_password_size ) == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-			 "%s: unable to clear recovery password.",
-			 function );
-
-			return( -1 );
-		}
-		memory_free(
-		 internal_volume->io_handle->recovery_password );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
 
-		internal_volume->io_handle->recovery_password      = NULL;
-		internal_volume->io_handle->recovery_password_size = 0;
+		goto on_error;
 	}
-	if( libuna_byte_stream_size_from_utf8(
-	     utf8_string,
-	     utf8_string_length,
-	     LIBFVDE_CODEPAGE_US_ASCII,
-	     &( internal_volume->io_handle->recovery_password_size ),
+	if( libbfio_file_set_name_wide(
+	     file_io_handle,
+	     filename,
+	     filename_length,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set recovery pasword size.",
+		 "%s: unable to set filename in file IO handle.",
 		 function );
 
 		goto on_error;
 	}
-	internal_volume->io_handle->recovery_password_size += 1;
-
-	internal_volume->io_handle->recovery_password = (uint8_t *) memory_allocate(
-	                                                             sizeof( uint8_t ) * internal_volume->io_handle->recovery_password_size );
-
-	if( internal_volume->io_handle->recovery_password == NULL )
+	if( libfvde_volume_export_layout_file_io_handle(
+	     volume,
+	     file_io_handle,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to create recovery password.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to export layout to file: %s.",
+		 function,
+		 filename );
 
 		goto on_error;
 	}
-	if( libuna_byte_stream_copy_from_utf8(
-	     internal_volume->io_handle->recovery_password,
-	     internal_volume->io_handle->recovery_password_size,
-	     LIBFVDE_CODEPAGE_US_ASCII,
-	     utf8_string,
-	     utf8_string_length,
+	if( libbfio_handle_free(
+	     &file_io_handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to copy recovery password.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
 		 function );
 
 		goto on_error;
 	}
-	internal_volume->io_handle->recovery_password[ internal_volume->io_handle->recovery_password_size - 1 ] = 0;
-
-	internal_volume->io_handle->recovery_password_is_set = 1;
-
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "%s: recovery password: %s\n",
-		 function,
-		 internal_volume->io_handle->recovery_password );
-	}
-#endif
 	return( 1 );
 
 on_error:
-	if( internal_volume->io_handle->recovery_password != NULL )
+	if( file_io_handle != NULL )
 	{
-		memory_set(
-		 internal_volume->io_handle->recovery_password,
-		 0,
-		 internal_volume->io_handle->recovery_password_size );
-		memory_free(
-		 internal_volume->io_handle->recovery_password );
-
-		internal_volume->io_handle->recovery_password = NULL;
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
 	}
-	internal_volume->io_handle->recovery_password_size = 0;
-
 	return( -1 );
 }
 
-/* Sets an UTF-16 formatted recovery password
- * This function needs to be used before one of the open functions
- * Returns 1 if successful, 0 if recovery password is invalid or -1 on error
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Exports the layout of the volume to a (sidecar) layout file using a Basic File IO (bfio) handle
+ * This function needs to be used after one of the open functions.
+ * Returns 1 if successful or -1 on error
  */
-int libfvde_volume_set_utf16_recovery_password(
+int libfvde_volume_export_layout_file_io_handle(
      libfvde_volume_t *volume,
-     const uint16_t *utf16_string,
-     size_t utf16_string_length,
+     libbfio_handle_t *file_io_handle,
      libcerror_error_t **error )
 {
 	libfvde_internal_volume_t *internal_volume = NULL;
-	static char *function                     = "libfvde_volume_set_utf16_recovery_password";
+	libfvde_layout_t *layout                   = NULL;
+	static char *function                      = "libfvde_volume_export_layout_file_io_handle";
 
 	if( volume == NULL )
 	{
@@ -3961,132 +7840,147 @@ int libfvde_volume_set_utf16_recovery_password(
 
 		return( -1 );
 	}
-	if( internal_volume->file_io_handle != NULL )
+	if( internal_volume->file_io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid volume - file IO handle already set.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing file IO handle.",
 		 function );
 
 		return( -1 );
 	}
-/* TODO HAVE_LIBFVDE_MULTI_THREAD_SUPPORT */
-	if( internal_volume->io_handle->recovery_password != NULL )
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
 	{
-		if( memory_set(
-		     internal_volume->io_handle->recovery_password,
-		     0,
-		     internal_volume->io_handle->recovery_password_size ) == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-			 "%s: unable to clear recovery password.",
-			 function );
-
-			return( -1 );
-		}
-		memory_free(
-		 internal_volume->io_handle->recovery_password );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
 
-		internal_volume->io_handle->recovery_password      = NULL;
-		internal_volume->io_handle->recovery_password_size = 0;
+		return( -1 );
 	}
-	if( libuna_byte_stream_size_from_utf16(
-	     utf16_string,
-	     utf16_string_length,
-	     LIBFVDE_CODEPAGE_US_ASCII,
-	     &(internal_volume->io_handle->recovery_password_size ),
-	     error ) != 1 )
+#endif
+	/* The encrypted metadata is not set if the layout was not read
+	 * e.g. when the metadata parse profile does not contain the layout
+	 */
+	if( internal_volume->encrypted_metadata == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set recovery size.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing encrypted metadata layout.",
 		 function );
 
 		goto on_error;
 	}
-	internal_volume->io_handle->recovery_password_size += 1;
-
-	internal_volume->io_handle->recovery_password = (uint8_t *) memory_allocate(
-	                                                             sizeof( uint8_t ) * internal_volume->io_handle->recovery_password_size );
-
-	if( internal_volume->io_handle->recovery_password == NULL )
+	if( libfvde_layout_initialize(
+	     &layout,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to create recovery password.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create layout.",
 		 function );
 
 		goto on_error;
 	}
-	if( libuna_byte_stream_copy_from_utf16(
-	     internal_volume->io_handle->recovery_password,
-	     internal_volume->io_handle->recovery_password_size,
-	     LIBFVDE_CODEPAGE_US_ASCII,
-	     utf16_string,
-	     utf16_string_length,
+	if( libfvde_layout_set_values(
+	     layout,
+	     internal_volume->io_handle,
+	     internal_volume->file_io_handle,
+	     internal_volume->primary_metadata,
+	     internal_volume->encrypted_metadata,
+	     internal_volume->metadata_copy_index,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to copy recovery password.",
+		 "%s: unable to set layout values.",
 		 function );
 
 		goto on_error;
 	}
-	internal_volume->io_handle->recovery_password[ internal_volume->io_handle->recovery_password_size - 1 ] = 0;
+	if( libfvde_layout_write_file_io_handle(
+	     layout,
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write layout.",
+		 function );
 
-	internal_volume->io_handle->recovery_password_is_set = 1;
+		goto on_error;
+	}
+	if( libfvde_layout_free(
+	     &layout,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free layout.",
+		 function );
 
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+		goto on_error;
+	}
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
 	{
-		libcnotify_printf(
-		 "%s: recovery password: %s\n",
-		 function,
-		 internal_volume->io_handle->recovery_password );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
 	}
 #endif
 	return( 1 );
 
 on_error:
-	if( internal_volume->io_handle->recovery_password != NULL )
+	if( layout != NULL )
 	{
-		memory_set(
-		 internal_volume->io_handle->recovery_password,
-		 0,
-		 internal_volume->io_handle->recovery_password_size );
-		memory_free(
-		 internal_volume->io_handle->recovery_password );
-
-		internal_volume->io_handle->recovery_password = NULL;
+		libfvde_layout_free(
+		 &layout,
+		 NULL );
 	}
-	internal_volume->io_handle->recovery_password_size = 0;
-
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_volume->read_write_lock,
+	 NULL );
+#endif
 	return( -1 );
 }
 
-/* Reads the EncryptedRoot.plist file
+/* Imports the layout of the volume from a (sidecar) layout file
  * This function needs to be used before one of the open functions.
  * Returns 1 if successful or -1 on error
  */
-int libfvde_volume_read_encrypted_root_plist(
+int libfvde_volume_import_layout(
      libfvde_volume_t *volume,
      const char *filename,
      libcerror_error_t **error )
 {
 	libbfio_handle_t *file_io_handle = NULL;
-	static char *function            = "libfvde_volume_read_encrypted_root_plist";
+	static char *function            = "libfvde_volume_import_layout";
 	size_t filename_length           = 0;
 
 	if( volume == NULL )
@@ -4100,7 +7994,17 @@ int libfvde_volume_read_encrypted_root_plist(
 
 		return( -1 );
 	}
-/* TODO HAVE_LIBFVDE_MULTI_THREAD_SUPPORT */
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
 	filename_length = narrow_string_length(
 	                   filename );
 
@@ -4143,7 +8047,7 @@ int libfvde_volume_read_encrypted_root_plist(
 
 		goto on_error;
 	}
-	if( libfvde_volume_read_encrypted_root_plist_file_io_handle(
+	if( libfvde_volume_import_layout_file_io_handle(
 	     volume,
 	     file_io_handle,
 	     error ) != 1 )
@@ -4152,7 +8056,7 @@ int libfvde_volume_read_encrypted_root_plist(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read encrypted root plist file: %s.",
+		 "%s: unable to import layout from file: %s.",
 		 function,
 		 filename );
 
@@ -4185,17 +8089,17 @@ on_error:
 
 #if defined( HAVE_WIDE_CHARACTER_TYPE )
 
-/* Reads the EncryptedRoot.plist file
+/* Imports the layout of the volume from a (sidecar) layout file
  * This function needs to be used before one of the open functions.
  * Returns 1 if successful or -1 on error
  */
-int libfvde_volume_read_encrypted_root_plist_wide(
+int libfvde_volume_import_layout_wide(
      libfvde_volume_t *volume,
      const wchar_t *filename,
      libcerror_error_t **error )
 {
 	libbfio_handle_t *file_io_handle = NULL;
-	static char *function            = "libfvde_volume_read_encrypted_root_plist_wide";
+	static char *function            = "libfvde_volume_import_layout_wide";
 	size_t filename_length           = 0;
 
 	if( volume == NULL )
@@ -4209,7 +8113,17 @@ int libfvde_volume_read_encrypted_root_plist_wide(
 
 		return( -1 );
 	}
-/* TODO HAVE_LIBFVDE_MULTI_THREAD_SUPPORT */
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
 	filename_length = wide_string_length(
 	                   filename );
 
@@ -4252,7 +8166,7 @@ int libfvde_volume_read_encrypted_root_plist_wide(
 
 		goto on_error;
 	}
-	if( libfvde_volume_read_encrypted_root_plist_file_io_handle(
+	if( libfvde_volume_import_layout_file_io_handle(
 	     volume,
 	     file_io_handle,
 	     error ) != 1 )
@@ -4261,7 +8175,7 @@ int libfvde_volume_read_encrypted_root_plist_wide(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read encrypted root plist file: %s.",
+		 "%s: unable to import layout from file: %s.",
 		 function,
 		 filename );
 
@@ -4294,17 +8208,17 @@ on_error:
 
 #endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
 
-/* Reads the EncryptedRoot.plist file using a Basic File IO (bfio) handle
+/* Imports the layout of the volume from a (sidecar) layout file using a Basic File IO (bfio) handle
  * This function needs to be used before one of the open functions.
  * Returns 1 if successful or -1 on error
  */
-int libfvde_volume_read_encrypted_root_plist_file_io_handle(
+int libfvde_volume_import_layout_file_io_handle(
      libfvde_volume_t *volume,
      libbfio_handle_t *file_io_handle,
      libcerror_error_t **error )
 {
 	libfvde_internal_volume_t *internal_volume = NULL;
-	static char *function                      = "libfvde_volume_read_encrypted_root_plist_file_io_handle";
+	static char *function                      = "libfvde_volume_import_layout_file_io_handle";
 
 	if( volume == NULL )
 	{
@@ -4319,17 +8233,6 @@ int libfvde_volume_read_encrypted_root_plist_file_io_handle(
 	}
 	internal_volume = (libfvde_internal_volume_t *) volume;
 
-	if( internal_volume->io_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing IO handle.",
-		 function );
-
-		return( -1 );
-	}
 	if( internal_volume->file_io_handle != NULL )
 	{
 		libcerror_error_set(
@@ -4341,59 +8244,56 @@ int libfvde_volume_read_encrypted_root_plist_file_io_handle(
 
 		return( -1 );
 	}
-/* TODO HAVE_LIBFVDE_MULTI_THREAD_SUPPORT */
-	if( internal_volume->encrypted_root_plist != NULL )
+	if( internal_volume->layout != NULL )
 	{
-		if( libfvde_encryption_context_plist_free(
-		     &( internal_volume->encrypted_root_plist ),
+		if( libfvde_layout_free(
+		     &( internal_volume->layout ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free encrypted root plist.",
+			 "%s: unable to free layout.",
 			 function );
 
 			goto on_error;
 		}
 	}
-	if( libfvde_encryption_context_plist_initialize(
-	     &( internal_volume->encrypted_root_plist ),
+	if( libfvde_layout_initialize(
+	     &( internal_volume->layout ),
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create encrypted root plist.",
+		 "%s: unable to create layout.",
 		 function );
 
 		goto on_error;
 	}
-	if( libfvde_encryption_context_plist_read_file_io_handle(
-	     internal_volume->encrypted_root_plist,
+	if( libfvde_layout_read_file_io_handle(
+	     internal_volume->layout,
 	     file_io_handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_GENERIC,
-		 "%s: unable to read encrypted root plist.",
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read layout.",
 		 function );
 
 		goto on_error;
 	}
-	internal_volume->encrypted_root_plist_file_is_set = 1;
-
 	return( 1 );
 
 on_error:
-	if( internal_volume->encrypted_root_plist != NULL )
+	if( internal_volume->layout != NULL )
 	{
-		libfvde_encryption_context_plist_free(
-		 &( internal_volume->encrypted_root_plist ),
+		libfvde_layout_free(
+		 &( internal_volume->layout ),
 		 NULL );
 	}
 	return( -1 );
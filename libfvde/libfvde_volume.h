@@ -26,18 +26,25 @@
 #include <common.h>
 #include <types.h>
 
+#include "libfvde_decryption_pool.h"
 #include "libfvde_encrypted_metadata.h"
 #include "libfvde_encryption_context_plist.h"
 #include "libfvde_extern.h"
 #include "libfvde_io_handle.h"
 #include "libfvde_keyring.h"
+#include "libfvde_layout.h"
 #include "libfvde_libbfio.h"
+#include "libfvde_libcaes.h"
 #include "libfvde_libcerror.h"
 #include "libfvde_libcthreads.h"
 #include "libfvde_libfcache.h"
 #include "libfvde_libfdata.h"
 #include "libfvde_libuna.h"
 #include "libfvde_metadata.h"
+#include "libfvde_read_ahead.h"
+#include "libfvde_read_context.h"
+#include "libfvde_sector_data_pool.h"
+#include "libfvde_sectors_cache.h"
 #include "libfvde_types.h"
 
 #if defined( __cplusplus )
@@ -76,6 +83,19 @@ struct libfvde_internal_volume
 	 */
 	libfvde_encrypted_metadata_t *secondary_encrypted_metadata;
 
+	/* The encrypted metadata that contains the layout of the logical volume
+	 */
+	libfvde_encrypted_metadata_t *encrypted_metadata;
+
+	/* The index of the metadata copy that was used
+	 */
+	int metadata_copy_index;
+
+	/* The imported layout
+	 * if valid the layout is used instead of parsing the metadata
+	 */
+	libfvde_layout_t *layout;
+
 	/* The EncryptedRoot.plist
 	 */
 	libfvde_encryption_context_plist_t *encrypted_root_plist;
@@ -92,13 +112,43 @@ struct libfvde_internal_volume
 	 */
 	uint8_t volume_master_key_is_set;
 
-	/* The sectors vector
+	/* The size of the sector data, which contains one or more consecutive sectors
+	 * a value of 0 represents the block size of the volume
+	 */
+	size_t sector_data_size;
+
+	/* The size of the sectors cache
+	 * a value of 0 represents the default number of cache entries
+	 */
+	size_t cache_size;
+
+	/* The maximum size of the read-ahead windows
+	 * a value of 0 represents read-ahead is disabled
+	 */
+	size_t read_ahead_size;
+
+	/* The number of threads used to decrypt large reads
+	 * a value of 0 represents large reads are decrypted by the reading thread
+	 */
+	int number_of_decryption_threads;
+
+	/* Value to indicate the volume is opened lazily
+	 * in which case only the newest valid copy of the metadata is parsed
 	 */
-	libfdata_vector_t *sectors_vector;
+	uint8_t lazy_open;
+
+	/* The metadata parse profile, which contains the parse profile flags
+	 * of the encrypted metadata block types that are read
+	 */
+	uint8_t parse_profile;
 
 	/* The sectors cache
 	 */
-	libfcache_cache_t *sectors_cache;
+	libfvde_sectors_cache_t *sectors_cache;
+
+	/* The sector data pool, which recycles the sector data of the sectors cache
+	 */
+	libfvde_sector_data_pool_t *sector_data_pool;
 
         /* The keyring
 	 */
@@ -125,6 +175,18 @@ struct libfvde_internal_volume
 	uint8_t is_locked;
 
 #if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+	/* The read-ahead
+	 */
+	libfvde_read_ahead_t *read_ahead;
+
+	/* The decryption pool
+	 */
+	libfvde_decryption_pool_t *decryption_pool;
+
+	/* The read contexts that are not in use by a read at a specific offset
+	 */
+	libcthreads_queue_t *read_contexts;
+
 	/* The read/write lock
 	 */
 	libcthreads_read_write_lock_t *read_write_lock;
@@ -191,6 +253,15 @@ int libfvde_volume_is_locked(
      libfvde_volume_t *volume,
      libcerror_error_t **error );
 
+ssize_t libfvde_internal_volume_read_buffer_at_offset_from_file_io_handle(
+         libfvde_internal_volume_t *internal_volume,
+         libbfio_handle_t *file_io_handle,
+         libcaes_tweaked_context_t *xts_context,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
 ssize_t libfvde_internal_volume_read_buffer_from_file_io_handle(
          libfvde_internal_volume_t *internal_volume,
          libbfio_handle_t *file_io_handle,
@@ -213,6 +284,58 @@ ssize_t libfvde_volume_read_buffer_at_offset(
          off64_t offset,
          libcerror_error_t **error );
 
+#if defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+
+int libfvde_internal_volume_get_read_context(
+     libfvde_internal_volume_t *internal_volume,
+     libfvde_read_context_t **read_context,
+     libcerror_error_t **error );
+
+int libfvde_internal_volume_release_read_context(
+     libfvde_internal_volume_t *internal_volume,
+     libfvde_read_context_t **read_context,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT ) */
+
+LIBFVDE_EXTERN \
+ssize_t libfvde_volume_read_buffer_at_offset_positional(
+         libfvde_volume_t *volume,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+int libfvde_internal_volume_read_uncached_sector_data(
+     libfvde_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     libcaes_tweaked_context_t *xts_context,
+     off64_t offset,
+     uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+int libfvde_internal_volume_read_buffers_at_offsets_from_file_io_handle(
+     libfvde_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     libcaes_tweaked_context_t *xts_context,
+     void **buffers,
+     const size_t *buffer_sizes,
+     const off64_t *offsets,
+     ssize_t *read_counts,
+     int number_of_buffers,
+     libcerror_error_t **error );
+
+LIBFVDE_EXTERN \
+int libfvde_volume_read_buffers_at_offsets(
+     libfvde_volume_t *volume,
+     void **buffers,
+     const size_t *buffer_sizes,
+     const off64_t *offsets,
+     ssize_t *read_counts,
+     int number_of_buffers,
+     libcerror_error_t **error );
+
 #ifdef TODO_WRITE_SUPPORT
 
 LIBFVDE_EXTERN \
@@ -257,6 +380,14 @@ int libfvde_volume_get_logical_volume_size(
      size64_t *size,
      libcerror_error_t **error );
 
+LIBFVDE_EXTERN \
+int libfvde_volume_get_next_mapped_range(
+     libfvde_volume_t *volume,
+     off64_t offset,
+     off64_t *range_offset,
+     size64_t *range_size,
+     libcerror_error_t **error );
+
 LIBFVDE_EXTERN \
 int libfvde_volume_get_logical_volume_encryption_method(
      libfvde_volume_t *volume,
@@ -296,6 +427,38 @@ int libfvde_volume_get_physical_volume_identifier(
      size_t size,
      libcerror_error_t **error );
 
+int libfvde_internal_volume_get_encryption_context_plist(
+     libfvde_internal_volume_t *internal_volume,
+     libfvde_encryption_context_plist_t **encryption_context_plist,
+     libcerror_error_t **error );
+
+LIBFVDE_EXTERN \
+int libfvde_volume_get_number_of_passphrase_wrapped_keks(
+     libfvde_volume_t *volume,
+     int *number_of_passphrase_wrapped_keks,
+     libcerror_error_t **error );
+
+LIBFVDE_EXTERN \
+int libfvde_volume_get_passphrase_wrapped_kek_by_index(
+     libfvde_volume_t *volume,
+     int passphrase_wrapped_kek_index,
+     uint8_t *salt,
+     size_t salt_size,
+     uint32_t *number_of_iterations,
+     uint8_t *wrapped_kek,
+     size_t wrapped_kek_size,
+     libcerror_error_t **error );
+
+LIBFVDE_EXTERN \
+int libfvde_volume_check_utf8_passwords(
+     libfvde_volume_t *volume,
+     int passphrase_wrapped_kek_index,
+     const uint8_t **utf8_strings,
+     const size_t *utf8_string_lengths,
+     int number_of_passwords,
+     int *password_index,
+     libcerror_error_t **error );
+
 LIBFVDE_EXTERN \
 int libfvde_volume_set_keys(
      libfvde_volume_t *volume,
@@ -331,6 +494,42 @@ int libfvde_volume_set_utf16_recovery_password(
      size_t utf16_string_length,
      libcerror_error_t **error );
 
+LIBFVDE_EXTERN \
+int libfvde_volume_set_sector_data_size(
+     libfvde_volume_t *volume,
+     size_t sector_data_size,
+     libcerror_error_t **error );
+
+LIBFVDE_EXTERN \
+int libfvde_volume_set_cache_size(
+     libfvde_volume_t *volume,
+     size_t cache_size,
+     libcerror_error_t **error );
+
+LIBFVDE_EXTERN \
+int libfvde_volume_set_read_ahead_size(
+     libfvde_volume_t *volume,
+     size_t read_ahead_size,
+     libcerror_error_t **error );
+
+LIBFVDE_EXTERN \
+int libfvde_volume_set_number_of_decryption_threads(
+     libfvde_volume_t *volume,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+LIBFVDE_EXTERN \
+int libfvde_volume_set_lazy_open(
+     libfvde_volume_t *volume,
+     uint8_t lazy_open,
+     libcerror_error_t **error );
+
+LIBFVDE_EXTERN \
+int libfvde_volume_set_parse_profile(
+     libfvde_volume_t *volume,
+     uint8_t parse_profile,
+     libcerror_error_t **error );
+
 LIBFVDE_EXTERN \
 int libfvde_volume_read_encrypted_root_plist(
      libfvde_volume_t *volume,
@@ -353,6 +552,50 @@ int libfvde_volume_read_encrypted_root_plist_file_io_handle(
      libbfio_handle_t *file_io_handle,
      libcerror_error_t **error );
 
+LIBFVDE_EXTERN \
+int libfvde_volume_export_layout(
+     libfvde_volume_t *volume,
+     const char *filename,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+LIBFVDE_EXTERN \
+int libfvde_volume_export_layout_wide(
+     libfvde_volume_t *volume,
+     const wchar_t *filename,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+LIBFVDE_EXTERN \
+int libfvde_volume_export_layout_file_io_handle(
+     libfvde_volume_t *volume,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+LIBFVDE_EXTERN \
+int libfvde_volume_import_layout(
+     libfvde_volume_t *volume,
+     const char *filename,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+LIBFVDE_EXTERN \
+int libfvde_volume_import_layout_wide(
+     libfvde_volume_t *volume,
+     const wchar_t *filename,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+LIBFVDE_EXTERN \
+int libfvde_volume_import_layout_file_io_handle(
+     libfvde_volume_t *volume,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
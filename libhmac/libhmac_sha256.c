@@ -40,9 +40,37 @@
 #include "libhmac_definitions.h"
 #include "libhmac_libcerror.h"
 #include "libhmac_sha256.h"
+#include "libhmac_unused.h"
 
 #if !defined( LIBHMAC_HAVE_SHA256_SUPPORT )
 
+/* Hardware accelerated SHA-256 block transforms, selected at run-time
+ */
+#if defined( __GNUC__ ) && ( defined( __x86_64__ ) || defined( __i386__ ) ) && ( ( __GNUC__ >= 5 ) || defined( __clang__ ) )
+#include <cpuid.h>
+#include <immintrin.h>
+
+#define LIBHMAC_HAVE_SHA256_X86_TRANSFORM		1
+#define LIBHMAC_SHA256_X86_TARGET			__attribute__((target("sha,sse4.1,ssse3")))
+
+#elif defined( _MSC_VER ) && ( _MSC_VER >= 1900 ) && ( defined( _M_X64 ) || defined( _M_IX86 ) )
+#include <intrin.h>
+#include <immintrin.h>
+
+#define LIBHMAC_HAVE_SHA256_X86_TRANSFORM		1
+#define LIBHMAC_SHA256_X86_TARGET
+
+#elif defined( __aarch64__ ) && ( defined( __ARM_FEATURE_SHA2 ) || defined( __ARM_FEATURE_CRYPTO ) )
+#include <arm_neon.h>
+
+#define LIBHMAC_HAVE_SHA256_ARM_TRANSFORM		1
+
+#endif
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
+#include <pthread.h>
+#endif
+
 /* FIPS 180-2 based SHA-256 functions
  */
 
@@ -225,6 +253,358 @@ uint32_t libhmac_sha256_prime_cube_roots[ 64 ] = {
 	libhmac_sha256_transform_unfolded_calculate_hash_value( values_32bit, 62, hash_values, 2, 3, 4, 5, 6, 7, 0, 1, s0, s1, t1, t2 ) \
 	libhmac_sha256_transform_unfolded_calculate_hash_value( values_32bit, 63, hash_values, 1, 2, 3, 4, 5, 6, 7, 0, s0, s1, t1, t2 )
 
+#if defined( LIBHMAC_HAVE_SHA256_X86_TRANSFORM )
+
+/* Calculates the SHA256 of 64 byte sized blocks of data using the x86 SHA extensions
+ */
+LIBHMAC_SHA256_X86_TARGET \
+static void libhmac_sha256_transform_blocks_x86_sha(
+             uint32_t *hash_values,
+             const uint8_t *buffer,
+             size_t number_of_blocks )
+{
+	__m128i message_values[ 4 ];
+
+	__m128i abef_values       = _mm_setzero_si128();
+	__m128i byte_order_mask   = _mm_set_epi64x( 0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL );
+	__m128i cdgh_values       = _mm_setzero_si128();
+	__m128i saved_abef_values = _mm_setzero_si128();
+	__m128i saved_cdgh_values = _mm_setzero_si128();
+	__m128i values_128bit     = _mm_setzero_si128();
+	uint8_t value_index       = 0;
+
+	/* The SHA extensions operate on the hash values as ABEF and CDGH
+	 */
+	values_128bit = _mm_loadu_si128(
+	                 (const __m128i *) &( hash_values[ 0 ] ) );
+	cdgh_values   = _mm_loadu_si128(
+	                 (const __m128i *) &( hash_values[ 4 ] ) );
+
+	values_128bit = _mm_shuffle_epi32( values_128bit, 0xb1 );
+	cdgh_values   = _mm_shuffle_epi32( cdgh_values, 0x1b );
+	abef_values   = _mm_alignr_epi8( values_128bit, cdgh_values, 8 );
+	cdgh_values   = _mm_blend_epi16( cdgh_values, values_128bit, 0xf0 );
+
+	while( number_of_blocks > 0 )
+	{
+		saved_abef_values = abef_values;
+		saved_cdgh_values = cdgh_values;
+
+		for( value_index = 0;
+		     value_index < 4;
+		     value_index++ )
+		{
+			message_values[ value_index ] = _mm_shuffle_epi8(
+			                                 _mm_loadu_si128(
+			                                  (const __m128i *) &( buffer[ value_index * 16 ] ) ),
+			                                 byte_order_mask );
+		}
+		/* Each iteration calculates 4 rounds and extends the message schedule by 4 x 32-bit values
+		 */
+		for( value_index = 0;
+		     value_index < 16;
+		     value_index++ )
+		{
+			values_128bit = _mm_add_epi32(
+			                 message_values[ value_index & 3 ],
+			                 _mm_loadu_si128(
+			                  (const __m128i *) &( libhmac_sha256_prime_cube_roots[ value_index * 4 ] ) ) );
+
+			cdgh_values = _mm_sha256rnds2_epu32(
+			               cdgh_values,
+			               abef_values,
+			               values_128bit );
+
+			values_128bit = _mm_shuffle_epi32(
+			                 values_128bit,
+			                 0x0e );
+
+			abef_values = _mm_sha256rnds2_epu32(
+			               abef_values,
+			               cdgh_values,
+			               values_128bit );
+
+			if( value_index < 12 )
+			{
+				values_128bit = _mm_add_epi32(
+				                 _mm_sha256msg1_epu32(
+				                  message_values[ value_index & 3 ],
+				                  message_values[ ( value_index + 1 ) & 3 ] ),
+				                 _mm_alignr_epi8(
+				                  message_values[ ( value_index + 3 ) & 3 ],
+				                  message_values[ ( value_index + 2 ) & 3 ],
+				                  4 ) );
+
+				message_values[ value_index & 3 ] = _mm_sha256msg2_epu32(
+				                                     values_128bit,
+				                                     message_values[ ( value_index + 3 ) & 3 ] );
+			}
+		}
+		abef_values = _mm_add_epi32(
+		               abef_values,
+		               saved_abef_values );
+		cdgh_values = _mm_add_epi32(
+		               cdgh_values,
+		               saved_cdgh_values );
+
+		buffer           += LIBHMAC_SHA256_BLOCK_SIZE;
+		number_of_blocks -= 1;
+	}
+	values_128bit = _mm_shuffle_epi32( abef_values, 0x1b );
+	cdgh_values   = _mm_shuffle_epi32( cdgh_values, 0xb1 );
+	abef_values   = _mm_blend_epi16( values_128bit, cdgh_values, 0xf0 );
+	cdgh_values   = _mm_alignr_epi8( cdgh_values, values_128bit, 8 );
+
+	_mm_storeu_si128(
+	 (__m128i *) &( hash_values[ 0 ] ),
+	 abef_values );
+
+	_mm_storeu_si128(
+	 (__m128i *) &( hash_values[ 4 ] ),
+	 cdgh_values );
+}
+
+/* Determines if the CPU supports the x86 SHA extensions
+ * Returns 1 if supported or 0 if not
+ */
+static int libhmac_sha256_x86_sha_is_supported(
+            void )
+{
+	int cpu_information[ 4 ];
+
+#if defined( _MSC_VER )
+	__cpuid(
+	 cpu_information,
+	 0 );
+
+	if( cpu_information[ 0 ] < 7 )
+	{
+		return( 0 );
+	}
+	__cpuid(
+	 cpu_information,
+	 1 );
+#else
+	unsigned int eax = 0;
+	unsigned int ebx = 0;
+	unsigned int ecx = 0;
+	unsigned int edx = 0;
+
+	if( __get_cpuid_max(
+	     0,
+	     NULL ) < 7 )
+	{
+		return( 0 );
+	}
+	__cpuid(
+	 1,
+	 eax,
+	 ebx,
+	 ecx,
+	 edx );
+
+	cpu_information[ 2 ] = (int) ecx;
+#endif
+	/* SSSE3 (ECX bit 9) and SSE4.1 (ECX bit 19)
+	 */
+	if( ( cpu_information[ 2 ] & 0x00080200UL ) != 0x00080200UL )
+	{
+		return( 0 );
+	}
+#if defined( _MSC_VER )
+	__cpuidex(
+	 cpu_information,
+	 7,
+	 0 );
+#else
+	__cpuid_count(
+	 7,
+	 0,
+	 eax,
+	 ebx,
+	 ecx,
+	 edx );
+
+	cpu_information[ 1 ] = (int) ebx;
+#endif
+	/* SHA (EBX bit 29)
+	 */
+	if( ( cpu_information[ 1 ] & 0x20000000UL ) == 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+#endif /* defined( LIBHMAC_HAVE_SHA256_X86_TRANSFORM ) */
+
+#if defined( LIBHMAC_HAVE_SHA256_ARM_TRANSFORM )
+
+/* Calculates the SHA256 of 64 byte sized blocks of data using the ARMv8 SHA2 instructions
+ */
+static void libhmac_sha256_transform_blocks_arm_sha2(
+             uint32_t *hash_values,
+             const uint8_t *buffer,
+             size_t number_of_blocks )
+{
+	uint32x4_t message_values[ 4 ];
+
+	uint32x4_t previous_abcd_values;
+	uint32x4_t saved_abcd_values;
+	uint32x4_t saved_efgh_values;
+	uint32x4_t values_128bit;
+
+	uint32x4_t abcd_values = vld1q_u32( &( hash_values[ 0 ] ) );
+	uint32x4_t efgh_values = vld1q_u32( &( hash_values[ 4 ] ) );
+	uint8_t value_index    = 0;
+
+	while( number_of_blocks > 0 )
+	{
+		saved_abcd_values = abcd_values;
+		saved_efgh_values = efgh_values;
+
+		for( value_index = 0;
+		     value_index < 4;
+		     value_index++ )
+		{
+			message_values[ value_index ] = vreinterpretq_u32_u8(
+			                                 vrev32q_u8(
+			                                  vld1q_u8( &( buffer[ value_index * 16 ] ) ) ) );
+		}
+		/* Each iteration calculates 4 rounds and extends the message schedule by 4 x 32-bit values
+		 */
+		for( value_index = 0;
+		     value_index < 16;
+		     value_index++ )
+		{
+			values_128bit = vaddq_u32(
+			                 message_values[ value_index & 3 ],
+			                 vld1q_u32( &( libhmac_sha256_prime_cube_roots[ value_index * 4 ] ) ) );
+
+			previous_abcd_values = abcd_values;
+
+			abcd_values = vsha256hq_u32(
+			               abcd_values,
+			               efgh_values,
+			               values_128bit );
+
+			efgh_values = vsha256h2q_u32(
+			               efgh_values,
+			               previous_abcd_values,
+			               values_128bit );
+
+			if( value_index < 12 )
+			{
+				message_values[ value_index & 3 ] = vsha256su1q_u32(
+				                                     vsha256su0q_u32(
+				                                      message_values[ value_index & 3 ],
+				                                      message_values[ ( value_index + 1 ) & 3 ] ),
+				                                     message_values[ ( value_index + 2 ) & 3 ],
+				                                     message_values[ ( value_index + 3 ) & 3 ] );
+			}
+		}
+		abcd_values = vaddq_u32(
+		               abcd_values,
+		               saved_abcd_values );
+		efgh_values = vaddq_u32(
+		               efgh_values,
+		               saved_efgh_values );
+
+		buffer           += LIBHMAC_SHA256_BLOCK_SIZE;
+		number_of_blocks -= 1;
+	}
+	vst1q_u32(
+	 &( hash_values[ 0 ] ),
+	 abcd_values );
+
+	vst1q_u32(
+	 &( hash_values[ 4 ] ),
+	 efgh_values );
+}
+
+#endif /* defined( LIBHMAC_HAVE_SHA256_ARM_TRANSFORM ) */
+
+/* The hardware accelerated block transform function
+ * This value is determined once by libhmac_sha256_transform_initialize
+ */
+static void (*libhmac_sha256_transform_blocks)( uint32_t *hash_values, const uint8_t *buffer, size_t number_of_blocks ) = NULL;
+
+/* Value to indicate the hardware accelerated block transform function is disabled
+ */
+static int libhmac_sha256_hardware_disabled = 0;
+
+/* The state of libhmac_sha256_transform_initialize
+ */
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && defined( WINAPI )
+static LONG volatile libhmac_sha256_transform_initialize_state = 0;
+
+#elif defined( HAVE_MULTI_THREAD_SUPPORT ) && defined( HAVE_PTHREAD_H )
+static pthread_once_t libhmac_sha256_transform_initialize_once = PTHREAD_ONCE_INIT;
+
+#else
+static int libhmac_sha256_transform_is_initialized = 0;
+
+#endif
+
+/* Selects the block transform function supported by the CPU
+ * The portable transform is used if no hardware support is available
+ */
+static void libhmac_sha256_transform_select(
+             void )
+{
+#if defined( LIBHMAC_HAVE_SHA256_X86_TRANSFORM )
+	if( libhmac_sha256_x86_sha_is_supported() != 0 )
+	{
+		libhmac_sha256_transform_blocks = &libhmac_sha256_transform_blocks_x86_sha;
+	}
+#elif defined( LIBHMAC_HAVE_SHA256_ARM_TRANSFORM )
+	/* The compiler only defines the SHA2 feature macros if the target CPU supports it
+	 */
+	libhmac_sha256_transform_blocks = &libhmac_sha256_transform_blocks_arm_sha2;
+#endif
+}
+
+/* Selects the block transform function once
+ */
+void libhmac_sha256_transform_initialize(
+      void )
+{
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && defined( WINAPI )
+	/* State 0 represents not selected, 1 selecting and 2 selected
+	 */
+	if( InterlockedCompareExchange(
+	     &libhmac_sha256_transform_initialize_state,
+	     1,
+	     0 ) == 0 )
+	{
+		libhmac_sha256_transform_select();
+
+		InterlockedExchange(
+		 &libhmac_sha256_transform_initialize_state,
+		 2 );
+	}
+	while( InterlockedCompareExchange(
+	        &libhmac_sha256_transform_initialize_state,
+	        2,
+	        2 ) != 2 )
+	{
+		Sleep(
+		 0 );
+	}
+#elif defined( HAVE_MULTI_THREAD_SUPPORT ) && defined( HAVE_PTHREAD_H )
+	pthread_once(
+	 &libhmac_sha256_transform_initialize_once,
+	 &libhmac_sha256_transform_select );
+#else
+	if( libhmac_sha256_transform_is_initialized == 0 )
+	{
+		libhmac_sha256_transform_select();
+
+		libhmac_sha256_transform_is_initialized = 1;
+	}
+#endif
+}
+
 /* Calculates the SHA256 of 64 byte sized blocks of data in a buffer
  * Returns the number of bytes used if successful or -1 on error
  */
@@ -282,6 +662,20 @@ ssize_t libhmac_sha256_transform(
 
 		return( -1 );
 	}
+	libhmac_sha256_transform_initialize();
+
+	if( ( libhmac_sha256_transform_blocks != NULL )
+	 && ( libhmac_sha256_hardware_disabled == 0 )
+	 && ( size >= LIBHMAC_SHA256_BLOCK_SIZE ) )
+	{
+		libhmac_sha256_transform_blocks(
+		 internal_context->hash_values,
+		 buffer,
+		 size / LIBHMAC_SHA256_BLOCK_SIZE );
+
+		buffer_offset = size - ( size % LIBHMAC_SHA256_BLOCK_SIZE );
+		size         %= LIBHMAC_SHA256_BLOCK_SIZE;
+	}
 	while( size >= LIBHMAC_SHA256_BLOCK_SIZE )
 	{
 		if( memory_copy(
@@ -453,6 +847,70 @@ on_error:
 
 #endif /* !defined( LIBHMAC_HAVE_SHA256_SUPPORT ) */
 
+/* Retrieves the name of the SHA256 implementation that is used
+ * Returns a string containing the name
+ */
+const char *libhmac_sha256_get_implementation_name(
+             void )
+{
+#if defined( WINAPI ) && ( WINVER >= 0x0600 ) && defined( HAVE_WINCRYPT ) && defined( CALG_SHA_256 )
+	return( "wincrypt" );
+
+#elif defined( HAVE_LIBCRYPTO ) && defined( HAVE_OPENSSL_SHA_H ) && defined( SHA256_DIGEST_LENGTH )
+	return( "openssl" );
+
+#elif defined( HAVE_LIBCRYPTO ) && defined( HAVE_OPENSSL_EVP_H ) && defined( HAVE_EVP_SHA256 )
+	return( "openssl" );
+
+#else
+	libhmac_sha256_transform_initialize();
+
+	if( libhmac_sha256_hardware_disabled != 0 )
+	{
+		return( "generic" );
+	}
+#if defined( LIBHMAC_HAVE_SHA256_X86_TRANSFORM )
+	if( libhmac_sha256_transform_blocks == &libhmac_sha256_transform_blocks_x86_sha )
+	{
+		return( "sha-ni" );
+	}
+#elif defined( LIBHMAC_HAVE_SHA256_ARM_TRANSFORM )
+	if( libhmac_sha256_transform_blocks == &libhmac_sha256_transform_blocks_arm_sha2 )
+	{
+		return( "armv8-sha2" );
+	}
+#endif
+	return( "generic" );
+#endif
+}
+
+/* Enables or disables the use of the hardware accelerated block transform function
+ * This function is intended for testing and benchmarking and should not be called while data is being hashed
+ */
+void libhmac_sha256_set_hardware_enabled(
+      int enabled LIBHMAC_ATTRIBUTE_UNUSED )
+{
+#if defined( WINAPI ) && ( WINVER >= 0x0600 ) && defined( HAVE_WINCRYPT ) && defined( CALG_SHA_256 )
+	LIBHMAC_UNREFERENCED_PARAMETER( enabled )
+
+#elif defined( HAVE_LIBCRYPTO ) && defined( HAVE_OPENSSL_SHA_H ) && defined( SHA256_DIGEST_LENGTH )
+	LIBHMAC_UNREFERENCED_PARAMETER( enabled )
+
+#elif defined( HAVE_LIBCRYPTO ) && defined( HAVE_OPENSSL_EVP_H ) && defined( HAVE_EVP_SHA256 )
+	LIBHMAC_UNREFERENCED_PARAMETER( enabled )
+
+#else
+	if( enabled == 0 )
+	{
+		libhmac_sha256_hardware_disabled = 1;
+	}
+	else
+	{
+		libhmac_sha256_hardware_disabled = 0;
+	}
+#endif
+}
+
 /* Creates a SHA256 context
  * Make sure the value context is referencing, is set to NULL
  * Returns 1 if successful or -1 on error
@@ -1868,3 +2326,781 @@ on_error:
 	return( -1 );
 }
 
+
+/* Clones the state of a SHA256 context into an unused destination context
+ * The destination context is not allocated and must be cleared with
+ * libhmac_internal_sha256_context_clear after use
+ * Returns 1 if successful or -1 on error
+ */
+int libhmac_internal_sha256_context_clone(
+     libhmac_internal_sha256_context_t *destination_context,
+     libhmac_internal_sha256_context_t *source_context,
+     libcerror_error_t **error )
+{
+	static char *function = "libhmac_internal_sha256_context_clone";
+
+	if( destination_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination context.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid source context.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( WINAPI ) && ( WINVER >= 0x0600 ) && defined( HAVE_WINCRYPT ) && defined( CALG_SHA_256 )
+	/* The crypt provider remains owned by the source context
+	 */
+	destination_context->crypt_provider = 0;
+	destination_context->hash           = 0;
+
+	if( CryptDuplicateHash(
+	     source_context->hash,
+	     NULL,
+	     0,
+	     &( destination_context->hash ) ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to duplicate hash object.",
+		 function );
+
+		return( -1 );
+	}
+
+#elif defined( HAVE_LIBCRYPTO ) && defined( HAVE_OPENSSL_SHA_H ) && defined( SHA256_DIGEST_LENGTH )
+	destination_context->sha256_context = source_context->sha256_context;
+
+#elif defined( HAVE_LIBCRYPTO ) && defined( HAVE_OPENSSL_EVP_H ) && defined( HAVE_EVP_SHA256 )
+	EVP_MD_CTX_init(
+	 &( destination_context->evp_md_context ) );
+
+	if( EVP_MD_CTX_copy_ex(
+	     &( destination_context->evp_md_context ),
+	     &( source_context->evp_md_context ) ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy context.",
+		 function );
+
+		EVP_MD_CTX_cleanup(
+		 &( destination_context->evp_md_context ) );
+
+		return( -1 );
+	}
+
+#else
+	if( memory_copy(
+	     destination_context,
+	     source_context,
+	     sizeof( libhmac_internal_sha256_context_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy context.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Clears a SHA256 context created by libhmac_internal_sha256_context_clone
+ * Returns 1 if successful or -1 on error
+ */
+int libhmac_internal_sha256_context_clear(
+     libhmac_internal_sha256_context_t *context,
+     libcerror_error_t **error )
+{
+	static char *function = "libhmac_internal_sha256_context_clear";
+	int result            = 1;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( WINAPI ) && ( WINVER >= 0x0600 ) && defined( HAVE_WINCRYPT ) && defined( CALG_SHA_256 )
+	if( context->hash != 0 )
+	{
+		if( CryptDestroyHash(
+		     context->hash ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to destroy hash object.",
+			 function );
+
+			result = -1;
+		}
+		context->hash = 0;
+	}
+
+#elif defined( HAVE_LIBCRYPTO ) && defined( HAVE_OPENSSL_SHA_H ) && defined( SHA256_DIGEST_LENGTH )
+	if( memory_set(
+	     &( context->sha256_context ),
+	     0,
+	     sizeof( SHA256_CTX ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear context.",
+		 function );
+
+		result = -1;
+	}
+
+#elif defined( HAVE_LIBCRYPTO ) && defined( HAVE_OPENSSL_EVP_H ) && defined( HAVE_EVP_SHA256 )
+	if( EVP_MD_CTX_cleanup(
+	     &( context->evp_md_context ) ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to clean up context.",
+		 function );
+
+		result = -1;
+	}
+
+#else
+	/* Prevent sensitive data from leaking
+	 */
+	if( memory_set(
+	     context,
+	     0,
+	     sizeof( libhmac_internal_sha256_context_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear context.",
+		 function );
+
+		result = -1;
+	}
+#endif
+	return( result );
+}
+
+/* Creates a SHA256 HMAC context for a specific key
+ * The key is padded and hashed once, the resulting state is reused by
+ * libhmac_sha256_hmac_calculate which does not allocate memory
+ * Make sure the value context is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libhmac_sha256_hmac_initialize(
+     libhmac_sha256_hmac_context_t **context,
+     const uint8_t *key,
+     size_t key_size,
+     libcerror_error_t **error )
+{
+	uint8_t key_data[ 64 ];
+	uint8_t padding[ 64 ];
+
+	libhmac_internal_sha256_hmac_context_t *internal_context = NULL;
+	static char *function                                    = "libhmac_sha256_hmac_initialize";
+	size_t block_index                                       = 0;
+	size_t block_size                                        = 64;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *context != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid context value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key.",
+		 function );
+
+		return( -1 );
+	}
+	if( key_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid key size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	internal_context = memory_allocate_structure(
+	                    libhmac_internal_sha256_hmac_context_t );
+
+	if( internal_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create context.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     internal_context,
+	     0,
+	     sizeof( libhmac_internal_sha256_hmac_context_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear context.",
+		 function );
+
+		memory_free(
+		 internal_context );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     key_data,
+	     0,
+	     block_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear key data.",
+		 function );
+
+		goto on_error;
+	}
+	if( key_size <= block_size )
+	{
+		if( memory_copy(
+		     key_data,
+		     key,
+		     key_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy key data.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else if( libhmac_sha256_calculate(
+	          key,
+	          key_size,
+	          key_data,
+	          LIBHMAC_SHA256_HASH_SIZE,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to calculate key hash.",
+		 function );
+
+		goto on_error;
+	}
+	for( block_index = 0;
+	     block_index < block_size;
+	     block_index++ )
+	{
+		padding[ block_index ] = key_data[ block_index ] ^ 0x36;
+	}
+	if( libhmac_sha256_initialize(
+	     &( internal_context->inner_context ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize inner context.",
+		 function );
+
+		goto on_error;
+	}
+	if( libhmac_sha256_update(
+	     internal_context->inner_context,
+	     padding,
+	     block_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update inner context.",
+		 function );
+
+		goto on_error;
+	}
+	for( block_index = 0;
+	     block_index < block_size;
+	     block_index++ )
+	{
+		padding[ block_index ] = key_data[ block_index ] ^ 0x5c;
+	}
+	if( libhmac_sha256_initialize(
+	     &( internal_context->outer_context ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize outer context.",
+		 function );
+
+		goto on_error;
+	}
+	if( libhmac_sha256_update(
+	     internal_context->outer_context,
+	     padding,
+	     block_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update outer context.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     padding,
+	     0,
+	     block_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear padding.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     key_data,
+	     0,
+	     block_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear key data.",
+		 function );
+
+		goto on_error;
+	}
+	*context = (libhmac_sha256_hmac_context_t *) internal_context;
+
+	return( 1 );
+
+on_error:
+	if( internal_context != NULL )
+	{
+		if( internal_context->outer_context != NULL )
+		{
+			libhmac_sha256_free(
+			 &( internal_context->outer_context ),
+			 NULL );
+		}
+		if( internal_context->inner_context != NULL )
+		{
+			libhmac_sha256_free(
+			 &( internal_context->inner_context ),
+			 NULL );
+		}
+		memory_free(
+		 internal_context );
+	}
+	memory_set(
+	 padding,
+	 0,
+	 block_size );
+
+	memory_set(
+	 key_data,
+	 0,
+	 block_size );
+
+	return( -1 );
+}
+
+/* Frees a SHA256 HMAC context
+ * Returns 1 if successful or -1 on error
+ */
+int libhmac_sha256_hmac_free(
+     libhmac_sha256_hmac_context_t **context,
+     libcerror_error_t **error )
+{
+	libhmac_internal_sha256_hmac_context_t *internal_context = NULL;
+	static char *function                                    = "libhmac_sha256_hmac_free";
+	int result                                               = 1;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *context != NULL )
+	{
+		internal_context = (libhmac_internal_sha256_hmac_context_t *) *context;
+		*context         = NULL;
+
+		/* The contexts are freed without being finalized
+		 * clear them first to prevent sensitive data from leaking
+		 */
+		if( internal_context->inner_context != NULL )
+		{
+			if( libhmac_internal_sha256_context_clear(
+			     (libhmac_internal_sha256_context_t *) internal_context->inner_context,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to clear inner context.",
+				 function );
+
+				result = -1;
+			}
+			if( libhmac_sha256_free(
+			     &( internal_context->inner_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free inner context.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( internal_context->outer_context != NULL )
+		{
+			if( libhmac_internal_sha256_context_clear(
+			     (libhmac_internal_sha256_context_t *) internal_context->outer_context,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to clear outer context.",
+				 function );
+
+				result = -1;
+			}
+			if( libhmac_sha256_free(
+			     &( internal_context->outer_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free outer context.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 internal_context );
+	}
+	return( result );
+}
+
+/* Calculates the SHA256 HMAC of the buffer using a SHA256 HMAC context
+ * The context is not modified and can be reused, no memory is allocated
+ * HMAC is defined in RFC 2104
+ * Returns 1 if successful or -1 on error
+ */
+int libhmac_sha256_hmac_calculate(
+     libhmac_sha256_hmac_context_t *context,
+     const uint8_t *buffer,
+     size_t size,
+     uint8_t *hmac,
+     size_t hmac_size,
+     libcerror_error_t **error )
+{
+	uint8_t inner_hash[ LIBHMAC_SHA256_HASH_SIZE ];
+
+	libhmac_internal_sha256_context_t sha256_context;
+
+	libhmac_internal_sha256_hmac_context_t *internal_context = NULL;
+	static char *function                                    = "libhmac_sha256_hmac_calculate";
+	int sha256_context_is_set                                = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	internal_context = (libhmac_internal_sha256_hmac_context_t *) context;
+
+	if( ( internal_context->inner_context == NULL )
+	 || ( internal_context->outer_context == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid context - missing inner or outer context.",
+		 function );
+
+		return( -1 );
+	}
+	if( hmac == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid HMAC.",
+		 function );
+
+		return( -1 );
+	}
+	if( hmac_size < (size_t) LIBHMAC_SHA256_HASH_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid HMAC size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( libhmac_internal_sha256_context_clone(
+	     &sha256_context,
+	     (libhmac_internal_sha256_context_t *) internal_context->inner_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to clone inner context.",
+		 function );
+
+		goto on_error;
+	}
+	sha256_context_is_set = 1;
+
+	if( libhmac_sha256_update(
+	     (libhmac_sha256_context_t *) &sha256_context,
+	     buffer,
+	     size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update inner context.",
+		 function );
+
+		goto on_error;
+	}
+	if( libhmac_sha256_finalize(
+	     (libhmac_sha256_context_t *) &sha256_context,
+	     inner_hash,
+	     LIBHMAC_SHA256_HASH_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to finalize inner context.",
+		 function );
+
+		goto on_error;
+	}
+	sha256_context_is_set = 0;
+
+	if( libhmac_internal_sha256_context_clear(
+	     &sha256_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to clear inner context.",
+		 function );
+
+		goto on_error;
+	}
+	if( libhmac_internal_sha256_context_clone(
+	     &sha256_context,
+	     (libhmac_internal_sha256_context_t *) internal_context->outer_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to clone outer context.",
+		 function );
+
+		goto on_error;
+	}
+	sha256_context_is_set = 1;
+
+	if( libhmac_sha256_update(
+	     (libhmac_sha256_context_t *) &sha256_context,
+	     inner_hash,
+	     LIBHMAC_SHA256_HASH_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update outer context.",
+		 function );
+
+		goto on_error;
+	}
+	if( libhmac_sha256_finalize(
+	     (libhmac_sha256_context_t *) &sha256_context,
+	     hmac,
+	     hmac_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to finalize outer context.",
+		 function );
+
+		goto on_error;
+	}
+	sha256_context_is_set = 0;
+
+	if( libhmac_internal_sha256_context_clear(
+	     &sha256_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to clear outer context.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     inner_hash,
+	     0,
+	     LIBHMAC_SHA256_HASH_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear inner hash.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( sha256_context_is_set != 0 )
+	{
+		libhmac_internal_sha256_context_clear(
+		 &sha256_context,
+		 NULL );
+	}
+	memory_set(
+	 inner_hash,
+	 0,
+	 LIBHMAC_SHA256_HASH_SIZE );
+
+	return( -1 );
+}
+
@@ -95,8 +95,24 @@ struct libhmac_internal_sha256_context
 #endif
 };
 
+typedef struct libhmac_internal_sha256_hmac_context libhmac_internal_sha256_hmac_context_t;
+
+struct libhmac_internal_sha256_hmac_context
+{
+	/* The context containing the hashed key XOR inner padding
+	 */
+	libhmac_sha256_context_t *inner_context;
+
+	/* The context containing the hashed key XOR outer padding
+	 */
+	libhmac_sha256_context_t *outer_context;
+};
+
 #if !defined( LIBHMAC_HAVE_SHA256_SUPPORT )
 
+void libhmac_sha256_transform_initialize(
+      void );
+
 ssize_t libhmac_sha256_transform(
          libhmac_internal_sha256_context_t *internal_context,
          const uint8_t *buffer,
@@ -105,6 +121,14 @@ ssize_t libhmac_sha256_transform(
 
 #endif /* !defined( LIBHMAC_HAVE_SHA256_SUPPORT ) */
 
+LIBHMAC_EXTERN \
+const char *libhmac_sha256_get_implementation_name(
+             void );
+
+LIBHMAC_EXTERN \
+void libhmac_sha256_set_hardware_enabled(
+      int enabled );
+
 LIBHMAC_EXTERN \
 int libhmac_sha256_initialize(
      libhmac_sha256_context_t **context,
@@ -147,6 +171,36 @@ int libhmac_sha256_calculate_hmac(
      size_t hmac_size,
      libcerror_error_t **error );
 
+int libhmac_internal_sha256_context_clone(
+     libhmac_internal_sha256_context_t *destination_context,
+     libhmac_internal_sha256_context_t *source_context,
+     libcerror_error_t **error );
+
+int libhmac_internal_sha256_context_clear(
+     libhmac_internal_sha256_context_t *context,
+     libcerror_error_t **error );
+
+LIBHMAC_EXTERN \
+int libhmac_sha256_hmac_initialize(
+     libhmac_sha256_hmac_context_t **context,
+     const uint8_t *key,
+     size_t key_size,
+     libcerror_error_t **error );
+
+LIBHMAC_EXTERN \
+int libhmac_sha256_hmac_free(
+     libhmac_sha256_hmac_context_t **context,
+     libcerror_error_t **error );
+
+LIBHMAC_EXTERN \
+int libhmac_sha256_hmac_calculate(
+     libhmac_sha256_hmac_context_t *context,
+     const uint8_t *buffer,
+     size_t size,
+     uint8_t *hmac,
+     size_t hmac_size,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -38,6 +38,7 @@ typedef struct libhmac_md5_context {}		libhmac_md5_context_t;
 typedef struct libhmac_sha1_context {}		libhmac_sha1_context_t;
 typedef struct libhmac_sha224_context {}	libhmac_sha224_context_t;
 typedef struct libhmac_sha256_context {}	libhmac_sha256_context_t;
+typedef struct libhmac_sha256_hmac_context {}	libhmac_sha256_hmac_context_t;
 typedef struct libhmac_sha512_context {}	libhmac_sha512_context_t;
 
 #else
@@ -45,6 +46,7 @@ typedef intptr_t libhmac_md5_context_t;
 typedef intptr_t libhmac_sha1_context_t;
 typedef intptr_t libhmac_sha224_context_t;
 typedef intptr_t libhmac_sha256_context_t;
+typedef intptr_t libhmac_sha256_hmac_context_t;
 typedef intptr_t libhmac_sha512_context_t;
 
 #endif /* defined( HAVE_DEBUG_OUTPUT ) && !defined( WINAPI ) */
@@ -103,6 +103,11 @@ AC_DEFUN([AX_LIBCAES_CHECK_LIB],
           libcaes_crypt_xts,
           [ac_cv_libcaes_dummy=yes],
           [ac_cv_libcaes=no])
+        AC_CHECK_LIB(
+          caes,
+          libcaes_crypt_xts_data_units,
+          [ac_cv_libcaes_dummy=yes],
+          [ac_cv_libcaes=no])
 
         ac_cv_libcaes_LIBADD="-lcaes"
         ])
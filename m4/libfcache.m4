@@ -89,6 +89,16 @@ AC_DEFUN([AX_LIBFCACHE_CHECK_LIB],
           libfcache_cache_set_value_by_index,
           [ac_cv_libfcache_dummy=yes],
           [ac_cv_libfcache=no])
+        AC_CHECK_LIB(
+          fcache,
+          libfcache_cache_get_value_by_identifier,
+          [ac_cv_libfcache_dummy=yes],
+          [ac_cv_libfcache=no])
+        AC_CHECK_LIB(
+          fcache,
+          libfcache_cache_set_value_by_identifier,
+          [ac_cv_libfcache_dummy=yes],
+          [ac_cv_libfcache=no])
 
         dnl Cache value functions
         AC_CHECK_LIB(
@@ -135,6 +135,21 @@ AC_DEFUN([AX_LIBHMAC_CHECK_LIB],
           libhmac_sha256_free,
           [ac_cv_libhmac_dummy=yes],
           [ac_cv_libhmac=no])
+        AC_CHECK_LIB(
+          hmac,
+          libhmac_sha256_hmac_initialize,
+          [ac_cv_libhmac_dummy=yes],
+          [ac_cv_libhmac=no])
+        AC_CHECK_LIB(
+          hmac,
+          libhmac_sha256_hmac_free,
+          [ac_cv_libhmac_dummy=yes],
+          [ac_cv_libhmac=no])
+        AC_CHECK_LIB(
+          hmac,
+          libhmac_sha256_hmac_calculate,
+          [ac_cv_libhmac_dummy=yes],
+          [ac_cv_libhmac=no])
 
         dnl SHA512 functions
         AC_CHECK_LIB(
@@ -244,6 +244,8 @@ int pyfvde_file_object_io_handle_free(
 }
 
 /* Clones (duplicates) the file object IO handle and its attributes
+ * A Python file object has a single current offset that cannot be duplicated,
+ * hence a clone would share its state with the source and cloning is not supported
  * Returns 1 if succesful or -1 on error
  */
 int pyfvde_file_object_io_handle_clone(
@@ -281,32 +283,14 @@ int pyfvde_file_object_io_handle_clone(
 
 		return( 1 );
 	}
-	if( pyfvde_file_object_io_handle_initialize(
-	     destination_file_object_io_handle,
-	     source_file_object_io_handle->file_object,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create file object IO handle.",
-		 function );
-
-		return( -1 );
-	}
-	if( *destination_file_object_io_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: missing destination file object IO handle.",
-		 function );
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: unsupported file object IO handle - cloning a file object is not supported.",
+	 function );
 
-		return( -1 );
-	}
-	return( 1 );
+	return( -1 );
 }
 
 /* Opens the file object IO handle
@@ -0,0 +1,1124 @@
+/*
+ * AES hardware functions test program
+ *
+ * Copyright (C) 2011-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fvde_test_libcerror.h"
+#include "fvde_test_libfvde.h"
+#include "fvde_test_macros.h"
+#include "fvde_test_unused.h"
+
+#include "../libfvde/libfvde_libcaes.h"
+
+#if defined( HAVE_LOCAL_LIBCAES ) && !defined( LIBCAES_HAVE_AES_SUPPORT )
+#include "../libcaes/libcaes_hardware.h"
+
+#define FVDE_TEST_AES_HARDWARE_CROSS_CHECK	1
+#endif
+
+#if defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT ) && defined( FVDE_TEST_AES_HARDWARE_CROSS_CHECK )
+
+/* The maximum size of the test data, 19 data units of 4096 bytes
+ */
+#define FVDE_TEST_AES_HARDWARE_MAXIMUM_DATA_SIZE	( 19 * 4096 )
+
+uint8_t fvde_test_aes_hardware_input_data[ FVDE_TEST_AES_HARDWARE_MAXIMUM_DATA_SIZE ];
+uint8_t fvde_test_aes_hardware_expected_data[ FVDE_TEST_AES_HARDWARE_MAXIMUM_DATA_SIZE ];
+uint8_t fvde_test_aes_hardware_output_data[ FVDE_TEST_AES_HARDWARE_MAXIMUM_DATA_SIZE ];
+
+/* Fills the test data and key with a pseudo random pattern
+ */
+void fvde_test_aes_hardware_fill_data(
+      uint8_t *data,
+      size_t data_size,
+      uint32_t seed )
+{
+	size_t data_offset = 0;
+
+	for( data_offset = 0;
+	     data_offset < data_size;
+	     data_offset++ )
+	{
+		seed = ( seed * 1103515245UL ) + 12345;
+
+		data[ data_offset ] = (uint8_t) ( seed >> 16 );
+	}
+}
+
+/* De/encrypts data in ECB mode with and without the AES instructions and compares the results
+ * The AES instructions are also tested with the input and output data in the same buffer
+ * Returns 1 if the results match or 0 if not
+ */
+int fvde_test_aes_hardware_compare_ecb(
+     libcaes_context_t *context,
+     int mode,
+     size_t data_size )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	fvde_test_aes_hardware_fill_data(
+	 fvde_test_aes_hardware_input_data,
+	 data_size,
+	 (uint32_t) data_size );
+
+	libcaes_hardware_set_enabled(
+	 0 );
+
+	result = libcaes_crypt_ecb(
+	          context,
+	          mode,
+	          fvde_test_aes_hardware_input_data,
+	          data_size,
+	          fvde_test_aes_hardware_expected_data,
+	          data_size,
+	          &error );
+
+	libcaes_hardware_set_enabled(
+	 1 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcaes_crypt_ecb(
+	          context,
+	          mode,
+	          fvde_test_aes_hardware_input_data,
+	          data_size,
+	          fvde_test_aes_hardware_output_data,
+	          data_size,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          fvde_test_aes_hardware_output_data,
+	          fvde_test_aes_hardware_expected_data,
+	          data_size );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test in-place de/encryption
+	 */
+	memory_copy(
+	 fvde_test_aes_hardware_output_data,
+	 fvde_test_aes_hardware_input_data,
+	 data_size );
+
+	result = libcaes_crypt_ecb(
+	          context,
+	          mode,
+	          fvde_test_aes_hardware_output_data,
+	          data_size,
+	          fvde_test_aes_hardware_output_data,
+	          data_size,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          fvde_test_aes_hardware_output_data,
+	          fvde_test_aes_hardware_expected_data,
+	          data_size );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* De/encrypts data in CBC mode with and without the AES instructions and compares the results
+ * The AES instructions are also tested with the input and output data in the same buffer
+ * Returns 1 if the results match or 0 if not
+ */
+int fvde_test_aes_hardware_compare_cbc(
+     libcaes_context_t *context,
+     int mode,
+     const uint8_t *initialization_vector,
+     size_t data_size )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	fvde_test_aes_hardware_fill_data(
+	 fvde_test_aes_hardware_input_data,
+	 data_size,
+	 (uint32_t) data_size );
+
+	libcaes_hardware_set_enabled(
+	 0 );
+
+	result = libcaes_crypt_cbc(
+	          context,
+	          mode,
+	          initialization_vector,
+	          16,
+	          fvde_test_aes_hardware_input_data,
+	          data_size,
+	          fvde_test_aes_hardware_expected_data,
+	          data_size,
+	          &error );
+
+	libcaes_hardware_set_enabled(
+	 1 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcaes_crypt_cbc(
+	          context,
+	          mode,
+	          initialization_vector,
+	          16,
+	          fvde_test_aes_hardware_input_data,
+	          data_size,
+	          fvde_test_aes_hardware_output_data,
+	          data_size,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          fvde_test_aes_hardware_output_data,
+	          fvde_test_aes_hardware_expected_data,
+	          data_size );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test in-place de/encryption
+	 */
+	memory_copy(
+	 fvde_test_aes_hardware_output_data,
+	 fvde_test_aes_hardware_input_data,
+	 data_size );
+
+	result = libcaes_crypt_cbc(
+	          context,
+	          mode,
+	          initialization_vector,
+	          16,
+	          fvde_test_aes_hardware_output_data,
+	          data_size,
+	          fvde_test_aes_hardware_output_data,
+	          data_size,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          fvde_test_aes_hardware_output_data,
+	          fvde_test_aes_hardware_expected_data,
+	          data_size );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* De/encrypts data in XTS mode with and without the AES instructions and compares the results
+ * The AES instructions are also tested with the input and output data in the same buffer
+ * Returns 1 if the results match or 0 if not
+ */
+int fvde_test_aes_hardware_compare_xts(
+     libcaes_tweaked_context_t *tweaked_context,
+     int mode,
+     const uint8_t *tweak_value,
+     size_t data_size )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	fvde_test_aes_hardware_fill_data(
+	 fvde_test_aes_hardware_input_data,
+	 data_size,
+	 (uint32_t) data_size );
+
+	libcaes_hardware_set_enabled(
+	 0 );
+
+	result = libcaes_crypt_xts(
+	          tweaked_context,
+	          mode,
+	          tweak_value,
+	          16,
+	          fvde_test_aes_hardware_input_data,
+	          data_size,
+	          fvde_test_aes_hardware_expected_data,
+	          data_size,
+	          &error );
+
+	libcaes_hardware_set_enabled(
+	 1 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcaes_crypt_xts(
+	          tweaked_context,
+	          mode,
+	          tweak_value,
+	          16,
+	          fvde_test_aes_hardware_input_data,
+	          data_size,
+	          fvde_test_aes_hardware_output_data,
+	          data_size,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          fvde_test_aes_hardware_output_data,
+	          fvde_test_aes_hardware_expected_data,
+	          data_size );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test in-place de/encryption
+	 */
+	memory_copy(
+	 fvde_test_aes_hardware_output_data,
+	 fvde_test_aes_hardware_input_data,
+	 data_size );
+
+	result = libcaes_crypt_xts(
+	          tweaked_context,
+	          mode,
+	          tweak_value,
+	          16,
+	          fvde_test_aes_hardware_output_data,
+	          data_size,
+	          fvde_test_aes_hardware_output_data,
+	          data_size,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          fvde_test_aes_hardware_output_data,
+	          fvde_test_aes_hardware_expected_data,
+	          data_size );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* De/encrypts data units in XTS mode with and without the AES instructions and compares the results
+ * The AES instructions are also tested with the input and output data in the same buffer
+ * Returns 1 if the results match or 0 if not
+ */
+int fvde_test_aes_hardware_compare_xts_data_units(
+     libcaes_tweaked_context_t *tweaked_context,
+     int mode,
+     uint64_t data_unit_number,
+     size_t data_unit_size,
+     size_t data_size )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	fvde_test_aes_hardware_fill_data(
+	 fvde_test_aes_hardware_input_data,
+	 data_size,
+	 (uint32_t) data_size );
+
+	libcaes_hardware_set_enabled(
+	 0 );
+
+	result = libcaes_crypt_xts_data_units(
+	          tweaked_context,
+	          mode,
+	          data_unit_number,
+	          data_unit_size,
+	          fvde_test_aes_hardware_input_data,
+	          data_size,
+	          fvde_test_aes_hardware_expected_data,
+	          data_size,
+	          &error );
+
+	libcaes_hardware_set_enabled(
+	 1 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcaes_crypt_xts_data_units(
+	          tweaked_context,
+	          mode,
+	          data_unit_number,
+	          data_unit_size,
+	          fvde_test_aes_hardware_input_data,
+	          data_size,
+	          fvde_test_aes_hardware_output_data,
+	          data_size,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          fvde_test_aes_hardware_output_data,
+	          fvde_test_aes_hardware_expected_data,
+	          data_size );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test in-place de/encryption
+	 */
+	memory_copy(
+	 fvde_test_aes_hardware_output_data,
+	 fvde_test_aes_hardware_input_data,
+	 data_size );
+
+	result = libcaes_crypt_xts_data_units(
+	          tweaked_context,
+	          mode,
+	          data_unit_number,
+	          data_unit_size,
+	          fvde_test_aes_hardware_output_data,
+	          data_size,
+	          fvde_test_aes_hardware_output_data,
+	          data_size,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          fvde_test_aes_hardware_output_data,
+	          fvde_test_aes_hardware_expected_data,
+	          data_size );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libcaes_hardware_crypt_ecb function
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_aes_hardware_crypt_ecb(
+     void )
+{
+	uint8_t key[ 32 ];
+
+	size_t key_bit_sizes[ 3 ]     = { 128, 192, 256 };
+	int modes[ 2 ]                = { LIBCAES_CRYPT_MODE_ENCRYPT, LIBCAES_CRYPT_MODE_DECRYPT };
+
+	libcaes_context_t *context    = NULL;
+	libcerror_error_t *error      = NULL;
+	size_t number_of_blocks       = 0;
+	int key_bit_size_index        = 0;
+	int mode_index                = 0;
+	int result                    = 0;
+
+	fvde_test_aes_hardware_fill_data(
+	 key,
+	 32,
+	 0x4145530aUL );
+
+	/* Initialize test
+	 */
+	result = libcaes_context_initialize(
+	          &context,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "context",
+	 context );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 * The number of blocks covers the tails of the 4, 8 and 16 block pipelines
+	 */
+	for( key_bit_size_index = 0;
+	     key_bit_size_index < 3;
+	     key_bit_size_index++ )
+	{
+		for( mode_index = 0;
+		     mode_index < 2;
+		     mode_index++ )
+		{
+			result = libcaes_context_set_key(
+			          context,
+			          modes[ mode_index ],
+			          key,
+			          key_bit_sizes[ key_bit_size_index ],
+			          &error );
+
+			FVDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			FVDE_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			for( number_of_blocks = 1;
+			     number_of_blocks <= 33;
+			     number_of_blocks++ )
+			{
+				result = fvde_test_aes_hardware_compare_ecb(
+				          context,
+				          modes[ mode_index ],
+				          number_of_blocks * 16 );
+
+				FVDE_TEST_ASSERT_EQUAL_INT(
+				 "result",
+				 result,
+				 1 );
+			}
+		}
+	}
+	/* Clean up
+	 */
+	result = libcaes_context_free(
+	          &context,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "context",
+	 context );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( context != NULL )
+	{
+		libcaes_context_free(
+		 &context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libcaes_hardware_crypt_cbc function
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_aes_hardware_crypt_cbc(
+     void )
+{
+	uint8_t initialization_vector[ 16 ];
+	uint8_t key[ 32 ];
+
+	size_t key_bit_sizes[ 3 ]     = { 128, 192, 256 };
+	int modes[ 2 ]                = { LIBCAES_CRYPT_MODE_ENCRYPT, LIBCAES_CRYPT_MODE_DECRYPT };
+
+	libcaes_context_t *context    = NULL;
+	libcerror_error_t *error      = NULL;
+	size_t number_of_blocks       = 0;
+	int key_bit_size_index        = 0;
+	int mode_index                = 0;
+	int result                    = 0;
+
+	fvde_test_aes_hardware_fill_data(
+	 key,
+	 32,
+	 0x4342430aUL );
+
+	fvde_test_aes_hardware_fill_data(
+	 initialization_vector,
+	 16,
+	 0x4956000aUL );
+
+	/* Initialize test
+	 */
+	result = libcaes_context_initialize(
+	          &context,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "context",
+	 context );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 * The number of blocks covers the tails of the 4, 8 and 16 block pipelines
+	 */
+	for( key_bit_size_index = 0;
+	     key_bit_size_index < 3;
+	     key_bit_size_index++ )
+	{
+		for( mode_index = 0;
+		     mode_index < 2;
+		     mode_index++ )
+		{
+			result = libcaes_context_set_key(
+			          context,
+			          modes[ mode_index ],
+			          key,
+			          key_bit_sizes[ key_bit_size_index ],
+			          &error );
+
+			FVDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			FVDE_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			for( number_of_blocks = 1;
+			     number_of_blocks <= 33;
+			     number_of_blocks++ )
+			{
+				result = fvde_test_aes_hardware_compare_cbc(
+				          context,
+				          modes[ mode_index ],
+				          initialization_vector,
+				          number_of_blocks * 16 );
+
+				FVDE_TEST_ASSERT_EQUAL_INT(
+				 "result",
+				 result,
+				 1 );
+			}
+		}
+	}
+	/* Clean up
+	 */
+	result = libcaes_context_free(
+	          &context,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "context",
+	 context );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( context != NULL )
+	{
+		libcaes_context_free(
+		 &context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libcaes_hardware_crypt_xts function
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_aes_hardware_crypt_xts(
+     void )
+{
+	uint8_t key[ 32 ];
+	uint8_t tweak_key[ 32 ];
+	uint8_t tweak_value[ 16 ];
+
+	size_t key_bit_sizes[ 2 ]                  = { 128, 256 };
+	int modes[ 2 ]                             = { LIBCAES_CRYPT_MODE_ENCRYPT, LIBCAES_CRYPT_MODE_DECRYPT };
+
+	libcaes_tweaked_context_t *tweaked_context = NULL;
+	libcerror_error_t *error                   = NULL;
+	size_t data_size                           = 0;
+	int key_bit_size_index                     = 0;
+	int mode_index                             = 0;
+	int result                                 = 0;
+
+	fvde_test_aes_hardware_fill_data(
+	 key,
+	 32,
+	 0x5854530aUL );
+
+	fvde_test_aes_hardware_fill_data(
+	 tweak_key,
+	 32,
+	 0x5457000aUL );
+
+	fvde_test_aes_hardware_fill_data(
+	 tweak_value,
+	 16,
+	 0x5456000aUL );
+
+	/* Initialize test
+	 */
+	result = libcaes_tweaked_context_initialize(
+	          &tweaked_context,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "tweaked_context",
+	 tweaked_context );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 * The data sizes cover the tails of the 8 and 16 block pipelines
+	 * and ciphertext stealing, including the data sizes 17 to 47
+	 */
+	for( key_bit_size_index = 0;
+	     key_bit_size_index < 2;
+	     key_bit_size_index++ )
+	{
+		for( mode_index = 0;
+		     mode_index < 2;
+		     mode_index++ )
+		{
+			result = libcaes_tweaked_context_set_keys(
+			          tweaked_context,
+			          modes[ mode_index ],
+			          key,
+			          key_bit_sizes[ key_bit_size_index ],
+			          tweak_key,
+			          key_bit_sizes[ key_bit_size_index ],
+			          &error );
+
+			FVDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			FVDE_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			for( data_size = 16;
+			     data_size < ( 34 * 16 );
+			     data_size++ )
+			{
+				result = fvde_test_aes_hardware_compare_xts(
+				          tweaked_context,
+				          modes[ mode_index ],
+				          tweak_value,
+				          data_size );
+
+				FVDE_TEST_ASSERT_EQUAL_INT(
+				 "result",
+				 result,
+				 1 );
+			}
+		}
+	}
+	/* Clean up
+	 */
+	result = libcaes_tweaked_context_free(
+	          &tweaked_context,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "tweaked_context",
+	 tweaked_context );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( tweaked_context != NULL )
+	{
+		libcaes_tweaked_context_free(
+		 &tweaked_context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libcaes_hardware_crypt_xts_data_units function
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_aes_hardware_crypt_xts_data_units(
+     void )
+{
+	uint8_t key[ 32 ];
+	uint8_t tweak_key[ 32 ];
+
+	size_t data_unit_sizes[ 2 ]                = { 512, 4096 };
+	size_t key_bit_sizes[ 2 ]                  = { 128, 256 };
+	int modes[ 2 ]                             = { LIBCAES_CRYPT_MODE_ENCRYPT, LIBCAES_CRYPT_MODE_DECRYPT };
+
+	libcaes_tweaked_context_t *tweaked_context = NULL;
+	libcerror_error_t *error                   = NULL;
+	size_t number_of_data_units                = 0;
+	int data_unit_size_index                   = 0;
+	int key_bit_size_index                     = 0;
+	int mode_index                             = 0;
+	int result                                 = 0;
+
+	fvde_test_aes_hardware_fill_data(
+	 key,
+	 32,
+	 0x44550a0aUL );
+
+	fvde_test_aes_hardware_fill_data(
+	 tweak_key,
+	 32,
+	 0x4455570aUL );
+
+	/* Initialize test
+	 */
+	result = libcaes_tweaked_context_initialize(
+	          &tweaked_context,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "tweaked_context",
+	 tweaked_context );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 * The number of data units includes values that are not a multiple of 8
+	 */
+	for( key_bit_size_index = 0;
+	     key_bit_size_index < 2;
+	     key_bit_size_index++ )
+	{
+		for( mode_index = 0;
+		     mode_index < 2;
+		     mode_index++ )
+		{
+			result = libcaes_tweaked_context_set_keys(
+			          tweaked_context,
+			          modes[ mode_index ],
+			          key,
+			          key_bit_sizes[ key_bit_size_index ],
+			          tweak_key,
+			          key_bit_sizes[ key_bit_size_index ],
+			          &error );
+
+			FVDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			FVDE_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			for( data_unit_size_index = 0;
+			     data_unit_size_index < 2;
+			     data_unit_size_index++ )
+			{
+				for( number_of_data_units = 1;
+				     number_of_data_units <= 19;
+				     number_of_data_units++ )
+				{
+					result = fvde_test_aes_hardware_compare_xts_data_units(
+					          tweaked_context,
+					          modes[ mode_index ],
+					          (uint64_t) 0x00000000fffffff9ULL + number_of_data_units,
+					          data_unit_sizes[ data_unit_size_index ],
+					          number_of_data_units * data_unit_sizes[ data_unit_size_index ] );
+
+					FVDE_TEST_ASSERT_EQUAL_INT(
+					 "result",
+					 result,
+					 1 );
+				}
+			}
+		}
+	}
+	/* Clean up
+	 */
+	result = libcaes_tweaked_context_free(
+	          &tweaked_context,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "tweaked_context",
+	 tweaked_context );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( tweaked_context != NULL )
+	{
+		libcaes_tweaked_context_free(
+		 &tweaked_context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT ) && defined( FVDE_TEST_AES_HARDWARE_CROSS_CHECK ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FVDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FVDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FVDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FVDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	FVDE_TEST_UNREFERENCED_PARAMETER( argc )
+	FVDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT ) && defined( FVDE_TEST_AES_HARDWARE_CROSS_CHECK )
+
+	FVDE_TEST_RUN(
+	 "libcaes_hardware_crypt_ecb",
+	 fvde_test_aes_hardware_crypt_ecb );
+
+	FVDE_TEST_RUN(
+	 "libcaes_hardware_crypt_cbc",
+	 fvde_test_aes_hardware_crypt_cbc );
+
+	FVDE_TEST_RUN(
+	 "libcaes_hardware_crypt_xts",
+	 fvde_test_aes_hardware_crypt_xts );
+
+	FVDE_TEST_RUN(
+	 "libcaes_hardware_crypt_xts_data_units",
+	 fvde_test_aes_hardware_crypt_xts_data_units );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT ) && defined( FVDE_TEST_AES_HARDWARE_CROSS_CHECK ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT ) && defined( FVDE_TEST_AES_HARDWARE_CROSS_CHECK )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT ) && defined( FVDE_TEST_AES_HARDWARE_CROSS_CHECK ) */
+}
@@ -0,0 +1,336 @@
+/*
+ * Library checksum functions test program
+ *
+ * Copyright (C) 2011-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fvde_test_libcerror.h"
+#include "fvde_test_libfvde.h"
+#include "fvde_test_macros.h"
+#include "fvde_test_unused.h"
+
+#include "../libfvde/libfvde_checksum.h"
+
+#if defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT )
+
+/* Calculates a reflected CRC-32 one bit at a time
+ * Returns the CRC-32
+ */
+uint32_t fvde_test_checksum_calculate_bitwise_crc32(
+          uint32_t polynomial,
+          const uint8_t *buffer,
+          size_t size,
+          uint32_t initial_value )
+{
+	size_t buffer_offset = 0;
+	uint32_t checksum    = initial_value;
+	uint8_t bit_iterator = 0;
+
+	for( buffer_offset = 0;
+	     buffer_offset < size;
+	     buffer_offset++ )
+	{
+		checksum ^= buffer[ buffer_offset ];
+
+		for( bit_iterator = 0;
+		     bit_iterator < 8;
+		     bit_iterator++ )
+		{
+			if( ( checksum & 1 ) != 0 )
+			{
+				checksum = polynomial ^ ( checksum >> 1 );
+			}
+			else
+			{
+				checksum >>= 1;
+			}
+		}
+	}
+	return( checksum );
+}
+
+/* Tests libfvde_checksum_calculate_weak_crc32 against the bitwise CRC-32
+ * for various buffer sizes and alignments
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_checksum_calculate_weak_crc32_sizes(
+     uint32_t polynomial )
+{
+	uint8_t buffer[ 8192 + 8 ];
+
+	libcerror_error_t *error   = NULL;
+	size_t buffer_offset       = 0;
+	size_t size                = 0;
+	uint32_t checksum          = 0;
+	uint32_t expected_checksum = 0;
+	uint32_t value_32bit       = 0x12345678UL;
+	int result                 = 0;
+
+	for( buffer_offset = 0;
+	     buffer_offset < 8192 + 8;
+	     buffer_offset++ )
+	{
+		value_32bit = ( value_32bit * 1103515245UL ) + 12345;
+
+		buffer[ buffer_offset ] = (uint8_t) ( value_32bit >> 16 );
+	}
+	/* Use sizes around the sizes of the parts that are calculated in parallel
+	 */
+	for( size = 0;
+	     size <= 8192;
+	     size += ( size < 512 ) ? 1 : 127 )
+	{
+		for( buffer_offset = 0;
+		     buffer_offset < 8;
+		     buffer_offset += 3 )
+		{
+			expected_checksum = fvde_test_checksum_calculate_bitwise_crc32(
+			                     polynomial,
+			                     &( buffer[ buffer_offset ] ),
+			                     size,
+			                     0xffffffffUL );
+
+			result = libfvde_checksum_calculate_weak_crc32(
+			          &checksum,
+			          &( buffer[ buffer_offset ] ),
+			          size,
+			          0xffffffffUL,
+			          &error );
+
+			FVDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			FVDE_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			FVDE_TEST_ASSERT_EQUAL_UINT32(
+			 "checksum",
+			 checksum,
+			 expected_checksum );
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfvde_checksum_calculate_weak_crc32 function
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_checksum_calculate_weak_crc32(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	uint32_t checksum        = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	libfvde_checksum_initialize_crc32_table(
+	 0x82f63b78UL );
+
+	result = libfvde_checksum_calculate_weak_crc32(
+	          &checksum,
+	          (uint8_t *) "123456789",
+	          9,
+	          0xffffffffUL,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	checksum ^= 0xffffffffUL;
+
+	FVDE_TEST_ASSERT_EQUAL_UINT32(
+	 "checksum",
+	 checksum,
+	 (uint32_t) 0xe3069283UL );
+
+	result = fvde_test_checksum_calculate_weak_crc32_sizes(
+	          0x82f63b78UL );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test the table based calculation with a polynomial that is not supported
+	 * by the CRC-32C instructions
+	 */
+	libfvde_checksum_initialize_crc32_table(
+	 0xedb88320UL );
+
+	result = libfvde_checksum_calculate_weak_crc32(
+	          &checksum,
+	          (uint8_t *) "123456789",
+	          9,
+	          0xffffffffUL,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	checksum ^= 0xffffffffUL;
+
+	FVDE_TEST_ASSERT_EQUAL_UINT32(
+	 "checksum",
+	 checksum,
+	 (uint32_t) 0xcbf43926UL );
+
+	result = fvde_test_checksum_calculate_weak_crc32_sizes(
+	          0xedb88320UL );
+
+	libfvde_checksum_initialize_crc32_table(
+	 0x82f63b78UL );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test error cases
+	 */
+	result = libfvde_checksum_calculate_weak_crc32(
+	          NULL,
+	          (uint8_t *) "123456789",
+	          9,
+	          0xffffffffUL,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_checksum_calculate_weak_crc32(
+	          &checksum,
+	          NULL,
+	          9,
+	          0xffffffffUL,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_checksum_calculate_weak_crc32(
+	          &checksum,
+	          (uint8_t *) "123456789",
+	          (size_t) SSIZE_MAX + 1,
+	          0xffffffffUL,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FVDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FVDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FVDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FVDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	FVDE_TEST_UNREFERENCED_PARAMETER( argc )
+	FVDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT )
+
+	FVDE_TEST_RUN(
+	 "libfvde_checksum_calculate_weak_crc32",
+	 fvde_test_checksum_calculate_weak_crc32 );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
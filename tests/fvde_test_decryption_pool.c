@@ -0,0 +1,756 @@
+/*
+ * Library decryption_pool type test program
+ *
+ * Copyright (C) 2011-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fvde_test_libcerror.h"
+#include "fvde_test_libfvde.h"
+#include "fvde_test_macros.h"
+#include "fvde_test_memory.h"
+#include "fvde_test_unused.h"
+
+#include "../libfvde/libfvde_decryption_pool.h"
+#include "../libfvde/libfvde_libcaes.h"
+
+#if defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT ) && defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+
+uint8_t fvde_test_decryption_pool_key_data[ 32 ] = {
+	0x0b, 0x0e, 0x11, 0x14, 0x17, 0x1a, 0x1d, 0x20, 0x23, 0x26, 0x29, 0x2c, 0x2f, 0x32, 0x35, 0x38,
+	0x3b, 0x3e, 0x41, 0x44, 0x47, 0x4a, 0x4d, 0x50, 0x53, 0x56, 0x59, 0x5c, 0x5f, 0x62, 0x65, 0x68 };
+
+/* Tests the libfvde_decryption_pool_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_decryption_pool_initialize(
+     void )
+{
+	libcerror_error_t *error                   = NULL;
+	libfvde_decryption_pool_t *decryption_pool = NULL;
+	int result                                 = 0;
+
+	/* Test regular cases
+	 */
+	result = libfvde_decryption_pool_initialize(
+	          &decryption_pool,
+	          2,
+	          fvde_test_decryption_pool_key_data,
+	          &( fvde_test_decryption_pool_key_data[ 16 ] ),
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "decryption_pool",
+	 decryption_pool );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfvde_decryption_pool_free(
+	          &decryption_pool,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "decryption_pool",
+	 decryption_pool );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfvde_decryption_pool_initialize(
+	          NULL,
+	          2,
+	          fvde_test_decryption_pool_key_data,
+	          &( fvde_test_decryption_pool_key_data[ 16 ] ),
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	decryption_pool = (libfvde_decryption_pool_t *) 0x12345678UL;
+
+	result = libfvde_decryption_pool_initialize(
+	          &decryption_pool,
+	          2,
+	          fvde_test_decryption_pool_key_data,
+	          &( fvde_test_decryption_pool_key_data[ 16 ] ),
+	          &error );
+
+	decryption_pool = NULL;
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_decryption_pool_initialize(
+	          &decryption_pool,
+	          0,
+	          fvde_test_decryption_pool_key_data,
+	          &( fvde_test_decryption_pool_key_data[ 16 ] ),
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_decryption_pool_initialize(
+	          &decryption_pool,
+	          LIBFVDE_MAXIMUM_NUMBER_OF_DECRYPTION_THREADS + 1,
+	          fvde_test_decryption_pool_key_data,
+	          &( fvde_test_decryption_pool_key_data[ 16 ] ),
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_decryption_pool_initialize(
+	          &decryption_pool,
+	          2,
+	          NULL,
+	          &( fvde_test_decryption_pool_key_data[ 16 ] ),
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_decryption_pool_initialize(
+	          &decryption_pool,
+	          2,
+	          fvde_test_decryption_pool_key_data,
+	          NULL,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( decryption_pool != NULL )
+	{
+		libfvde_decryption_pool_free(
+		 &decryption_pool,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfvde_decryption_pool_free function
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_decryption_pool_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libfvde_decryption_pool_free(
+	          NULL,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfvde_decryption_pool_decrypt function
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_decryption_pool_decrypt(
+     void )
+{
+	libcaes_tweaked_context_t *xts_context     = NULL;
+	libcerror_error_t *error                   = NULL;
+	libfvde_decryption_pool_t *decryption_pool = NULL;
+	uint8_t *data                              = NULL;
+	uint8_t *plain_text_data                   = NULL;
+	size_t data_offset                         = 0;
+	int result                                 = 0;
+
+	/* Initialize test
+	 */
+	data = (uint8_t *) memory_allocate(
+	                    sizeof( uint8_t ) * 37 * 512 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "data",
+	 data );
+
+	plain_text_data = (uint8_t *) memory_allocate(
+	                               sizeof( uint8_t ) * 37 * 512 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "plain_text_data",
+	 plain_text_data );
+
+	for( data_offset = 0;
+	     data_offset < 37 * 512;
+	     data_offset++ )
+	{
+		plain_text_data[ data_offset ] = (uint8_t) ( data_offset % 251 );
+	}
+	result = libcaes_tweaked_context_initialize(
+	          &xts_context,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcaes_tweaked_context_set_keys(
+	          xts_context,
+	          LIBCAES_CRYPT_MODE_ENCRYPT,
+	          fvde_test_decryption_pool_key_data,
+	          128,
+	          &( fvde_test_decryption_pool_key_data[ 16 ] ),
+	          128,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The data starts at data unit 5
+	 */
+	result = libcaes_crypt_xts_data_units(
+	          xts_context,
+	          LIBCAES_CRYPT_MODE_ENCRYPT,
+	          5,
+	          512,
+	          plain_text_data,
+	          37 * 512,
+	          data,
+	          37 * 512,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcaes_tweaked_context_set_keys(
+	          xts_context,
+	          LIBCAES_CRYPT_MODE_DECRYPT,
+	          fvde_test_decryption_pool_key_data,
+	          128,
+	          &( fvde_test_decryption_pool_key_data[ 16 ] ),
+	          128,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfvde_decryption_pool_initialize(
+	          &decryption_pool,
+	          3,
+	          fvde_test_decryption_pool_key_data,
+	          &( fvde_test_decryption_pool_key_data[ 16 ] ),
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "decryption_pool",
+	 decryption_pool );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfvde_decryption_pool_decrypt(
+	          decryption_pool,
+	          xts_context,
+	          5,
+	          512,
+	          data,
+	          37 * 512,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          data,
+	          plain_text_data,
+	          37 * 512 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test data that contains less data units than the number of threads
+	 */
+	result = libcaes_tweaked_context_set_keys(
+	          xts_context,
+	          LIBCAES_CRYPT_MODE_ENCRYPT,
+	          fvde_test_decryption_pool_key_data,
+	          128,
+	          &( fvde_test_decryption_pool_key_data[ 16 ] ),
+	          128,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcaes_crypt_xts_data_units(
+	          xts_context,
+	          LIBCAES_CRYPT_MODE_ENCRYPT,
+	          7,
+	          512,
+	          &( plain_text_data[ 2 * 512 ] ),
+	          2 * 512,
+	          data,
+	          2 * 512,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcaes_tweaked_context_set_keys(
+	          xts_context,
+	          LIBCAES_CRYPT_MODE_DECRYPT,
+	          fvde_test_decryption_pool_key_data,
+	          128,
+	          &( fvde_test_decryption_pool_key_data[ 16 ] ),
+	          128,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfvde_decryption_pool_decrypt(
+	          decryption_pool,
+	          xts_context,
+	          7,
+	          512,
+	          data,
+	          2 * 512,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          data,
+	          &( plain_text_data[ 2 * 512 ] ),
+	          2 * 512 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libfvde_decryption_pool_decrypt(
+	          NULL,
+	          xts_context,
+	          5,
+	          512,
+	          data,
+	          37 * 512,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_decryption_pool_decrypt(
+	          decryption_pool,
+	          NULL,
+	          5,
+	          512,
+	          data,
+	          37 * 512,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_decryption_pool_decrypt(
+	          decryption_pool,
+	          xts_context,
+	          5,
+	          0,
+	          data,
+	          37 * 512,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_decryption_pool_decrypt(
+	          decryption_pool,
+	          xts_context,
+	          5,
+	          512,
+	          NULL,
+	          37 * 512,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_decryption_pool_decrypt(
+	          decryption_pool,
+	          xts_context,
+	          5,
+	          512,
+	          data,
+	          0,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_decryption_pool_decrypt(
+	          decryption_pool,
+	          xts_context,
+	          5,
+	          512,
+	          data,
+	          1000,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfvde_decryption_pool_free(
+	          &decryption_pool,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "decryption_pool",
+	 decryption_pool );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcaes_tweaked_context_free(
+	          &xts_context,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 plain_text_data );
+
+	memory_free(
+	 data );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( decryption_pool != NULL )
+	{
+		libfvde_decryption_pool_free(
+		 &decryption_pool,
+		 NULL );
+	}
+	if( xts_context != NULL )
+	{
+		libcaes_tweaked_context_free(
+		 &xts_context,
+		 NULL );
+	}
+	if( plain_text_data != NULL )
+	{
+		memory_free(
+		 plain_text_data );
+	}
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT ) && defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FVDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FVDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FVDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FVDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	FVDE_TEST_UNREFERENCED_PARAMETER( argc )
+	FVDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT ) && defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+
+	FVDE_TEST_RUN(
+	 "libfvde_decryption_pool_initialize",
+	 fvde_test_decryption_pool_initialize );
+
+	FVDE_TEST_RUN(
+	 "libfvde_decryption_pool_free",
+	 fvde_test_decryption_pool_free );
+
+	/* TODO: add tests for libfvde_decryption_pool_job_callback */
+
+	FVDE_TEST_RUN(
+	 "libfvde_decryption_pool_decrypt",
+	 fvde_test_decryption_pool_decrypt );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT ) && defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT ) && defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT ) && defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT ) */
+}
+
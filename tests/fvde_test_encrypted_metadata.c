@@ -21,19 +21,23 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
 #include <stdlib.h>
 #endif
 
+#include "fvde_test_libbfio.h"
 #include "fvde_test_libcerror.h"
 #include "fvde_test_libfvde.h"
 #include "fvde_test_macros.h"
 #include "fvde_test_memory.h"
 #include "fvde_test_unused.h"
 
+#include "../libfvde/libfvde_definitions.h"
 #include "../libfvde/libfvde_encrypted_metadata.h"
+#include "../libfvde/libfvde_io_handle.h"
 
 #if defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT )
 
@@ -270,14 +274,74 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libfvde_encrypted_metadata_get_parse_profile_flag function
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_encrypted_metadata_get_parse_profile_flag(
+     void )
+{
+	uint8_t parse_profile_flag = 0;
+
+	/* Test regular cases
+	 */
+	parse_profile_flag = libfvde_encrypted_metadata_get_parse_profile_flag(
+	                      0x0019 );
+
+	FVDE_TEST_ASSERT_EQUAL_UINT8(
+	 "parse_profile_flag",
+	 parse_profile_flag,
+	 LIBFVDE_PARSE_PROFILE_FLAG_KEYS );
+
+	parse_profile_flag = libfvde_encrypted_metadata_get_parse_profile_flag(
+	                      0x001a );
+
+	FVDE_TEST_ASSERT_EQUAL_UINT8(
+	 "parse_profile_flag",
+	 parse_profile_flag,
+	 LIBFVDE_PARSE_PROFILE_FLAG_KEYS );
+
+	parse_profile_flag = libfvde_encrypted_metadata_get_parse_profile_flag(
+	                      0x0305 );
+
+	FVDE_TEST_ASSERT_EQUAL_UINT8(
+	 "parse_profile_flag",
+	 parse_profile_flag,
+	 LIBFVDE_PARSE_PROFILE_FLAG_LAYOUT );
+
+	parse_profile_flag = libfvde_encrypted_metadata_get_parse_profile_flag(
+	                      0x0505 );
+
+	FVDE_TEST_ASSERT_EQUAL_UINT8(
+	 "parse_profile_flag",
+	 parse_profile_flag,
+	 LIBFVDE_PARSE_PROFILE_FLAG_LAYOUT );
+
+	parse_profile_flag = libfvde_encrypted_metadata_get_parse_profile_flag(
+	                      0x0012 );
+
+	FVDE_TEST_ASSERT_EQUAL_UINT8(
+	 "parse_profile_flag",
+	 parse_profile_flag,
+	 LIBFVDE_PARSE_PROFILE_FLAG_OTHER );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
 /* Tests the libfvde_encrypted_metadata_read function
  * Returns 1 if successful or 0 if not
  */
 int fvde_test_encrypted_metadata_read(
      void )
 {
+	libbfio_handle_t *file_io_handle                 = NULL;
 	libcerror_error_t *error                         = NULL;
 	libfvde_encrypted_metadata_t *encrypted_metadata = NULL;
+	libfvde_io_handle_t *io_handle                   = NULL;
+	uint8_t *data                                    = NULL;
+	size_t data_size                                 = LIBFVDE_ENCRYPTED_METADATA_WINDOW_SIZE;
 	int result                                       = 0;
 
 	/* Initialize test
@@ -299,14 +363,117 @@ int fvde_test_encrypted_metadata_read(
 	 "error",
 	 error );
 
+	result = libfvde_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	io_handle->block_size = 4096;
+
+	/* The first window contains only empty blocks, where all bytes are the same,
+	 * the data after the first window is beyond the end of the data and must not be read
+	 */
+	data = (uint8_t *) memory_allocate(
+	                    sizeof( uint8_t ) * data_size );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "data",
+	 data );
+
+	if( memory_set(
+	     data,
+	     0,
+	     data_size ) == NULL )
+	{
+		goto on_error;
+	}
+
+	result = libbfio_memory_range_initialize(
+	          &file_io_handle,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_memory_range_set(
+	          file_io_handle,
+	          data,
+	          data_size,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_open(
+	          file_io_handle,
+	          LIBBFIO_OPEN_READ,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfvde_encrypted_metadata_read(
+	          encrypted_metadata,
+	          io_handle,
+	          file_io_handle,
+	          NULL,
+	          0,
+	          4 * LIBFVDE_ENCRYPTED_METADATA_WINDOW_SIZE,
+	          LIBFVDE_PARSE_PROFILE_FULL,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FVDE_TEST_ASSERT_EQUAL_UINT64(
+	 "encrypted_metadata->logical_volume_size",
+	 encrypted_metadata->logical_volume_size,
+	 (uint64_t) 0 );
+
 	/* Test error cases
 	 */
 	result = libfvde_encrypted_metadata_read(
 	          NULL,
 	          NULL,
 	          NULL,
+	          NULL,
 	          0,
 	          0,
+	          LIBFVDE_PARSE_PROFILE_FULL,
 	          &error );
 
 	FVDE_TEST_ASSERT_EQUAL_INT(
@@ -325,8 +492,34 @@ int fvde_test_encrypted_metadata_read(
 	          encrypted_metadata,
 	          NULL,
 	          NULL,
+	          NULL,
 	          0,
 	          0,
+	          LIBFVDE_PARSE_PROFILE_FULL,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where the data ends before the end of the first window
+	 */
+	result = libfvde_encrypted_metadata_read(
+	          encrypted_metadata,
+	          io_handle,
+	          file_io_handle,
+	          NULL,
+	          8192,
+	          4 * LIBFVDE_ENCRYPTED_METADATA_WINDOW_SIZE,
+	          LIBFVDE_PARSE_PROFILE_FULL,
 	          &error );
 
 	FVDE_TEST_ASSERT_EQUAL_INT(
@@ -343,6 +536,50 @@ int fvde_test_encrypted_metadata_read(
 
 	/* Clean up
 	 */
+	result = libbfio_handle_close(
+	          file_io_handle,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_free(
+	          &file_io_handle,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 data );
+
+	data = NULL;
+
+	result = libfvde_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 	result = libfvde_encrypted_metadata_free(
 	          &encrypted_metadata,
 	          &error );
@@ -368,6 +605,23 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	if( io_handle != NULL )
+	{
+		libfvde_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
 	if( encrypted_metadata != NULL )
 	{
 		libfvde_encrypted_metadata_free(
@@ -567,6 +821,10 @@ int main(
 
 	/* TODO: add tests for libfvde_encrypted_metadata_read_type_0x0505 */
 
+	FVDE_TEST_RUN(
+	 "libfvde_encrypted_metadata_get_parse_profile_flag",
+	 fvde_test_encrypted_metadata_get_parse_profile_flag );
+
 	FVDE_TEST_RUN(
 	 "libfvde_encrypted_metadata_read",
 	 fvde_test_encrypted_metadata_read );
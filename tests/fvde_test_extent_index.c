@@ -0,0 +1,1347 @@
+/*
+ * Library extent_index type test program
+ *
+ * Copyright (C) 2011-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fvde_test_libcerror.h"
+#include "fvde_test_libfvde.h"
+#include "fvde_test_macros.h"
+#include "fvde_test_memory.h"
+#include "fvde_test_unused.h"
+
+#include "../libfvde/libfvde_extent_index.h"
+#include "../libfvde/libfvde_libcdata.h"
+#include "../libfvde/libfvde_segment_descriptor.h"
+
+#if defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT )
+
+/* Tests the libfvde_extent_index_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_extent_index_initialize(
+     void )
+{
+	libcerror_error_t *error             = NULL;
+	libfvde_extent_index_t *extent_index = NULL;
+	int result                           = 0;
+
+#if defined( HAVE_FVDE_TEST_MEMORY )
+	int number_of_malloc_fail_tests      = 1;
+	int number_of_memset_fail_tests      = 1;
+	int test_number                      = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libfvde_extent_index_initialize(
+	          &extent_index,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "extent_index",
+	 extent_index );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfvde_extent_index_free(
+	          &extent_index,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "extent_index",
+	 extent_index );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfvde_extent_index_initialize(
+	          NULL,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	extent_index = (libfvde_extent_index_t *) 0x12345678UL;
+
+	result = libfvde_extent_index_initialize(
+	          &extent_index,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	extent_index = NULL;
+
+#if defined( HAVE_FVDE_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfvde_extent_index_initialize with malloc failing
+		 */
+		fvde_test_malloc_attempts_before_fail = test_number;
+
+		result = libfvde_extent_index_initialize(
+		          &extent_index,
+		          &error );
+
+		if( fvde_test_malloc_attempts_before_fail != -1 )
+		{
+			fvde_test_malloc_attempts_before_fail = -1;
+
+			if( extent_index != NULL )
+			{
+				libfvde_extent_index_free(
+				 &extent_index,
+				 NULL );
+			}
+		}
+		else
+		{
+			FVDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FVDE_TEST_ASSERT_IS_NULL(
+			 "extent_index",
+			 extent_index );
+
+			FVDE_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfvde_extent_index_initialize with memset failing
+		 */
+		fvde_test_memset_attempts_before_fail = test_number;
+
+		result = libfvde_extent_index_initialize(
+		          &extent_index,
+		          &error );
+
+		if( fvde_test_memset_attempts_before_fail != -1 )
+		{
+			fvde_test_memset_attempts_before_fail = -1;
+
+			if( extent_index != NULL )
+			{
+				libfvde_extent_index_free(
+				 &extent_index,
+				 NULL );
+			}
+		}
+		else
+		{
+			FVDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FVDE_TEST_ASSERT_IS_NULL(
+			 "extent_index",
+			 extent_index );
+
+			FVDE_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_FVDE_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( extent_index != NULL )
+	{
+		libfvde_extent_index_free(
+		 &extent_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfvde_extent_index_free function
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_extent_index_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libfvde_extent_index_free(
+	          NULL,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfvde_extent_index_insert_extent function
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_extent_index_insert_extent(
+     void )
+{
+	libcerror_error_t *error             = NULL;
+	libfvde_extent_index_t *extent_index = NULL;
+	int result                           = 0;
+
+	/* Initialize test
+	 */
+	result = libfvde_extent_index_initialize(
+	          &extent_index,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "extent_index",
+	 extent_index );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfvde_extent_index_insert_extent(
+	          extent_index,
+	          8192,
+	          4096,
+	          65536,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfvde_extent_index_insert_extent(
+	          extent_index,
+	          0,
+	          8192,
+	          16384,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test an extent that is identical to an extent in the index
+	 */
+	result = libfvde_extent_index_insert_extent(
+	          extent_index,
+	          8192,
+	          4096,
+	          65536,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "number_of_extents",
+	 extent_index->number_of_extents,
+	 2 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT64(
+	 "extents[ 0 ].logical_offset",
+	 (int64_t) extent_index->extents[ 0 ].logical_offset,
+	 (int64_t) 0 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT64(
+	 "extents[ 1 ].logical_offset",
+	 (int64_t) extent_index->extents[ 1 ].logical_offset,
+	 (int64_t) 8192 );
+
+	/* Test error cases
+	 */
+	result = libfvde_extent_index_insert_extent(
+	          NULL,
+	          16384,
+	          4096,
+	          0,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_extent_index_insert_extent(
+	          extent_index,
+	          -1,
+	          4096,
+	          0,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_extent_index_insert_extent(
+	          extent_index,
+	          16384,
+	          0,
+	          0,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_extent_index_insert_extent(
+	          extent_index,
+	          16384,
+	          4096,
+	          -1,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test an extent that overlaps with the previous extent
+	 */
+	result = libfvde_extent_index_insert_extent(
+	          extent_index,
+	          4096,
+	          512,
+	          0,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test an extent that overlaps with the next extent
+	 */
+	result = libfvde_extent_index_insert_extent(
+	          extent_index,
+	          12288,
+	          4096,
+	          0,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfvde_extent_index_insert_extent(
+	          extent_index,
+	          32768,
+	          4096,
+	          0,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfvde_extent_index_insert_extent(
+	          extent_index,
+	          20480,
+	          16384,
+	          0,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfvde_extent_index_free(
+	          &extent_index,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "extent_index",
+	 extent_index );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( extent_index != NULL )
+	{
+		libfvde_extent_index_free(
+		 &extent_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfvde_extent_index_read_segment_descriptors function
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_extent_index_read_segment_descriptors(
+     void )
+{
+	libcdata_array_t *segment_descriptors            = NULL;
+	libcerror_error_t *error                         = NULL;
+	libfvde_extent_index_t *extent_index             = NULL;
+	libfvde_segment_descriptor_t *segment_descriptor = NULL;
+	int entry_index                                  = 0;
+	int result                                       = 0;
+	int segment_descriptor_index                     = 0;
+
+	/* Initialize test
+	 */
+	result = libcdata_array_initialize(
+	          &segment_descriptors,
+	          0,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The segment descriptors are not stored in logical order
+	 */
+	for( entry_index = 0;
+	     entry_index < 2;
+	     entry_index++ )
+	{
+		result = libfvde_segment_descriptor_initialize(
+		          &segment_descriptor,
+		          &error );
+
+		FVDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FVDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		segment_descriptor->logical_block_number  = (uint64_t) ( 1 - entry_index ) * 16;
+		segment_descriptor->number_of_blocks      = 16;
+		segment_descriptor->physical_block_number = (uint64_t) ( entry_index + 1 ) * 100;
+
+		result = libcdata_array_append_entry(
+		          segment_descriptors,
+		          &segment_descriptor_index,
+		          (intptr_t *) segment_descriptor,
+		          &error );
+
+		FVDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FVDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		segment_descriptor = NULL;
+	}
+	result = libfvde_extent_index_initialize(
+	          &extent_index,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfvde_extent_index_read_segment_descriptors(
+	          extent_index,
+	          segment_descriptors,
+	          4096,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "number_of_extents",
+	 extent_index->number_of_extents,
+	 2 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT64(
+	 "extents[ 0 ].physical_offset",
+	 (int64_t) extent_index->extents[ 0 ].physical_offset,
+	 (int64_t) 200 * 4096 );
+
+	FVDE_TEST_ASSERT_EQUAL_UINT64(
+	 "extents[ 1 ].size",
+	 (uint64_t) extent_index->extents[ 1 ].size,
+	 (uint64_t) 16 * 4096 );
+
+	/* Test error cases
+	 */
+	result = libfvde_extent_index_read_segment_descriptors(
+	          NULL,
+	          segment_descriptors,
+	          4096,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_extent_index_read_segment_descriptors(
+	          extent_index,
+	          NULL,
+	          4096,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_extent_index_read_segment_descriptors(
+	          extent_index,
+	          segment_descriptors,
+	          0,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfvde_extent_index_free(
+	          &extent_index,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcdata_array_free(
+	          &segment_descriptors,
+	          (int (*)(intptr_t **, libcerror_error_t **)) &libfvde_segment_descriptor_free,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( extent_index != NULL )
+	{
+		libfvde_extent_index_free(
+		 &extent_index,
+		 NULL );
+	}
+	if( segment_descriptor != NULL )
+	{
+		libfvde_segment_descriptor_free(
+		 &segment_descriptor,
+		 NULL );
+	}
+	if( segment_descriptors != NULL )
+	{
+		libcdata_array_free(
+		 &segment_descriptors,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libfvde_segment_descriptor_free,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfvde_extent_index_get_physical_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_extent_index_get_physical_offset(
+     void )
+{
+	libcerror_error_t *error             = NULL;
+	libfvde_extent_index_t *extent_index = NULL;
+	size64_t physical_size               = 0;
+	off64_t physical_offset              = 0;
+	int extent_number                    = 0;
+	int result                           = 0;
+
+	/* Initialize test
+	 */
+	result = libfvde_extent_index_initialize(
+	          &extent_index,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Map 64 extents of 4096 bytes in reverse physical order with a gap of 4096 bytes
+	 * after every extent
+	 */
+	for( extent_number = 0;
+	     extent_number < 64;
+	     extent_number++ )
+	{
+		result = libfvde_extent_index_insert_extent(
+		          extent_index,
+		          (off64_t) extent_number * 8192,
+		          4096,
+		          (off64_t) ( 63 - extent_number ) * 4096,
+		          &error );
+
+		FVDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FVDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test regular cases
+	 */
+	for( extent_number = 0;
+	     extent_number < 64;
+	     extent_number++ )
+	{
+		result = libfvde_extent_index_get_physical_offset(
+		          extent_index,
+		          ( (off64_t) extent_number * 8192 ) + 1000,
+		          &physical_offset,
+		          &physical_size,
+		          &error );
+
+		FVDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FVDE_TEST_ASSERT_EQUAL_INT64(
+		 "physical_offset",
+		 (int64_t) physical_offset,
+		 (int64_t) ( ( 63 - extent_number ) * 4096 ) + 1000 );
+
+		FVDE_TEST_ASSERT_EQUAL_UINT64(
+		 "physical_size",
+		 (uint64_t) physical_size,
+		 (uint64_t) 4096 - 1000 );
+
+		FVDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test an offset that is not mapped
+	 */
+	result = libfvde_extent_index_get_physical_offset(
+	          extent_index,
+	          ( 5 * 8192 ) + 4096 + 96,
+	          &physical_offset,
+	          &physical_size,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FVDE_TEST_ASSERT_EQUAL_UINT64(
+	 "physical_size",
+	 (uint64_t) physical_size,
+	 (uint64_t) 4096 - 96 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test an offset beyond the last extent
+	 */
+	result = libfvde_extent_index_get_physical_offset(
+	          extent_index,
+	          64 * 8192,
+	          &physical_offset,
+	          &physical_size,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FVDE_TEST_ASSERT_EQUAL_UINT64(
+	 "physical_size",
+	 (uint64_t) physical_size,
+	 (uint64_t) 0 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfvde_extent_index_get_physical_offset(
+	          NULL,
+	          0,
+	          &physical_offset,
+	          &physical_size,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_extent_index_get_physical_offset(
+	          extent_index,
+	          -1,
+	          &physical_offset,
+	          &physical_size,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_extent_index_get_physical_offset(
+	          extent_index,
+	          0,
+	          NULL,
+	          &physical_size,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_extent_index_get_physical_offset(
+	          extent_index,
+	          0,
+	          &physical_offset,
+	          NULL,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfvde_extent_index_free(
+	          &extent_index,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( extent_index != NULL )
+	{
+		libfvde_extent_index_free(
+		 &extent_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfvde_extent_index_get_next_mapped_range function
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_extent_index_get_next_mapped_range(
+     void )
+{
+	libcerror_error_t *error             = NULL;
+	libfvde_extent_index_t *extent_index = NULL;
+	size64_t range_size                  = 0;
+	off64_t range_offset                 = 0;
+	int result                           = 0;
+
+	/* Initialize test
+	 */
+	result = libfvde_extent_index_initialize(
+	          &extent_index,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Map 2 logically adjacent extents and a third extent after a gap of 8192 bytes
+	 */
+	result = libfvde_extent_index_insert_extent(
+	          extent_index,
+	          16384,
+	          4096,
+	          0,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfvde_extent_index_insert_extent(
+	          extent_index,
+	          4096,
+	          4096,
+	          65536,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfvde_extent_index_insert_extent(
+	          extent_index,
+	          0,
+	          4096,
+	          8192,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfvde_extent_index_get_next_mapped_range(
+	          extent_index,
+	          1000,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT64(
+	 "range_offset",
+	 (int64_t) range_offset,
+	 (int64_t) 1000 );
+
+	FVDE_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 (uint64_t) range_size,
+	 (uint64_t) 8192 - 1000 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test an offset in the gap between extents
+	 */
+	result = libfvde_extent_index_get_next_mapped_range(
+	          extent_index,
+	          8192,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT64(
+	 "range_offset",
+	 (int64_t) range_offset,
+	 (int64_t) 16384 );
+
+	FVDE_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 (uint64_t) range_size,
+	 (uint64_t) 4096 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test an offset beyond the last extent
+	 */
+	result = libfvde_extent_index_get_next_mapped_range(
+	          extent_index,
+	          20480,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfvde_extent_index_get_next_mapped_range(
+	          NULL,
+	          0,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_extent_index_get_next_mapped_range(
+	          extent_index,
+	          -1,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_extent_index_get_next_mapped_range(
+	          extent_index,
+	          0,
+	          NULL,
+	          &range_size,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_extent_index_get_next_mapped_range(
+	          extent_index,
+	          0,
+	          &range_offset,
+	          NULL,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfvde_extent_index_free(
+	          &extent_index,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( extent_index != NULL )
+	{
+		libfvde_extent_index_free(
+		 &extent_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FVDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FVDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FVDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FVDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	FVDE_TEST_UNREFERENCED_PARAMETER( argc )
+	FVDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( HAVE_DEBUG_OUTPUT ) && defined( FVDE_TEST_EXTENT_INDEX_VERBOSE )
+	libfvde_notify_set_verbose(
+	 1 );
+	libfvde_notify_set_stream(
+	 stderr,
+	 NULL );
+#endif
+
+#if defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT )
+
+	FVDE_TEST_RUN(
+	 "libfvde_extent_index_initialize",
+	 fvde_test_extent_index_initialize );
+
+	FVDE_TEST_RUN(
+	 "libfvde_extent_index_free",
+	 fvde_test_extent_index_free );
+
+	FVDE_TEST_RUN(
+	 "libfvde_extent_index_insert_extent",
+	 fvde_test_extent_index_insert_extent );
+
+	FVDE_TEST_RUN(
+	 "libfvde_extent_index_read_segment_descriptors",
+	 fvde_test_extent_index_read_segment_descriptors );
+
+	FVDE_TEST_RUN(
+	 "libfvde_extent_index_get_physical_offset",
+	 fvde_test_extent_index_get_physical_offset );
+
+	FVDE_TEST_RUN(
+	 "libfvde_extent_index_get_next_mapped_range",
+	 fvde_test_extent_index_get_next_mapped_range );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
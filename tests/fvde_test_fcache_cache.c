@@ -0,0 +1,1025 @@
+/*
+ * Library cache by identifier functions test program
+ *
+ * Copyright (C) 2011-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fvde_test_libcerror.h"
+#include "fvde_test_libfvde.h"
+#include "fvde_test_macros.h"
+#include "fvde_test_unused.h"
+
+#include "../libfvde/libfvde_libfcache.h"
+
+#if defined( HAVE_LOCAL_LIBFCACHE )
+#include "../libfcache/libfcache_cache_value.h"
+
+#define FVDE_TEST_FCACHE_CACHE_BY_IDENTIFIER	1
+#endif
+
+#if defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT ) && defined( FVDE_TEST_FCACHE_CACHE_BY_IDENTIFIER )
+
+#define FVDE_TEST_FCACHE_CACHE_NUMBER_OF_VALUES	8
+
+/* The values that are stored in the cache
+ */
+int fvde_test_fcache_cache_values[ FVDE_TEST_FCACHE_CACHE_NUMBER_OF_VALUES ];
+
+/* The number of times every value was freed by the cache
+ */
+int fvde_test_fcache_cache_number_of_frees[ FVDE_TEST_FCACHE_CACHE_NUMBER_OF_VALUES ];
+
+/* Frees a value, which only counts the number of times the value was freed
+ * Returns 1 if successful or -1 on error
+ */
+int fvde_test_fcache_cache_value_free(
+     intptr_t **value,
+     libcerror_error_t **error )
+{
+	static char *function = "fvde_test_fcache_cache_value_free";
+	int value_index       = 0;
+
+	if( ( value == NULL )
+	 || ( *value == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	value_index = (int) ( (int *) *value - fvde_test_fcache_cache_values );
+
+	if( ( value_index < 0 )
+	 || ( value_index >= FVDE_TEST_FCACHE_CACHE_NUMBER_OF_VALUES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid value index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	fvde_test_fcache_cache_number_of_frees[ value_index ] += 1;
+
+	*value = NULL;
+
+	return( 1 );
+}
+
+/* Sets the value with a specific index in the cache
+ * The offset of the identifier is the index of the value
+ * Returns 1 if successful or -1 on error
+ */
+int fvde_test_fcache_cache_set_value(
+     libfcache_cache_t *cache,
+     int value_index,
+     libcerror_error_t **error )
+{
+	return( libfcache_cache_set_value_by_identifier(
+	         cache,
+	         0,
+	         (off64_t) value_index,
+	         0,
+	         (intptr_t *) &( fvde_test_fcache_cache_values[ value_index ] ),
+	         &fvde_test_fcache_cache_value_free,
+	         LIBFCACHE_CACHE_VALUE_FLAG_MANAGED,
+	         error ) );
+}
+
+/* Determines the value that is cached for a specific offset
+ * Returns 1 if successful, 0 if no such value or -1 on error
+ */
+int fvde_test_fcache_cache_get_value_index(
+     libfcache_cache_t *cache,
+     off64_t offset,
+     int *value_index,
+     libcerror_error_t **error )
+{
+	libfcache_cache_value_t *cache_value = NULL;
+	intptr_t *value                      = NULL;
+	int result                           = 0;
+
+	result = libfcache_cache_get_value_by_identifier(
+	          cache,
+	          0,
+	          offset,
+	          0,
+	          &cache_value,
+	          error );
+
+	if( result != 1 )
+	{
+		return( result );
+	}
+	if( libfcache_cache_value_get_value(
+	     cache_value,
+	     &value,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	*value_index = (int) ( (int *) value - fvde_test_fcache_cache_values );
+
+	return( 1 );
+}
+
+/* Tests the libfcache_cache_get_value_by_identifier function
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_fcache_cache_get_value_by_identifier(
+     void )
+{
+	libcerror_error_t *error             = NULL;
+	libfcache_cache_t *cache             = NULL;
+	libfcache_cache_value_t *cache_value = NULL;
+	int result                           = 0;
+	int value_index                      = 0;
+
+	/* Initialize test
+	 */
+	result = libfcache_cache_initialize(
+	          &cache,
+	          3,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "cache",
+	 cache );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfcache_cache_get_value_by_identifier(
+	          cache,
+	          0,
+	          0,
+	          0,
+	          &cache_value,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( value_index = 0;
+	     value_index < 3;
+	     value_index++ )
+	{
+		result = fvde_test_fcache_cache_set_value(
+		          cache,
+		          value_index,
+		          &error );
+
+		FVDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FVDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = fvde_test_fcache_cache_get_value_index(
+	          cache,
+	          1,
+	          &value_index,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "value_index",
+	 value_index,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test retrieving a value that is not cached
+	 */
+	result = libfcache_cache_get_value_by_identifier(
+	          cache,
+	          0,
+	          3,
+	          0,
+	          &cache_value,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfcache_cache_get_value_by_identifier(
+	          cache,
+	          1,
+	          1,
+	          0,
+	          &cache_value,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test retrieving a value with a different timestamp
+	 */
+	result = libfcache_cache_get_value_by_identifier(
+	          cache,
+	          0,
+	          1,
+	          1,
+	          &cache_value,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfcache_cache_get_value_by_identifier(
+	          NULL,
+	          0,
+	          1,
+	          0,
+	          &cache_value,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfcache_cache_get_value_by_identifier(
+	          cache,
+	          0,
+	          1,
+	          0,
+	          NULL,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfcache_cache_free(
+	          &cache,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "cache",
+	 cache );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( cache != NULL )
+	{
+		libfcache_cache_free(
+		 &cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfcache_cache_set_value_by_identifier function
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_fcache_cache_set_value_by_identifier(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	libfcache_cache_t *cache = NULL;
+	int cached_value_index   = 0;
+	int result               = 0;
+	int value_index          = 0;
+
+	/* Initialize test
+	 */
+	if( memory_set(
+	     fvde_test_fcache_cache_number_of_frees,
+	     0,
+	     sizeof( int ) * FVDE_TEST_FCACHE_CACHE_NUMBER_OF_VALUES ) == NULL )
+	{
+		goto on_error;
+	}
+	result = libfcache_cache_initialize(
+	          &cache,
+	          3,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "cache",
+	 cache );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	for( value_index = 0;
+	     value_index < 3;
+	     value_index++ )
+	{
+		result = fvde_test_fcache_cache_set_value(
+		          cache,
+		          value_index,
+		          &error );
+
+		FVDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FVDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Retrieving value 0 makes it the most recently used value,
+	 * hence value 1 is the least recently used value and is replaced by value 3
+	 */
+	result = fvde_test_fcache_cache_get_value_index(
+	          cache,
+	          0,
+	          &value_index,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = fvde_test_fcache_cache_set_value(
+	          cache,
+	          3,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "fvde_test_fcache_cache_number_of_frees[ 1 ]",
+	 fvde_test_fcache_cache_number_of_frees[ 1 ],
+	 1 );
+
+	result = fvde_test_fcache_cache_get_value_index(
+	          cache,
+	          1,
+	          &value_index,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Retrieving values 0, 2 and 3 in that order makes value 0
+	 * the least recently used value, which is replaced by value 4
+	 */
+	for( value_index = 0;
+	     value_index < 4;
+	     value_index++ )
+	{
+		if( value_index == 1 )
+		{
+			continue;
+		}
+		result = fvde_test_fcache_cache_get_value_index(
+		          cache,
+		          (off64_t) value_index,
+		          &cached_value_index,
+		          &error );
+
+		FVDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FVDE_TEST_ASSERT_EQUAL_INT(
+		 "cached_value_index",
+		 cached_value_index,
+		 value_index );
+
+		FVDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = fvde_test_fcache_cache_set_value(
+	          cache,
+	          4,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "fvde_test_fcache_cache_number_of_frees[ 0 ]",
+	 fvde_test_fcache_cache_number_of_frees[ 0 ],
+	 1 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "fvde_test_fcache_cache_number_of_frees[ 2 ]",
+	 fvde_test_fcache_cache_number_of_frees[ 2 ],
+	 0 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "fvde_test_fcache_cache_number_of_frees[ 3 ]",
+	 fvde_test_fcache_cache_number_of_frees[ 3 ],
+	 0 );
+
+	result = fvde_test_fcache_cache_get_value_index(
+	          cache,
+	          0,
+	          &value_index,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test replacing the value of an identifier that is cached
+	 */
+	result = libfcache_cache_set_value_by_identifier(
+	          cache,
+	          0,
+	          2,
+	          0,
+	          (intptr_t *) &( fvde_test_fcache_cache_values[ 5 ] ),
+	          &fvde_test_fcache_cache_value_free,
+	          LIBFCACHE_CACHE_VALUE_FLAG_MANAGED,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "fvde_test_fcache_cache_number_of_frees[ 2 ]",
+	 fvde_test_fcache_cache_number_of_frees[ 2 ],
+	 1 );
+
+	result = fvde_test_fcache_cache_get_value_index(
+	          cache,
+	          2,
+	          &value_index,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "value_index",
+	 value_index,
+	 5 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = fvde_test_fcache_cache_set_value(
+	          NULL,
+	          6,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfcache_cache_free(
+	          &cache,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "cache",
+	 cache );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The values that remained cached are freed with the cache
+	 */
+	for( value_index = 2;
+	     value_index < 6;
+	     value_index++ )
+	{
+		FVDE_TEST_ASSERT_EQUAL_INT(
+		 "fvde_test_fcache_cache_number_of_frees[ value_index ]",
+		 fvde_test_fcache_cache_number_of_frees[ value_index ],
+		 1 );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( cache != NULL )
+	{
+		libfcache_cache_free(
+		 &cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfcache_cache_resize function of a cache used by identifier
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_fcache_cache_resize(
+     void )
+{
+	libcerror_error_t *error   = NULL;
+	libfcache_cache_t *cache   = NULL;
+	int cached_value_index     = 0;
+	int number_of_cache_values = 0;
+	int number_of_entries      = 0;
+	int result                 = 0;
+	int value_index            = 0;
+
+	/* Initialize test
+	 */
+	if( memory_set(
+	     fvde_test_fcache_cache_number_of_frees,
+	     0,
+	     sizeof( int ) * FVDE_TEST_FCACHE_CACHE_NUMBER_OF_VALUES ) == NULL )
+	{
+		goto on_error;
+	}
+	result = libfcache_cache_initialize(
+	          &cache,
+	          3,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "cache",
+	 cache );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( value_index = 0;
+	     value_index < 3;
+	     value_index++ )
+	{
+		result = fvde_test_fcache_cache_set_value(
+		          cache,
+		          value_index,
+		          &error );
+
+		FVDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FVDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test shrinking the cache, which empties a cache used by identifier
+	 */
+	result = libfcache_cache_resize(
+	          cache,
+	          2,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfcache_cache_get_number_of_entries(
+	          cache,
+	          &number_of_entries,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "number_of_entries",
+	 number_of_entries,
+	 2 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfcache_cache_get_number_of_cache_values(
+	          cache,
+	          &number_of_cache_values,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "number_of_cache_values",
+	 number_of_cache_values,
+	 0 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( value_index = 0;
+	     value_index < 3;
+	     value_index++ )
+	{
+		FVDE_TEST_ASSERT_EQUAL_INT(
+		 "fvde_test_fcache_cache_number_of_frees[ value_index ]",
+		 fvde_test_fcache_cache_number_of_frees[ value_index ],
+		 1 );
+
+		result = fvde_test_fcache_cache_get_value_index(
+		          cache,
+		          (off64_t) value_index,
+		          &cached_value_index,
+		          &error );
+
+		FVDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		FVDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* The resized cache holds 2 values, hence value 3 is replaced by value 5
+	 */
+	for( value_index = 3;
+	     value_index < 6;
+	     value_index++ )
+	{
+		result = fvde_test_fcache_cache_set_value(
+		          cache,
+		          value_index,
+		          &error );
+
+		FVDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FVDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "fvde_test_fcache_cache_number_of_frees[ 3 ]",
+	 fvde_test_fcache_cache_number_of_frees[ 3 ],
+	 1 );
+
+	for( value_index = 4;
+	     value_index < 6;
+	     value_index++ )
+	{
+		result = fvde_test_fcache_cache_get_value_index(
+		          cache,
+		          (off64_t) value_index,
+		          &cached_value_index,
+		          &error );
+
+		FVDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FVDE_TEST_ASSERT_EQUAL_INT(
+		 "cached_value_index",
+		 cached_value_index,
+		 value_index );
+
+		FVDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test growing the cache
+	 */
+	result = libfcache_cache_resize(
+	          cache,
+	          4,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( value_index = 4;
+	     value_index < 8;
+	     value_index++ )
+	{
+		result = fvde_test_fcache_cache_set_value(
+		          cache,
+		          value_index,
+		          &error );
+
+		FVDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FVDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Values 4 and 5 were freed when the cache was emptied
+	 * and none of the values are replaced after the cache was resized
+	 */
+	for( value_index = 4;
+	     value_index < 8;
+	     value_index++ )
+	{
+		FVDE_TEST_ASSERT_EQUAL_INT(
+		 "fvde_test_fcache_cache_number_of_frees[ value_index ]",
+		 fvde_test_fcache_cache_number_of_frees[ value_index ],
+		 ( value_index < 6 ) ? 1 : 0 );
+
+		result = fvde_test_fcache_cache_get_value_index(
+		          cache,
+		          (off64_t) value_index,
+		          &cached_value_index,
+		          &error );
+
+		FVDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FVDE_TEST_ASSERT_EQUAL_INT(
+		 "cached_value_index",
+		 cached_value_index,
+		 value_index );
+
+		FVDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test error cases
+	 */
+	result = libfcache_cache_resize(
+	          NULL,
+	          4,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfcache_cache_free(
+	          &cache,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "cache",
+	 cache );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( cache != NULL )
+	{
+		libfcache_cache_free(
+		 &cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT ) && defined( FVDE_TEST_FCACHE_CACHE_BY_IDENTIFIER ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FVDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FVDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FVDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FVDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	FVDE_TEST_UNREFERENCED_PARAMETER( argc )
+	FVDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT ) && defined( FVDE_TEST_FCACHE_CACHE_BY_IDENTIFIER )
+
+	FVDE_TEST_RUN(
+	 "libfcache_cache_get_value_by_identifier",
+	 fvde_test_fcache_cache_get_value_by_identifier );
+
+	FVDE_TEST_RUN(
+	 "libfcache_cache_set_value_by_identifier",
+	 fvde_test_fcache_cache_set_value_by_identifier );
+
+	FVDE_TEST_RUN(
+	 "libfcache_cache_resize",
+	 fvde_test_fcache_cache_resize );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT ) && defined( FVDE_TEST_FCACHE_CACHE_BY_IDENTIFIER ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT ) && defined( FVDE_TEST_FCACHE_CACHE_BY_IDENTIFIER )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT ) && defined( FVDE_TEST_FCACHE_CACHE_BY_IDENTIFIER ) */
+}
+
@@ -21,12 +21,14 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
 #include <stdlib.h>
 #endif
 
+#include "fvde_test_libbfio.h"
 #include "fvde_test_libcerror.h"
 #include "fvde_test_libfvde.h"
 #include "fvde_test_macros.h"
@@ -34,6 +36,7 @@
 #include "fvde_test_unused.h"
 
 #include "../libfvde/libfvde_io_handle.h"
+#include "../libfvde/libfvde_libcaes.h"
 
 #if defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT )
 
@@ -368,6 +371,442 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libfvde_io_handle_read_sectors_to_buffer function
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_io_handle_read_sectors_to_buffer(
+     void )
+{
+	uint8_t buffer[ 4 * 512 ];
+	uint8_t encrypted_data[ 8 * 512 ];
+	uint8_t key_data[ 32 ];
+	uint8_t plain_text_data[ 4 * 512 ];
+
+	libbfio_handle_t *file_io_handle       = NULL;
+	libcaes_tweaked_context_t *xts_context = NULL;
+	libcerror_error_t *error               = NULL;
+	libfvde_io_handle_t *io_handle         = NULL;
+	size_t data_offset                     = 0;
+	int result                             = 0;
+
+	/* Initialize test
+	 */
+	for( data_offset = 0;
+	     data_offset < 32;
+	     data_offset++ )
+	{
+		key_data[ data_offset ] = (uint8_t) ( ( data_offset * 5 ) + 3 );
+	}
+	for( data_offset = 0;
+	     data_offset < 4 * 512;
+	     data_offset++ )
+	{
+		plain_text_data[ data_offset ] = (uint8_t) ( data_offset % 241 );
+	}
+	result = libcaes_tweaked_context_initialize(
+	          &xts_context,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcaes_tweaked_context_set_keys(
+	          xts_context,
+	          LIBCAES_CRYPT_MODE_ENCRYPT,
+	          key_data,
+	          128,
+	          &( key_data[ 16 ] ),
+	          128,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The logical volume starts at sector 2, encrypt its sectors 2 to 5
+	 */
+	memory_set(
+	 encrypted_data,
+	 0,
+	 8 * 512 );
+
+	result = libcaes_crypt_xts_data_units(
+	          xts_context,
+	          LIBCAES_CRYPT_MODE_ENCRYPT,
+	          2,
+	          512,
+	          plain_text_data,
+	          4 * 512,
+	          &( encrypted_data[ 4 * 512 ] ),
+	          4 * 512,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcaes_tweaked_context_set_keys(
+	          xts_context,
+	          LIBCAES_CRYPT_MODE_DECRYPT,
+	          key_data,
+	          128,
+	          &( key_data[ 16 ] ),
+	          128,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfvde_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	io_handle->bytes_per_sector      = 512;
+	io_handle->logical_volume_offset = 2 * 512;
+	io_handle->logical_volume_size   = 6 * 512;
+	io_handle->is_encrypted          = 1;
+	io_handle->xts_context           = xts_context;
+
+	result = libbfio_memory_range_initialize(
+	          &file_io_handle,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_memory_range_set(
+	          file_io_handle,
+	          encrypted_data,
+	          8 * 512,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_open(
+	          file_io_handle,
+	          LIBBFIO_OPEN_READ,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfvde_io_handle_read_sectors_to_buffer(
+	          io_handle,
+	          file_io_handle,
+	          xts_context,
+	          NULL,
+	          2 * 512,
+	          buffer,
+	          4 * 512,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          buffer,
+	          plain_text_data,
+	          4 * 512 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libfvde_io_handle_read_sectors_to_buffer(
+	          io_handle,
+	          file_io_handle,
+	          xts_context,
+	          NULL,
+	          3 * 512,
+	          buffer,
+	          512,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          buffer,
+	          &( plain_text_data[ 512 ] ),
+	          512 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libfvde_io_handle_read_sectors_to_buffer(
+	          NULL,
+	          file_io_handle,
+	          xts_context,
+	          NULL,
+	          2 * 512,
+	          buffer,
+	          4 * 512,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_io_handle_read_sectors_to_buffer(
+	          io_handle,
+	          file_io_handle,
+	          xts_context,
+	          NULL,
+	          100,
+	          buffer,
+	          512,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_io_handle_read_sectors_to_buffer(
+	          io_handle,
+	          file_io_handle,
+	          xts_context,
+	          NULL,
+	          2 * 512,
+	          NULL,
+	          4 * 512,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_io_handle_read_sectors_to_buffer(
+	          io_handle,
+	          file_io_handle,
+	          xts_context,
+	          NULL,
+	          2 * 512,
+	          buffer,
+	          100,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_io_handle_read_sectors_to_buffer(
+	          io_handle,
+	          file_io_handle,
+	          xts_context,
+	          NULL,
+	          4 * 512,
+	          buffer,
+	          4 * 512,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	io_handle->xts_context = NULL;
+
+	result = libbfio_handle_close(
+	          file_io_handle,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_free(
+	          &file_io_handle,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfvde_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcaes_tweaked_context_free(
+	          &xts_context,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		io_handle->xts_context = NULL;
+
+		libfvde_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	if( xts_context != NULL )
+	{
+		libcaes_tweaked_context_free(
+		 &xts_context,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT ) */
 
 /* The main program
@@ -401,7 +840,9 @@ int main(
 
 	/* TODO: add tests for libfvde_io_handle_read_volume_header */
 
-	/* TODO: add tests for libfvde_io_handle_read_sector */
+	FVDE_TEST_RUN(
+	 "libfvde_io_handle_read_sectors_to_buffer",
+	 fvde_test_io_handle_read_sectors_to_buffer );
 
 	/* TODO: add tests for libfvde_io_handle_read_logical_volume_header */
 
@@ -0,0 +1,1409 @@
+/*
+ * Library layout type test program
+ *
+ * Copyright (C) 2011-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fvde_test_libbfio.h"
+#include "fvde_test_libcerror.h"
+#include "fvde_test_libfvde.h"
+#include "fvde_test_macros.h"
+#include "fvde_test_memory.h"
+#include "fvde_test_unused.h"
+
+#include "../libfvde/libfvde_data_area_descriptor.h"
+#include "../libfvde/libfvde_layout.h"
+#include "../libfvde/libfvde_libcdata.h"
+#include "../libfvde/libfvde_segment_descriptor.h"
+
+#if defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT )
+
+/* Tests the libfvde_layout_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_layout_initialize(
+     void )
+{
+	libcerror_error_t *error        = NULL;
+	libfvde_layout_t *layout        = NULL;
+	int result                      = 0;
+
+#if defined( HAVE_FVDE_TEST_MEMORY )
+	int number_of_malloc_fail_tests = 3;
+	int number_of_memset_fail_tests = 1;
+	int test_number                 = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libfvde_layout_initialize(
+	          &layout,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "layout",
+	 layout );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfvde_layout_free(
+	          &layout,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "layout",
+	 layout );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfvde_layout_initialize(
+	          NULL,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	layout = (libfvde_layout_t *) 0x12345678UL;
+
+	result = libfvde_layout_initialize(
+	          &layout,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	layout = NULL;
+
+#if defined( HAVE_FVDE_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfvde_layout_initialize with malloc failing
+		 */
+		fvde_test_malloc_attempts_before_fail = test_number;
+
+		result = libfvde_layout_initialize(
+		          &layout,
+		          &error );
+
+		if( fvde_test_malloc_attempts_before_fail != -1 )
+		{
+			fvde_test_malloc_attempts_before_fail = -1;
+
+			if( layout != NULL )
+			{
+				libfvde_layout_free(
+				 &layout,
+				 NULL );
+			}
+		}
+		else
+		{
+			FVDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FVDE_TEST_ASSERT_IS_NULL(
+			 "layout",
+			 layout );
+
+			FVDE_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfvde_layout_initialize with memset failing
+		 */
+		fvde_test_memset_attempts_before_fail = test_number;
+
+		result = libfvde_layout_initialize(
+		          &layout,
+		          &error );
+
+		if( fvde_test_memset_attempts_before_fail != -1 )
+		{
+			fvde_test_memset_attempts_before_fail = -1;
+
+			if( layout != NULL )
+			{
+				libfvde_layout_free(
+				 &layout,
+				 NULL );
+			}
+		}
+		else
+		{
+			FVDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FVDE_TEST_ASSERT_IS_NULL(
+			 "layout",
+			 layout );
+
+			FVDE_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_FVDE_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( layout != NULL )
+	{
+		libfvde_layout_free(
+		 &layout,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfvde_layout_free function
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_layout_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libfvde_layout_free(
+	          NULL,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfvde_layout_get_data_size function
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_layout_get_data_size(
+     void )
+{
+	libcerror_error_t *error                         = NULL;
+	libfvde_layout_t *layout                         = NULL;
+	libfvde_segment_descriptor_t *segment_descriptor = NULL;
+	size_t data_size                                 = 0;
+	int entry_index                                  = 0;
+	int result                                       = 0;
+
+	/* Initialize test
+	 */
+	result = libfvde_layout_initialize(
+	          &layout,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "layout",
+	 layout );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfvde_layout_get_data_size(
+	          layout,
+	          &data_size,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_EQUAL_SIZE(
+	 "data_size",
+	 data_size,
+	 (size_t) 152 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfvde_segment_descriptor_initialize(
+	          &segment_descriptor,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcdata_array_append_entry(
+	          layout->segment_descriptors,
+	          &entry_index,
+	          (intptr_t *) segment_descriptor,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	segment_descriptor = NULL;
+
+	result = libfvde_layout_get_data_size(
+	          layout,
+	          &data_size,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_EQUAL_SIZE(
+	 "data_size",
+	 data_size,
+	 (size_t) 176 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfvde_layout_get_data_size(
+	          NULL,
+	          &data_size,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_layout_get_data_size(
+	          layout,
+	          NULL,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfvde_layout_free(
+	          &layout,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "layout",
+	 layout );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( segment_descriptor != NULL )
+	{
+		libfvde_segment_descriptor_free(
+		 &segment_descriptor,
+		 NULL );
+	}
+	if( layout != NULL )
+	{
+		libfvde_layout_free(
+		 &layout,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfvde_layout_write_data and libfvde_layout_read_data functions
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_layout_read_data(
+     void )
+{
+	uint8_t data[ 208 ];
+
+	libcerror_error_t *error                             = NULL;
+	libfvde_data_area_descriptor_t *data_area_descriptor = NULL;
+	libfvde_data_area_descriptor_t *read_descriptor      = NULL;
+	libfvde_layout_t *layout                             = NULL;
+	libfvde_layout_t *read_layout                        = NULL;
+	libfvde_segment_descriptor_t *segment_descriptor     = NULL;
+	size_t data_size                                     = 0;
+	int entry_index                                      = 0;
+	int number_of_entries                                = 0;
+	int result                                           = 0;
+
+	/* Initialize test
+	 */
+	result = libfvde_layout_initialize(
+	          &layout,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "layout",
+	 layout );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	layout->volume_header_checksum              = 0x12345678UL;
+	layout->serial_number                       = 0x0000abcdUL;
+	layout->block_size                          = 4096;
+	layout->metadata_copy_index                 = 2;
+	layout->metadata_checksums[ 2 ]             = 0x87654321UL;
+	layout->metadata_transaction_numbers[ 2 ]   = 1234;
+	layout->encrypted_metadata_size             = 8192 * 16;
+	layout->primary_encrypted_metadata_offset   = 4096 * 8;
+	layout->secondary_encrypted_metadata_offset = 4096 * 64;
+	layout->logical_volume_offset               = 4096 * 128;
+	layout->logical_volume_size                 = 4096 * 1024;
+
+	result = libfvde_segment_descriptor_initialize(
+	          &segment_descriptor,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	segment_descriptor->logical_block_number  = 0;
+	segment_descriptor->number_of_blocks      = 1024;
+	segment_descriptor->physical_block_number = 128;
+
+	result = libcdata_array_append_entry(
+	          layout->segment_descriptors,
+	          &entry_index,
+	          (intptr_t *) segment_descriptor,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	segment_descriptor = NULL;
+
+	result = libfvde_data_area_descriptor_initialize(
+	          &data_area_descriptor,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	data_area_descriptor->offset        = 4096 * 128;
+	data_area_descriptor->size          = 4096 * 1024;
+	data_area_descriptor->data_type     = 1;
+	data_area_descriptor->mapped_offset = 0;
+
+	result = libcdata_array_append_entry(
+	          layout->data_area_descriptors,
+	          &entry_index,
+	          (intptr_t *) data_area_descriptor,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	data_area_descriptor = NULL;
+
+	result = libfvde_layout_get_data_size(
+	          layout,
+	          &data_size,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_EQUAL_SIZE(
+	 "data_size",
+	 data_size,
+	 (size_t) 208 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfvde_layout_write_data(
+	          layout,
+	          data,
+	          208,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfvde_layout_initialize(
+	          &read_layout,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "read_layout",
+	 read_layout );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfvde_layout_read_data(
+	          read_layout,
+	          data,
+	          208,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FVDE_TEST_ASSERT_EQUAL_UINT32(
+	 "read_layout->volume_header_checksum",
+	 read_layout->volume_header_checksum,
+	 (uint32_t) 0x12345678UL );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "read_layout->metadata_copy_index",
+	 read_layout->metadata_copy_index,
+	 2 );
+
+	FVDE_TEST_ASSERT_EQUAL_UINT64(
+	 "read_layout->metadata_transaction_numbers[ 2 ]",
+	 read_layout->metadata_transaction_numbers[ 2 ],
+	 (uint64_t) 1234 );
+
+	FVDE_TEST_ASSERT_EQUAL_UINT64(
+	 "read_layout->logical_volume_size",
+	 read_layout->logical_volume_size,
+	 (uint64_t) 4096 * 1024 );
+
+	result = libcdata_array_get_number_of_entries(
+	          read_layout->segment_descriptors,
+	          &number_of_entries,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "number_of_entries",
+	 number_of_entries,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcdata_array_get_entry_by_index(
+	          read_layout->data_area_descriptors,
+	          0,
+	          (intptr_t **) &read_descriptor,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "read_descriptor",
+	 read_descriptor );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FVDE_TEST_ASSERT_EQUAL_UINT64(
+	 "read_descriptor->data_type",
+	 read_descriptor->data_type,
+	 (uint64_t) 1 );
+
+	/* Test error cases
+	 */
+	result = libfvde_layout_read_data(
+	          NULL,
+	          data,
+	          208,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_layout_read_data(
+	          read_layout,
+	          NULL,
+	          208,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_layout_read_data(
+	          read_layout,
+	          data,
+	          200,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_layout_write_data(
+	          layout,
+	          data,
+	          200,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test libfvde_layout_read_data with a mismatch in checksum
+	 */
+	data[ 100 ] ^= 0xff;
+
+	result = libfvde_layout_read_data(
+	          read_layout,
+	          data,
+	          208,
+	          &error );
+
+	data[ 100 ] ^= 0xff;
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test libfvde_layout_read_data with an invalid signature
+	 */
+	data[ 0 ] = 'x';
+
+	result = libfvde_layout_read_data(
+	          read_layout,
+	          data,
+	          208,
+	          &error );
+
+	data[ 0 ] = 'f';
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test libfvde_layout_read_data with an unsupported format version
+	 */
+	data[ 8 ] = 2;
+
+	result = libfvde_layout_read_data(
+	          read_layout,
+	          data,
+	          208,
+	          &error );
+
+	data[ 8 ] = 1;
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfvde_layout_free(
+	          &read_layout,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "read_layout",
+	 read_layout );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfvde_layout_free(
+	          &layout,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "layout",
+	 layout );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( data_area_descriptor != NULL )
+	{
+		libfvde_data_area_descriptor_free(
+		 &data_area_descriptor,
+		 NULL );
+	}
+	if( segment_descriptor != NULL )
+	{
+		libfvde_segment_descriptor_free(
+		 &segment_descriptor,
+		 NULL );
+	}
+	if( read_layout != NULL )
+	{
+		libfvde_layout_free(
+		 &read_layout,
+		 NULL );
+	}
+	if( layout != NULL )
+	{
+		libfvde_layout_free(
+		 &layout,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfvde_layout_write_file_io_handle and libfvde_layout_read_file_io_handle functions
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_layout_write_file_io_handle(
+     void )
+{
+	uint8_t data[ 208 ];
+
+	libbfio_handle_t *file_io_handle                     = NULL;
+	libcerror_error_t *error                             = NULL;
+	libfvde_data_area_descriptor_t *data_area_descriptor = NULL;
+	libfvde_layout_t *layout                             = NULL;
+	libfvde_layout_t *read_layout                        = NULL;
+	libfvde_segment_descriptor_t *read_descriptor        = NULL;
+	libfvde_segment_descriptor_t *segment_descriptor     = NULL;
+	int entry_index                                      = 0;
+	int number_of_entries                                = 0;
+	int result                                           = 0;
+
+	/* Initialize test
+	 */
+	result = libfvde_layout_initialize(
+	          &layout,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "layout",
+	 layout );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	layout->volume_header_checksum              = 0x12345678UL;
+	layout->serial_number                       = 0x0000abcdUL;
+	layout->block_size                          = 4096;
+	layout->metadata_copy_index                 = 1;
+	layout->metadata_checksums[ 1 ]             = 0x87654321UL;
+	layout->metadata_transaction_numbers[ 1 ]   = 5678;
+	layout->encrypted_metadata_size             = 8192 * 16;
+	layout->primary_encrypted_metadata_offset   = 4096 * 8;
+	layout->secondary_encrypted_metadata_offset = 4096 * 64;
+	layout->logical_volume_offset               = 4096 * 128;
+	layout->logical_volume_size                 = 4096 * 1024;
+
+	result = libfvde_segment_descriptor_initialize(
+	          &segment_descriptor,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	segment_descriptor->logical_block_number  = 0;
+	segment_descriptor->number_of_blocks      = 1024;
+	segment_descriptor->physical_block_number = 128;
+
+	result = libcdata_array_append_entry(
+	          layout->segment_descriptors,
+	          &entry_index,
+	          (intptr_t *) segment_descriptor,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	segment_descriptor = NULL;
+
+	result = libfvde_data_area_descriptor_initialize(
+	          &data_area_descriptor,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	data_area_descriptor->offset        = 4096 * 128;
+	data_area_descriptor->size          = 4096 * 1024;
+	data_area_descriptor->data_type     = 1;
+	data_area_descriptor->mapped_offset = 0;
+
+	result = libcdata_array_append_entry(
+	          layout->data_area_descriptors,
+	          &entry_index,
+	          (intptr_t *) data_area_descriptor,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	data_area_descriptor = NULL;
+
+	result = libbfio_memory_range_initialize(
+	          &file_io_handle,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_memory_range_set(
+	          file_io_handle,
+	          data,
+	          208,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfvde_layout_initialize(
+	          &read_layout,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "read_layout",
+	 read_layout );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfvde_layout_write_file_io_handle(
+	          layout,
+	          file_io_handle,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfvde_layout_read_file_io_handle(
+	          read_layout,
+	          file_io_handle,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FVDE_TEST_ASSERT_EQUAL_UINT32(
+	 "read_layout->serial_number",
+	 read_layout->serial_number,
+	 (uint32_t) 0x0000abcdUL );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "read_layout->metadata_copy_index",
+	 read_layout->metadata_copy_index,
+	 1 );
+
+	FVDE_TEST_ASSERT_EQUAL_UINT32(
+	 "read_layout->metadata_checksums[ 1 ]",
+	 read_layout->metadata_checksums[ 1 ],
+	 (uint32_t) 0x87654321UL );
+
+	FVDE_TEST_ASSERT_EQUAL_UINT64(
+	 "read_layout->secondary_encrypted_metadata_offset",
+	 read_layout->secondary_encrypted_metadata_offset,
+	 (uint64_t) 4096 * 64 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT64(
+	 "read_layout->logical_volume_offset",
+	 (int64_t) read_layout->logical_volume_offset,
+	 (int64_t) 4096 * 128 );
+
+	result = libcdata_array_get_number_of_entries(
+	          read_layout->data_area_descriptors,
+	          &number_of_entries,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "number_of_entries",
+	 number_of_entries,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcdata_array_get_entry_by_index(
+	          read_layout->segment_descriptors,
+	          0,
+	          (intptr_t **) &read_descriptor,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "read_descriptor",
+	 read_descriptor );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FVDE_TEST_ASSERT_EQUAL_UINT64(
+	 "read_descriptor->number_of_blocks",
+	 read_descriptor->number_of_blocks,
+	 (uint64_t) 1024 );
+
+	FVDE_TEST_ASSERT_EQUAL_UINT64(
+	 "read_descriptor->physical_block_number",
+	 read_descriptor->physical_block_number,
+	 (uint64_t) 128 );
+
+	/* Test error cases
+	 */
+	result = libfvde_layout_write_file_io_handle(
+	          NULL,
+	          file_io_handle,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_layout_read_file_io_handle(
+	          NULL,
+	          file_io_handle,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test libfvde_layout_read_file_io_handle with a layout file that is too small
+	 */
+	result = libbfio_memory_range_set(
+	          file_io_handle,
+	          data,
+	          16,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfvde_layout_read_file_io_handle(
+	          read_layout,
+	          file_io_handle,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbfio_handle_free(
+	          &file_io_handle,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfvde_layout_free(
+	          &read_layout,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "read_layout",
+	 read_layout );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfvde_layout_free(
+	          &layout,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "layout",
+	 layout );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( data_area_descriptor != NULL )
+	{
+		libfvde_data_area_descriptor_free(
+		 &data_area_descriptor,
+		 NULL );
+	}
+	if( segment_descriptor != NULL )
+	{
+		libfvde_segment_descriptor_free(
+		 &segment_descriptor,
+		 NULL );
+	}
+	if( read_layout != NULL )
+	{
+		libfvde_layout_free(
+		 &read_layout,
+		 NULL );
+	}
+	if( layout != NULL )
+	{
+		libfvde_layout_free(
+		 &layout,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FVDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FVDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FVDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FVDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	FVDE_TEST_UNREFERENCED_PARAMETER( argc )
+	FVDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( HAVE_DEBUG_OUTPUT ) && defined( FVDE_TEST_LAYOUT_VERBOSE )
+	libfvde_notify_set_verbose(
+	 1 );
+	libfvde_notify_set_stream(
+	 stderr,
+	 NULL );
+#endif
+
+#if defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT )
+
+	FVDE_TEST_RUN(
+	 "libfvde_layout_initialize",
+	 fvde_test_layout_initialize );
+
+	FVDE_TEST_RUN(
+	 "libfvde_layout_free",
+	 fvde_test_layout_free );
+
+	FVDE_TEST_RUN(
+	 "libfvde_layout_get_data_size",
+	 fvde_test_layout_get_data_size );
+
+	FVDE_TEST_RUN(
+	 "libfvde_layout_read_data",
+	 fvde_test_layout_read_data );
+
+	FVDE_TEST_RUN(
+	 "libfvde_layout_write_file_io_handle",
+	 fvde_test_layout_write_file_io_handle );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
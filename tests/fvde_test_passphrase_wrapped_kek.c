@@ -0,0 +1,809 @@
+/*
+ * Library passphrase_wrapped_kek type test program
+ *
+ * Copyright (C) 2011-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fvde_test_libcerror.h"
+#include "fvde_test_libfvde.h"
+#include "fvde_test_macros.h"
+#include "fvde_test_memory.h"
+#include "fvde_test_unused.h"
+
+#include "../libfvde/libfvde_passphrase_wrapped_kek.h"
+
+uint8_t fvde_test_passphrase_wrapped_kek_data1[ 284 ] = {
+	0x03, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0xe7, 0xee, 0xba, 0xab, 0xac, 0xaf, 0xfe, 0x04,
+	0xdd, 0x33, 0xd2, 0x2f, 0xd0, 0x9e, 0x30, 0xe5, 0x10, 0x00, 0x00, 0x00, 0x18, 0x00, 0x00, 0x00,
+	0xe9, 0xac, 0xbb, 0x4b, 0xc6, 0xda, 0xfb, 0x74, 0xaa, 0xdb, 0x72, 0xc5, 0x76, 0xfe, 0xcf, 0x69,
+	0xc2, 0xad, 0x45, 0xcc, 0xd4, 0x77, 0x6d, 0x76, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x28, 0xa0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+
+#if defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT )
+
+/* Tests the libfvde_passphrase_wrapped_kek_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_passphrase_wrapped_kek_initialize(
+     void )
+{
+	libcerror_error_t *error                                 = NULL;
+	libfvde_passphrase_wrapped_kek_t *passphrase_wrapped_kek = NULL;
+	int result                                               = 0;
+
+#if defined( HAVE_FVDE_TEST_MEMORY )
+	int number_of_malloc_fail_tests                          = 1;
+	int number_of_memset_fail_tests                          = 1;
+	int test_number                                          = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libfvde_passphrase_wrapped_kek_initialize(
+	          &passphrase_wrapped_kek,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "passphrase_wrapped_kek",
+	 passphrase_wrapped_kek );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfvde_passphrase_wrapped_kek_free(
+	          &passphrase_wrapped_kek,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "passphrase_wrapped_kek",
+	 passphrase_wrapped_kek );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfvde_passphrase_wrapped_kek_initialize(
+	          NULL,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	passphrase_wrapped_kek = (libfvde_passphrase_wrapped_kek_t *) 0x12345678UL;
+
+	result = libfvde_passphrase_wrapped_kek_initialize(
+	          &passphrase_wrapped_kek,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	passphrase_wrapped_kek = NULL;
+
+#if defined( HAVE_FVDE_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfvde_passphrase_wrapped_kek_initialize with malloc failing
+		 */
+		fvde_test_malloc_attempts_before_fail = test_number;
+
+		result = libfvde_passphrase_wrapped_kek_initialize(
+		          &passphrase_wrapped_kek,
+		          &error );
+
+		if( fvde_test_malloc_attempts_before_fail != -1 )
+		{
+			fvde_test_malloc_attempts_before_fail = -1;
+
+			if( passphrase_wrapped_kek != NULL )
+			{
+				libfvde_passphrase_wrapped_kek_free(
+				 &passphrase_wrapped_kek,
+				 NULL );
+			}
+		}
+		else
+		{
+			FVDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FVDE_TEST_ASSERT_IS_NULL(
+			 "passphrase_wrapped_kek",
+			 passphrase_wrapped_kek );
+
+			FVDE_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfvde_passphrase_wrapped_kek_initialize with memset failing
+		 */
+		fvde_test_memset_attempts_before_fail = test_number;
+
+		result = libfvde_passphrase_wrapped_kek_initialize(
+		          &passphrase_wrapped_kek,
+		          &error );
+
+		if( fvde_test_memset_attempts_before_fail != -1 )
+		{
+			fvde_test_memset_attempts_before_fail = -1;
+
+			if( passphrase_wrapped_kek != NULL )
+			{
+				libfvde_passphrase_wrapped_kek_free(
+				 &passphrase_wrapped_kek,
+				 NULL );
+			}
+		}
+		else
+		{
+			FVDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FVDE_TEST_ASSERT_IS_NULL(
+			 "passphrase_wrapped_kek",
+			 passphrase_wrapped_kek );
+
+			FVDE_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_FVDE_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( passphrase_wrapped_kek != NULL )
+	{
+		libfvde_passphrase_wrapped_kek_free(
+		 &passphrase_wrapped_kek,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfvde_passphrase_wrapped_kek_free function
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_passphrase_wrapped_kek_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libfvde_passphrase_wrapped_kek_free(
+	          NULL,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfvde_passphrase_wrapped_kek_read_data function
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_passphrase_wrapped_kek_read_data(
+     void )
+{
+	uint8_t expected_salt[ 16 ] = {
+		0xe7, 0xee, 0xba, 0xab, 0xac, 0xaf, 0xfe, 0x04, 0xdd, 0x33, 0xd2, 0x2f, 0xd0, 0x9e, 0x30, 0xe5 };
+
+	uint8_t expected_wrapped_kek[ 24 ] = {
+		0xe9, 0xac, 0xbb, 0x4b, 0xc6, 0xda, 0xfb, 0x74, 0xaa, 0xdb, 0x72, 0xc5, 0x76, 0xfe, 0xcf, 0x69,
+		0xc2, 0xad, 0x45, 0xcc, 0xd4, 0x77, 0x6d, 0x76 };
+
+	uint8_t invalid_data[ 284 ];
+
+	libcerror_error_t *error                                 = NULL;
+	libfvde_passphrase_wrapped_kek_t *passphrase_wrapped_kek = NULL;
+	int result                                               = 0;
+
+	/* Initialize test
+	 */
+	result = libfvde_passphrase_wrapped_kek_initialize(
+	          &passphrase_wrapped_kek,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "passphrase_wrapped_kek",
+	 passphrase_wrapped_kek );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfvde_passphrase_wrapped_kek_read_data(
+	          passphrase_wrapped_kek,
+	          fvde_test_passphrase_wrapped_kek_data1,
+	          284,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          passphrase_wrapped_kek->salt,
+	          expected_salt,
+	          16 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FVDE_TEST_ASSERT_EQUAL_UINT32(
+	 "passphrase_wrapped_kek->number_of_iterations",
+	 passphrase_wrapped_kek->number_of_iterations,
+	 (uint32_t) 41000 );
+
+	result = memory_compare(
+	          passphrase_wrapped_kek->wrapped_kek,
+	          expected_wrapped_kek,
+	          24 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libfvde_passphrase_wrapped_kek_read_data(
+	          NULL,
+	          fvde_test_passphrase_wrapped_kek_data1,
+	          284,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_passphrase_wrapped_kek_read_data(
+	          passphrase_wrapped_kek,
+	          NULL,
+	          284,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_passphrase_wrapped_kek_read_data(
+	          passphrase_wrapped_kek,
+	          fvde_test_passphrase_wrapped_kek_data1,
+	          283,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where the salt value type is invalid
+	 */
+	memory_copy(
+	 invalid_data,
+	 fvde_test_passphrase_wrapped_kek_data1,
+	 284 );
+
+	invalid_data[ 0 ] = 0xff;
+
+	result = libfvde_passphrase_wrapped_kek_read_data(
+	          passphrase_wrapped_kek,
+	          invalid_data,
+	          284,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where the wrapped KEK value size is invalid
+	 */
+	invalid_data[ 0 ]  = 0x03;
+	invalid_data[ 28 ] = 0x20;
+
+	result = libfvde_passphrase_wrapped_kek_read_data(
+	          passphrase_wrapped_kek,
+	          invalid_data,
+	          284,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfvde_passphrase_wrapped_kek_free(
+	          &passphrase_wrapped_kek,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "passphrase_wrapped_kek",
+	 passphrase_wrapped_kek );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( passphrase_wrapped_kek != NULL )
+	{
+		libfvde_passphrase_wrapped_kek_free(
+		 &passphrase_wrapped_kek,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfvde_passphrase_wrapped_kek_check_passwords function
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_passphrase_wrapped_kek_check_passwords(
+     void )
+{
+	uint8_t salt[ 16 ] = {
+		0xe7, 0xee, 0xba, 0xab, 0xac, 0xaf, 0xfe, 0x04, 0xdd, 0x33, 0xd2, 0x2f, 0xd0, 0x9e, 0x30, 0xe5 };
+
+	uint8_t wrapped_kek[ 24 ] = {
+		0xe9, 0xac, 0xbb, 0x4b, 0xc6, 0xda, 0xfb, 0x74, 0xaa, 0xdb, 0x72, 0xc5, 0x76, 0xfe, 0xcf, 0x69,
+		0xc2, 0xad, 0x45, 0xcc, 0xd4, 0x77, 0x6d, 0x76 };
+
+	const uint8_t *passwords[ 3 ] = {
+		(const uint8_t *) "password",
+		(const uint8_t *) "openwall",
+		(const uint8_t *) "fvde" };
+
+	size_t password_sizes[ 3 ] = {
+		8, 8, 4 };
+
+	libcerror_error_t *error                                 = NULL;
+	libfvde_passphrase_wrapped_kek_t *passphrase_wrapped_kek = NULL;
+	int password_index                                       = -1;
+	int result                                               = 0;
+
+	/* Initialize test
+	 */
+	result = libfvde_passphrase_wrapped_kek_initialize(
+	          &passphrase_wrapped_kek,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "passphrase_wrapped_kek",
+	 passphrase_wrapped_kek );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_copy(
+	 passphrase_wrapped_kek->salt,
+	 salt,
+	 16 );
+
+	memory_copy(
+	 passphrase_wrapped_kek->wrapped_kek,
+	 wrapped_kek,
+	 24 );
+
+	passphrase_wrapped_kek->number_of_iterations = 41000;
+
+	/* Test regular cases
+	 */
+	result = libfvde_passphrase_wrapped_kek_check_passwords(
+	          passphrase_wrapped_kek,
+	          passwords,
+	          password_sizes,
+	          3,
+	          &password_index,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "password_index",
+	 password_index,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	password_index = -1;
+
+	result = libfvde_passphrase_wrapped_kek_check_passwords(
+	          passphrase_wrapped_kek,
+	          &( passwords[ 2 ] ),
+	          &( password_sizes[ 2 ] ),
+	          1,
+	          &password_index,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "password_index",
+	 password_index,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfvde_passphrase_wrapped_kek_check_passwords(
+	          NULL,
+	          passwords,
+	          password_sizes,
+	          3,
+	          &password_index,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_passphrase_wrapped_kek_check_passwords(
+	          passphrase_wrapped_kek,
+	          NULL,
+	          password_sizes,
+	          3,
+	          &password_index,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_passphrase_wrapped_kek_check_passwords(
+	          passphrase_wrapped_kek,
+	          passwords,
+	          NULL,
+	          3,
+	          &password_index,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_passphrase_wrapped_kek_check_passwords(
+	          passphrase_wrapped_kek,
+	          passwords,
+	          password_sizes,
+	          0,
+	          &password_index,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_passphrase_wrapped_kek_check_passwords(
+	          passphrase_wrapped_kek,
+	          passwords,
+	          password_sizes,
+	          3,
+	          NULL,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfvde_passphrase_wrapped_kek_free(
+	          &passphrase_wrapped_kek,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "passphrase_wrapped_kek",
+	 passphrase_wrapped_kek );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( passphrase_wrapped_kek != NULL )
+	{
+		libfvde_passphrase_wrapped_kek_free(
+		 &passphrase_wrapped_kek,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FVDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FVDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FVDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FVDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	FVDE_TEST_UNREFERENCED_PARAMETER( argc )
+	FVDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( HAVE_DEBUG_OUTPUT ) && defined( FVDE_TEST_PASSPHRASE_WRAPPED_KEK_VERBOSE )
+	libfvde_notify_set_verbose(
+	 1 );
+	libfvde_notify_set_stream(
+	 stderr,
+	 NULL );
+#endif
+
+#if defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT )
+
+	FVDE_TEST_RUN(
+	 "libfvde_passphrase_wrapped_kek_initialize",
+	 fvde_test_passphrase_wrapped_kek_initialize );
+
+	FVDE_TEST_RUN(
+	 "libfvde_passphrase_wrapped_kek_free",
+	 fvde_test_passphrase_wrapped_kek_free );
+
+	FVDE_TEST_RUN(
+	 "libfvde_passphrase_wrapped_kek_read_data",
+	 fvde_test_passphrase_wrapped_kek_read_data );
+
+	FVDE_TEST_RUN(
+	 "libfvde_passphrase_wrapped_kek_check_passwords",
+	 fvde_test_passphrase_wrapped_kek_check_passwords );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
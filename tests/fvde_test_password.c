@@ -0,0 +1,571 @@
+/*
+ * Library password functions test program
+ *
+ * Copyright (C) 2011-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fvde_test_libcerror.h"
+#include "fvde_test_libfvde.h"
+#include "fvde_test_macros.h"
+#include "fvde_test_unused.h"
+
+#include "../libfvde/libfvde_password.h"
+
+#if defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT )
+
+/* Tests libfvde_password_pbkdf2 against a known answer
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_password_pbkdf2_known_answer(
+     const char *password,
+     const char *salt,
+     uint32_t number_of_iterations,
+     const uint8_t *expected_key,
+     size_t key_size )
+{
+	uint8_t key[ 64 ];
+
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	result = libfvde_password_pbkdf2(
+	          (uint8_t *) password,
+	          narrow_string_length(
+	           password ),
+	          (uint8_t *) salt,
+	          narrow_string_length(
+	           salt ),
+	          number_of_iterations,
+	          key,
+	          key_size,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          key,
+	          expected_key,
+	          key_size );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfvde_password_pbkdf2 function
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_password_pbkdf2(
+     void )
+{
+	/* PBKDF2-HMAC-SHA256 test vectors from RFC 7914 and common RFC 6070 style vectors
+	 */
+	uint8_t expected_key1[ 64 ] = {
+		0x55, 0xac, 0x04, 0x6e, 0x56, 0xe3, 0x08, 0x9f, 0xec, 0x16, 0x91, 0xc2, 0x25, 0x44, 0xb6, 0x05,
+		0xf9, 0x41, 0x85, 0x21, 0x6d, 0xde, 0x04, 0x65, 0xe6, 0x8b, 0x9d, 0x57, 0xc2, 0x0d, 0xac, 0xbc,
+		0x49, 0xca, 0x9c, 0xcc, 0xf1, 0x79, 0xb6, 0x45, 0x99, 0x16, 0x64, 0xb3, 0x9d, 0x77, 0xef, 0x31,
+		0x7c, 0x71, 0xb8, 0x45, 0xb1, 0xe3, 0x0b, 0xd5, 0x09, 0x11, 0x20, 0x41, 0xd3, 0xa1, 0x97, 0x83 };
+
+	uint8_t expected_key2[ 32 ] = {
+		0x12, 0x0f, 0xb6, 0xcf, 0xfc, 0xf8, 0xb3, 0x2c, 0x43, 0xe7, 0x22, 0x52, 0x56, 0xc4, 0xf8, 0x37,
+		0xa8, 0x65, 0x48, 0xc9, 0x2c, 0xcc, 0x35, 0x48, 0x08, 0x05, 0x98, 0x7c, 0xb7, 0x0b, 0xe1, 0x7b };
+
+	uint8_t expected_key3[ 32 ] = {
+		0xae, 0x4d, 0x0c, 0x95, 0xaf, 0x6b, 0x46, 0xd3, 0x2d, 0x0a, 0xdf, 0xf9, 0x28, 0xf0, 0x6d, 0xd0,
+		0x2a, 0x30, 0x3f, 0x8e, 0xf3, 0xc2, 0x51, 0xdf, 0xd6, 0xe2, 0xd8, 0x5a, 0x95, 0x47, 0x4c, 0x43 };
+
+	uint8_t expected_key4[ 32 ] = {
+		0xc5, 0xe4, 0x78, 0xd5, 0x92, 0x88, 0xc8, 0x41, 0xaa, 0x53, 0x0d, 0xb6, 0x84, 0x5c, 0x4c, 0x8d,
+		0x96, 0x28, 0x93, 0xa0, 0x01, 0xce, 0x4e, 0x11, 0xa4, 0x96, 0x38, 0x73, 0xaa, 0x98, 0x13, 0x4a };
+
+	uint8_t expected_key5[ 40 ] = {
+		0x34, 0x8c, 0x89, 0xdb, 0xcb, 0xd3, 0x2b, 0x2f, 0x32, 0xd8, 0x14, 0xb8, 0x11, 0x6e, 0x84, 0xcf,
+		0x2b, 0x17, 0x34, 0x7e, 0xbc, 0x18, 0x00, 0x18, 0x1c, 0x4e, 0x2a, 0x1f, 0xb8, 0xdd, 0x53, 0xe1,
+		0xc6, 0x35, 0x51, 0x8c, 0x7d, 0xac, 0x47, 0xe9 };
+
+	/* A password larger than the SHA256 block size is hashed before use as HMAC key
+	 */
+	uint8_t expected_key6[ 32 ] = {
+		0xd4, 0x3a, 0x18, 0xcd, 0x77, 0xba, 0xfc, 0x1a, 0x4b, 0x0c, 0x60, 0x25, 0xdb, 0xbf, 0x29, 0xc7,
+		0xe6, 0xd6, 0x7a, 0xcc, 0xe6, 0xad, 0x02, 0xa7, 0x36, 0xd4, 0xa3, 0x00, 0x3b, 0x6a, 0x3c, 0x26 };
+
+	uint8_t key[ 32 ];
+
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = fvde_test_password_pbkdf2_known_answer(
+	          "passwd",
+	          "salt",
+	          1,
+	          expected_key1,
+	          64 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = fvde_test_password_pbkdf2_known_answer(
+	          "password",
+	          "salt",
+	          1,
+	          expected_key2,
+	          32 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = fvde_test_password_pbkdf2_known_answer(
+	          "password",
+	          "salt",
+	          2,
+	          expected_key3,
+	          32 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = fvde_test_password_pbkdf2_known_answer(
+	          "password",
+	          "salt",
+	          4096,
+	          expected_key4,
+	          32 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = fvde_test_password_pbkdf2_known_answer(
+	          "passwordPASSWORDpassword",
+	          "saltSALTsaltSALTsaltSALTsaltSALTsalt",
+	          4096,
+	          expected_key5,
+	          40 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = fvde_test_password_pbkdf2_known_answer(
+	          "xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx"
+	          "xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx",
+	          "salt",
+	          2,
+	          expected_key6,
+	          32 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test error cases
+	 */
+	result = libfvde_password_pbkdf2(
+	          NULL,
+	          8,
+	          (uint8_t *) "salt",
+	          4,
+	          1,
+	          key,
+	          32,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_password_pbkdf2(
+	          (uint8_t *) "password",
+	          8,
+	          NULL,
+	          4,
+	          1,
+	          key,
+	          32,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_password_pbkdf2(
+	          (uint8_t *) "password",
+	          8,
+	          (uint8_t *) "salt",
+	          4,
+	          0,
+	          key,
+	          32,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_password_pbkdf2(
+	          (uint8_t *) "password",
+	          8,
+	          (uint8_t *) "salt",
+	          4,
+	          1,
+	          NULL,
+	          32,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfvde_password_pbkdf2_batch function
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_password_pbkdf2_batch(
+     void )
+{
+	uint8_t expected_key[ 40 ];
+	uint8_t keys[ 19 * 40 ];
+	uint8_t password_data[ 19 * 80 ];
+
+	const uint8_t *passwords[ 19 ];
+	size_t password_sizes[ 19 ];
+
+	libcerror_error_t *error = NULL;
+	int password_index       = 0;
+	int result               = 0;
+
+	/* Use more passwords than the widest number of lanes, with sizes
+	 * that include an empty password and passwords larger than the SHA256 block size
+	 */
+	for( password_index = 0;
+	     password_index < 19;
+	     password_index++ )
+	{
+		passwords[ password_index ]      = &( password_data[ password_index * 80 ] );
+		password_sizes[ password_index ] = (size_t) ( password_index * 80 ) / 18;
+
+		memory_set(
+		 &( password_data[ password_index * 80 ] ),
+		 'a' + password_index,
+		 80 );
+	}
+	/* Test regular cases
+	 */
+	result = libfvde_password_pbkdf2_batch(
+	          passwords,
+	          password_sizes,
+	          19,
+	          (uint8_t *) "saltSALTsaltSALT",
+	          16,
+	          3,
+	          keys,
+	          19 * 40,
+	          40,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( password_index = 0;
+	     password_index < 19;
+	     password_index++ )
+	{
+		result = libfvde_password_pbkdf2(
+		          passwords[ password_index ],
+		          password_sizes[ password_index ],
+		          (uint8_t *) "saltSALTsaltSALT",
+		          16,
+		          3,
+		          expected_key,
+		          40,
+		          &error );
+
+		FVDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FVDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          &( keys[ password_index * 40 ] ),
+		          expected_key,
+		          40 );
+
+		FVDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Test with a salt that does not fit in a single block
+	 */
+	result = libfvde_password_pbkdf2_batch(
+	          passwords,
+	          password_sizes,
+	          3,
+	          password_data,
+	          60,
+	          2,
+	          keys,
+	          3 * 32,
+	          32,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfvde_password_pbkdf2(
+	          passwords[ 2 ],
+	          password_sizes[ 2 ],
+	          password_data,
+	          60,
+	          2,
+	          expected_key,
+	          32,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = memory_compare(
+	          &( keys[ 2 * 32 ] ),
+	          expected_key,
+	          32 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libfvde_password_pbkdf2_batch(
+	          NULL,
+	          password_sizes,
+	          19,
+	          (uint8_t *) "salt",
+	          4,
+	          1,
+	          keys,
+	          19 * 40,
+	          40,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_password_pbkdf2_batch(
+	          passwords,
+	          password_sizes,
+	          19,
+	          (uint8_t *) "salt",
+	          4,
+	          1,
+	          keys,
+	          18 * 40,
+	          40,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_password_pbkdf2_batch(
+	          passwords,
+	          password_sizes,
+	          19,
+	          (uint8_t *) "salt",
+	          4,
+	          0,
+	          keys,
+	          19 * 40,
+	          40,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FVDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FVDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FVDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FVDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	FVDE_TEST_UNREFERENCED_PARAMETER( argc )
+	FVDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT )
+
+	FVDE_TEST_RUN(
+	 "libfvde_password_pbkdf2",
+	 fvde_test_password_pbkdf2 );
+
+	FVDE_TEST_RUN(
+	 "libfvde_password_pbkdf2_batch",
+	 fvde_test_password_pbkdf2_batch );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
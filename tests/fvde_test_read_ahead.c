@@ -0,0 +1,597 @@
+/*
+ * Library read_ahead type test program
+ *
+ * Copyright (C) 2011-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fvde_test_libbfio.h"
+#include "fvde_test_libcerror.h"
+#include "fvde_test_libfvde.h"
+#include "fvde_test_macros.h"
+#include "fvde_test_memory.h"
+#include "fvde_test_unused.h"
+
+#include "../libfvde/libfvde_io_handle.h"
+#include "../libfvde/libfvde_libcaes.h"
+#include "../libfvde/libfvde_read_ahead.h"
+
+#if defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT ) && defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+
+/* Tests the libfvde_read_ahead_free function
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_read_ahead_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libfvde_read_ahead_free(
+	          NULL,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfvde_read_ahead_read_buffer and libfvde_read_ahead_update functions
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_read_ahead_read_buffer(
+     void )
+{
+	uint8_t buffer[ 4 * 512 ];
+	uint8_t encrypted_data[ 18 * 512 ];
+	uint8_t key_data[ 32 ];
+	uint8_t plain_text_data[ 16 * 512 ];
+
+	libbfio_handle_t *file_io_handle       = NULL;
+	libcaes_tweaked_context_t *xts_context = NULL;
+	libcerror_error_t *error               = NULL;
+	libfvde_io_handle_t *io_handle         = NULL;
+	libfvde_read_ahead_t *read_ahead       = NULL;
+	size_t data_offset                     = 0;
+	ssize_t read_count                     = 0;
+	int result                             = 0;
+
+	/* Initialize test
+	 */
+	for( data_offset = 0;
+	     data_offset < 32;
+	     data_offset++ )
+	{
+		key_data[ data_offset ] = (uint8_t) ( ( data_offset * 3 ) + 11 );
+	}
+	for( data_offset = 0;
+	     data_offset < 16 * 512;
+	     data_offset++ )
+	{
+		plain_text_data[ data_offset ] = (uint8_t) ( data_offset % 239 );
+	}
+	result = libcaes_tweaked_context_initialize(
+	          &xts_context,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcaes_tweaked_context_set_keys(
+	          xts_context,
+	          LIBCAES_CRYPT_MODE_ENCRYPT,
+	          key_data,
+	          128,
+	          &( key_data[ 16 ] ),
+	          128,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The logical volume starts at sector 2 and contains 16 sectors
+	 */
+	memory_set(
+	 encrypted_data,
+	 0,
+	 18 * 512 );
+
+	result = libcaes_crypt_xts_data_units(
+	          xts_context,
+	          LIBCAES_CRYPT_MODE_ENCRYPT,
+	          0,
+	          512,
+	          plain_text_data,
+	          16 * 512,
+	          &( encrypted_data[ 2 * 512 ] ),
+	          16 * 512,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcaes_tweaked_context_free(
+	          &xts_context,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfvde_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	io_handle->bytes_per_sector      = 512;
+	io_handle->sector_data_size      = 2 * 512;
+	io_handle->logical_volume_offset = 2 * 512;
+	io_handle->logical_volume_size   = 16 * 512;
+	io_handle->is_encrypted          = 1;
+
+	result = libbfio_memory_range_initialize(
+	          &file_io_handle,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_memory_range_set(
+	          file_io_handle,
+	          encrypted_data,
+	          18 * 512,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_open(
+	          file_io_handle,
+	          LIBBFIO_OPEN_READ,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfvde_read_ahead_initialize(
+	          &read_ahead,
+	          io_handle,
+	          file_io_handle,
+	          key_data,
+	          &( key_data[ 16 ] ),
+	          4 * 512,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "read_ahead",
+	 read_ahead );
+
+	/* Test regular cases
+	 */
+	read_count = libfvde_read_ahead_read_buffer(
+	              read_ahead,
+	              0,
+	              buffer,
+	              512,
+	              &error );
+
+	FVDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfvde_read_ahead_update(
+	          read_ahead,
+	          0,
+	          512,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The second sequential read schedules the windows that follow it
+	 */
+	result = libfvde_read_ahead_update(
+	          read_ahead,
+	          512,
+	          512,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libfvde_read_ahead_read_buffer(
+	              read_ahead,
+	              2 * 512,
+	              buffer,
+	              4 * 512,
+	              &error );
+
+	FVDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 4 * 512 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          buffer,
+	          &( plain_text_data[ 2 * 512 ] ),
+	          4 * 512 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	read_count = libfvde_read_ahead_read_buffer(
+	              read_ahead,
+	              15 * 512,
+	              buffer,
+	              512,
+	              &error );
+
+	FVDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfvde_read_ahead_initialize(
+	          NULL,
+	          io_handle,
+	          file_io_handle,
+	          key_data,
+	          &( key_data[ 16 ] ),
+	          4 * 512,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_read_ahead_initialize(
+	          &read_ahead,
+	          io_handle,
+	          file_io_handle,
+	          key_data,
+	          &( key_data[ 16 ] ),
+	          4 * 512,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libfvde_read_ahead_read_buffer(
+	              NULL,
+	              0,
+	              buffer,
+	              512,
+	              &error );
+
+	FVDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libfvde_read_ahead_read_buffer(
+	              read_ahead,
+	              0,
+	              NULL,
+	              512,
+	              &error );
+
+	FVDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_read_ahead_update(
+	          NULL,
+	          0,
+	          512,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfvde_read_ahead_free(
+	          &read_ahead,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "read_ahead",
+	 read_ahead );
+
+	result = libbfio_handle_close(
+	          file_io_handle,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_free(
+	          &file_io_handle,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfvde_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_ahead != NULL )
+	{
+		libfvde_read_ahead_free(
+		 &read_ahead,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libfvde_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	if( xts_context != NULL )
+	{
+		libcaes_tweaked_context_free(
+		 &xts_context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT ) && defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FVDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FVDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FVDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FVDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	FVDE_TEST_UNREFERENCED_PARAMETER( argc )
+	FVDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT ) && defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+
+	/* TODO: add tests for libfvde_read_ahead_initialize */
+
+	FVDE_TEST_RUN(
+	 "libfvde_read_ahead_free",
+	 fvde_test_read_ahead_free );
+
+	/* TODO: add tests for libfvde_read_ahead_read_window */
+
+	FVDE_TEST_RUN(
+	 "libfvde_read_ahead_read_buffer",
+	 fvde_test_read_ahead_read_buffer );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT ) && defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT ) && defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT ) && defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT ) */
+}
+
@@ -0,0 +1,764 @@
+/*
+ * Library read_batch type test program
+ *
+ * Copyright (C) 2011-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fvde_test_libcerror.h"
+#include "fvde_test_libfvde.h"
+#include "fvde_test_macros.h"
+#include "fvde_test_memory.h"
+#include "fvde_test_unused.h"
+
+#include "../libfvde/libfvde_io_handle.h"
+#include "../libfvde/libfvde_read_batch.h"
+
+#if defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT )
+
+/* Tests the libfvde_read_batch_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_read_batch_initialize(
+     void )
+{
+	libcerror_error_t *error         = NULL;
+	libfvde_read_batch_t *read_batch = NULL;
+	int result                       = 0;
+
+#if defined( HAVE_FVDE_TEST_MEMORY )
+	int number_of_malloc_fail_tests  = 3;
+	int number_of_memset_fail_tests  = 1;
+	int test_number                  = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libfvde_read_batch_initialize(
+	          &read_batch,
+	          8,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "read_batch",
+	 read_batch );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfvde_read_batch_free(
+	          &read_batch,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "read_batch",
+	 read_batch );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfvde_read_batch_initialize(
+	          NULL,
+	          8,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_batch = (libfvde_read_batch_t *) 0x12345678UL;
+
+	result = libfvde_read_batch_initialize(
+	          &read_batch,
+	          8,
+	          &error );
+
+	read_batch = NULL;
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_read_batch_initialize(
+	          &read_batch,
+	          0,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_FVDE_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfvde_read_batch_initialize with malloc failing
+		 */
+		fvde_test_malloc_attempts_before_fail = test_number;
+
+		result = libfvde_read_batch_initialize(
+		          &read_batch,
+		          8,
+		          &error );
+
+		if( fvde_test_malloc_attempts_before_fail != -1 )
+		{
+			fvde_test_malloc_attempts_before_fail = -1;
+
+			if( read_batch != NULL )
+			{
+				libfvde_read_batch_free(
+				 &read_batch,
+				 NULL );
+			}
+		}
+		else
+		{
+			FVDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FVDE_TEST_ASSERT_IS_NULL(
+			 "read_batch",
+			 read_batch );
+
+			FVDE_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfvde_read_batch_initialize with memset failing
+		 */
+		fvde_test_memset_attempts_before_fail = test_number;
+
+		result = libfvde_read_batch_initialize(
+		          &read_batch,
+		          8,
+		          &error );
+
+		if( fvde_test_memset_attempts_before_fail != -1 )
+		{
+			fvde_test_memset_attempts_before_fail = -1;
+
+			if( read_batch != NULL )
+			{
+				libfvde_read_batch_free(
+				 &read_batch,
+				 NULL );
+			}
+		}
+		else
+		{
+			FVDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FVDE_TEST_ASSERT_IS_NULL(
+			 "read_batch",
+			 read_batch );
+
+			FVDE_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_FVDE_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_batch != NULL )
+	{
+		libfvde_read_batch_free(
+		 &read_batch,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfvde_read_batch_free function
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_read_batch_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libfvde_read_batch_free(
+	          NULL,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfvde_read_batch_set_requests function
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_read_batch_set_requests(
+     void )
+{
+	off64_t offsets[ 6 ]             = { 5000, 0, 20480, 41000, 50000, 100 };
+	size_t sizes[ 6 ]                = { 100, 4096, 10, 1000, 10, 0 };
+	ssize_t read_counts[ 6 ];
+
+	libcerror_error_t *error         = NULL;
+	libfvde_io_handle_t *io_handle   = NULL;
+	libfvde_read_batch_t *read_batch = NULL;
+	off64_t invalid_offsets[ 1 ]     = { -1 };
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = libfvde_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	io_handle->sector_data_size      = 4096;
+	io_handle->logical_volume_offset = 8192;
+	io_handle->logical_volume_size   = ( 10 * 4096 ) + 100;
+
+	result = libfvde_read_batch_initialize(
+	          &read_batch,
+	          6,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "read_batch",
+	 read_batch );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfvde_read_batch_set_requests(
+	          read_batch,
+	          io_handle,
+	          offsets,
+	          sizes,
+	          read_counts,
+	          6,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FVDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_counts[ 0 ]",
+	 read_counts[ 0 ],
+	 (ssize_t) 100 );
+
+	FVDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_counts[ 1 ]",
+	 read_counts[ 1 ],
+	 (ssize_t) 4096 );
+
+	FVDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_counts[ 2 ]",
+	 read_counts[ 2 ],
+	 (ssize_t) 10 );
+
+	FVDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_counts[ 3 ]",
+	 read_counts[ 3 ],
+	 (ssize_t) 60 );
+
+	FVDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_counts[ 4 ]",
+	 read_counts[ 4 ],
+	 (ssize_t) 0 );
+
+	FVDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_counts[ 5 ]",
+	 read_counts[ 5 ],
+	 (ssize_t) 0 );
+
+	/* Requests that are empty or beyond the end of the logical volume have no entry
+	 */
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "read_batch->number_of_entries",
+	 read_batch->number_of_entries,
+	 4 );
+
+	/* The requests at offsets 0 and 5000 are adjacent and are coalesced
+	 */
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "read_batch->number_of_ranges",
+	 read_batch->number_of_ranges,
+	 3 );
+
+	FVDE_TEST_ASSERT_EQUAL_UINT64(
+	 "read_batch->maximum_range_size",
+	 (uint64_t) read_batch->maximum_range_size,
+	 (uint64_t) 8192 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT64(
+	 "read_batch->ranges[ 0 ].offset",
+	 (int64_t) read_batch->ranges[ 0 ].offset,
+	 (int64_t) 0 );
+
+	FVDE_TEST_ASSERT_EQUAL_UINT64(
+	 "read_batch->ranges[ 0 ].size",
+	 (uint64_t) read_batch->ranges[ 0 ].size,
+	 (uint64_t) 8192 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT64(
+	 "read_batch->ranges[ 0 ].physical_offset",
+	 (int64_t) read_batch->ranges[ 0 ].physical_offset,
+	 (int64_t) 8192 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "read_batch->ranges[ 0 ].first_entry_index",
+	 read_batch->ranges[ 0 ].first_entry_index,
+	 0 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "read_batch->ranges[ 0 ].number_of_entries",
+	 read_batch->ranges[ 0 ].number_of_entries,
+	 2 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT64(
+	 "read_batch->ranges[ 1 ].offset",
+	 (int64_t) read_batch->ranges[ 1 ].offset,
+	 (int64_t) 20480 );
+
+	FVDE_TEST_ASSERT_EQUAL_UINT64(
+	 "read_batch->ranges[ 1 ].size",
+	 (uint64_t) read_batch->ranges[ 1 ].size,
+	 (uint64_t) 4096 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT64(
+	 "read_batch->ranges[ 1 ].physical_offset",
+	 (int64_t) read_batch->ranges[ 1 ].physical_offset,
+	 (int64_t) 28672 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "read_batch->ranges[ 1 ].first_entry_index",
+	 read_batch->ranges[ 1 ].first_entry_index,
+	 2 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "read_batch->ranges[ 1 ].number_of_entries",
+	 read_batch->ranges[ 1 ].number_of_entries,
+	 1 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT64(
+	 "read_batch->ranges[ 2 ].offset",
+	 (int64_t) read_batch->ranges[ 2 ].offset,
+	 (int64_t) 40960 );
+
+	FVDE_TEST_ASSERT_EQUAL_UINT64(
+	 "read_batch->ranges[ 2 ].size",
+	 (uint64_t) read_batch->ranges[ 2 ].size,
+	 (uint64_t) 100 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT64(
+	 "read_batch->ranges[ 2 ].physical_offset",
+	 (int64_t) read_batch->ranges[ 2 ].physical_offset,
+	 (int64_t) 49152 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "read_batch->ranges[ 2 ].first_entry_index",
+	 read_batch->ranges[ 2 ].first_entry_index,
+	 3 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "read_batch->ranges[ 2 ].number_of_entries",
+	 read_batch->ranges[ 2 ].number_of_entries,
+	 1 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "read_batch->entries[ 0 ].request_index",
+	 read_batch->entries[ 0 ].request_index,
+	 1 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "read_batch->entries[ 1 ].request_index",
+	 read_batch->entries[ 1 ].request_index,
+	 0 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "read_batch->entries[ 2 ].request_index",
+	 read_batch->entries[ 2 ].request_index,
+	 2 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "read_batch->entries[ 3 ].request_index",
+	 read_batch->entries[ 3 ].request_index,
+	 3 );
+
+	/* Test error cases
+	 */
+	result = libfvde_read_batch_set_requests(
+	          NULL,
+	          io_handle,
+	          offsets,
+	          sizes,
+	          read_counts,
+	          6,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_read_batch_set_requests(
+	          read_batch,
+	          NULL,
+	          offsets,
+	          sizes,
+	          read_counts,
+	          6,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_read_batch_set_requests(
+	          read_batch,
+	          io_handle,
+	          NULL,
+	          sizes,
+	          read_counts,
+	          6,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_read_batch_set_requests(
+	          read_batch,
+	          io_handle,
+	          offsets,
+	          NULL,
+	          read_counts,
+	          6,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_read_batch_set_requests(
+	          read_batch,
+	          io_handle,
+	          offsets,
+	          sizes,
+	          NULL,
+	          6,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_read_batch_set_requests(
+	          read_batch,
+	          io_handle,
+	          offsets,
+	          sizes,
+	          read_counts,
+	          7,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_read_batch_set_requests(
+	          read_batch,
+	          io_handle,
+	          invalid_offsets,
+	          sizes,
+	          read_counts,
+	          1,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfvde_read_batch_free(
+	          &read_batch,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "read_batch",
+	 read_batch );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfvde_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_batch != NULL )
+	{
+		libfvde_read_batch_free(
+		 &read_batch,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libfvde_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FVDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FVDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FVDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FVDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	FVDE_TEST_UNREFERENCED_PARAMETER( argc )
+	FVDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT )
+
+	FVDE_TEST_RUN(
+	 "libfvde_read_batch_initialize",
+	 fvde_test_read_batch_initialize );
+
+	FVDE_TEST_RUN(
+	 "libfvde_read_batch_free",
+	 fvde_test_read_batch_free );
+
+	FVDE_TEST_RUN(
+	 "libfvde_read_batch_set_requests",
+	 fvde_test_read_batch_set_requests );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -20,19 +20,24 @@
  */
 
 #include <common.h>
+#include <byte_stream.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
 #include <stdlib.h>
 #endif
 
+#include "fvde_test_libbfio.h"
 #include "fvde_test_libcerror.h"
 #include "fvde_test_libfvde.h"
 #include "fvde_test_macros.h"
 #include "fvde_test_memory.h"
 #include "fvde_test_unused.h"
 
+#include "../libfvde/libfvde_io_handle.h"
+#include "../libfvde/libfvde_libcaes.h"
 #include "../libfvde/libfvde_sector_data.h"
 
 #if defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT )
@@ -75,6 +80,387 @@ on_error:
 	return( 0 );
 }
 
+
+/* Tests the libfvde_sector_data_read function
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_sector_data_read(
+     void )
+{
+	uint8_t encrypted_data[ 8 * 512 ];
+	uint8_t key_data[ 32 ];
+	uint8_t plain_text_data[ 4 * 512 ];
+	uint8_t tweak_value[ 16 ];
+
+	libbfio_handle_t *file_io_handle       = NULL;
+	libcaes_tweaked_context_t *xts_context = NULL;
+	libcerror_error_t *error               = NULL;
+	libfvde_io_handle_t *io_handle         = NULL;
+	libfvde_sector_data_t *sector_data     = NULL;
+	size_t data_offset                     = 0;
+	uint64_t sector_number                 = 0;
+	int result                             = 0;
+
+	/* Initialize test
+	 */
+	for( data_offset = 0;
+	     data_offset < 32;
+	     data_offset++ )
+	{
+		key_data[ data_offset ] = (uint8_t) ( ( data_offset * 7 ) + 1 );
+	}
+	for( data_offset = 0;
+	     data_offset < 4 * 512;
+	     data_offset++ )
+	{
+		plain_text_data[ data_offset ] = (uint8_t) ( data_offset % 251 );
+	}
+	result = libcaes_tweaked_context_initialize(
+	          &xts_context,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcaes_tweaked_context_set_keys(
+	          xts_context,
+	          LIBCAES_CRYPT_MODE_ENCRYPT,
+	          key_data,
+	          128,
+	          &( key_data[ 16 ] ),
+	          128,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Encrypt sectors 3 to 6 each with their own sector number as tweak value
+	 */
+	memory_set(
+	 encrypted_data,
+	 0,
+	 8 * 512 );
+
+	for( sector_number = 3;
+	     sector_number < 7;
+	     sector_number++ )
+	{
+		memory_set(
+		 tweak_value,
+		 0,
+		 16 );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 tweak_value,
+		 sector_number );
+
+		result = libcaes_crypt_xts(
+		          xts_context,
+		          LIBCAES_CRYPT_MODE_ENCRYPT,
+		          tweak_value,
+		          16,
+		          &( plain_text_data[ ( sector_number - 3 ) * 512 ] ),
+		          512,
+		          &( encrypted_data[ sector_number * 512 ] ),
+		          512,
+		          &error );
+
+		FVDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FVDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libcaes_tweaked_context_set_keys(
+	          xts_context,
+	          LIBCAES_CRYPT_MODE_DECRYPT,
+	          key_data,
+	          128,
+	          &( key_data[ 16 ] ),
+	          128,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfvde_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	io_handle->bytes_per_sector      = 512;
+	io_handle->logical_volume_offset = 0;
+	io_handle->is_encrypted          = 1;
+
+	result = libbfio_memory_range_initialize(
+	          &file_io_handle,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_memory_range_set(
+	          file_io_handle,
+	          encrypted_data,
+	          8 * 512,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_open(
+	          file_io_handle,
+	          LIBBFIO_OPEN_READ,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfvde_sector_data_initialize(
+	          &sector_data,
+	          4 * 512,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "sector_data",
+	 sector_data );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfvde_sector_data_read(
+	          sector_data,
+	          io_handle,
+	          file_io_handle,
+	          3 * 512,
+	          xts_context,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          sector_data->data,
+	          plain_text_data,
+	          4 * 512 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libfvde_sector_data_read(
+	          NULL,
+	          io_handle,
+	          file_io_handle,
+	          3 * 512,
+	          xts_context,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_sector_data_read(
+	          sector_data,
+	          NULL,
+	          file_io_handle,
+	          3 * 512,
+	          xts_context,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfvde_sector_data_free(
+	          &sector_data,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_close(
+	          file_io_handle,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_free(
+	          &file_io_handle,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfvde_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcaes_tweaked_context_free(
+	          &xts_context,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( sector_data != NULL )
+	{
+		libfvde_sector_data_free(
+		 &sector_data,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libfvde_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	if( xts_context != NULL )
+	{
+		libcaes_tweaked_context_free(
+		 &xts_context,
+		 NULL );
+	}
+	return( 0 );
+}
 #endif /* defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT ) */
 
 /* The main program
@@ -100,7 +486,9 @@ int main(
 	 "libfvde_sector_data_free",
 	 fvde_test_sector_data_free );
 
-	/* TODO: add tests for libfvde_sector_data_read */
+	FVDE_TEST_RUN(
+	 "libfvde_sector_data_read",
+	 fvde_test_sector_data_read );
 
 #endif /* defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT ) */
 
@@ -0,0 +1,724 @@
+/*
+ * Library sector_data_pool type test program
+ *
+ * Copyright (C) 2011-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fvde_test_libcerror.h"
+#include "fvde_test_libfvde.h"
+#include "fvde_test_macros.h"
+#include "fvde_test_memory.h"
+#include "fvde_test_unused.h"
+
+#include "../libfvde/libfvde_definitions.h"
+#include "../libfvde/libfvde_sector_data.h"
+#include "../libfvde/libfvde_sector_data_pool.h"
+
+#if defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT )
+
+/* Tests the libfvde_sector_data_pool_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_sector_data_pool_initialize(
+     void )
+{
+	libcerror_error_t *error                     = NULL;
+	libfvde_sector_data_pool_t *sector_data_pool = NULL;
+	int result                                   = 0;
+
+#if defined( HAVE_FVDE_TEST_MEMORY )
+	int number_of_malloc_fail_tests              = 2;
+	int number_of_memset_fail_tests              = 1;
+	int test_number                              = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libfvde_sector_data_pool_initialize(
+	          &sector_data_pool,
+	          4096,
+	          16,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "sector_data_pool",
+	 sector_data_pool );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfvde_sector_data_pool_free(
+	          &sector_data_pool,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "sector_data_pool",
+	 sector_data_pool );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfvde_sector_data_pool_initialize(
+	          NULL,
+	          4096,
+	          16,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	sector_data_pool = (libfvde_sector_data_pool_t *) 0x12345678UL;
+
+	result = libfvde_sector_data_pool_initialize(
+	          &sector_data_pool,
+	          4096,
+	          16,
+	          &error );
+
+	sector_data_pool = NULL;
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_sector_data_pool_initialize(
+	          &sector_data_pool,
+	          0,
+	          16,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_sector_data_pool_initialize(
+	          &sector_data_pool,
+	          (size_t) SSIZE_MAX + 1,
+	          16,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_sector_data_pool_initialize(
+	          &sector_data_pool,
+	          4096,
+	          0,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_FVDE_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfvde_sector_data_pool_initialize with malloc failing
+		 */
+		fvde_test_malloc_attempts_before_fail = test_number;
+
+		result = libfvde_sector_data_pool_initialize(
+		          &sector_data_pool,
+		          4096,
+		          16,
+		          &error );
+
+		if( fvde_test_malloc_attempts_before_fail != -1 )
+		{
+			fvde_test_malloc_attempts_before_fail = -1;
+
+			if( sector_data_pool != NULL )
+			{
+				libfvde_sector_data_pool_free(
+				 &sector_data_pool,
+				 NULL );
+			}
+		}
+		else
+		{
+			FVDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FVDE_TEST_ASSERT_IS_NULL(
+			 "sector_data_pool",
+			 sector_data_pool );
+
+			FVDE_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfvde_sector_data_pool_initialize with memset failing
+		 */
+		fvde_test_memset_attempts_before_fail = test_number;
+
+		result = libfvde_sector_data_pool_initialize(
+		          &sector_data_pool,
+		          4096,
+		          16,
+		          &error );
+
+		if( fvde_test_memset_attempts_before_fail != -1 )
+		{
+			fvde_test_memset_attempts_before_fail = -1;
+
+			if( sector_data_pool != NULL )
+			{
+				libfvde_sector_data_pool_free(
+				 &sector_data_pool,
+				 NULL );
+			}
+		}
+		else
+		{
+			FVDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FVDE_TEST_ASSERT_IS_NULL(
+			 "sector_data_pool",
+			 sector_data_pool );
+
+			FVDE_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_FVDE_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( sector_data_pool != NULL )
+	{
+		libfvde_sector_data_pool_free(
+		 &sector_data_pool,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfvde_sector_data_pool_free function
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_sector_data_pool_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libfvde_sector_data_pool_free(
+	          NULL,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfvde_sector_data_pool_get_sector_data and libfvde_sector_data_pool_release_sector_data functions
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_sector_data_pool_get_sector_data(
+     void )
+{
+	libcerror_error_t *error                     = NULL;
+	libfvde_sector_data_pool_t *sector_data_pool = NULL;
+	libfvde_sector_data_t *reused_sector_data    = NULL;
+	libfvde_sector_data_t *sector_data           = NULL;
+	libfvde_sector_data_t *sector_data2          = NULL;
+	int result                                   = 0;
+
+	/* Initialize test
+	 */
+	result = libfvde_sector_data_pool_initialize(
+	          &sector_data_pool,
+	          4096,
+	          1,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfvde_sector_data_pool_get_sector_data(
+	          sector_data_pool,
+	          1024,
+	          &sector_data,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "sector_data",
+	 sector_data );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FVDE_TEST_ASSERT_EQUAL_SIZE(
+	 "sector_data->data_size",
+	 sector_data->data_size,
+	 (size_t) 1024 );
+
+	FVDE_TEST_ASSERT_EQUAL_SIZE(
+	 "sector_data->allocated_data_size",
+	 sector_data->allocated_data_size,
+	 (size_t) 4096 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "data alignment",
+	 (int) ( (intptr_t) sector_data->data % LIBFVDE_SECTOR_DATA_ALIGNMENT ),
+	 0 );
+
+	reused_sector_data = sector_data;
+
+	result = libfvde_sector_data_pool_release_sector_data(
+	          &sector_data,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "sector_data",
+	 sector_data );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test if released sector data is reused
+	 */
+	result = libfvde_sector_data_pool_get_sector_data(
+	          sector_data_pool,
+	          4096,
+	          &sector_data,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "sector_data is reused",
+	 (int) ( sector_data == reused_sector_data ),
+	 1 );
+
+	FVDE_TEST_ASSERT_EQUAL_SIZE(
+	 "sector_data->data_size",
+	 sector_data->data_size,
+	 (size_t) 4096 );
+
+	/* Test if sector data is created when no released sector data is available
+	 */
+	result = libfvde_sector_data_pool_get_sector_data(
+	          sector_data_pool,
+	          4096,
+	          &sector_data2,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "sector_data2",
+	 sector_data2 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "sector_data2 is new",
+	 (int) ( sector_data2 != sector_data ),
+	 1 );
+
+	/* Test if sector data is freed when the pool is full
+	 */
+	result = libfvde_sector_data_pool_release_sector_data(
+	          &sector_data,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfvde_sector_data_pool_release_sector_data(
+	          &sector_data2,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "sector_data2",
+	 sector_data2 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "sector_data_pool->number_of_free_sector_data",
+	 sector_data_pool->number_of_free_sector_data,
+	 1 );
+
+	/* Test releasing sector data that is not managed by a pool
+	 */
+	result = libfvde_sector_data_initialize(
+	          &sector_data,
+	          512,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfvde_sector_data_pool_release_sector_data(
+	          &sector_data,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "sector_data",
+	 sector_data );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfvde_sector_data_pool_get_sector_data(
+	          NULL,
+	          4096,
+	          &sector_data,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_sector_data_pool_get_sector_data(
+	          sector_data_pool,
+	          0,
+	          &sector_data,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_sector_data_pool_get_sector_data(
+	          sector_data_pool,
+	          8192,
+	          &sector_data,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_sector_data_pool_get_sector_data(
+	          sector_data_pool,
+	          4096,
+	          NULL,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_sector_data_pool_release_sector_data(
+	          NULL,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfvde_sector_data_pool_free(
+	          &sector_data_pool,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "sector_data_pool",
+	 sector_data_pool );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( sector_data2 != NULL )
+	{
+		libfvde_sector_data_pool_release_sector_data(
+		 &sector_data2,
+		 NULL );
+	}
+	if( sector_data != NULL )
+	{
+		libfvde_sector_data_pool_release_sector_data(
+		 &sector_data,
+		 NULL );
+	}
+	if( sector_data_pool != NULL )
+	{
+		libfvde_sector_data_pool_free(
+		 &sector_data_pool,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FVDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FVDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FVDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FVDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	FVDE_TEST_UNREFERENCED_PARAMETER( argc )
+	FVDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT )
+
+	FVDE_TEST_RUN(
+	 "libfvde_sector_data_pool_initialize",
+	 fvde_test_sector_data_pool_initialize );
+
+	FVDE_TEST_RUN(
+	 "libfvde_sector_data_pool_free",
+	 fvde_test_sector_data_pool_free );
+
+	FVDE_TEST_RUN(
+	 "libfvde_sector_data_pool_get_sector_data",
+	 fvde_test_sector_data_pool_get_sector_data );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
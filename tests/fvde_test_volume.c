@@ -20,7 +20,9 @@
  */
 
 #include <common.h>
+#include <byte_stream.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <narrow_string.h>
 #include <system_string.h>
 #include <types.h>
@@ -39,6 +41,14 @@
 #include "fvde_test_memory.h"
 #include "fvde_test_unused.h"
 
+#include "../libfvde/fvde_layout.h"
+#include "../libfvde/libfvde_definitions.h"
+#include "../libfvde/libfvde_libcaes.h"
+#include "../libfvde/libfvde_libcthreads.h"
+#include "../libfvde/libfvde_read_ahead.h"
+#include "../libfvde/libfvde_read_context.h"
+#include "../libfvde/libfvde_sector_data_pool.h"
+#include "../libfvde/libfvde_sectors_cache.h"
 #include "../libfvde/libfvde_volume.h"
 
 #if !defined( LIBFVDE_HAVE_BFIO )
@@ -55,6 +65,18 @@ int libfvde_volume_open_file_io_handle(
      int access_flags,
      libfvde_error_t **error );
 
+LIBFVDE_EXTERN \
+int libfvde_volume_export_layout_file_io_handle(
+     libfvde_volume_t *volume,
+     libbfio_handle_t *file_io_handle,
+     libfvde_error_t **error );
+
+LIBFVDE_EXTERN \
+int libfvde_volume_import_layout_file_io_handle(
+     libfvde_volume_t *volume,
+     libbfio_handle_t *file_io_handle,
+     libfvde_error_t **error );
+
 #endif /* !defined( LIBFVDE_HAVE_BFIO ) */
 
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER ) && SIZEOF_WCHAR_T != 2 && SIZEOF_WCHAR_T != 4
@@ -65,6 +87,10 @@ int libfvde_volume_open_file_io_handle(
 #define FVDE_TEST_VOLUME_VERBOSE
  */
 
+/* The size of the buffer the layout is exported to
+ */
+#define FVDE_TEST_VOLUME_LAYOUT_DATA_SIZE	( 1024 * 1024 )
+
 /* Creates and opens a source volume
  * Returns 1 if successful or -1 on error
  */
@@ -1756,109 +1782,154 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libfvde_volume_seek_offset function
+/* Tests the libfvde_volume_read_buffers_at_offsets function
  * Returns 1 if successful or 0 if not
  */
-int fvde_test_volume_seek_offset(
+int fvde_test_volume_read_buffers_at_offsets(
      libfvde_volume_t *volume )
 {
+	uint8_t buffer[ 16 ];
+	uint8_t batch_data[ 3 ][ 16 ];
+
 	libcerror_error_t *error = NULL;
+	void *buffers[ 3 ]       = { NULL, NULL, NULL };
 	size64_t size            = 0;
-	off64_t offset           = 0;
+	size_t buffer_sizes[ 3 ] = { 16, 16, 16 };
+	off64_t offsets[ 3 ]     = { 0, 0, 0 };
+	ssize_t read_count       = 0;
+	ssize_t read_counts[ 3 ] = { 0, 0, 0 };
+	int buffer_index         = 0;
+	int result               = 0;
 
-	/* Test regular cases
+	/* Determine size
 	 */
-	offset = libfvde_volume_seek_offset(
+	result = libfvde_volume_get_logical_volume_size(
 	          volume,
-	          0,
-	          SEEK_END,
+	          &size,
 	          &error );
 
-	FVDE_TEST_ASSERT_NOT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	FVDE_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	size = (size64_t) offset;
+	for( buffer_index = 0;
+	     buffer_index < 3;
+	     buffer_index++ )
+	{
+		buffers[ buffer_index ] = batch_data[ buffer_index ];
+	}
+	/* Test regular cases
+	 */
+	if( size > 32 )
+	{
+		/* Read buffers out of order, on the size boundary and beyond the size boundary
+		 */
+		offsets[ 0 ] = (off64_t) size - 8;
+		offsets[ 1 ] = 16;
+		offsets[ 2 ] = (off64_t) size + 8;
 
-	offset = libfvde_volume_seek_offset(
-	          volume,
-	          1024,
-	          SEEK_SET,
-	          &error );
+		result = libfvde_volume_read_buffers_at_offsets(
+		          volume,
+		          buffers,
+		          buffer_sizes,
+		          offsets,
+		          read_counts,
+		          3,
+		          &error );
 
-	FVDE_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) 1024 );
+		FVDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
 
-	FVDE_TEST_ASSERT_IS_NULL(
-	 "error",
-	 error );
+		FVDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
 
-	offset = libfvde_volume_seek_offset(
-	          volume,
-	          -512,
-	          SEEK_CUR,
-	          &error );
+		FVDE_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_counts[ 0 ]",
+		 read_counts[ 0 ],
+		 (ssize_t) 8 );
 
-	FVDE_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) 512 );
+		FVDE_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_counts[ 1 ]",
+		 read_counts[ 1 ],
+		 (ssize_t) 16 );
 
-	FVDE_TEST_ASSERT_IS_NULL(
-	 "error",
-	 error );
+		FVDE_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_counts[ 2 ]",
+		 read_counts[ 2 ],
+		 (ssize_t) 0 );
 
-	offset = libfvde_volume_seek_offset(
-	          volume,
-	          (off64_t) ( size + 512 ),
-	          SEEK_SET,
-	          &error );
+		/* The data must match the data read by libfvde_volume_read_buffer_at_offset
+		 */
+		read_count = libfvde_volume_read_buffer_at_offset(
+		              volume,
+		              buffer,
+		              16,
+		              16,
+		              &error );
 
-	FVDE_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) ( size + 512 ) );
+		FVDE_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 16 );
 
-	FVDE_TEST_ASSERT_IS_NULL(
-	 "error",
-	 error );
+		FVDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
 
-	/* Reset offset to 0
+		result = memory_compare(
+		          batch_data[ 1 ],
+		          buffer,
+		          16 );
+
+		FVDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Test error cases
 	 */
-	offset = libfvde_volume_seek_offset(
-	          volume,
-	          0,
-	          SEEK_SET,
+	result = libfvde_volume_read_buffers_at_offsets(
+	          NULL,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          read_counts,
+	          3,
 	          &error );
 
-	FVDE_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) 0 );
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-	FVDE_TEST_ASSERT_IS_NULL(
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	/* Test error cases
-	 */
-	offset = libfvde_volume_seek_offset(
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_volume_read_buffers_at_offsets(
+	          volume,
 	          NULL,
-	          0,
-	          SEEK_SET,
+	          buffer_sizes,
+	          offsets,
+	          read_counts,
+	          3,
 	          &error );
 
-	FVDE_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	FVDE_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -1867,16 +1938,19 @@ int fvde_test_volume_seek_offset(
 	libcerror_error_free(
 	 &error );
 
-	offset = libfvde_volume_seek_offset(
+	result = libfvde_volume_read_buffers_at_offsets(
 	          volume,
-	          -1,
-	          SEEK_SET,
+	          buffers,
+	          NULL,
+	          offsets,
+	          read_counts,
+	          3,
 	          &error );
 
-	FVDE_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	FVDE_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -1885,31 +1959,40 @@ int fvde_test_volume_seek_offset(
 	libcerror_error_free(
 	 &error );
 
-	offset = libfvde_volume_seek_offset(
+	result = libfvde_volume_read_buffers_at_offsets(
 	          volume,
-	          -1,
-	          SEEK_CUR,
+	          buffers,
+	          buffer_sizes,
+	          NULL,
+	          read_counts,
+	          3,
 	          &error );
 
-	FVDE_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	FVDE_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	offset = libfvde_volume_seek_offset(
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_volume_read_buffers_at_offsets(
 	          volume,
-	          (off64_t) ( -1 * ( size + 1 ) ),
-	          SEEK_END,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          NULL,
+	          3,
 	          &error );
 
-	FVDE_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	FVDE_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -1918,51 +2001,36 @@ int fvde_test_volume_seek_offset(
 	libcerror_error_free(
 	 &error );
 
-	return( 1 );
-
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
-	return( 0 );
-}
-
-/* Tests the libfvde_volume_get_offset function
- * Returns 1 if successful or 0 if not
- */
-int fvde_test_volume_get_offset(
-     libfvde_volume_t *volume )
-{
-	libcerror_error_t *error = NULL;
-	off64_t offset           = 0;
-	int offset_is_set        = 0;
-	int result               = 0;
-
-	/* Test regular cases
-	 */
-	result = libfvde_volume_get_offset(
+	result = libfvde_volume_read_buffers_at_offsets(
 	          volume,
-	          &offset,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          read_counts,
+	          0,
 	          &error );
 
-	FVDE_TEST_ASSERT_NOT_EQUAL_INT(
+	FVDE_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
 	 -1 );
 
-	FVDE_TEST_ASSERT_IS_NULL(
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	offset_is_set = result;
+	libcerror_error_free(
+	 &error );
 
-	/* Test error cases
-	 */
-	result = libfvde_volume_get_offset(
-	          NULL,
-	          &offset,
+	offsets[ 0 ] = -1;
+
+	result = libfvde_volume_read_buffers_at_offsets(
+	          volume,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          read_counts,
+	          3,
 	          &error );
 
 	FVDE_TEST_ASSERT_EQUAL_INT(
@@ -1977,25 +2045,6 @@ int fvde_test_volume_get_offset(
 	libcerror_error_free(
 	 &error );
 
-	if( offset_is_set != 0 )
-	{
-		result = libfvde_volume_get_offset(
-		          volume,
-		          NULL,
-		          &error );
-
-		FVDE_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
-
-		FVDE_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
-
-		libcerror_error_free(
-		 &error );
-	}
 	return( 1 );
 
 on_error:
@@ -2007,40 +2056,2635 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libfvde_volume_get_logical_volume_size function
- * Returns 1 if successful or 0 if not
- */
-int fvde_test_volume_get_logical_volume_size(
-     libfvde_volume_t *volume )
-{
-	libcerror_error_t *error       = NULL;
-	size64_t logical_volume_size   = 0;
-	int logical_volume_size_is_set = 0;
-	int result                     = 0;
+#if defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT ) && defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
 
-	/* Test regular cases
+#define FVDE_TEST_VOLUME_THREADED_LOGICAL_VOLUME_OFFSET	8192
+#define FVDE_TEST_VOLUME_THREADED_LOGICAL_VOLUME_SIZE	( ( 256 * 1024 ) + 1536 )
+#define FVDE_TEST_VOLUME_THREADED_NUMBER_OF_THREADS	4
+#define FVDE_TEST_VOLUME_THREADED_NUMBER_OF_READS	256
+
+typedef struct fvde_test_volume_thread_values fvde_test_volume_thread_values_t;
+
+struct fvde_test_volume_thread_values
+{
+	/* The volume
+	 */
+	libfvde_volume_t *volume;
+
+	/* The expected (decrypted) data of the logical volume
+	 */
+	const uint8_t *expected_data;
+
+	/* The seed of the pseudo random offsets and sizes
+	 */
+	uint32_t seed;
+
+	/* The result
+	 */
+	int result;
+};
+
+/* Reads from the volume at pseudo random offsets and compares the data
+ * with the expected data, every fourth read continues where the previous read ended
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_volume_read_buffer_at_offset_positional_thread_callback(
+     void *arguments )
+{
+	uint8_t buffer[ 16384 ];
+
+	fvde_test_volume_thread_values_t *thread_values = NULL;
+	libcerror_error_t *error                        = NULL;
+	off64_t offset                                  = 0;
+	size_t expected_read_size                       = 0;
+	size_t read_size                                = 0;
+	ssize_t read_count                              = 0;
+	uint32_t seed                                   = 0;
+	int read_index                                  = 0;
+	int result                                      = 0;
+
+	thread_values = (fvde_test_volume_thread_values_t *) arguments;
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "thread_values",
+	 thread_values );
+
+	seed = thread_values->seed;
+
+	for( read_index = 0;
+	     read_index < FVDE_TEST_VOLUME_THREADED_NUMBER_OF_READS;
+	     read_index++ )
+	{
+		seed = ( seed * 1103515245UL ) + 12345;
+
+		if( ( read_index % 4 ) == 3 )
+		{
+			offset += (off64_t) read_count;
+		}
+		else
+		{
+			offset = (off64_t) ( ( seed >> 8 ) % ( FVDE_TEST_VOLUME_THREADED_LOGICAL_VOLUME_SIZE + 512 ) );
+		}
+		seed = ( seed * 1103515245UL ) + 12345;
+
+		read_size = (size_t) ( 1 + ( ( seed >> 8 ) % sizeof( buffer ) ) );
+
+		expected_read_size = 0;
+
+		if( offset < (off64_t) FVDE_TEST_VOLUME_THREADED_LOGICAL_VOLUME_SIZE )
+		{
+			expected_read_size = (size_t) ( FVDE_TEST_VOLUME_THREADED_LOGICAL_VOLUME_SIZE - offset );
+
+			if( expected_read_size > read_size )
+			{
+				expected_read_size = read_size;
+			}
+		}
+		read_count = libfvde_volume_read_buffer_at_offset_positional(
+		              thread_values->volume,
+		              buffer,
+		              read_size,
+		              offset,
+		              &error );
+
+		FVDE_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) expected_read_size );
+
+		FVDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		if( expected_read_size > 0 )
+		{
+			result = memory_compare(
+			          buffer,
+			          &( thread_values->expected_data[ offset ] ),
+			          expected_read_size );
+
+			FVDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 0 );
+		}
+	}
+	thread_values->result = 1;
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfvde_volume_read_buffer_at_offset_positional function with multiple threads
+ * The threads share the read contexts, the sectors cache and the read-ahead of the volume
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_volume_read_buffer_at_offset_positional(
+     void )
+{
+	uint8_t key[ 16 ] = {
+		0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef, 0xfe, 0xdc, 0xba, 0x98, 0x76, 0x54, 0x32, 0x10 };
+
+	uint8_t tweak_key[ 16 ] = {
+		0x0f, 0x1e, 0x2d, 0x3c, 0x4b, 0x5a, 0x69, 0x78, 0x87, 0x96, 0xa5, 0xb4, 0xc3, 0xd2, 0xe1, 0xf0 };
+
+	uint8_t buffer[ 16 ];
+	uint8_t tweak_value[ 16 ];
+
+	fvde_test_volume_thread_values_t thread_values[ FVDE_TEST_VOLUME_THREADED_NUMBER_OF_THREADS ];
+	libcthreads_thread_t *threads[ FVDE_TEST_VOLUME_THREADED_NUMBER_OF_THREADS ];
+
+	libbfio_handle_t *file_io_handle           = NULL;
+	libcaes_tweaked_context_t *xts_context     = NULL;
+	libcerror_error_t *error                   = NULL;
+	libcthreads_queue_t *read_contexts         = NULL;
+	libfvde_internal_volume_t *internal_volume = NULL;
+	libfvde_read_context_t *read_context       = NULL;
+	libfvde_volume_t *volume                   = NULL;
+	uint8_t *data                              = NULL;
+	uint8_t *expected_data                     = NULL;
+	off64_t offset                             = 0;
+	size_t data_offset                         = 0;
+	ssize_t read_count                         = 0;
+	size_t data_size                           = FVDE_TEST_VOLUME_THREADED_LOGICAL_VOLUME_OFFSET + FVDE_TEST_VOLUME_THREADED_LOGICAL_VOLUME_SIZE + 4096;
+	uint32_t seed                              = 0x12345678UL;
+	int result                                 = 0;
+	int thread_index                           = 0;
+
+	for( thread_index = 0;
+	     thread_index < FVDE_TEST_VOLUME_THREADED_NUMBER_OF_THREADS;
+	     thread_index++ )
+	{
+		threads[ thread_index ] = NULL;
+	}
+	/* Initialize test
+	 */
+	expected_data = (uint8_t *) memory_allocate(
+	                             sizeof( uint8_t ) * FVDE_TEST_VOLUME_THREADED_LOGICAL_VOLUME_SIZE );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "expected_data",
+	 expected_data );
+
+	for( data_offset = 0;
+	     data_offset < FVDE_TEST_VOLUME_THREADED_LOGICAL_VOLUME_SIZE;
+	     data_offset++ )
+	{
+		seed = ( seed * 1103515245UL ) + 12345;
+
+		expected_data[ data_offset ] = (uint8_t) ( seed >> 16 );
+	}
+	data = (uint8_t *) memory_allocate(
+	                    sizeof( uint8_t ) * data_size );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "data",
+	 data );
+
+	result = memory_set(
+	          data,
+	          0,
+	          data_size ) != NULL;
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* The logical volume is encrypted per sector of 512 bytes
+	 * where the sector number is the tweak value
+	 */
+	result = libcaes_tweaked_context_initialize(
+	          &xts_context,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcaes_tweaked_context_set_keys(
+	          xts_context,
+	          LIBCAES_CRYPT_MODE_ENCRYPT,
+	          key,
+	          128,
+	          tweak_key,
+	          128,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( data_offset = 0;
+	     data_offset < FVDE_TEST_VOLUME_THREADED_LOGICAL_VOLUME_SIZE;
+	     data_offset += 512 )
+	{
+		result = memory_set(
+		          tweak_value,
+		          0,
+		          16 ) != NULL;
+
+		FVDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 tweak_value,
+		 (uint64_t) ( data_offset / 512 ) );
+
+		result = libcaes_crypt_xts(
+		          xts_context,
+		          LIBCAES_CRYPT_MODE_ENCRYPT,
+		          tweak_value,
+		          16,
+		          &( expected_data[ data_offset ] ),
+		          512,
+		          &( data[ FVDE_TEST_VOLUME_THREADED_LOGICAL_VOLUME_OFFSET + data_offset ] ),
+		          512,
+		          &error );
+
+		FVDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FVDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libcaes_tweaked_context_free(
+	          &xts_context,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_memory_range_initialize(
+	          &file_io_handle,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_memory_range_set(
+	          file_io_handle,
+	          data,
+	          data_size,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_open(
+	          file_io_handle,
+	          LIBBFIO_OPEN_READ,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The volume is set up as libfvde_volume_open_read would for an unlocked volume
+	 * with a small sectors cache so that sector data is evicted while the threads read
+	 */
+	result = libfvde_volume_initialize(
+	          &volume,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	internal_volume = (libfvde_internal_volume_t *) volume;
+
+	internal_volume->file_io_handle                   = file_io_handle;
+	internal_volume->io_handle->is_encrypted          = 1;
+	internal_volume->io_handle->bytes_per_sector      = 512;
+	internal_volume->io_handle->block_size            = 4096;
+	internal_volume->io_handle->logical_volume_offset = FVDE_TEST_VOLUME_THREADED_LOGICAL_VOLUME_OFFSET;
+	internal_volume->io_handle->logical_volume_size   = FVDE_TEST_VOLUME_THREADED_LOGICAL_VOLUME_SIZE;
+	internal_volume->io_handle->sector_data_size      = 4096;
+
+	result = memory_copy(
+	          internal_volume->keyring->volume_master_key,
+	          key,
+	          16 ) != NULL;
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = memory_copy(
+	          internal_volume->keyring->volume_tweak_key,
+	          tweak_key,
+	          16 ) != NULL;
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libcaes_tweaked_context_initialize(
+	          &( internal_volume->io_handle->xts_context ),
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcaes_tweaked_context_set_keys(
+	          internal_volume->io_handle->xts_context,
+	          LIBCAES_CRYPT_MODE_DECRYPT,
+	          key,
+	          128,
+	          tweak_key,
+	          128,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfvde_sectors_cache_initialize(
+	          &( internal_volume->sectors_cache ),
+	          8,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfvde_sector_data_pool_initialize(
+	          &( internal_volume->sector_data_pool ),
+	          4096,
+	          8,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfvde_read_ahead_initialize(
+	          &( internal_volume->read_ahead ),
+	          internal_volume->io_handle,
+	          file_io_handle,
+	          key,
+	          tweak_key,
+	          64 * 1024,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_queue_initialize(
+	          &( internal_volume->read_contexts ),
+	          LIBFVDE_MAXIMUM_NUMBER_OF_READ_CONTEXTS,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	internal_volume->is_locked = 0;
+
+	offset = libfvde_volume_seek_offset(
+	          volume,
+	          1024,
+	          SEEK_SET,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 (int64_t) offset,
+	 (int64_t) 1024 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test concurrent reads
+	 */
+	for( thread_index = 0;
+	     thread_index < FVDE_TEST_VOLUME_THREADED_NUMBER_OF_THREADS;
+	     thread_index++ )
+	{
+		thread_values[ thread_index ].volume        = volume;
+		thread_values[ thread_index ].expected_data = expected_data;
+		thread_values[ thread_index ].seed          = (uint32_t) ( thread_index + 1 );
+		thread_values[ thread_index ].result        = 0;
+
+		result = libcthreads_thread_create(
+		          &( threads[ thread_index ] ),
+		          NULL,
+		          &fvde_test_volume_read_buffer_at_offset_positional_thread_callback,
+		          (void *) &( thread_values[ thread_index ] ),
+		          &error );
+
+		FVDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FVDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	for( thread_index = 0;
+	     thread_index < FVDE_TEST_VOLUME_THREADED_NUMBER_OF_THREADS;
+	     thread_index++ )
+	{
+		result = libcthreads_thread_join(
+		          &( threads[ thread_index ] ),
+		          &error );
+
+		FVDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FVDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		FVDE_TEST_ASSERT_EQUAL_INT(
+		 "thread_values[ thread_index ].result",
+		 thread_values[ thread_index ].result,
+		 1 );
+	}
+	/* The reads at a specific offset do not change the current offset
+	 */
+	result = libfvde_volume_get_offset(
+	          volume,
+	          &offset,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 (int64_t) offset,
+	 (int64_t) 1024 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The read contexts are pushed back onto the queue for reuse
+	 */
+	result = libcthreads_queue_try_pop(
+	          internal_volume->read_contexts,
+	          (intptr_t **) &read_context,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "read_context",
+	 read_context );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfvde_read_context_free(
+	          &read_context,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test the serialized read without read contexts, as used when the file IO handle
+	 * cannot be cloned
+	 */
+	read_contexts                  = internal_volume->read_contexts;
+	internal_volume->read_contexts = NULL;
+
+	read_count = libfvde_volume_read_buffer_at_offset_positional(
+	              volume,
+	              buffer,
+	              16,
+	              2048,
+	              &error );
+
+	FVDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 16 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          buffer,
+	          &( expected_data[ 2048 ] ),
+	          16 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libfvde_volume_get_offset(
+	          volume,
+	          &offset,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 (int64_t) offset,
+	 (int64_t) 1024 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	internal_volume->read_contexts = read_contexts;
+	read_contexts                  = NULL;
+
+	/* Test that libfvde_volume_read_buffer_at_offset changes the current offset
+	 */
+	read_count = libfvde_volume_read_buffer_at_offset(
+	              volume,
+	              buffer,
+	              16,
+	              4096,
+	              &error );
+
+	FVDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 16 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          buffer,
+	          &( expected_data[ 4096 ] ),
+	          16 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libfvde_volume_get_offset(
+	          volume,
+	          &offset,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 (int64_t) offset,
+	 (int64_t) 4096 + 16 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = libfvde_volume_close(
+	          volume,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfvde_volume_free(
+	          &volume,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_close(
+	          file_io_handle,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_free(
+	          &file_io_handle,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 data );
+
+	memory_free(
+	 expected_data );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	for( thread_index = 0;
+	     thread_index < FVDE_TEST_VOLUME_THREADED_NUMBER_OF_THREADS;
+	     thread_index++ )
+	{
+		if( threads[ thread_index ] != NULL )
+		{
+			libcthreads_thread_join(
+			 &( threads[ thread_index ] ),
+			 NULL );
+		}
+	}
+	if( read_context != NULL )
+	{
+		libfvde_read_context_free(
+		 &read_context,
+		 NULL );
+	}
+	if( read_contexts != NULL )
+	{
+		internal_volume->read_contexts = read_contexts;
+	}
+	if( volume != NULL )
+	{
+		libfvde_volume_free(
+		 &volume,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( xts_context != NULL )
+	{
+		libcaes_tweaked_context_free(
+		 &xts_context,
+		 NULL );
+	}
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	if( expected_data != NULL )
+	{
+		memory_free(
+		 expected_data );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT ) && defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT ) */
+
+/* Tests the libfvde_volume_seek_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_volume_seek_offset(
+     libfvde_volume_t *volume )
+{
+	libcerror_error_t *error = NULL;
+	size64_t size            = 0;
+	off64_t offset           = 0;
+
+	/* Test regular cases
+	 */
+	offset = libfvde_volume_seek_offset(
+	          volume,
+	          0,
+	          SEEK_END,
+	          &error );
+
+	FVDE_TEST_ASSERT_NOT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	size = (size64_t) offset;
+
+	offset = libfvde_volume_seek_offset(
+	          volume,
+	          1024,
+	          SEEK_SET,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 1024 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	offset = libfvde_volume_seek_offset(
+	          volume,
+	          -512,
+	          SEEK_CUR,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 512 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	offset = libfvde_volume_seek_offset(
+	          volume,
+	          (off64_t) ( size + 512 ),
+	          SEEK_SET,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) ( size + 512 ) );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Reset offset to 0
+	 */
+	offset = libfvde_volume_seek_offset(
+	          volume,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 0 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	offset = libfvde_volume_seek_offset(
+	          NULL,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	offset = libfvde_volume_seek_offset(
+	          volume,
+	          -1,
+	          SEEK_SET,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	offset = libfvde_volume_seek_offset(
+	          volume,
+	          -1,
+	          SEEK_CUR,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	offset = libfvde_volume_seek_offset(
+	          volume,
+	          (off64_t) ( -1 * ( size + 1 ) ),
+	          SEEK_END,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfvde_volume_get_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_volume_get_offset(
+     libfvde_volume_t *volume )
+{
+	libcerror_error_t *error = NULL;
+	off64_t offset           = 0;
+	int offset_is_set        = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libfvde_volume_get_offset(
+	          volume,
+	          &offset,
+	          &error );
+
+	FVDE_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	offset_is_set = result;
+
+	/* Test error cases
+	 */
+	result = libfvde_volume_get_offset(
+	          NULL,
+	          &offset,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	if( offset_is_set != 0 )
+	{
+		result = libfvde_volume_get_offset(
+		          volume,
+		          NULL,
+		          &error );
+
+		FVDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		FVDE_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfvde_volume_get_logical_volume_size function
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_volume_get_logical_volume_size(
+     libfvde_volume_t *volume )
+{
+	libcerror_error_t *error       = NULL;
+	size64_t logical_volume_size   = 0;
+	int logical_volume_size_is_set = 0;
+	int result                     = 0;
+
+	/* Test regular cases
+	 */
+	result = libfvde_volume_get_logical_volume_size(
+	          volume,
+	          &logical_volume_size,
+	          &error );
+
+	FVDE_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	logical_volume_size_is_set = result;
+
+	/* Test error cases
+	 */
+	result = libfvde_volume_get_logical_volume_size(
+	          NULL,
+	          &logical_volume_size,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	if( logical_volume_size_is_set != 0 )
+	{
+		result = libfvde_volume_get_logical_volume_size(
+		          volume,
+		          NULL,
+		          &error );
+
+		FVDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		FVDE_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfvde_volume_get_next_mapped_range function
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_volume_get_next_mapped_range(
+     libfvde_volume_t *volume )
+{
+	libcerror_error_t *error = NULL;
+	size64_t range_size      = 0;
+	off64_t range_offset     = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libfvde_volume_get_next_mapped_range(
+	          volume,
+	          0,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	FVDE_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( result != 0 )
+	{
+		FVDE_TEST_ASSERT_NOT_EQUAL_INT64(
+		 "range_size",
+		 (int64_t) range_size,
+		 (int64_t) 0 );
+	}
+	/* Test error cases
+	 */
+	result = libfvde_volume_get_next_mapped_range(
+	          NULL,
+	          0,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_volume_get_next_mapped_range(
+	          volume,
+	          -1,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_volume_get_next_mapped_range(
+	          volume,
+	          0,
+	          NULL,
+	          &range_size,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_volume_get_next_mapped_range(
+	          volume,
+	          0,
+	          &range_offset,
+	          NULL,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfvde_volume_get_logical_volume_encryption_method function
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_volume_get_logical_volume_encryption_method(
+     libfvde_volume_t *volume )
+{
+	libcerror_error_t *error                    = NULL;
+	uint32_t logical_volume_encryption_method   = 0;
+	int logical_volume_encryption_method_is_set = 0;
+	int result                                  = 0;
+
+	/* Test regular cases
+	 */
+	result = libfvde_volume_get_logical_volume_encryption_method(
+	          volume,
+	          &logical_volume_encryption_method,
+	          &error );
+
+	FVDE_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	logical_volume_encryption_method_is_set = result;
+
+	/* Test error cases
+	 */
+	result = libfvde_volume_get_logical_volume_encryption_method(
+	          NULL,
+	          &logical_volume_encryption_method,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	if( logical_volume_encryption_method_is_set != 0 )
+	{
+		result = libfvde_volume_get_logical_volume_encryption_method(
+		          volume,
+		          NULL,
+		          &error );
+
+		FVDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		FVDE_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfvde_volume_get_physical_volume_size function
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_volume_get_physical_volume_size(
+     libfvde_volume_t *volume )
+{
+	libcerror_error_t *error        = NULL;
+	size64_t physical_volume_size   = 0;
+	int physical_volume_size_is_set = 0;
+	int result                      = 0;
+
+	/* Test regular cases
+	 */
+	result = libfvde_volume_get_physical_volume_size(
+	          volume,
+	          &physical_volume_size,
+	          &error );
+
+	FVDE_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	physical_volume_size_is_set = result;
+
+	/* Test error cases
+	 */
+	result = libfvde_volume_get_physical_volume_size(
+	          NULL,
+	          &physical_volume_size,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	if( physical_volume_size_is_set != 0 )
+	{
+		result = libfvde_volume_get_physical_volume_size(
+		          volume,
+		          NULL,
+		          &error );
+
+		FVDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		FVDE_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfvde_volume_get_physical_volume_encryption_method function
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_volume_get_physical_volume_encryption_method(
+     libfvde_volume_t *volume )
+{
+	libcerror_error_t *error                     = NULL;
+	uint32_t physical_volume_encryption_method   = 0;
+	int physical_volume_encryption_method_is_set = 0;
+	int result                                   = 0;
+
+	/* Test regular cases
+	 */
+	result = libfvde_volume_get_physical_volume_encryption_method(
+	          volume,
+	          &physical_volume_encryption_method,
+	          &error );
+
+	FVDE_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	physical_volume_encryption_method_is_set = result;
+
+	/* Test error cases
+	 */
+	result = libfvde_volume_get_physical_volume_encryption_method(
+	          NULL,
+	          &physical_volume_encryption_method,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	if( physical_volume_encryption_method_is_set != 0 )
+	{
+		result = libfvde_volume_get_physical_volume_encryption_method(
+		          volume,
+		          NULL,
+		          &error );
+
+		FVDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		FVDE_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfvde_volume_set_sector_data_size function
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_volume_set_sector_data_size(
+     void )
+{
+	libcerror_error_t *error  = NULL;
+	libfvde_volume_t *volume  = NULL;
+	int result                = 0;
+
+	/* Initialize test
+	 */
+	result = libfvde_volume_initialize(
+	          &volume,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfvde_volume_set_sector_data_size(
+	          volume,
+	          65536,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfvde_volume_set_sector_data_size(
+	          volume,
+	          0,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfvde_volume_set_sector_data_size(
+	          NULL,
+	          4096,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_volume_set_sector_data_size(
+	          volume,
+	          1000,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_volume_set_sector_data_size(
+	          volume,
+	          (size_t) ( 2 * 1024 * 1024 ),
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfvde_volume_free(
+	          &volume,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "volume",
+	 volume );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume != NULL )
+	{
+		libfvde_volume_free(
+		 &volume,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfvde_volume_set_cache_size function
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_volume_set_cache_size(
+     void )
+{
+	libcerror_error_t *error  = NULL;
+	libfvde_volume_t *volume  = NULL;
+	int result                = 0;
+
+	/* Initialize test
+	 */
+	result = libfvde_volume_initialize(
+	          &volume,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfvde_volume_set_cache_size(
+	          volume,
+	          1024 * 1024,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfvde_volume_set_cache_size(
+	          volume,
+	          0,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfvde_volume_set_cache_size(
+	          NULL,
+	          1024 * 1024,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_volume_set_cache_size(
+	          volume,
+	          (size_t) ( 1024 * 1024 * 1024 ) + 1,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfvde_volume_free(
+	          &volume,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "volume",
+	 volume );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume != NULL )
+	{
+		libfvde_volume_free(
+		 &volume,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfvde_volume_set_read_ahead_size function
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_volume_set_read_ahead_size(
+     void )
+{
+	libcerror_error_t *error  = NULL;
+	libfvde_volume_t *volume  = NULL;
+	int result                = 0;
+
+	/* Initialize test
+	 */
+	result = libfvde_volume_initialize(
+	          &volume,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfvde_volume_set_read_ahead_size(
+	          volume,
+	          1024 * 1024,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfvde_volume_set_read_ahead_size(
+	          volume,
+	          0,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfvde_volume_set_read_ahead_size(
+	          NULL,
+	          1024 * 1024,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_volume_set_read_ahead_size(
+	          volume,
+	          (size_t) ( 64 * 1024 * 1024 ) + 512,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_volume_set_read_ahead_size(
+	          volume,
+	          1000,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfvde_volume_free(
+	          &volume,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "volume",
+	 volume );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume != NULL )
+	{
+		libfvde_volume_free(
+		 &volume,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfvde_volume_set_number_of_decryption_threads function
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_volume_set_number_of_decryption_threads(
+     void )
+{
+	libcerror_error_t *error  = NULL;
+	libfvde_volume_t *volume  = NULL;
+	int result                = 0;
+
+	/* Initialize test
+	 */
+	result = libfvde_volume_initialize(
+	          &volume,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfvde_volume_set_number_of_decryption_threads(
+	          volume,
+	          4,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfvde_volume_set_number_of_decryption_threads(
+	          volume,
+	          0,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfvde_volume_set_number_of_decryption_threads(
+	          NULL,
+	          4,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_volume_set_number_of_decryption_threads(
+	          volume,
+	          -1,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_volume_set_number_of_decryption_threads(
+	          volume,
+	          65,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfvde_volume_free(
+	          &volume,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "volume",
+	 volume );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume != NULL )
+	{
+		libfvde_volume_free(
+		 &volume,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfvde_volume_set_lazy_open function
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_volume_set_lazy_open(
+     void )
+{
+	libcerror_error_t *error  = NULL;
+	libfvde_volume_t *volume  = NULL;
+	int result                = 0;
+
+	/* Initialize test
+	 */
+	result = libfvde_volume_initialize(
+	          &volume,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfvde_volume_set_lazy_open(
+	          volume,
+	          1,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfvde_volume_set_lazy_open(
+	          volume,
+	          0,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfvde_volume_set_lazy_open(
+	          NULL,
+	          1,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfvde_volume_free(
+	          &volume,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "volume",
+	 volume );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume != NULL )
+	{
+		libfvde_volume_free(
+		 &volume,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfvde_volume_set_parse_profile function
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_volume_set_parse_profile(
+     void )
+{
+	libcerror_error_t *error  = NULL;
+	libfvde_volume_t *volume  = NULL;
+	int result                = 0;
+
+	/* Initialize test
+	 */
+	result = libfvde_volume_initialize(
+	          &volume,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfvde_volume_set_parse_profile(
+	          volume,
+	          LIBFVDE_PARSE_PROFILE_KEYS_ONLY,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfvde_volume_set_parse_profile(
+	          volume,
+	          LIBFVDE_PARSE_PROFILE_FULL,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfvde_volume_set_parse_profile(
+	          NULL,
+	          LIBFVDE_PARSE_PROFILE_FULL,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_volume_set_parse_profile(
+	          volume,
+	          0,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_volume_set_parse_profile(
+	          volume,
+	          0x80,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
 	 */
-	result = libfvde_volume_get_logical_volume_size(
+	result = libfvde_volume_free(
+	          &volume,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "volume",
+	 volume );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume != NULL )
+	{
+		libfvde_volume_free(
+		 &volume,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfvde_volume_check_utf8_passwords function
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_volume_check_utf8_passwords(
+     void )
+{
+	const uint8_t *utf8_strings[ 1 ] = {
+		(const uint8_t *) "password" };
+
+	size_t utf8_string_lengths[ 1 ] = {
+		8 };
+
+	libcerror_error_t *error = NULL;
+	libfvde_volume_t *volume = NULL;
+	int password_index       = -1;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = libfvde_volume_initialize(
+	          &volume,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfvde_volume_check_utf8_passwords(
+	          NULL,
+	          0,
+	          utf8_strings,
+	          utf8_string_lengths,
+	          1,
+	          &password_index,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test libfvde_volume_check_utf8_passwords on a volume that is not open
+	 */
+	result = libfvde_volume_check_utf8_passwords(
 	          volume,
-	          &logical_volume_size,
+	          0,
+	          utf8_strings,
+	          utf8_string_lengths,
+	          1,
+	          &password_index,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "password_index",
+	 password_index,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfvde_volume_free(
+	          &volume,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "volume",
+	 volume );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume != NULL )
+	{
+		libfvde_volume_free(
+		 &volume,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfvde_volume_export_layout function
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_volume_export_layout(
+     void )
+{
+	libcerror_error_t *error  = NULL;
+	libfvde_volume_t *volume  = NULL;
+	int result                = 0;
+
+	/* Initialize test
+	 */
+	result = libfvde_volume_initialize(
+	          &volume,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfvde_volume_export_layout(
+	          NULL,
+	          "layout.fvdelayt",
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_volume_export_layout(
+	          volume,
+	          NULL,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_volume_export_layout(
+	          volume,
+	          "",
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test libfvde_volume_export_layout on a volume that was not opened
+	 */
+	result = libfvde_volume_export_layout(
+	          volume,
+	          "layout.fvdelayt",
 	          &error );
 
-	FVDE_TEST_ASSERT_NOT_EQUAL_INT(
+	FVDE_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
 	 -1 );
 
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfvde_volume_free(
+	          &volume,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "volume",
+	 volume );
+
 	FVDE_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	logical_volume_size_is_set = result;
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume != NULL )
+	{
+		libfvde_volume_free(
+		 &volume,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfvde_volume_import_layout function
+ * Returns 1 if successful or 0 if not
+ */
+int fvde_test_volume_import_layout(
+     void )
+{
+	libcerror_error_t *error  = NULL;
+	libfvde_volume_t *volume  = NULL;
+	int result                = 0;
+
+	/* Initialize test
+	 */
+	result = libfvde_volume_initialize(
+	          &volume,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
 	/* Test error cases
 	 */
-	result = libfvde_volume_get_logical_volume_size(
+	result = libfvde_volume_import_layout(
 	          NULL,
-	          &logical_volume_size,
+	          "layout.fvdelayt",
 	          &error );
 
 	FVDE_TEST_ASSERT_EQUAL_INT(
@@ -2055,25 +4699,78 @@ int fvde_test_volume_get_logical_volume_size(
 	libcerror_error_free(
 	 &error );
 
-	if( logical_volume_size_is_set != 0 )
-	{
-		result = libfvde_volume_get_logical_volume_size(
-		          volume,
-		          NULL,
-		          &error );
+	result = libfvde_volume_import_layout(
+	          volume,
+	          NULL,
+	          &error );
 
-		FVDE_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-		FVDE_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfvde_volume_import_layout(
+	          volume,
+	          "",
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test libfvde_volume_import_layout with a non-existing layout file
+	 */
+	result = libfvde_volume_import_layout(
+	          volume,
+	          "nonexisting.fvdelayt",
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfvde_volume_free(
+	          &volume,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "volume",
+	 volume );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-		libcerror_error_free(
-		 &error );
-	}
 	return( 1 );
 
 on_error:
@@ -2082,121 +4779,279 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
+	if( volume != NULL )
+	{
+		libfvde_volume_free(
+		 &volume,
+		 NULL );
+	}
 	return( 0 );
 }
 
-/* Tests the libfvde_volume_get_logical_volume_encryption_method function
+/* Tests the libfvde_volume_export_layout_file_io_handle and libfvde_volume_import_layout_file_io_handle functions
  * Returns 1 if successful or 0 if not
  */
-int fvde_test_volume_get_logical_volume_encryption_method(
-     libfvde_volume_t *volume )
+int fvde_test_volume_export_layout_file_io_handle(
+     libfvde_volume_t *volume,
+     libbfio_handle_t *file_io_handle,
+     const system_character_t *password )
 {
-	libcerror_error_t *error                    = NULL;
-	uint32_t logical_volume_encryption_method   = 0;
-	int logical_volume_encryption_method_is_set = 0;
-	int result                                  = 0;
+	uint8_t buffer[ 512 ];
+	uint8_t layout_buffer[ 512 ];
+
+	libbfio_handle_t *layout_file_io_handle = NULL;
+	libcerror_error_t *error                = NULL;
+	libfvde_volume_t *layout_volume         = NULL;
+	uint8_t *layout_data                    = NULL;
+	size64_t layout_volume_size             = 0;
+	size64_t volume_size                    = 0;
+	size_t layout_data_size                 = 0;
+	size_t read_size                        = 512;
+	ssize_t read_count                      = 0;
+	uint32_t data_size                      = 0;
+	int result                              = 0;
+
+	/* Initialize test
+	 */
+	layout_data = (uint8_t *) memory_allocate(
+	                           sizeof( uint8_t ) * FVDE_TEST_VOLUME_LAYOUT_DATA_SIZE );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "layout_data",
+	 layout_data );
+
+	result = libbfio_memory_range_initialize(
+	          &layout_file_io_handle,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_memory_range_set(
+	          layout_file_io_handle,
+	          layout_data,
+	          FVDE_TEST_VOLUME_LAYOUT_DATA_SIZE,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfvde_volume_export_layout_file_io_handle(
+	          volume,
+	          layout_file_io_handle,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The size of the layout file is determined by the file header
+	 */
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (fvde_layout_file_header_t *) layout_data )->data_size,
+	 data_size );
+
+	layout_data_size = sizeof( fvde_layout_file_header_t ) + (size_t) data_size;
+
+	FVDE_TEST_ASSERT_LESS_THAN_UINT64(
+	 "layout_data_size",
+	 (uint64_t) layout_data_size,
+	 (uint64_t) FVDE_TEST_VOLUME_LAYOUT_DATA_SIZE );
+
+	result = libbfio_memory_range_set(
+	          layout_file_io_handle,
+	          layout_data,
+	          layout_data_size,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test libfvde_volume_import_layout_file_io_handle with the exported layout
+	 */
+	result = libfvde_volume_initialize(
+	          &layout_volume,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "layout_volume",
+	 layout_volume );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfvde_volume_import_layout_file_io_handle(
+	          layout_volume,
+	          layout_file_io_handle,
+	          &error );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( password != NULL )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		result = libfvde_volume_set_utf16_password(
+		          layout_volume,
+		          (uint16_t *) password,
+		          system_string_length(
+		           password ),
+		          &error );
+#else
+		result = libfvde_volume_set_utf8_password(
+		          layout_volume,
+		          (uint8_t *) password,
+		          system_string_length(
+		           password ),
+		          &error );
+#endif
+		FVDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
 
-	/* Test regular cases
-	 */
-	result = libfvde_volume_get_logical_volume_encryption_method(
-	          volume,
-	          &logical_volume_encryption_method,
+		FVDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libfvde_volume_open_file_io_handle(
+	          layout_volume,
+	          file_io_handle,
+	          LIBFVDE_OPEN_READ,
 	          &error );
 
-	FVDE_TEST_ASSERT_NOT_EQUAL_INT(
+	FVDE_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
 	FVDE_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	logical_volume_encryption_method_is_set = result;
-
-	/* Test error cases
+	/* The volume opened with the layout should map the same logical volume
 	 */
-	result = libfvde_volume_get_logical_volume_encryption_method(
-	          NULL,
-	          &logical_volume_encryption_method,
+	result = libfvde_volume_get_logical_volume_size(
+	          volume,
+	          &volume_size,
 	          &error );
 
 	FVDE_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	FVDE_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
-
-	if( logical_volume_encryption_method_is_set != 0 )
-	{
-		result = libfvde_volume_get_logical_volume_encryption_method(
-		          volume,
-		          NULL,
-		          &error );
+	result = libfvde_volume_get_logical_volume_size(
+	          layout_volume,
+	          &layout_volume_size,
+	          &error );
 
-		FVDE_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-		FVDE_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
+	FVDE_TEST_ASSERT_EQUAL_UINT64(
+	 "layout_volume_size",
+	 (uint64_t) layout_volume_size,
+	 (uint64_t) volume_size );
 
-		libcerror_error_free(
-		 &error );
-	}
-	return( 1 );
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-on_error:
-	if( error != NULL )
+	if( volume_size < (size64_t) read_size )
 	{
-		libcerror_error_free(
-		 &error );
+		read_size = (size_t) volume_size;
 	}
-	return( 0 );
-}
+	read_count = libfvde_volume_read_buffer_at_offset(
+	              volume,
+	              buffer,
+	              read_size,
+	              0,
+	              &error );
 
-/* Tests the libfvde_volume_get_physical_volume_size function
- * Returns 1 if successful or 0 if not
- */
-int fvde_test_volume_get_physical_volume_size(
-     libfvde_volume_t *volume )
-{
-	libcerror_error_t *error        = NULL;
-	size64_t physical_volume_size   = 0;
-	int physical_volume_size_is_set = 0;
-	int result                      = 0;
+	FVDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) read_size );
 
-	/* Test regular cases
-	 */
-	result = libfvde_volume_get_physical_volume_size(
-	          volume,
-	          &physical_volume_size,
-	          &error );
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-	FVDE_TEST_ASSERT_NOT_EQUAL_INT(
-	 "result",
-	 result,
-	 -1 );
+	read_count = libfvde_volume_read_buffer_at_offset(
+	              layout_volume,
+	              layout_buffer,
+	              read_size,
+	              0,
+	              &error );
+
+	FVDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) read_size );
 
 	FVDE_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	physical_volume_size_is_set = result;
+	result = memory_compare(
+	          layout_buffer,
+	          buffer,
+	          read_size );
+
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
 
 	/* Test error cases
 	 */
-	result = libfvde_volume_get_physical_volume_size(
+	result = libfvde_volume_export_layout_file_io_handle(
 	          NULL,
-	          &physical_volume_size,
+	          layout_file_io_handle,
 	          &error );
 
 	FVDE_TEST_ASSERT_EQUAL_INT(
@@ -2211,103 +5066,77 @@ int fvde_test_volume_get_physical_volume_size(
 	libcerror_error_free(
 	 &error );
 
-	if( physical_volume_size_is_set != 0 )
-	{
-		result = libfvde_volume_get_physical_volume_size(
-		          volume,
-		          NULL,
-		          &error );
-
-		FVDE_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
-
-		FVDE_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
+	/* Test libfvde_volume_import_layout_file_io_handle on a volume that is open
+	 */
+	result = libfvde_volume_import_layout_file_io_handle(
+	          layout_volume,
+	          layout_file_io_handle,
+	          &error );
 
-		libcerror_error_free(
-		 &error );
-	}
-	return( 1 );
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
-	return( 0 );
-}
+	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
 
-/* Tests the libfvde_volume_get_physical_volume_encryption_method function
- * Returns 1 if successful or 0 if not
- */
-int fvde_test_volume_get_physical_volume_encryption_method(
-     libfvde_volume_t *volume )
-{
-	libcerror_error_t *error                     = NULL;
-	uint32_t physical_volume_encryption_method   = 0;
-	int physical_volume_encryption_method_is_set = 0;
-	int result                                   = 0;
+	libcerror_error_free(
+	 &error );
 
-	/* Test regular cases
+	/* Clean up
 	 */
-	result = libfvde_volume_get_physical_volume_encryption_method(
-	          volume,
-	          &physical_volume_encryption_method,
+	result = libfvde_volume_close(
+	          layout_volume,
 	          &error );
 
-	FVDE_TEST_ASSERT_NOT_EQUAL_INT(
+	FVDE_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 0 );
 
 	FVDE_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	physical_volume_encryption_method_is_set = result;
-
-	/* Test error cases
-	 */
-	result = libfvde_volume_get_physical_volume_encryption_method(
-	          NULL,
-	          &physical_volume_encryption_method,
+	result = libfvde_volume_free(
+	          &layout_volume,
 	          &error );
 
 	FVDE_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	FVDE_TEST_ASSERT_IS_NOT_NULL(
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "layout_volume",
+	 layout_volume );
+
+	FVDE_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	result = libbfio_handle_free(
+	          &layout_file_io_handle,
+	          &error );
 
-	if( physical_volume_encryption_method_is_set != 0 )
-	{
-		result = libfvde_volume_get_physical_volume_encryption_method(
-		          volume,
-		          NULL,
-		          &error );
+	FVDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-		FVDE_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "layout_file_io_handle",
+	 layout_file_io_handle );
 
-		FVDE_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
+	FVDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 layout_data );
 
-		libcerror_error_free(
-		 &error );
-	}
 	return( 1 );
 
 on_error:
@@ -2316,6 +5145,23 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
+	if( layout_volume != NULL )
+	{
+		libfvde_volume_free(
+		 &layout_volume,
+		 NULL );
+	}
+	if( layout_file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &layout_file_io_handle,
+		 NULL );
+	}
+	if( layout_data != NULL )
+	{
+		memory_free(
+		 layout_data );
+	}
 	return( 0 );
 }
 
@@ -2409,6 +5255,50 @@ int main(
 	 "libfvde_volume_free",
 	 fvde_test_volume_free );
 
+	FVDE_TEST_RUN(
+	 "libfvde_volume_set_sector_data_size",
+	 fvde_test_volume_set_sector_data_size );
+
+	FVDE_TEST_RUN(
+	 "libfvde_volume_set_cache_size",
+	 fvde_test_volume_set_cache_size );
+
+	FVDE_TEST_RUN(
+	 "libfvde_volume_set_read_ahead_size",
+	 fvde_test_volume_set_read_ahead_size );
+
+	FVDE_TEST_RUN(
+	 "libfvde_volume_set_number_of_decryption_threads",
+	 fvde_test_volume_set_number_of_decryption_threads );
+
+	FVDE_TEST_RUN(
+	 "libfvde_volume_set_lazy_open",
+	 fvde_test_volume_set_lazy_open );
+
+	FVDE_TEST_RUN(
+	 "libfvde_volume_set_parse_profile",
+	 fvde_test_volume_set_parse_profile );
+
+	FVDE_TEST_RUN(
+	 "libfvde_volume_check_utf8_passwords",
+	 fvde_test_volume_check_utf8_passwords );
+
+	FVDE_TEST_RUN(
+	 "libfvde_volume_export_layout",
+	 fvde_test_volume_export_layout );
+
+	FVDE_TEST_RUN(
+	 "libfvde_volume_import_layout",
+	 fvde_test_volume_import_layout );
+
+#if defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT ) && defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT )
+
+	FVDE_TEST_RUN(
+	 "libfvde_volume_read_buffer_at_offset_positional",
+	 fvde_test_volume_read_buffer_at_offset_positional );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFVDE_DLL_IMPORT ) && defined( HAVE_LIBFVDE_MULTI_THREAD_SUPPORT ) */
+
 #if !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 )
 	if( source != NULL )
 	{
@@ -2565,6 +5455,11 @@ int main(
 		 fvde_test_volume_read_buffer_at_offset,
 		 volume );
 
+		FVDE_TEST_RUN_WITH_ARGS(
+		 "libfvde_volume_read_buffers_at_offsets",
+		 fvde_test_volume_read_buffers_at_offsets,
+		 volume );
+
 		/* TODO: add tests for libfvde_volume_write_buffer */
 
 		/* TODO: add tests for libfvde_volume_write_buffer_at_offset */
@@ -2584,6 +5479,11 @@ int main(
 		 fvde_test_volume_get_logical_volume_size,
 		 volume );
 
+		FVDE_TEST_RUN_WITH_ARGS(
+		 "libfvde_volume_get_next_mapped_range",
+		 fvde_test_volume_get_next_mapped_range,
+		 volume );
+
 		FVDE_TEST_RUN_WITH_ARGS(
 		 "libfvde_volume_get_logical_volume_encryption_method",
 		 fvde_test_volume_get_logical_volume_encryption_method,
@@ -2621,6 +5521,13 @@ int main(
 
 		/* TODO: add tests for libfvde_volume_read_encrypted_root_plist_file_io_handle */
 
+		FVDE_TEST_RUN_WITH_ARGS(
+		 "libfvde_volume_export_layout_file_io_handle",
+		 fvde_test_volume_export_layout_file_io_handle,
+		 volume,
+		 file_io_handle,
+		 option_password );
+
 		/* Clean up
 		 */
 		result = fvde_test_volume_close_source(
@@ -7,7 +7,7 @@ EXIT_SUCCESS=0;
 EXIT_FAILURE=1;
 EXIT_IGNORE=77;
 
-LIBRARY_TESTS="data_area_descriptor encrypted_metadata encryption_context_plist error io_handle keyring metadata metadata_block notify sector_data segment_descriptor volume volume_group";
+LIBRARY_TESTS="aes_hardware checksum data_area_descriptor decryption_pool encrypted_metadata encryption encryption_context_plist error extent_index fcache_cache io_handle keyring layout metadata metadata_block notify passphrase_wrapped_kek password read_ahead read_batch sector_data sector_data_pool sectors_cache segment_descriptor volume volume_group";
 LIBRARY_TESTS_WITH_INPUT="support volume";
 OPTION_SETS="password";
 